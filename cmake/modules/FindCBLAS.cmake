@@ -0,0 +1,41 @@
+# Find the CBLAS includes and library (e.g. OpenBLAS, ATLAS or the reference CBLAS).
+#
+# This module defines
+# CBLAS_INCLUDE_DIR, where to locate cblas.h file
+# CBLAS_LIBRARIES, the libraries to link against to use CBLAS
+# CBLAS_FOUND.  If false, you cannot build anything that requires CBLAS.
+# CBLAS_LIBRARY, where to find the CBLAS library.
+
+set(CBLAS_FOUND 0)
+if(CBLAS_LIBRARY AND CBLAS_INCLUDE_DIR)
+  set(CBLAS_FIND_QUIETLY TRUE)
+endif()
+
+find_path(CBLAS_INCLUDE_DIR cblas.h
+  $ENV{CBLAS_DIR}/include
+  /usr/local/include
+  /usr/include
+  /usr/include/openblas
+  /opt/OpenBLAS/include
+  DOC "Specify the directory containing cblas.h"
+)
+
+find_library(CBLAS_LIBRARY NAMES openblas cblas satlas tatlas PATHS
+  $ENV{CBLAS_DIR}/lib
+  /usr/local/lib
+  /usr/lib
+  /opt/OpenBLAS/lib
+  DOC "Specify the CBLAS library here."
+)
+
+if(CBLAS_INCLUDE_DIR AND CBLAS_LIBRARY)
+  set(CBLAS_FOUND 1 )
+  if(NOT CBLAS_FIND_QUIETLY)
+     message(STATUS "Found CBLAS includes at ${CBLAS_INCLUDE_DIR}")
+     message(STATUS "Found CBLAS library at ${CBLAS_LIBRARY}")
+  endif()
+endif()
+
+set(CBLAS_LIBRARIES ${CBLAS_LIBRARY})
+
+mark_as_advanced(CBLAS_FOUND CBLAS_LIBRARY CBLAS_INCLUDE_DIR)
@@ -121,6 +121,7 @@ ROOT_BUILD_OPTION(builtin_tbb OFF "Built the TBB internally")
 ROOT_BUILD_OPTION(cxx11 ON "Build using C++11 compatible mode, requires gcc > 4.7.x or clang")
 ROOT_BUILD_OPTION(cxx14 OFF "Build using C++14 compatible mode, requires gcc > 5.1.x or clang")
 ROOT_BUILD_OPTION(libcxx OFF "Build using libc++, requires cxx11 option (MacOS X only, for the time being)")
+ROOT_BUILD_OPTION(cblas OFF "Use a system CBLAS library (e.g. OpenBLAS) for the dense matrix products in libMatrix")
 ROOT_BUILD_OPTION(castor ON "CASTOR support, requires libshift from CASTOR >= 1.5.2")
 ROOT_BUILD_OPTION(ccache OFF "Enable ccache usage for speeding up builds")
 ROOT_BUILD_OPTION(chirp ON "Chirp support (Condor remote I/O), requires libchirp_client")
@@ -154,6 +155,7 @@ ROOT_BUILD_OPTION(monalisa ON "Monalisa monitoring support, requires libapmoncpp
 ROOT_BUILD_OPTION(mysql ON "MySQL support, requires libmysqlclient")
 ROOT_BUILD_OPTION(odbc ON "ODBC support, requires libiodbc or libodbc")
 ROOT_BUILD_OPTION(opengl ON "OpenGL support, requires libGL and libGLU")
+ROOT_BUILD_OPTION(openmp OFF "Use OpenMP threads in the parallel algorithms of the hist, math and RooFit libraries")
 ROOT_BUILD_OPTION(oracle ON "Oracle support, requires libocci")
 ROOT_BUILD_OPTION(pch ON)
 ROOT_BUILD_OPTION(pgsql ON "PostgreSQL support, requires libpq")
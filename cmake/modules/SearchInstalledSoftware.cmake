@@ -510,6 +510,36 @@ if(pythia8)
   endif()
 endif()
 
+#---Check for CBLAS-------------------------------------------------------------------
+if(cblas)
+  message(STATUS "Looking for CBLAS")
+  find_package(CBLAS)
+  if(NOT CBLAS_FOUND)
+    if(fail-on-missing)
+      message(FATAL_ERROR "CBLAS library not found and it is required (cblas option enabled)")
+    else()
+      message(STATUS "CBLAS not found. Set [environment] variable CBLAS_DIR to point to your CBLAS installation")
+      message(STATUS "                 For the time being switching OFF 'cblas' option")
+      set(cblas OFF CACHE BOOL "" FORCE)
+    endif()
+  endif()
+endif()
+
+#---Check for OpenMP------------------------------------------------------------------
+if(openmp)
+  message(STATUS "Looking for OpenMP")
+  find_package(OpenMP)
+  if(NOT OPENMP_FOUND)
+    if(fail-on-missing)
+      message(FATAL_ERROR "OpenMP not supported by the compiler and it is required (openmp option enabled)")
+    else()
+      message(STATUS "OpenMP not supported by the compiler")
+      message(STATUS "                 For the time being switching OFF 'openmp' option")
+      set(openmp OFF CACHE BOOL "" FORCE)
+    endif()
+  endif()
+endif()
+
 #---Check for FFTW3-------------------------------------------------------------------
 if(fftw3)
   if(NOT builtin_fftw3)
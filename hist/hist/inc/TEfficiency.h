@@ -64,6 +64,8 @@ protected:
       EStatOption   fStatisticOption;        //defines how the confidence intervals are determined
       TH1*          fTotalHistogram;         //histogram for total number of events
       Double_t      fWeight;                 //weight for all events (default = 1)
+      mutable std::vector<Double_t> fIntervalCache;    //!cached bin contents, efficiencies and errors per global bin
+      mutable std::vector<Double_t> fIntervalSettings; //!settings used for the cached intervals
 
       enum{
          kIsBayesian       = BIT(14),              //bayesian statistics are used
@@ -74,8 +76,14 @@ protected:
       };
 
       void          Build(const char* name,const char* title);
+      void          CheckIntervalCache() const;
+      Double_t      ComputeEfficiencyErrorLow(Int_t bin) const;
+      Double_t      ComputeEfficiencyErrorUp(Int_t bin) const;
       void          FillGraph(TGraphAsymmErrors * graph, Option_t * opt) const;
       void          FillHistogram(TH2 * h2) const;
+      const Double_t* GetCachedInterval(Int_t bin) const;
+      Bool_t        UpdateCacheKey(Int_t bin,Double_t* entry) const;
+      void          UpdateIntervalCache() const;
 
 public:
       TEfficiency();
@@ -118,6 +126,7 @@ public:
       Int_t         GetDimension() const;
       TDirectory*   GetDirectory() const {return fDirectory;}
       Double_t      GetEfficiency(Int_t bin) const;
+      Int_t         GetEfficiencies(std::vector<Double_t>& eff,std::vector<Double_t>& errLow,std::vector<Double_t>& errUp) const;
       Double_t      GetEfficiencyErrorLow(Int_t bin) const;
       Double_t      GetEfficiencyErrorUp(Int_t bin) const;
       Int_t         GetGlobalBin(Int_t binx,Int_t biny=0,Int_t binz=0) const;
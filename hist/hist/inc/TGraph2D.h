@@ -69,6 +69,7 @@ protected:
    TVirtualHistPainter *fPainter; //!Pointer to histogram painter
 
    void     Build(Int_t n);
+   void     ResetDelaunay();
 
 private:
 
@@ -26,6 +26,8 @@
 #include "TNamed.h"
 #endif
 
+#include <vector>
+
 class TGraph2D;
 class TView;
 
@@ -55,24 +57,30 @@ protected:
    Double_t    fXScaleFactor; //!
    Double_t    fYScaleFactor; //!
    Double_t    fZout;        //!Histogram bin height for points lying outside the convex hull
-   Double_t   *fDist;        //!Array used to order mass points by distance
    Int_t       fMaxIter;     //!Maximum number of iterations to find Delaunay triangles
    Int_t       fTriedSize;   //!Real size of the fxTried arrays
    Int_t      *fPTried;      //!
    Int_t      *fNTried;      //!Delaunay triangles storage of size fNdt
    Int_t      *fMTried;      //!
    Int_t      *fHullPoints;  //!Hull points of size fNhull
-   Int_t      *fOrder;       //!Array used to order mass points by distance
    Bool_t      fAllTri;      //!True if FindAllTriangles() has been performed on fGraph2D
-   Bool_t      fInit;        //!True if CreateTrianglesDataStructure() and FindHull() have been performed
+   Bool_t      fInit;        //!True if CreateTrianglesDataStructure(), Triangulate() and FindHull() have been performed
    TGraph2D   *fGraph2D;     //!2D graph containing the user data
+   std::vector<Int_t> fTriVertices;   //!Vertices of the triangulation, 3 per triangle (-1 is the point at infinity)
+   std::vector<Int_t> fTriNeighbours; //!Neighbouring triangle across the edge opposite to each vertex
+   std::vector<Int_t> fTriMark;       //!Work array used to mark triangles during point insertion
+   Int_t       fLastTriangle; //!Triangle found by the last point location, start of the next walk
 
    void     CreateTrianglesDataStructure();
    Bool_t   Enclose(Int_t T1, Int_t T2, Int_t T3, Int_t Ex) const;
    void     FileIt(Int_t P, Int_t N, Int_t M);
    void     FindHull();
+   Bool_t   InConflict(Int_t t, Double_t x, Double_t y) const;
    Bool_t   InHull(Int_t E, Int_t X) const;
+   void     InsertPoint(Int_t p);
    Double_t InterpolateOnPlane(Int_t TI1, Int_t TI2, Int_t TI3, Int_t E) const;
+   Int_t    Locate(Double_t x, Double_t y, Int_t start) const;
+   void     Triangulate();
 
 public:
 
@@ -96,6 +104,7 @@ public:
    Double_t  GetYNmin() const {return fYNmin;}
    Double_t  GetYNmax() const {return fYNmax;}
    Double_t  Interpolate(Double_t x, Double_t y);
+   void      Reset();
    void      SetMaxIter(Int_t n=100000);
    void      SetMarginBinsContent(Double_t z=0.);
 
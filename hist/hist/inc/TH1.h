@@ -149,6 +149,9 @@ protected:
    virtual void     SavePrimitiveHelp(std::ostream &out, const char *hname, Option_t *option = "");
    static Bool_t    RecomputeAxisLimits(TAxis& destAxis, const TAxis& anAxis);
    static Bool_t    SameLimitsAndNBins(const TAxis& axis1, const TAxis& axis2);
+   Bool_t           MergeSameBinning(TCollection *list);
+   static void      AddArrays(Double_t *dest, const Double_t * const *src, Int_t nsrc, Int_t n);
+   static void      AddArrays(Float_t *dest, const Float_t * const *src, Int_t nsrc, Int_t n);
 
    virtual Double_t DoIntegral(Int_t ix1, Int_t ix2, Int_t iy1, Int_t iy2, Int_t iz1, Int_t iz2, Double_t & err,
                                Option_t * opt, Bool_t doerr = kFALSE) const;
@@ -33,6 +33,9 @@ Theory, Practice and Visualization. New York: Wiley", (2) "Jann Ben - ETH Zurich
    The algorithm is briefly described in (4) "Cranmer KS, Kernel Estimation in High-Energy
 Physics. Computer Physics Communications 136:198-207,2001" - e-Print Archive: hep ex/0011057.
    A binned version is also implemented to address the performance issue due to its data size dependence.
+   With SetUseFFT() the estimate is instead computed once on an equidistant grid, by convolving the linearly
+binned data with the sampled kernel via FFT (TVirtualFFT if the FFTW plugin is available, a built-in radix-2
+transform otherwise), and then interpolated. The adaptive bandwidths are computed on the same grid.
 */
 class TKDE : public TNamed  {
 public:
@@ -100,6 +103,8 @@ public:
    void SetUseBinsNEvents(UInt_t nEvents);
    void SetTuneFactor(Double_t rho);
    void SetRange(Double_t xMin, Double_t xMax); // By default computed from the data
+   void SetUseFFT(Bool_t useFFT = kTRUE);
+   void SetNofPointsFFT(UInt_t npoints);
 
    virtual void Draw(const Option_t* option = "");
 
@@ -107,6 +112,7 @@ public:
    Double_t operator()(const Double_t* x, const Double_t* p=0) const;  // Needed for creating TF1
 
    Double_t GetValue(Double_t x) const { return (*this)(x); }
+   void GetValues(UInt_t n, const Double_t* x, Double_t* result) const;
    Double_t GetError(Double_t x) const;
 
    Double_t GetBias(Double_t x) const;
@@ -164,11 +170,13 @@ private:
    Bool_t fUseBins;
    Bool_t fNewData;        // flag to control when new data are given
    Bool_t fUseMinMaxFromData; // flag top control if min and max must be used from data
+   Bool_t fUseFFT;         // flag to compute the estimate on a grid using FFT convolution
 
    UInt_t fNBins;          // Number of bins for binned data option
    UInt_t fNEvents;        // Data's number of events
    Double_t fSumOfCounts; // Data sum of weights
    UInt_t fUseBinsNEvents; // If the algorithm is allowed to use binning this is the minimum number of events to do so
+   UInt_t fNFFTPoints;     // Minimum number of grid points for the FFT evaluation
 
    Double_t fMean;  // Data mean
    Double_t fSigma; // Data std deviation
@@ -182,6 +190,7 @@ private:
 
    std::vector<Double_t> fCanonicalBandwidths;
    std::vector<Double_t> fKernelSigmas2;
+   Double_t fUserKernelSupport; // Half width of the user kernel support in units of the bandwidth
 
    std::vector<Double_t> fBinCount; // Number of events per bin for binned data option
 
@@ -209,6 +218,11 @@ private:
       // Returns the kernel evaluation at x
       return (x > -1. &&  x < 1.) ? M_PI_4 * std::cos(M_PI_2 * x) : 0.0;
    }
+   inline Double_t KernelSupport() const {
+      // Returns the half width of the kernel support in units of the bandwidth
+      if (fKernelType == kUserDefined) return fUserKernelSupport;
+      return (fKernelType == kGaussian) ? 9. : 1.;
+   }
    Double_t UpperConfidenceInterval(const Double_t* x, const Double_t* p) const; // Valid if the bandwidth is small compared to nEvents**1/5
    Double_t LowerConfidenceInterval(const Double_t* x, const Double_t* p) const; // Valid if the bandwidth is small compared to nEvents**1/5
    Double_t ApproximateBias(const Double_t* x, const Double_t* ) const { return GetBias(*x); }
@@ -226,6 +240,7 @@ private:
    void CheckKernelValidity();
    void SetUserCanonicalBandwidth();
    void SetUserKernelSigma2();
+   void SetUserKernelSupport();
    void SetCanonicalBandwidths();
    void SetKernelSigmas2();
    void SetHistogram();
@@ -252,7 +267,7 @@ private:
    TF1* GetPDFUpperConfidenceInterval(Double_t confidenceLevel = 0.95, UInt_t npx = 100, Double_t xMin = 1.0, Double_t xMax = 0.0);
    TF1* GetPDFLowerConfidenceInterval(Double_t confidenceLevel = 0.95, UInt_t npx = 100, Double_t xMin = 1.0, Double_t xMax = 0.0);
 
-   ClassDef(TKDE, 2) // One dimensional semi-parametric Kernel Density Estimation
+   ClassDef(TKDE, 3) // One dimensional semi-parametric Kernel Density Estimation
 
 };
 
@@ -143,6 +143,9 @@ class TUnfold : public TObject {
    TMatrixDSparse *fDXDY;       // Result: derivative dx/dy
    TMatrixDSparse *fEinv;       // Result: matrix E^(-1)
    TMatrixDSparse *fE;          // Result: matrix E
+   TMatrixDSparse *fAtVyyInv;   //! Cache: A# Vyy^(-1), independent of tau
+   TMatrixDSparse *fAtVyyInvA;  //! Cache: A# Vyy^(-1) A, independent of tau
+   TMatrixDSparse *fLSquared;   //! Cache: L# L, independent of tau
  protected:
    TUnfold(void);              // for derived classes
    // Int_t IsNotSymmetric(TMatrixDSparse const &m) const;
@@ -159,6 +162,7 @@ class TUnfold : public TObject {
    TMatrixDSparse *InvertMSparseSymmPos(const TMatrixDSparse *A,Int_t *rank) const; // invert symmetric (semi-)positive sparse matrix
    void AddMSparse(TMatrixDSparse *dest,Double_t f,const TMatrixDSparse *src) const; // replacement for dest += f*src
    TMatrixDSparse *CreateSparseMatrix(Int_t nrow,Int_t ncol,Int_t nele,Int_t *row,Int_t *col,Double_t *data) const; // create a TMatrixDSparse from an array
+   static Int_t CompactRows(Int_t nrow,const Int_t *start,const Int_t *size,Int_t *row,Int_t *col,Double_t *data); // pack row-wise results into contiguous arrays
    inline Int_t GetNx(void) const {
       return fA->GetNcols();
    } // number of non-zero output bins
@@ -2,6 +2,7 @@
 #define ROOT_TEfficiency_cxx
 
 //standard header
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <cmath>
@@ -38,6 +39,20 @@ const Double_t kDefConfLevel = 0.682689492137; // 1 sigma
 const TEfficiency::EStatOption kDefStatOpt = TEfficiency::kFCP;
 const Double_t kDefWeight = 1;
 
+//layout of the entries of the interval cache (one entry per global bin)
+enum {
+   kCacheTotal = 0,                     //content of the total histogram
+   kCachePassed,                        //content of the passed histogram
+   kCacheTotalW2,                       //sum of weights squared (total)
+   kCachePassedW2,                      //sum of weights squared (passed)
+   kCacheAlpha,                         //alpha of the beta prior
+   kCacheBeta,                          //beta of the beta prior
+   kCacheEff,                           //efficiency
+   kCacheLow,                           //lower error
+   kCacheUp,                            //upper error
+   kCacheSize
+};
+
 ClassImp(TEfficiency)
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1612,6 +1627,8 @@ void TEfficiency::FillGraph(TGraphAsymmErrors * graph, Option_t * opt) const
    double * eyl = graph->GetEYlow();
    double * eyh = graph->GetEYhigh();
    Int_t npoints = fTotalHistogram->GetNbinsX();
+   // calculate all intervals at once, the loop below only reads the cache
+   UpdateIntervalCache();
    for (Int_t i = 0; i < npoints; ++i) {
       if (!plot0Bins && fTotalHistogram->GetBinContent(i+1) == 0 )    continue;
       x = fTotalHistogram->GetBinCenter(i+1);
@@ -2492,6 +2509,16 @@ Double_t TEfficiency::GetEfficiency(Int_t bin) const
 ///      normal approximation are supported.
 
 Double_t TEfficiency::GetEfficiencyErrorLow(Int_t bin) const
+{
+   const Double_t* entry = GetCachedInterval(bin);
+   return (entry) ? entry[kCacheLow] : ComputeEfficiencyErrorLow(bin);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///calculates the lower error on the efficiency in the given global bin
+///without using the interval cache
+
+Double_t TEfficiency::ComputeEfficiencyErrorLow(Int_t bin) const
 {
    Int_t total = (Int_t)fTotalHistogram->GetBinContent(bin);
    Int_t passed = (Int_t)fPassedHistogram->GetBinContent(bin);
@@ -2572,6 +2599,16 @@ Double_t TEfficiency::GetEfficiencyErrorLow(Int_t bin) const
 ///      normal approximation are supported.
 
 Double_t TEfficiency::GetEfficiencyErrorUp(Int_t bin) const
+{
+   const Double_t* entry = GetCachedInterval(bin);
+   return (entry) ? entry[kCacheUp] : ComputeEfficiencyErrorUp(bin);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///calculates the upper error on the efficiency in the given global bin
+///without using the interval cache
+
+Double_t TEfficiency::ComputeEfficiencyErrorUp(Int_t bin) const
 {
    Int_t total = (Int_t)fTotalHistogram->GetBinContent(bin);
    Int_t passed = (Int_t)fPassedHistogram->GetBinContent(bin);
@@ -2640,6 +2677,154 @@ Double_t TEfficiency::GetEfficiencyErrorUp(Int_t bin) const
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///fills the given vectors with the efficiency and its lower and upper error
+///for all global bins (including underflow and overflow bins)
+///
+///The vectors are resized to the number of cells of the histograms and are
+///indexed by the global bin number, i.e. eff[bin] == GetEfficiency(bin). The
+///boundaries of the confidence interval are given by eff - errLow and
+///eff + errUp. The return value is the number of bins.
+///
+///Note: - Bins whose intervals have not been calculated yet (or whose content
+///        has changed, e.g. by filling, since they have been calculated) are
+///        computed in one go. If ROOT has been built with OpenMP support for
+///        this class, this is done in parallel.
+///      - The results are cached, so subsequent calls as well as calls to
+///        GetEfficiencyErrorLow/Up or painting do not repeat the calculation.
+
+Int_t TEfficiency::GetEfficiencies(std::vector<Double_t>& eff,std::vector<Double_t>& errLow,
+                                   std::vector<Double_t>& errUp) const
+{
+   UpdateIntervalCache();
+
+   Int_t n = fTotalHistogram->GetNcells();
+   eff.resize(n);
+   errLow.resize(n);
+   errUp.resize(n);
+   for(Int_t bin = 0; bin < n; ++bin) {
+      const Double_t* entry = &fIntervalCache[bin*kCacheSize];
+      eff[bin] = entry[kCacheEff];
+      errLow[bin] = entry[kCacheLow];
+      errUp[bin] = entry[kCacheUp];
+   }
+   return n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///checks that the interval cache has been filled with the current settings
+///(confidence level, statistic option and interval type) and the current
+///number of bins. Otherwise all entries are invalidated.
+
+void TEfficiency::CheckIntervalCache() const
+{
+   const UInt_t kBits = kIsBayesian | kPosteriorMode | kShortestInterval | kUseWeights;
+
+   Double_t settings[3];
+   settings[0] = fConfLevel;
+   settings[1] = fStatisticOption;
+   settings[2] = TestBits(kBits);
+
+   UInt_t size = fTotalHistogram->GetNcells() * kCacheSize;
+   if(fIntervalCache.size() == size && fIntervalSettings.size() == 3 &&
+      std::equal(settings,settings + 3,fIntervalSettings.begin()))
+      return;
+
+   fIntervalSettings.assign(settings,settings + 3);
+   // a NaN never compares equal, so all entries are recalculated
+   fIntervalCache.assign(size,TMath::QuietNaN());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///stores the current inputs of the given bin in its cache entry
+///
+///Returns true if they are the same as the ones stored before, i.e. if the
+///cached efficiency and errors are still valid.
+
+Bool_t TEfficiency::UpdateCacheKey(Int_t bin,Double_t* entry) const
+{
+   Double_t key[kCacheEff];
+   key[kCacheTotal] = fTotalHistogram->GetBinContent(bin);
+   key[kCachePassed] = fPassedHistogram->GetBinContent(bin);
+   key[kCacheTotalW2] = 0;
+   key[kCachePassedW2] = 0;
+   if(TestBit(kUseWeights)) {
+      key[kCacheTotalW2] = fTotalHistogram->GetSumw2()->At(bin);
+      key[kCachePassedW2] = fPassedHistogram->GetSumw2()->At(bin);
+   }
+   key[kCacheAlpha] = TestBit(kUseBinPrior) ? GetBetaAlpha(bin) : GetBetaAlpha();
+   key[kCacheBeta]  = TestBit(kUseBinPrior) ? GetBetaBeta(bin)  : GetBetaBeta();
+
+   if(std::equal(key,key + kCacheEff,entry))
+      return true;
+
+   std::copy(key,key + kCacheEff,entry);
+   return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///returns the cache entry of the given global bin
+///
+///The efficiency and its errors are (re)calculated if the bin has not been
+///cached before or if its content has changed. A null pointer is returned for
+///bins outside the histogram range.
+
+const Double_t* TEfficiency::GetCachedInterval(Int_t bin) const
+{
+   if(bin < 0 || bin >= fTotalHistogram->GetNcells())
+      return 0;
+
+   CheckIntervalCache();
+
+   Double_t* entry = &fIntervalCache[bin*kCacheSize];
+   if(!UpdateCacheKey(bin,entry)) {
+      entry[kCacheEff] = GetEfficiency(bin);
+      entry[kCacheLow] = ComputeEfficiencyErrorLow(bin);
+      entry[kCacheUp] = ComputeEfficiencyErrorUp(bin);
+   }
+   return entry;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///(re)calculates the cache entries of all bins which are not up to date
+///
+///The interval calculations of different bins are independent of each other
+///and are distributed over several threads if OpenMP is enabled. Each bin is
+///computed exactly as by GetEfficiencyErrorLow/Up, so the results do not
+///depend on the number of threads.
+
+void TEfficiency::UpdateIntervalCache() const
+{
+   // the fallback to the normal approximation has to happen before the
+   // (possibly parallel) calculation starts
+   if(TestBit(kUseWeights) && !TestBit(kIsBayesian) && fStatisticOption != kFNormal)
+   {
+      Warning("UpdateIntervalCache","frequentist confidence intervals for weights are only supported by the normal approximation");
+      Info("UpdateIntervalCache","setting statistic option to kFNormal");
+      const_cast<TEfficiency*>(this)->SetStatisticOption(kFNormal);
+   }
+
+   CheckIntervalCache();
+
+   std::vector<Int_t> bins;
+   Int_t n = fTotalHistogram->GetNcells();
+   for(Int_t bin = 0; bin < n; ++bin) {
+      if(!UpdateCacheKey(bin,&fIntervalCache[bin*kCacheSize]))
+         bins.push_back(bin);
+   }
+
+   Int_t nbins = bins.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+   for(Int_t i = 0; i < nbins; ++i) {
+      Double_t* entry = &fIntervalCache[bins[i]*kCacheSize];
+      entry[kCacheEff] = GetEfficiency(bins[i]);
+      entry[kCacheLow] = ComputeEfficiencyErrorLow(bins[i]);
+      entry[kCacheUp] = ComputeEfficiencyErrorUp(bins[i]);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///returns the global bin number which can be used as argument for the
 ///following functions:
@@ -1071,13 +1071,21 @@ TH2D *TGraph2D::GetHistogram(Option_t *option)
    opt.ToLower();
    Bool_t empty = opt.Contains("empty");
 
+   // The Delaunay triangles found for an empty histogram are kept for the
+   // filled one. They are computed for all the points at once, so the points
+   // must not have changed since: SetPoint, Set and RemovePoint delete
+   // fHistogram (or reset the TGraphDelaunay of a user histogram).
+   TGraphDelaunay *dt = 0;
    if (fHistogram) {
       if (!empty && fHistogram->GetEntries() == 0) {
+         dt = (TGraphDelaunay*)fHistogram->GetListOfFunctions()->FindObject("TGraphDelaunay");
          if (!fUserHisto) {
+            if (dt) fHistogram->GetListOfFunctions()->Remove(dt);
             delete fHistogram;
             fHistogram = 0;
          }
-      } else if (fHistogram->GetEntries() == 0){;
+      } else if (fHistogram->GetEntries() == 0) {
+         dt = (TGraphDelaunay*)fHistogram->GetListOfFunctions()->FindObject("TGraphDelaunay");
       } else {
          return fHistogram;
       }
@@ -1133,11 +1141,13 @@ TH2D *TGraph2D::GetHistogram(Option_t *option)
    }
 
    // Add a TGraphDelaunay in the list of the fHistogram's functions
-   TGraphDelaunay *dt = new TGraphDelaunay(this);
-   dt->SetMaxIter(fMaxIter);
-   dt->SetMarginBinsContent(fZout);
    TList *hl = fHistogram->GetListOfFunctions();
-   hl->Add(dt);
+   if (!dt) {
+      dt = new TGraphDelaunay(this);
+      dt->SetMaxIter(fMaxIter);
+   }
+   dt->SetMarginBinsContent(fZout);
+   if (!hl->FindObject(dt)) hl->Add(dt);
 
    // Option "empty" is selected. An empty histogram is returned.
    if (empty) {
@@ -1494,6 +1504,7 @@ void TGraph2D::Set(Int_t n)
    if (n == fNpoints) return;
    if (n >  fNpoints) SetPoint(n, 0, 0, 0);
    fNpoints = n;
+   ResetDelaunay();
 }
 
 
@@ -1658,6 +1669,24 @@ void TGraph2D::SetNpy(Int_t npy)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Forgets the Delaunay triangles of the current points, which have changed.
+/// fHistogram is deleted, unless it is a user histogram: its TGraphDelaunay
+/// (still referenced by its painter) is then reset.
+
+void TGraph2D::ResetDelaunay()
+{
+   if (!fHistogram) return;
+   if (!fUserHisto) {
+      delete fHistogram;
+      fHistogram = 0;
+      return;
+   }
+   TGraphDelaunay *dt = (TGraphDelaunay*)fHistogram->GetListOfFunctions()->FindObject("TGraphDelaunay");
+   if (dt) dt->Reset();
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Sets point number n.
 /// If n is greater than the current size, the arrays are automatically
@@ -1697,6 +1726,7 @@ void TGraph2D::SetPoint(Int_t n, Double_t x, Double_t y, Double_t z)
    fY[n]    = y;
    fZ[n]    = z;
    fNpoints = TMath::Max(fNpoints, n + 1);
+   ResetDelaunay();
 }
 
 
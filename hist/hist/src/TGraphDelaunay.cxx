@@ -9,12 +9,44 @@
  * For the list of contributors see $ROOTSYS/README/CREDITS.             *
  *************************************************************************/
 
+#include <algorithm>
+
 #include "TMath.h"
 #include "TGraph2D.h"
 #include "TGraphDelaunay.h"
 
 ClassImp(TGraphDelaunay)
 
+namespace {
+
+   // Twice the signed area of the triangle a-b-c: positive if counterclockwise
+   inline Double_t Orient(Double_t ax, Double_t ay, Double_t bx, Double_t by, Double_t cx, Double_t cy)
+   {
+      return (bx-ax)*(cy-ay)-(by-ay)*(cx-ax);
+   }
+
+   // Position of the point (x,y) (both in [0,65535]) along a Hilbert curve
+   ULong64_t HilbertIndex(UInt_t x, UInt_t y)
+   {
+      const UInt_t n = 1 << 16;
+      ULong64_t d = 0;
+      for (UInt_t s = n/2; s > 0; s /= 2) {
+         UInt_t rx = (x & s) > 0;
+         UInt_t ry = (y & s) > 0;
+         d += ULong64_t(s) * s * ((3 * rx) ^ ry);
+         if (ry == 0) {
+            if (rx == 1) {
+               x = n-1-x;
+               y = n-1-y;
+            }
+            std::swap(x, y);
+         }
+      }
+      return d;
+   }
+
+}
+
 
 //______________________________________________________________________________
 //
@@ -22,9 +54,13 @@ ClassImp(TGraphDelaunay)
 // triangulation code derives from an implementation done by Luke Jones
 // (Royal Holloway, University of London) in April 2002 in the PAW context.
 //
-// This software cannot be guaranteed to work under all circumstances. They
-// were originally written to work with a few hundred points in an XY space
-// with similar X and Y ranges.
+// The triangulation is now built once, for all the points, by incremental
+// insertion (Bowyer-Watson algorithm). The points are inserted along a Hilbert
+// curve and each one is located by walking through the triangles from the
+// previously inserted one. The convex hull is closed with "ghost" triangles
+// sharing a vertex at infinity, so no bounding triangle is needed. Interpolate
+// locates the query point with the same walk starting from the triangle found
+// by the previous call, which is very fast when filling a histogram.
 //
 // Definition of Delaunay triangulation (After B. Delaunay):
 // For a set S of points in the Euclidean plane, the unique triangulation DT(S)
@@ -63,8 +99,6 @@ TGraphDelaunay::TGraphDelaunay()
    fHullPoints   = 0;
    fXN           = 0;
    fYN           = 0;
-   fOrder        = 0;
-   fDist         = 0;
    fPTried       = 0;
    fNTried       = 0;
    fMTried       = 0;
@@ -77,6 +111,7 @@ TGraphDelaunay::TGraphDelaunay()
    fYoffset      = 0.;
    fXScaleFactor = 0.;
    fYScaleFactor = 0.;
+   fLastTriangle = -1;
 
    SetMaxIter();
 }
@@ -100,8 +135,6 @@ TGraphDelaunay::TGraphDelaunay(TGraph2D *g)
    fHullPoints   = 0;
    fXN           = 0;
    fYN           = 0;
-   fOrder        = 0;
-   fDist         = 0;
    fPTried       = 0;
    fNTried       = 0;
    fMTried       = 0;
@@ -114,6 +147,7 @@ TGraphDelaunay::TGraphDelaunay(TGraph2D *g)
    fYoffset      = 0.;
    fXScaleFactor = 0.;
    fYScaleFactor = 0.;
+   fLastTriangle = -1;
 
    SetMaxIter();
 }
@@ -128,8 +162,6 @@ TGraphDelaunay::~TGraphDelaunay()
    if (fNTried)     delete [] fNTried;
    if (fMTried)     delete [] fMTried;
    if (fHullPoints) delete [] fHullPoints;
-   if (fOrder)      delete [] fOrder;
-   if (fDist)       delete [] fDist;
    if (fXN)         delete [] fXN;
    if (fYN)         delete [] fYN;
 
@@ -137,13 +169,49 @@ TGraphDelaunay::~TGraphDelaunay()
    fNTried     = 0;
    fMTried     = 0;
    fHullPoints = 0;
-   fOrder      = 0;
-   fDist       = 0;
    fXN         = 0;
    fYN         = 0;
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Forgets the triangulation, which is computed again for the current points
+/// of fGraph2D when it is needed. Must be called when the points have changed.
+
+void TGraphDelaunay::Reset()
+{
+   if (fPTried)     delete [] fPTried;
+   if (fNTried)     delete [] fNTried;
+   if (fMTried)     delete [] fMTried;
+   if (fHullPoints) delete [] fHullPoints;
+   if (fXN)         delete [] fXN;
+   if (fYN)         delete [] fYN;
+
+   fPTried     = 0;
+   fNTried     = 0;
+   fMTried     = 0;
+   fHullPoints = 0;
+   fXN         = 0;
+   fYN         = 0;
+   fTriedSize  = 0;
+   fNdt        = 0;
+   fNhull      = 0;
+   fInit       = kFALSE;
+   fAllTri     = kFALSE;
+   fTriVertices.clear();
+   fTriNeighbours.clear();
+   fTriMark.clear();
+   fLastTriangle = -1;
+
+   if (fGraph2D) {
+      fX       = fGraph2D->GetX();
+      fY       = fGraph2D->GetY();
+      fZ       = fGraph2D->GetZ();
+      fNpoints = fGraph2D->GetN();
+   }
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the z value corresponding to the (x,y) point in fGraph2D
 
@@ -155,6 +223,7 @@ Double_t TGraphDelaunay::ComputeZ(Double_t x, Double_t y)
    // needed in this function.
    if (!fInit) {
       CreateTrianglesDataStructure();
+      Triangulate();
       FindHull();
       fInit = kTRUE;
    }
@@ -278,137 +347,19 @@ L1:
 
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Attempt to find all the Delaunay triangles of the point set. It is not
-/// guaranteed that it will fully succeed, and no check is made that it has
-/// fully succeeded (such a check would be possible by referencing the points
-/// that make up the convex hull). The method is to check if each triangle
-/// shares all three of its sides with other triangles. If not, a point is
-/// generated just outside the triangle on the side(s) not shared, and a new
-/// triangle is found for that point. If this method is not working properly
-/// (many triangles are not being found) it's probably because the new points
-/// are too far beyond or too close to the non-shared sides. Fiddling with
-/// the size of the `alittlebit' parameter may help.
+/// Find all the Delaunay triangles of the point set. They are computed by
+/// Triangulate() when the algorithm is initialised, so this only makes
+/// sure the initialisation has been done.
 
 void TGraphDelaunay::FindAllTriangles()
 {
    if (fAllTri) return; else fAllTri = kTRUE;
 
-   Double_t xcntr,ycntr,xm,ym,xx,yy;
-   Double_t sx,sy,nx,ny,mx,my,mdotn,nn,a;
-   Int_t t1,t2,pa,na,ma,pb,nb,mb,p1=0,p2=0,m,n,p3=0;
-   Bool_t s[3];
-   Double_t alittlebit = 0.0001;
-
-   // start with a point that is guaranteed to be inside the hull (the
-   // centre of the hull). The starting point is shifted "a little bit"
-   // otherwise, in case of triangles aligned on a regular grid, we may
-   // found none of them.
-   xcntr = 0;
-   ycntr = 0;
-   for (n=1; n<=fNhull; n++) {
-      xcntr = xcntr+fXN[fHullPoints[n-1]];
-      ycntr = ycntr+fYN[fHullPoints[n-1]];
-   }
-   xcntr = xcntr/fNhull+alittlebit;
-   ycntr = ycntr/fNhull+alittlebit;
-   // and calculate it's triangle
-   Interpolate(xcntr,ycntr);
-
-   // loop over all Delaunay triangles (including those constantly being
-   // produced within the loop) and check to see if their 3 sides also
-   // correspond to the sides of other Delaunay triangles, i.e. that they
-   // have all their neighbours.
-   t1 = 1;
-   while (t1 <= fNdt) {
-      // get the three points that make up this triangle
-      pa = fPTried[t1-1];
-      na = fNTried[t1-1];
-      ma = fMTried[t1-1];
-
-      // produce three integers which will represent the three sides
-      s[0]  = kFALSE;
-      s[1]  = kFALSE;
-      s[2]  = kFALSE;
-      // loop over all other Delaunay triangles
-      for (t2=1; t2<=fNdt; t2++) {
-         if (t2 != t1) {
-            // get the points that make up this triangle
-            pb = fPTried[t2-1];
-            nb = fNTried[t2-1];
-            mb = fMTried[t2-1];
-            // do triangles t1 and t2 share a side?
-            if ((pa==pb && na==nb) || (pa==pb && na==mb) || (pa==nb && na==mb)) {
-               // they share side 1
-               s[0] = kTRUE;
-            } else if ((pa==pb && ma==nb) || (pa==pb && ma==mb) || (pa==nb && ma==mb)) {
-               // they share side 2
-               s[1] = kTRUE;
-            } else if ((na==pb && ma==nb) || (na==pb && ma==mb) || (na==nb && ma==mb)) {
-               // they share side 3
-               s[2] = kTRUE;
-            }
-         }
-         // if t1 shares all its sides with other Delaunay triangles then
-         // forget about it
-         if (s[0] && s[1] && s[2]) continue;
-      }
-      // Looks like t1 is missing a neighbour on at least one side.
-      // For each side, take a point a little bit beyond it and calculate
-      // the Delaunay triangle for that point, this should be the triangle
-      // which shares the side.
-      for (m=1; m<=3; m++) {
-         if (!s[m-1]) {
-            // get the two points that make up this side
-            if (m == 1) {
-               p1 = pa;
-               p2 = na;
-               p3 = ma;
-            } else if (m == 2) {
-               p1 = pa;
-               p2 = ma;
-               p3 = na;
-            } else if (m == 3) {
-               p1 = na;
-               p2 = ma;
-               p3 = pa;
-            }
-            // get the coordinates of the centre of this side
-            xm = (fXN[p1]+fXN[p2])/2.;
-            ym = (fYN[p1]+fYN[p2])/2.;
-            // we want to add a little to these coordinates to get a point just
-            // outside the triangle; (sx,sy) will be the vector that represents
-            // the side
-            sx = fXN[p1]-fXN[p2];
-            sy = fYN[p1]-fYN[p2];
-            // (nx,ny) will be the normal to the side, but don't know if it's
-            // pointing in or out yet
-            nx    = sy;
-            ny    = -sx;
-            nn    = TMath::Sqrt(nx*nx+ny*ny);
-            nx    = nx/nn;
-            ny    = ny/nn;
-            mx    = fXN[p3]-xm;
-            my    = fYN[p3]-ym;
-            mdotn = mx*nx+my*ny;
-            if (mdotn > 0) {
-               // (nx,ny) is pointing in, we want it pointing out
-               nx = -nx;
-               ny = -ny;
-            }
-            // increase/decrease xm and ym a little to produce a point
-            // just outside the triangle (ensuring that the amount added will
-            // be large enough such that it won't be lost in rounding errors)
-            a  = TMath::Abs(TMath::Max(alittlebit*xm,alittlebit*ym));
-            xx = xm+nx*a;
-            yy = ym+ny*a;
-            // try and find a new Delaunay triangle for this point
-            Interpolate(xx,yy);
-
-            // this side of t1 should now, hopefully, if it's not part of the
-            // hull, be shared with a new Delaunay triangle just calculated by Interpolate
-         }
-      }
-      t1++;
+   if (!fInit) {
+      CreateTrianglesDataStructure();
+      Triangulate();
+      FindHull();
+      fInit = kTRUE;
    }
 }
 
@@ -419,28 +370,276 @@ void TGraphDelaunay::FindAllTriangles()
 /// at the respective coordinates, then if an elastic band were stretched
 /// over all the nails it would form the shape of the convex hull. Those
 /// nails in contact with it are the points that make up the hull.
+/// The hull edges are the real edges of the ghost triangles of the
+/// triangulation, so Triangulate() must have been called before.
 
 void TGraphDelaunay::FindHull()
 {
-   Int_t n,nhull_tmp;
-   Bool_t in;
-
    if (!fHullPoints) fHullPoints = new Int_t[fNpoints];
 
-   nhull_tmp = 0;
-   for(n=1; n<=fNpoints; n++) {
-      // if the point is not inside the hull of the set of all points
-      // bar it, then it is part of the hull of the set of all points
-      // including it
-      in = InHull(n,n);
-      if (!in) {
-         // cannot increment fNhull directly - InHull needs to know that
-         // the hull has not yet been completely found
-         nhull_tmp++;
-         fHullPoints[nhull_tmp-1] = n;
+   fNhull = 0;
+   Int_t ntri = fTriVertices.size()/3;
+   for (Int_t t=0; t<ntri; t++) {
+      for (Int_t i=0; i<3; i++) {
+         // the ghost triangle (u,v,infinity) has the hull edge u-v
+         if (fTriVertices[3*t+i] == -1) {
+            fHullPoints[fNhull++] = fTriVertices[3*t+(i+1)%3];
+            break;
+         }
       }
    }
-   fNhull = nhull_tmp;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Is the point (x,y) in conflict with triangle t, ie. inside its
+/// circumcircle? For a ghost triangle (u,v,infinity) the circumcircle
+/// degenerates to the open half plane on the outer side of the hull edge
+/// u-v, plus the edge itself.
+
+Bool_t TGraphDelaunay::InConflict(Int_t t, Double_t x, Double_t y) const
+{
+   const Int_t *v = &fTriVertices[3*t];
+   for (Int_t i=0; i<3; i++) {
+      if (v[i] == -1) {
+         Int_t u = v[(i+1)%3];
+         Int_t w = v[(i+2)%3];
+         Double_t o = Orient(fXN[u], fYN[u], fXN[w], fYN[w], x, y);
+         if (o > 0) return kTRUE;
+         if (o < 0) return kFALSE;
+         // on the line of the edge: in conflict if strictly between u and w
+         return ((x-fXN[u])*(x-fXN[w])+(y-fYN[u])*(y-fYN[w])) < 0;
+      }
+   }
+   Double_t adx = fXN[v[0]]-x, ady = fYN[v[0]]-y;
+   Double_t bdx = fXN[v[1]]-x, bdy = fYN[v[1]]-y;
+   Double_t cdx = fXN[v[2]]-x, cdy = fYN[v[2]]-y;
+   Double_t det = (adx*adx+ady*ady)*(bdx*cdy-cdx*bdy)
+                + (bdx*bdx+bdy*bdy)*(cdx*ady-adx*cdy)
+                + (cdx*cdx+cdy*cdy)*(adx*bdy-bdx*ady);
+   return det > 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Adds the point p (index in fXN, fYN) to the triangulation. The triangles
+/// in conflict with p (the cavity) are found by a breadth-first search from the
+/// triangle containing p. They are replaced by the triangles joining p to the
+/// edges of the cavity boundary.
+
+void TGraphDelaunay::InsertPoint(Int_t p)
+{
+   Double_t x = fXN[p];
+   Double_t y = fYN[p];
+   Int_t t0 = Locate(x, y, fLastTriangle);
+
+   // ignore a point sitting on top of a vertex of the triangulation
+   for (Int_t i=0; i<3; i++) {
+      Int_t v = fTriVertices[3*t0+i];
+      if (v != -1 && fXN[v] == x && fYN[v] == y) return;
+   }
+
+   // find the cavity and its boundary edges (triangle, index of the opposite vertex)
+   std::vector<Int_t> cavity(1, t0);
+   std::vector<Int_t> edgeTri, edgeIdx;
+   fTriMark[t0] = p;
+   for (UInt_t k=0; k<cavity.size(); k++) {
+      Int_t t = cavity[k];
+      for (Int_t i=0; i<3; i++) {
+         Int_t nb = fTriNeighbours[3*t+i];
+         if (fTriMark[nb] == p) continue;
+         Int_t a = fTriVertices[3*t+(i+1)%3];
+         Int_t b = fTriVertices[3*t+(i+2)%3];
+         // the new triangle a-b-p must be counterclockwise, otherwise the
+         // neighbour has to be removed as well (protects against rounding errors)
+         Bool_t visible = (a == -1 || b == -1 || Orient(fXN[a], fYN[a], fXN[b], fYN[b], x, y) > 0);
+         if (!visible || InConflict(nb, x, y)) {
+            fTriMark[nb] = p;
+            cavity.push_back(nb);
+         } else {
+            edgeTri.push_back(t);
+            edgeIdx.push_back(i);
+         }
+      }
+   }
+   // the cavity triangles sharing an edge with the boundary may have been added after it was recorded
+   UInt_t nedges = 0;
+   for (UInt_t e=0; e<edgeTri.size(); e++) {
+      if (fTriMark[fTriNeighbours[3*edgeTri[e]+edgeIdx[e]]] == p) continue;
+      edgeTri[nedges] = edgeTri[e];
+      edgeIdx[nedges] = edgeIdx[e];
+      nedges++;
+   }
+
+   // A cavity of c triangles has c+2 boundary edges. Fewer edges mean that
+   // rounding errors gave a cavity which is not star-shaped around p: the
+   // point is then not inserted rather than leaving overlapping triangles.
+   if (nedges < 3 || nedges < cavity.size()) {
+      Warning("InsertPoint", "Point %d cannot be inserted in the triangulation (rounding errors), it is ignored", p-1);
+      return;
+   }
+
+   // build the new triangles a-b-p, reusing the slots of the cavity triangles
+   std::vector<Int_t> newTri(nedges);
+   std::vector<Int_t> va(nedges), vb(nedges), outer(nedges);
+   for (UInt_t e=0; e<nedges; e++) {
+      Int_t t = edgeTri[e];
+      Int_t i = edgeIdx[e];
+      va[e]    = fTriVertices[3*t+(i+1)%3];
+      vb[e]    = fTriVertices[3*t+(i+2)%3];
+      outer[e] = fTriNeighbours[3*t+i];
+   }
+   for (UInt_t e=0; e<nedges; e++) {
+      if (e < cavity.size()) {
+         newTri[e] = cavity[e];
+      } else {
+         newTri[e] = fTriVertices.size()/3;
+         fTriVertices.resize(fTriVertices.size()+3);
+         fTriNeighbours.resize(fTriNeighbours.size()+3);
+         fTriMark.push_back(0);
+      }
+   }
+   for (UInt_t e=0; e<nedges; e++) {
+      Int_t t = newTri[e];
+      fTriMark[t] = 0;
+      fTriVertices[3*t]   = va[e];
+      fTriVertices[3*t+1] = vb[e];
+      fTriVertices[3*t+2] = p;
+      // across a-b: the triangle outside the cavity
+      fTriNeighbours[3*t+2] = outer[e];
+      Int_t *nn = &fTriNeighbours[3*outer[e]];
+      for (Int_t j=0; j<3; j++) {
+         if (fTriVertices[3*outer[e]+(j+1)%3] == vb[e] && fTriVertices[3*outer[e]+(j+2)%3] == va[e]) nn[j] = t;
+      }
+   }
+   // across b-p: the new triangle starting at b, across p-a: the new triangle ending at a
+   for (UInt_t e=0; e<nedges; e++) {
+      for (UInt_t f=0; f<nedges; f++) {
+         if (va[f] == vb[e]) fTriNeighbours[3*newTri[e]]   = newTri[f];
+         if (vb[f] == va[e]) fTriNeighbours[3*newTri[e]+1] = newTri[f];
+      }
+   }
+   fLastTriangle = newTri[0];
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the triangle containing the point (x,y), walking through the
+/// triangulation from the triangle start: at each step the walk crosses an
+/// edge having the point on its other side. If the point is outside the
+/// convex hull, the ghost triangle reached when leaving the hull is returned.
+
+Int_t TGraphDelaunay::Locate(Double_t x, Double_t y, Int_t start) const
+{
+   Int_t ntri = fTriVertices.size()/3;
+   Int_t t = (start >= 0 && start < ntri) ? start : 0;
+   for (Int_t i=0; i<3; i++) {
+      if (fTriVertices[3*t+i] == -1) {
+         t = fTriNeighbours[3*t+i];
+         break;
+      }
+   }
+
+   // the first edge tested changes at each step, this avoids cycling
+   Int_t maxStep = TMath::Min(ntri, fMaxIter);
+   Int_t step;
+   for (step=0; step<maxStep; step++) {
+      Bool_t crossed = kFALSE;
+      for (Int_t k=0; k<3; k++) {
+         Int_t i = (k+step)%3;
+         Int_t a = fTriVertices[3*t+(i+1)%3];
+         Int_t b = fTriVertices[3*t+(i+2)%3];
+         if (Orient(fXN[a], fYN[a], fXN[b], fYN[b], x, y) < 0) {
+            t = fTriNeighbours[3*t+i];
+            crossed = kTRUE;
+            break;
+         }
+      }
+      if (!crossed) return t;
+      const Int_t *v = &fTriVertices[3*t];
+      if (v[0] == -1 || v[1] == -1 || v[2] == -1) return t;
+   }
+
+   // the walk did not converge (rounding errors): look at all triangles
+   Int_t ghost = -1;
+   for (t=0; t<ntri; t++) {
+      const Int_t *v = &fTriVertices[3*t];
+      if (v[0] == -1 || v[1] == -1 || v[2] == -1) {
+         if (ghost < 0 && InConflict(t, x, y)) ghost = t;
+         continue;
+      }
+      if (Orient(fXN[v[0]], fYN[v[0]], fXN[v[1]], fYN[v[1]], x, y) >= 0 &&
+          Orient(fXN[v[1]], fYN[v[1]], fXN[v[2]], fYN[v[2]], x, y) >= 0 &&
+          Orient(fXN[v[2]], fYN[v[2]], fXN[v[0]], fYN[v[0]], x, y) >= 0) return t;
+   }
+   return (ghost >= 0) ? ghost : 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Computes the Delaunay triangulation of all the points and files its
+/// triangles. The first triangle is made of the first three non colinear
+/// points along a Hilbert curve, closed with three ghost triangles; the other
+/// points are then inserted in the Hilbert curve order so that the walks
+/// locating them are short.
+
+void TGraphDelaunay::Triangulate()
+{
+   fTriVertices.clear();
+   fTriNeighbours.clear();
+   fTriMark.clear();
+   fLastTriangle = -1;
+   fNdt          = 0;
+   if (fNpoints < 3) return;
+
+   // order the points along a Hilbert curve
+   std::vector<std::pair<ULong64_t, Int_t> > order(fNpoints);
+   Double_t dx = fXNmax-fXNmin;
+   Double_t dy = fYNmax-fYNmin;
+   for (Int_t n=1; n<=fNpoints; n++) {
+      UInt_t ix = (dx > 0) ? UInt_t(65535*(fXN[n]-fXNmin)/dx) : 0;
+      UInt_t iy = (dy > 0) ? UInt_t(65535*(fYN[n]-fYNmin)/dy) : 0;
+      order[n-1] = std::make_pair(HilbertIndex(ix, iy), n);
+   }
+   std::sort(order.begin(), order.end());
+
+   // first triangle
+   Int_t p1 = order[0].second, p2 = 0, p3 = 0;
+   Int_t i2 = 0, i3 = 0;
+   for (i2=1; i2<fNpoints; i2++) {
+      p2 = order[i2].second;
+      if (fXN[p2] != fXN[p1] || fYN[p2] != fYN[p1]) break;
+   }
+   for (i3=i2+1; i3<fNpoints; i3++) {
+      p3 = order[i3].second;
+      if (Orient(fXN[p1], fYN[p1], fXN[p2], fYN[p2], fXN[p3], fYN[p3]) != 0) break;
+   }
+   if (i3 >= fNpoints) {
+      Warning("Triangulate", "All points are colinear, no triangles can be found");
+      return;
+   }
+   if (Orient(fXN[p1], fYN[p1], fXN[p2], fYN[p2], fXN[p3], fYN[p3]) < 0) std::swap(p2, p3);
+   // triangle 0 is p1-p2-p3, triangle i+1 is the ghost triangle on the edge opposite to vertex i
+   const Int_t vert[12]  = {p1, p2, p3,  p3, p2, -1,  p1, p3, -1,  p2, p1, -1};
+   const Int_t neigh[12] = {1, 2, 3,     3, 2, 0,     1, 3, 0,     2, 1, 0};
+   fTriVertices.assign(vert, vert+12);
+   fTriNeighbours.assign(neigh, neigh+12);
+   fTriMark.assign(4, 0);
+   fLastTriangle = 0;
+
+   for (Int_t k=1; k<fNpoints; k++) {
+      if (k == i2 || k == i3) continue;
+      InsertPoint(order[k].second);
+   }
+
+   // file the real triangles
+   Int_t ntri = fTriVertices.size()/3;
+   for (Int_t t=0; t<ntri; t++) {
+      const Int_t *v = &fTriVertices[3*t];
+      if (v[0] == -1 || v[1] == -1 || v[2] == -1) continue;
+      FileIt(v[0], v[1], v[2]);
+   }
+   fLastTriangle = -1;
 }
 
 
@@ -592,344 +791,49 @@ L1:
 ////////////////////////////////////////////////////////////////////////////////
 /// Finds the Delaunay triangle that the point (xi,yi) sits in (if any) and
 /// calculate a z-value for it by linearly interpolating the z-values that
-/// make up that triangle.
+/// make up that triangle. The triangle is located by walking from the one
+/// found in the previous call.
 
 Double_t TGraphDelaunay::Interpolate(Double_t xx, Double_t yy)
 {
-   Double_t thevalue;
-
-   Int_t it, ntris_tried, p, n, m;
-   Int_t i,j,k,l,z,f,d,o1,o2,a,b,t1,t2,t3;
-   Int_t ndegen=0,degen=0,fdegen=0,o1degen=0,o2degen=0;
-   Double_t vxN,vyN;
-   Double_t d1,d2,d3,c1,c2,dko1,dko2,dfo1;
-   Double_t dfo2,sin_sum,cfo1k,co2o1k,co2o1f;
-
-   Bool_t shouldbein;
-   Double_t dx1,dx2,dx3,dy1,dy2,dy3,u,v,dxz[3],dyz[3];
-
    // initialise the Delaunay algorithm if needed
    if (!fInit) {
       CreateTrianglesDataStructure();
+      Triangulate();
       FindHull();
       fInit = kTRUE;
    }
 
-   // create vectors needed for sorting
-   if (!fOrder) {
-      fOrder = new Int_t[fNpoints];
-      fDist  = new Double_t[fNpoints];
-   }
-
    // the input point will be point zero.
    fXN[0] = xx;
    fYN[0] = yy;
 
    // set the output value to the default value for now
-   thevalue = fZout;
-
-   // some counting
-   ntris_tried = 0;
+   Double_t thevalue = fZout;
 
    // no point in proceeding if xx or yy are silly
    if ((xx>fXNmax) || (xx<fXNmin) || (yy>fYNmax) || (yy<fYNmin)) return thevalue;
 
-   // check existing Delaunay triangles for a good one
-   for (it=1; it<=fNdt; it++) {
-      p = fPTried[it-1];
-      n = fNTried[it-1];
-      m = fMTried[it-1];
-      // p, n and m form a previously found Delaunay triangle, does it
-      // enclose the point?
-      if (Enclose(p,n,m,0)) {
-         // yes, we have the triangle
-         thevalue = InterpolateOnPlane(p,n,m,0);
-         return thevalue;
-      }
-   }
-
-   // is this point inside the convex hull?
-   shouldbein = InHull(0,-1);
-   if (!shouldbein) return thevalue;
+   // no triangles (less than 3 points or all colinear)
+   if (fTriVertices.empty()) return thevalue;
 
-   // it must be in a Delaunay triangle - find it...
+   Int_t t = Locate(xx, yy, fLastTriangle);
+   const Int_t *v = &fTriVertices[3*t];
 
-   // order mass points by distance in mass plane from desired point
-   for (it=1; it<=fNpoints; it++) {
-      vxN = fXN[it];
-      vyN = fYN[it];
-      fDist[it-1] = TMath::Sqrt((xx-vxN)*(xx-vxN)+(yy-vyN)*(yy-vyN));
-   }
+   // outside the convex hull
+   if (v[0] == -1 || v[1] == -1 || v[2] == -1) return thevalue;
 
-   // sort array 'fDist' to find closest points
-   TMath::Sort(fNpoints, fDist, fOrder, kFALSE);
-   for (it=0; it<fNpoints; it++) fOrder[it]++;
-
-   // loop over triplets of close points to try to find a triangle that
-   // encloses the point.
-   for (k=3; k<=fNpoints; k++) {
-      m = fOrder[k-1];
-      for (j=2; j<=k-1; j++) {
-         n = fOrder[j-1];
-         for (i=1; i<=j-1; i++) {
-            p = fOrder[i-1];
-            if (ntris_tried > fMaxIter) {
-               // perhaps this point isn't in the hull after all
-///            Warning("Interpolate",
-///                    "Abandoning the effort to find a Delaunay triangle (and thus interpolated z-value) for point %g %g"
-///                    ,xx,yy);
-               return thevalue;
-            }
-            ntris_tried++;
-            // check the points aren't colinear
-            d1 = TMath::Sqrt((fXN[p]-fXN[n])*(fXN[p]-fXN[n])+(fYN[p]-fYN[n])*(fYN[p]-fYN[n]));
-            d2 = TMath::Sqrt((fXN[p]-fXN[m])*(fXN[p]-fXN[m])+(fYN[p]-fYN[m])*(fYN[p]-fYN[m]));
-            d3 = TMath::Sqrt((fXN[n]-fXN[m])*(fXN[n]-fXN[m])+(fYN[n]-fYN[m])*(fYN[n]-fYN[m]));
-            if ((d1+d2<=d3) || (d1+d3<=d2) || (d2+d3<=d1)) goto L90;
-
-            // does the triangle enclose the point?
-            if (!Enclose(p,n,m,0)) goto L90;
-
-            // is it a Delaunay triangle? (ie. are there any other points
-            // inside the circle that is defined by its vertices?)
-
-            // test the triangle for Delaunay'ness
-
-            // loop over all other points testing each to see if it's
-            // inside the triangle's circle
-            ndegen = 0;
-            for ( z=1; z<=fNpoints; z++) {
-               if ((z==p) || (z==n) || (z==m)) goto L50;
-               // An easy first check is to see if point z is inside the triangle
-               // (if it's in the triangle it's also in the circle)
-
-               // point z cannot be inside the triangle if it's further from (xx,yy)
-               // than the furthest pointing making up the triangle - test this
-               for (l=1; l<=fNpoints; l++) {
-                  if (fOrder[l-1] == z) {
-                     if ((l<i) || (l<j) || (l<k)) {
-                        // point z is nearer to (xx,yy) than m, n or p - it could be in the
-                        // triangle so call enclose to find out
-
-                        // if it is inside the triangle this can't be a Delaunay triangle
-                        if (Enclose(p,n,m,z)) goto L90;
-                     } else {
-                        // there's no way it could be in the triangle so there's no point
-                        // calling enclose
-                        goto L1;
-                     }
-                  }
-               }
-               // is point z colinear with any pair of the triangle points?
-L1:
-               if (((fXN[p]-fXN[z])*(fYN[p]-fYN[n])) == ((fYN[p]-fYN[z])*(fXN[p]-fXN[n]))) {
-                  // z is colinear with p and n
-                  a = p;
-                  b = n;
-               } else if (((fXN[p]-fXN[z])*(fYN[p]-fYN[m])) == ((fYN[p]-fYN[z])*(fXN[p]-fXN[m]))) {
-                  // z is colinear with p and m
-                  a = p;
-                  b = m;
-               } else if (((fXN[n]-fXN[z])*(fYN[n]-fYN[m])) == ((fYN[n]-fYN[z])*(fXN[n]-fXN[m]))) {
-                  // z is colinear with n and m
-                  a = n;
-                  b = m;
-               } else {
-                  a = 0;
-                  b = 0;
-               }
-               if (a != 0) {
-                  // point z is colinear with 2 of the triangle points, if it lies
-                  // between them it's in the circle otherwise it's outside
-                  if (fXN[a] != fXN[b]) {
-                     if (((fXN[z]-fXN[a])*(fXN[z]-fXN[b])) < 0) {
-                        goto L90;
-                     } else if (((fXN[z]-fXN[a])*(fXN[z]-fXN[b])) == 0) {
-                        // At least two points are sitting on top of each other, we will
-                        // treat these as one and not consider this a 'multiple points lying
-                        // on a common circle' situation. It is a sign something could be
-                        // wrong though, especially if the two coincident points have
-                        // different fZ's. If they don't then this is harmless.
-                        Warning("Interpolate", "Two of these three points are coincident %d %d %d",a,b,z);
-                     }
-                  } else {
-                     if (((fYN[z]-fYN[a])*(fYN[z]-fYN[b])) < 0) {
-                        goto L90;
-                     } else if (((fYN[z]-fYN[a])*(fYN[z]-fYN[b])) == 0) {
-                        // At least two points are sitting on top of each other - see above.
-                        Warning("Interpolate", "Two of these three points are coincident %d %d %d",a,b,z);
-                     }
-                  }
-                  // point is outside the circle, move to next point
-                  goto L50;
-               }
-
-               // if point z were to look at the triangle, which point would it see
-               // lying between the other two? (we're going to form a quadrilateral
-               // from the points, and then demand certain properties of that
-               // quadrilateral)
-               dxz[0] = fXN[p]-fXN[z];
-               dyz[0] = fYN[p]-fYN[z];
-               dxz[1] = fXN[n]-fXN[z];
-               dyz[1] = fYN[n]-fYN[z];
-               dxz[2] = fXN[m]-fXN[z];
-               dyz[2] = fYN[m]-fYN[z];
-               for(l=1; l<=3; l++) {
-                  dx1 = dxz[l-1];
-                  dx2 = dxz[l%3];
-                  dx3 = dxz[(l+1)%3];
-                  dy1 = dyz[l-1];
-                  dy2 = dyz[l%3];
-                  dy3 = dyz[(l+1)%3];
-
-                  // u et v are used only to know their sign. The previous
-                  // code computed them with a division which was long and
-                  // might be a division by 0. It is now replaced by a
-                  // multiplication.
-                  u = (dy3*dx2-dx3*dy2)*(dy1*dx2-dx1*dy2);
-                  v = (dy3*dx1-dx3*dy1)*(dy2*dx1-dx2*dy1);
-
-                  if ((u>=0) && (v>=0)) {
-                     // vector (dx3,dy3) is expressible as a sum of the other two vectors
-                     // with positive coefficents -> i.e. it lies between the other two vectors
-                     if (l == 1) {
-                        f  = m;
-                        o1 = p;
-                        o2 = n;
-                     } else if (l == 2) {
-                        f  = p;
-                        o1 = n;
-                        o2 = m;
-                     } else {
-                        f  = n;
-                        o1 = m;
-                        o2 = p;
-                     }
-                     goto L2;
-                  }
-               }
-///            Error("Interpolate", "Should not get to here");
-               // may as well soldier on
-               f  = m;
-               o1 = p;
-               o2 = n;
-L2:
-               // this is not a valid quadrilateral if the diagonals don't cross,
-               // check that points f and z lie on opposite side of the line o1-o2,
-               // this is true if the angle f-o1-z is greater than o2-o1-z and o2-o1-f
-               cfo1k  = ((fXN[f]-fXN[o1])*(fXN[z]-fXN[o1])+(fYN[f]-fYN[o1])*(fYN[z]-fYN[o1]))/
-                        TMath::Sqrt(((fXN[f]-fXN[o1])*(fXN[f]-fXN[o1])+(fYN[f]-fYN[o1])*(fYN[f]-fYN[o1]))*
-                        ((fXN[z]-fXN[o1])*(fXN[z]-fXN[o1])+(fYN[z]-fYN[o1])*(fYN[z]-fYN[o1])));
-               co2o1k = ((fXN[o2]-fXN[o1])*(fXN[z]-fXN[o1])+(fYN[o2]-fYN[o1])*(fYN[z]-fYN[o1]))/
-                        TMath::Sqrt(((fXN[o2]-fXN[o1])*(fXN[o2]-fXN[o1])+(fYN[o2]-fYN[o1])*(fYN[o2]-fYN[o1]))*
-                        ((fXN[z]-fXN[o1])*(fXN[z]-fXN[o1])  + (fYN[z]-fYN[o1])*(fYN[z]-fYN[o1])));
-               co2o1f = ((fXN[o2]-fXN[o1])*(fXN[f]-fXN[o1])+(fYN[o2]-fYN[o1])*(fYN[f]-fYN[o1]))/
-                        TMath::Sqrt(((fXN[o2]-fXN[o1])*(fXN[o2]-fXN[o1])+(fYN[o2]-fYN[o1])*(fYN[o2]-fYN[o1]))*
-                        ((fXN[f]-fXN[o1])*(fXN[f]-fXN[o1]) + (fYN[f]-fYN[o1])*(fYN[f]-fYN[o1]) ));
-               if ((cfo1k>co2o1k) || (cfo1k>co2o1f)) {
-                  // not a valid quadrilateral - point z is definitely outside the circle
-                  goto L50;
-               }
-               // calculate the 2 internal angles of the quadrangle formed by joining
-               // points z and f to points o1 and o2, at z and f. If they sum to less
-               // than 180 degrees then z lies outside the circle
-               dko1    = TMath::Sqrt((fXN[z]-fXN[o1])*(fXN[z]-fXN[o1])+(fYN[z]-fYN[o1])*(fYN[z]-fYN[o1]));
-               dko2    = TMath::Sqrt((fXN[z]-fXN[o2])*(fXN[z]-fXN[o2])+(fYN[z]-fYN[o2])*(fYN[z]-fYN[o2]));
-               dfo1    = TMath::Sqrt((fXN[f]-fXN[o1])*(fXN[f]-fXN[o1])+(fYN[f]-fYN[o1])*(fYN[f]-fYN[o1]));
-               dfo2    = TMath::Sqrt((fXN[f]-fXN[o2])*(fXN[f]-fXN[o2])+(fYN[f]-fYN[o2])*(fYN[f]-fYN[o2]));
-               c1      = ((fXN[z]-fXN[o1])*(fXN[z]-fXN[o2])+(fYN[z]-fYN[o1])*(fYN[z]-fYN[o2]))/dko1/dko2;
-               c2      = ((fXN[f]-fXN[o1])*(fXN[f]-fXN[o2])+(fYN[f]-fYN[o1])*(fYN[f]-fYN[o2]))/dfo1/dfo2;
-               sin_sum = c1*TMath::Sqrt(1-c2*c2)+c2*TMath::Sqrt(1-c1*c1);
-
-               // sin_sum doesn't always come out as zero when it should do.
-               if (sin_sum < -1.E-6) {
-                  // z is inside the circle, this is not a Delaunay triangle
-                  goto L90;
-               } else if (TMath::Abs(sin_sum) <= 1.E-6) {
-                  // point z lies on the circumference of the circle (within rounding errors)
-                  // defined by the triangle, so there is potential for degeneracy in the
-                  // triangle set (Delaunay triangulation does not give a unique way to split
-                  // a polygon whose points lie on a circle into constituent triangles). Make
-                  // a note of the additional point number.
-                  ndegen++;
-                  degen   = z;
-                  fdegen  = f;
-                  o1degen = o1;
-                  o2degen = o2;
-               }
-L50:
-            continue;
-            }
-            // This is a good triangle
-            if (ndegen > 0) {
-               // but is degenerate with at least one other,
-               // haven't figured out what to do if more than 4 points are involved
-///            if (ndegen > 1) {
-///               Error("Interpolate",
-///                     "More than 4 points lying on a circle. No decision making process formulated for triangulating this region in a non-arbitrary way %d %d %d %d",
-///                     p,n,m,degen);
-///               return thevalue;
-///            }
-
-               // we have a quadrilateral which can be split down either diagonal
-               // (d<->f or o1<->o2) to form valid Delaunay triangles. Choose diagonal
-               // with highest average z-value. Whichever we choose we will have
-               // verified two triangles as good and two as bad, only note the good ones
-               d  = degen;
-               f  = fdegen;
-               o1 = o1degen;
-               o2 = o2degen;
-               if ((fZ[o1-1]+fZ[o2-1]) > (fZ[d-1]+fZ[f-1])) {
-                  // best diagonalisation of quadrilateral is current one, we have
-                  // the triangle
-                  t1 = p;
-                  t2 = n;
-                  t3 = m;
-                  // file the good triangles
-                  FileIt(p, n, m);
-                  FileIt(d, o1, o2);
-               } else {
-                  // use other diagonal to split quadrilateral, use triangle formed by
-                  // point f, the degnerate point d and whichever of o1 and o2 create
-                  // an enclosing triangle
-                  t1 = f;
-                  t2 = d;
-                  if (Enclose(f,d,o1,0)) {
-                     t3 = o1;
-                  } else {
-                     t3 = o2;
-                  }
-                  // file the good triangles
-                  FileIt(f, d, o1);
-                  FileIt(f, d, o2);
-               }
-            } else {
-               // this is a Delaunay triangle, file it
-               FileIt(p, n, m);
-               t1 = p;
-               t2 = n;
-               t3 = m;
-            }
-            // do the interpolation
-            thevalue = InterpolateOnPlane(t1,t2,t3,0);
-            return thevalue;
-L90:
-            continue;
-         }
-      }
-   }
-   if (shouldbein) {
-      Error("Interpolate",
-            "Point outside hull when expected inside: this point could be dodgy %g %g %d",
-             xx, yy, ntris_tried);
-   }
+   fLastTriangle = t;
+   thevalue = InterpolateOnPlane(v[0], v[1], v[2], 0);
    return thevalue;
 }
 
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Defines the number of triangles tested for a Delaunay triangle
-/// (number of iterations) before abandoning the search
+/// Defines the maximum number of triangles crossed by the walk locating a
+/// point in the triangulation (number of iterations). If the walk does not
+/// end within this limit (e.g. because of rounding errors), all triangles
+/// are tested.
 
 void TGraphDelaunay::SetMaxIter(Int_t n)
 {
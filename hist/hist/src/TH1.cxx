@@ -13,6 +13,7 @@
 #include <string.h>
 #include <stdio.h>
 #include <ctype.h>
+#include <vector>
 
 #include "Riostream.h"
 #include "TROOT.h"
@@ -21,6 +22,7 @@
 #include "THashList.h"
 #include "TH1.h"
 #include "TH2.h"
+#include "TH3.h"
 #include "TF2.h"
 #include "TF3.h"
 #include "TPluginManager.h"
@@ -5274,6 +5276,144 @@ Bool_t TH1::RecomputeAxisLimits(TAxis& destAxis, const TAxis& anAxis)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Check if the two axes have exactly the same bins and no bin labels.
+
+static inline bool IdenticalBinning(const TAxis& axis1, const TAxis& axis2)
+{
+   if (axis1.GetNbins() != axis2.GetNbins() ||
+       axis1.GetXmin() != axis2.GetXmin() || axis1.GetXmax() != axis2.GetXmax())
+      return false;
+   if (axis1.GetLabels() || axis2.GetLabels())
+      return false;
+   const TArrayD *bins1 = axis1.GetXbins();
+   const TArrayD *bins2 = axis2.GetXbins();
+   if (bins1->fN != bins2->fN)
+      return false;
+   for (Int_t i = 0; i < bins1->fN; ++i) {
+      if (bins1->fArray[i] != bins2->fArray[i]) return false;
+   }
+   return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the arrays src[0..nsrc-1] bin by bin to dest (all of size n).
+/// The bins are processed in blocks, so that the block of the destination
+/// stays in the cache while the sources are added one after the other and
+/// the inner loop can be vectorized. The blocks are independent and are
+/// distributed over several threads if OpenMP is enabled. Each bin is summed
+/// in the order of the sources, so the result does not depend on the number
+/// of threads.
+
+template <typename T>
+static void AddArraysImpl(T *dest, const T * const *src, Int_t nsrc, Int_t n)
+{
+   const Int_t kBlockSize = 2048;
+   Int_t nblocks = (n + kBlockSize - 1) / kBlockSize;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (nblocks > 1 && nsrc > 1)
+#endif
+   for (Int_t iblock = 0; iblock < nblocks; ++iblock) {
+      Int_t first = iblock * kBlockSize;
+      Int_t last = TMath::Min(n, first + kBlockSize);
+      for (Int_t isrc = 0; isrc < nsrc; ++isrc) {
+         const T *s = src[isrc];
+         for (Int_t i = first; i < last; ++i)
+            dest[i] += s[i];
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the arrays src[0..nsrc-1] of size n to dest (used by the Merge functions).
+
+void TH1::AddArrays(Double_t *dest, const Double_t * const *src, Int_t nsrc, Int_t n)
+{
+   AddArraysImpl(dest, src, nsrc, n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the arrays src[0..nsrc-1] of size n to dest (used by the Merge functions).
+
+void TH1::AddArrays(Float_t *dest, const Float_t * const *src, Int_t nsrc, Int_t n)
+{
+   AddArraysImpl(dest, src, nsrc, n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fast path of Merge for the common case (e.g. hadd) where all histograms
+/// in the list are of the same class as this histogram and have exactly the
+/// same binning.
+///
+/// The binning is checked once for the whole list; the bin contents and the
+/// sum of weights squared are then added array-wise (see TH1::AddArrays).
+/// The result is identical to the one of the generic merge.
+/// Returns kFALSE, without modifying this histogram, if the fast path cannot
+/// be used: different binning, bin labels, non-empty buffers, histograms with
+/// integer contents (which saturate) or missing Sumw2 in one of the inputs.
+/// Only the classes TH1F, TH1D, TH2F, TH2D, TH3F and TH3D are accepted: in
+/// derived classes (e.g. TH1K) the array does not necessarily hold the bin
+/// contents.
+
+Bool_t TH1::MergeSameBinning(TCollection *li)
+{
+   TClass *cl = IsA();
+   if (cl != TH1F::Class() && cl != TH1D::Class() &&
+       cl != TH2F::Class() && cl != TH2D::Class() &&
+       cl != TH3F::Class() && cl != TH3D::Class()) return kFALSE;
+   TArrayD *arrayD = dynamic_cast<TArrayD*>(this);
+   TArrayF *arrayF = dynamic_cast<TArrayF*>(this);
+   if (!arrayD && !arrayF) return kFALSE;
+   if ((arrayD ? arrayD->fN : arrayF->fN) != fNcells) return kFALSE;
+   if (fXaxis.GetXmin() >= fXaxis.GetXmax()) return kFALSE;
+   if (fBuffer && fBuffer[0] != 0) return kFALSE;
+
+   std::vector<const TH1*> hists;
+   hists.reserve(li->GetSize());
+   TIter next(li);
+   while (TObject *obj = next()) {
+      if (obj->IsA() != cl) return kFALSE;
+      const TH1 *h = static_cast<const TH1*>(obj);
+      if (h->fNcells != fNcells) return kFALSE;
+      if (dynamic_cast<const TArray*>(h)->fN != fNcells) return kFALSE;
+      if (h->fBuffer && h->fBuffer[0] != 0) return kFALSE;
+      if (fSumw2.fN && !h->fSumw2.fN) return kFALSE;
+      if (!IdenticalBinning(fXaxis, h->fXaxis) || !IdenticalBinning(fYaxis, h->fYaxis) ||
+          !IdenticalBinning(fZaxis, h->fZaxis)) return kFALSE;
+      hists.push_back(h);
+   }
+
+   Double_t stats[kNstat], totstats[kNstat];
+   for (Int_t i=0;i<kNstat;i++) {totstats[i] = stats[i] = 0;}
+   GetStats(totstats);
+   Double_t nentries = GetEntries();
+
+   std::vector<const Double_t*> contD, sumw2;
+   std::vector<const Float_t*> contF;
+   for (UInt_t ih = 0; ih < hists.size(); ++ih) {
+      const TH1 *h = hists[ih];
+      // skip empty histograms (as the generic merge does)
+      Double_t histEntries = h->GetEntries();
+      if (h->fTsumw == 0 && histEntries == 0) continue;
+      h->GetStats(stats);
+      for (Int_t i=0;i<kNstat;i++)
+         totstats[i] += stats[i];
+      nentries += histEntries;
+      if (arrayD) contD.push_back(dynamic_cast<const TArrayD*>(h)->GetArray());
+      else        contF.push_back(dynamic_cast<const TArrayF*>(h)->GetArray());
+      if (fSumw2.fN) sumw2.push_back(h->fSumw2.GetArray());
+   }
+
+   if (arrayD) AddArrays(arrayD->GetArray(), contD.data(), contD.size(), fNcells);
+   else        AddArrays(arrayF->GetArray(), contF.data(), contF.size(), fNcells);
+   if (fSumw2.fN) AddArrays(fSumw2.GetArray(), sumw2.data(), sumw2.size(), fNcells);
+
+   //copy merged stats
+   PutStats(totstats);
+   SetEntries(nentries);
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Add all histograms in the collection to this histogram.
 /// This function computes the min/max for the x axis,
@@ -5316,6 +5456,9 @@ Long64_t TH1::Merge(TCollection *li)
    if (!li) return 0;
    if (li->IsEmpty()) return (Long64_t) GetEntries();
 
+   // fast path for histograms with identical binning
+   if (MergeSameBinning(li)) return (Long64_t) GetEntries();
+
    // is this really needed ?
    TList inlist;
    inlist.AddAll(li);
@@ -1553,6 +1553,9 @@ Long64_t TH3::Merge(TCollection *list)
    if (!list) return 0;
    if (list->IsEmpty()) return (Long64_t) GetEntries();
 
+   // fast path for histograms with identical binning
+   if (MergeSameBinning(list)) return (Long64_t) GetEntries();
+
    TList inlist;
    inlist.AddAll(list);
 
@@ -25,6 +25,7 @@
 #include <algorithm>
 #include <numeric>
 #include <limits>
+#include <complex>
 #include <cassert>
 
 #include "Math/Error.h"
@@ -37,18 +38,131 @@
 #include "TF1.h"
 #include "TH1.h"
 #include "TCanvas.h"
+#include "TROOT.h"
+#include "TPluginManager.h"
+#include "TVirtualFFT.h"
 #include "TKDE.h"
 
 
 ClassImp(TKDE)
 
+namespace {
+
+   // Real to complex transforms of a fixed power of two size used for the FFT evaluation of TKDE.
+   // The TVirtualFFT (FFTW) plugin is used when available, otherwise a simple radix-2 transform.
+   class TKDEFFT {
+   public:
+      explicit TKDEFFT(Int_t n);
+      ~TKDEFFT();
+      // forward transform of n real values, returns the first n/2+1 coefficients
+      void Forward(const std::vector<Double_t>& in, std::vector<std::complex<Double_t> >& out);
+      // backward (unnormalized) transform of the n/2+1 coefficients of a real sequence
+      void Backward(const std::vector<std::complex<Double_t> >& in, std::vector<Double_t>& out);
+   private:
+      TKDEFFT(const TKDEFFT&);
+      TKDEFFT& operator=(const TKDEFFT&);
+      static void Radix2(std::vector<std::complex<Double_t> >& a, Bool_t inverse);
+
+      Int_t fN;
+      TVirtualFFT* fForward;
+      TVirtualFFT* fBackward;
+      std::vector<std::complex<Double_t> > fWork;
+   };
+
+   TKDEFFT::TKDEFFT(Int_t n) : fN(n), fForward(0), fBackward(0) {
+      // check first the plugin to avoid the error messages of TVirtualFFT::FFT when FFTW is not there
+      TPluginHandler* h = gROOT->GetPluginManager()->FindHandler("TVirtualFFT", "fftwr2c");
+      if (h && h->CheckPlugin() != -1) {
+         fForward = TVirtualFFT::FFT(1, &fN, "R2C ES K");
+         fBackward = TVirtualFFT::FFT(1, &fN, "C2R ES K");
+      }
+      if (!fForward || !fBackward) {
+         delete fForward; fForward = 0;
+         delete fBackward; fBackward = 0;
+         fWork.resize(fN);
+      }
+   }
+
+   TKDEFFT::~TKDEFFT() {
+      delete fForward;
+      delete fBackward;
+   }
+
+   void TKDEFFT::Forward(const std::vector<Double_t>& in, std::vector<std::complex<Double_t> >& out) {
+      out.resize(fN / 2 + 1);
+      if (fForward) {
+         fForward->SetPoints(&in[0]);
+         fForward->Transform();
+         Double_t re, im;
+         for (Int_t i = 0; i <= fN / 2; ++i) {
+            fForward->GetPointComplex(i, re, im);
+            out[i] = std::complex<Double_t>(re, im);
+         }
+         return;
+      }
+      for (Int_t i = 0; i < fN; ++i) fWork[i] = in[i];
+      Radix2(fWork, kFALSE);
+      std::copy(fWork.begin(), fWork.begin() + fN / 2 + 1, out.begin());
+   }
+
+   void TKDEFFT::Backward(const std::vector<std::complex<Double_t> >& in, std::vector<Double_t>& out) {
+      out.resize(fN);
+      if (fBackward) {
+         for (Int_t i = 0; i <= fN / 2; ++i)
+            fBackward->SetPoint(i, in[i].real(), in[i].imag());
+         fBackward->Transform();
+         for (Int_t i = 0; i < fN; ++i)
+            out[i] = fBackward->GetPointReal(i);
+         return;
+      }
+      for (Int_t i = 0; i <= fN / 2; ++i) fWork[i] = in[i];
+      for (Int_t i = 1; i < fN / 2; ++i) fWork[fN - i] = std::conj(in[i]);
+      Radix2(fWork, kTRUE);
+      for (Int_t i = 0; i < fN; ++i) out[i] = fWork[i].real();
+   }
+
+   void TKDEFFT::Radix2(std::vector<std::complex<Double_t> >& a, Bool_t inverse) {
+      // In place iterative Cooley-Tukey transform (size must be a power of two)
+      const UInt_t n = a.size();
+      for (UInt_t i = 1, j = 0; i < n; ++i) {
+         UInt_t bit = n >> 1;
+         for (; j & bit; bit >>= 1) j ^= bit;
+         j ^= bit;
+         if (i < j) std::swap(a[i], a[j]);
+      }
+      for (UInt_t len = 2; len <= n; len <<= 1) {
+         Double_t angle = (inverse ? 2. : -2.) * M_PI / len;
+         std::complex<Double_t> wlen(std::cos(angle), std::sin(angle));
+         for (UInt_t i = 0; i < n; i += len) {
+            std::complex<Double_t> w(1.);
+            for (UInt_t k = 0; k < len / 2; ++k) {
+               std::complex<Double_t> u = a[i + k];
+               std::complex<Double_t> v = a[i + k + len / 2] * w;
+               a[i + k] = u + v;
+               a[i + k + len / 2] = u - v;
+               w *= wlen;
+            }
+         }
+      }
+   }
+
+}
+
 class TKDE::TKernel {
    TKDE* fKDE;
    UInt_t fNWeights; // Number of kernel weights (bandwidth as vectorized for binning)
    std::vector<Double_t> fWeights; // Kernel weights (bandwidth)
+   Double_t fGridMin;   // First grid point for the FFT evaluation
+   Double_t fGridDelta; // Grid spacing for the FFT evaluation
+   std::vector<Double_t> fGridValues; // Kernel sum (not normalized) at the grid points
+   Double_t KernelSum(Double_t x) const;
+   Double_t GridSum(Double_t x) const;
+   void AddConvolution(TKDEFFT& fft, const std::vector<Double_t>& counts, Double_t weight,
+                       std::vector<std::complex<Double_t> >& spectrum) const;
 public:
    TKernel(Double_t weight, TKDE* kde);
    void ComputeAdaptiveWeights();
+   void ComputeGridEstimate(Bool_t adaptive);
    Double_t operator()(Double_t x) const;
    Double_t GetWeight(Double_t x) const;
    Double_t GetFixedWeight() const;
@@ -131,12 +245,15 @@ void TKDE::Instantiate(KernelFunction_Ptr kernfunc, UInt_t events, const Double_
    fXMin = xMin;
    fXMax = xMax;
    fUseMinMaxFromData = (fXMin >= fXMax);
+   fUseFFT = false;
+   fNFFTPoints = 4096;
    fSumOfCounts = 0;
    fAdaptiveBandwidthFactor = 1.;
    fRho = rho;
    fWeightSize = 0;
    fCanonicalBandwidths = std::vector<Double_t>(kTotalKernels, 0.0);
    fKernelSigmas2 = std::vector<Double_t>(kTotalKernels, -1.0);
+   fUserKernelSupport = 9.;
    fSettedOptions = std::vector<Bool_t>(4, kFALSE);
    SetOptions(option, rho);
    CheckOptions(kTRUE);
@@ -409,6 +526,30 @@ void TKDE::SetRange(Double_t xMin, Double_t xMax) {
    SetKernel();
 }
 
+void TKDE::SetUseFFT(Bool_t useFFT) {
+   // Sets User option for computing the estimate on a grid with FFT convolution.
+   // The data (or the bin centres for the binned option) are linearly binned on an
+   // equidistant grid covering the data range extended by the kernel support, and the
+   // kernel sum is obtained by FFT convolution with the kernel sampled at the grid spacing.
+   // The cost is then O(N + M log M) for N events and M grid points, instead of O(N)
+   // per evaluation; values are linearly interpolated between the grid points.
+   // With the adaptive iteration the local bandwidths are computed at the grid points too.
+   // The FFTW plugin of TVirtualFFT is used if available, otherwise a built-in transform.
+   fUseFFT = useFFT;
+   SetKernel();
+}
+
+void TKDE::SetNofPointsFFT(UInt_t npoints) {
+   // Sets the minimum number of grid points used for the FFT evaluation (rounded up to a
+   // power of two). More points are used if needed to resolve the bandwidth.
+   if (npoints < 2) {
+      Error("SetNofPointsFFT", "Number of grid points must be at least 2.");
+      return;
+   }
+   fNFFTPoints = npoints;
+   if (fUseFFT) SetKernel();
+}
+
 // private methods
 
 void TKDE::SetUseBins() {
@@ -544,7 +685,9 @@ void TKDE::SetKernel() {
    weight *= fRho * fCanonicalBandwidths[fKernelType] / fCanonicalBandwidths[kGaussian];
    if (fKernel) delete fKernel;
    fKernel = new TKernel(weight, this);
-   if (fIteration == kAdaptive) {
+   if (fUseFFT) {
+      fKernel->ComputeGridEstimate(fIteration == kAdaptive);
+   } else if (fIteration == kAdaptive) {
       fKernel->ComputeAdaptiveWeights();
    }
 }
@@ -581,6 +724,7 @@ void TKDE::SetKernelFunction(KernelFunction_Ptr kernfunc) {
          CheckKernelValidity();
          SetUserCanonicalBandwidth();
          SetUserKernelSigma2();
+         SetUserKernelSupport();
       }
       else {
          Error("SetKernelFunction", "User kernel function is not defined !");
@@ -668,6 +812,15 @@ Double_t TKDE::operator()(Double_t x) const {
    return (*fKernel)(x);
 }
 
+void TKDE::GetValues(UInt_t n, const Double_t* x, Double_t* result) const {
+   // Evaluates the kernel density estimate at the n points x and stores the values in result.
+   // This is fastest when the FFT evaluation is used (see SetUseFFT)
+   if (fNewData) (const_cast<TKDE*>(this))->InitFromNewData();
+   for (UInt_t i = 0; i < n; ++i) {
+      result[i] = (*fKernel)(x[i]);
+   }
+}
+
 Double_t TKDE::GetMean() const {
    // return the mean of the data
    if (fNewData) (const_cast<TKDE*>(this))->InitFromNewData();
@@ -690,7 +843,9 @@ TKDE::TKernel::TKernel(Double_t weight, TKDE* kde) :
 // Internal class constructor
 fKDE(kde),
 fNWeights(kde->fData.size()),
-fWeights(fNWeights, weight)
+fWeights(fNWeights, weight),
+fGridMin(0.0),
+fGridDelta(0.0)
 {}
 
 void TKDE::TKernel::ComputeAdaptiveWeights() {
@@ -718,6 +873,179 @@ void TKDE::TKernel::ComputeAdaptiveWeights() {
    //printf("adaptive bandwidth factor % f weight 0 %f , %f \n",fKDE->fAdaptiveBandwidthFactor, weights[0],fWeights[0] );
 }
 
+void TKDE::TKernel::ComputeGridEstimate(Bool_t adaptive) {
+   // Computes the kernel sum at the points of an equidistant grid covering the data and the
+   // kernel support. The data are linearly binned on the grid and convolved via FFT with the
+   // kernel sampled at the grid spacing. For the adaptive iteration the pilot (fixed bandwidth)
+   // estimate and the local bandwidths are evaluated at the grid points; each grid count is then
+   // shared between the two closest bandwidths of a geometric ladder and one convolution per
+   // bandwidth of the ladder is done.
+   const std::vector<Double_t>& data = fKDE->fData;
+   UInt_t n = data.size();
+   if (n == 0) return;
+   Bool_t useBins = (fKDE->fBinCount.size() == n);
+   Double_t weight = fWeights[0];
+   Double_t support = fKDE->KernelSupport() * weight;
+   Double_t dataMin = *std::min_element(data.begin(), data.end());
+   Double_t dataMax = *std::max_element(data.begin(), data.end());
+   fGridMin = dataMin - support;
+   Double_t gridMax = dataMax + support;
+   // the asymmetric mirroring terms need the kernel sum at the points mirrored around the boundaries
+   if (fKDE->fAsymLeft)  fGridMin = std::min(fGridMin, 2. * fKDE->fXMin - fKDE->fXMax);
+   if (fKDE->fAsymRight) gridMax  = std::max(gridMax, 2. * fKDE->fXMax - fKDE->fXMin);
+   Double_t range = gridMax - fGridMin;
+
+   // number of grid points: a power of two giving a spacing small enough for the bandwidth
+   const UInt_t kMaxGridPoints = 1 << 18;
+   Double_t minDelta = weight / (adaptive ? 8. : 4.);
+   UInt_t m = 2;
+   while (m < kMaxGridPoints && (m < fKDE->fNFFTPoints || range / (m - 1) > minDelta)) m <<= 1;
+   fGridDelta = range / (m - 1);
+
+   // linear binning of the data on the grid
+   std::vector<Double_t> counts(m, 0.0);
+   for (UInt_t i = 0; i < n; ++i) {
+      Double_t binCount = (useBins) ? fKDE->fBinCount[i] : 1.0;
+      Double_t u = (data[i] - fGridMin) / fGridDelta;
+      UInt_t j = UInt_t(u);
+      if (j >= m - 1) {
+         counts[m - 1] += binCount;
+         continue;
+      }
+      counts[j]     += (j + 1 - u) * binCount;
+      counts[j + 1] += (u - j) * binCount;
+   }
+
+   // the transform size is twice the grid size to avoid the wrap around of the circular convolution
+   TKDEFFT fft(2 * m);
+   std::vector<std::complex<Double_t> > spectrum(m + 1, 0.0);
+   std::vector<Double_t> result;
+   AddConvolution(fft, counts, weight, spectrum);
+   fft.Backward(spectrum, result);
+   fGridValues.assign(result.begin(), result.begin() + m);
+   for (UInt_t j = 0; j < m; ++j) fGridValues[j] /= (2 * m);
+   if (!adaptive) return;
+
+   // local bandwidths at the grid points from the pilot estimate
+   std::vector<Double_t> gridWeights(m, weight);
+   Double_t minWeight = weight * 0.05;
+   Double_t logSum = 0.0, countSum = 0.0;
+   for (UInt_t j = 0; j < m; ++j) {
+      if (counts[j] <= 0) continue;  // skip negative or null weights
+      Double_t x = fGridMin + j * fGridDelta;
+      Double_t f = (*this)(x);
+      if (f <= 0) {
+         fKDE->Warning("ComputeGridEstimate", "function value is zero or negative for x = %f w = %f", x, counts[j]);
+         continue;
+      }
+      gridWeights[j] = std::max(weight / std::sqrt(f), minWeight);
+      logSum += counts[j] * std::log(f);
+      countSum += counts[j];
+   }
+   Double_t kAPPROX_GEO_MEAN = 0.241970724519143365; // see ComputeAdaptiveWeights
+   fKDE->fAdaptiveBandwidthFactor = fKDE->fUseMirroring ? kAPPROX_GEO_MEAN / fKDE->fSigmaRob : (countSum > 0 ? std::sqrt(std::exp(logSum / countSum)) : 1.);
+   Double_t wMin = std::numeric_limits<Double_t>::max(), wMax = 0.;
+   for (UInt_t j = 0; j < m; ++j) {
+      gridWeights[j] *= fKDE->fAdaptiveBandwidthFactor;
+      if (counts[j] != 0) {
+         wMin = std::min(wMin, gridWeights[j]);
+         wMax = std::max(wMax, gridWeights[j]);
+      }
+   }
+   // bandwidths of the data points (used for the errors and outside of the grid) from the closest grid point
+   for (UInt_t i = 0; i < n; ++i) {
+      UInt_t j = std::min(UInt_t((data[i] - fGridMin) / fGridDelta + 0.5), m - 1);
+      fWeights[i] = gridWeights[j];
+   }
+   if (wMax <= 0) return;
+
+   // geometric ladder of bandwidths, with at most 5% between two consecutive ones
+   const Int_t kMaxLevels = 64;
+   Int_t nLevels = 1;
+   Double_t logRatio = 0.;
+   if (wMax > wMin * (1. + 1.E-6)) {
+      nLevels = std::min(kMaxLevels, Int_t(std::ceil(std::log(wMax / wMin) / std::log(1.05))) + 1);
+      logRatio = std::log(wMax / wMin) / (nLevels - 1);
+   }
+   std::vector<Double_t> levelCounts(m);
+   std::fill(spectrum.begin(), spectrum.end(), 0.0);
+   for (Int_t l = 0; l < nLevels; ++l) {
+      std::fill(levelCounts.begin(), levelCounts.end(), 0.0);
+      Bool_t empty = kTRUE;
+      for (UInt_t j = 0; j < m; ++j) {
+         if (counts[j] == 0) continue;
+         Double_t u = (nLevels > 1) ? std::log(gridWeights[j] / wMin) / logRatio : 0.;
+         Int_t level = std::min(Int_t(u), nLevels - 1);
+         Double_t frac = 0.;
+         if (level == l) frac = (l == nLevels - 1) ? 1. : 1. - (u - level);
+         else if (level == l - 1) frac = u - level;
+         if (frac == 0) continue;
+         levelCounts[j] = frac * counts[j];
+         empty = kFALSE;
+      }
+      if (!empty) AddConvolution(fft, levelCounts, wMin * std::exp(l * logRatio), spectrum);
+   }
+   fft.Backward(spectrum, result);
+   for (UInt_t j = 0; j < m; ++j) fGridValues[j] = result[j] / (2 * m);
+}
+
+void TKDE::TKernel::AddConvolution(TKDEFFT& fft, const std::vector<Double_t>& counts, Double_t weight,
+                                   std::vector<std::complex<Double_t> >& spectrum) const {
+   // Adds to spectrum the transform of the convolution of the grid counts with the kernel of
+   // the given bandwidth. The kernel is sampled at the grid spacing up to the grid size and is
+   // stored in wrap around order; it is normalized on the grid when it is not well resolved.
+   UInt_t m = counts.size();
+   UInt_t size = 2 * m;
+   std::vector<Double_t> input(size, 0.0);
+   std::vector<std::complex<Double_t> > countsFT, kernelFT;
+   std::copy(counts.begin(), counts.end(), input.begin());
+   fft.Forward(input, countsFT);
+
+   std::fill(input.begin(), input.end(), 0.0);
+   Double_t fullRange = fKDE->KernelSupport() * weight / fGridDelta;
+   UInt_t nk = UInt_t(std::min(fullRange + 1., Double_t(m - 1)));
+   Double_t norm = 0.0;
+   for (UInt_t d = 0; d <= nk; ++d) {
+      input[d] = (*fKDE->fKernelFunction)(d * fGridDelta / weight);
+      norm += input[d];
+      if (d > 0) {
+         input[size - d] = (*fKDE->fKernelFunction)(- (d * fGridDelta / weight));
+         norm += input[size - d];
+      }
+   }
+   // use the exact normalization (1/weight) when the kernel is resolved or truncated by the grid
+   Bool_t resolved = (weight > 2. * fGridDelta);
+   Double_t scale = (!resolved && nk < m - 1 && norm > 0) ? 1. / (norm * fGridDelta) : 1. / weight;
+   for (UInt_t i = 0; i < size; ++i) input[i] *= scale;
+   fft.Forward(input, kernelFT);
+
+   for (UInt_t i = 0; i < spectrum.size(); ++i)
+      spectrum[i] += countsFT[i] * kernelFT[i];
+}
+
+Double_t TKDE::TKernel::KernelSum(Double_t x) const {
+   // Returns the (not normalized) kernel sum at x without the asymmetric mirroring terms
+   Double_t result(0.0);
+   UInt_t n = fKDE->fData.size();
+   Bool_t useBins = (fKDE->fBinCount.size() == n);
+   for (UInt_t i = 0; i < n; ++i) {
+      Double_t binCount = (useBins) ? fKDE->fBinCount[i] : 1.0;
+      result += binCount / fWeights[i] * (*fKDE->fKernelFunction)((x - fKDE->fData[i]) / fWeights[i]);
+   }
+   return result;
+}
+
+Double_t TKDE::TKernel::GridSum(Double_t x) const {
+   // Returns the (not normalized) kernel sum at x interpolated from the grid values;
+   // outside of the grid the sum is computed directly
+   Double_t u = (x - fGridMin) / fGridDelta;
+   Int_t last = fGridValues.size() - 1;
+   if (u < 0 || u > last) return KernelSum(x);
+   Int_t j = std::min(Int_t(u), last - 1);
+   Double_t t = u - j;
+   return (1. - t) * fGridValues[j] + t * fGridValues[j + 1];
+}
+
 Double_t TKDE::TKernel::GetWeight(Double_t x) const {
    // Returns the bandwidth
    return fWeights[fKDE->Index(x)];
@@ -905,6 +1233,17 @@ Double_t TKDE::TKernel::operator()(Double_t x) const {
    // case of bins or weighted data 
    Bool_t useBins = (fKDE->fBinCount.size() == n);
    Double_t nSum = (useBins) ? fKDE->fSumOfCounts : fKDE->fNEvents;
+   if (!fGridValues.empty()) {
+      // FFT evaluation: the mirrored asymmetric terms are the kernel sum at the mirrored points
+      result = GridSum(x);
+      if (fKDE->fAsymLeft) {
+         result -= GridSum(2. * fKDE->fXMin - x);
+      }
+      if (fKDE->fAsymRight) {
+         result -= GridSum(2. * fKDE->fXMax - x);
+      }
+      return result / nSum;
+   }
    // double dmin = 1.E10;
    // double xmin,bmin,wmin; 
    for (UInt_t i = 0; i < n; ++i) {
@@ -1099,6 +1438,26 @@ void TKDE::SetUserKernelSigma2() {
    fKernelSigmas2[kUserDefined] = ComputeKernelSigma2();
 }
 
+void TKDE::SetUserKernelSupport() {
+   // Computes the half width of the user's input kernel function support, used for the FFT evaluation.
+   // The kernel is scanned up to 100 bandwidths and is neglected where it is below 1.E-10 of its maximum
+   const Double_t kMaxSupport = 100.;
+   const Double_t kStep = 0.01;
+   const Double_t kEps = 1.E-10;
+   const Int_t nSteps = Int_t(kMaxSupport / kStep + 0.5);
+   std::vector<Double_t> values(nSteps + 1);
+   Double_t maxValue = 0.0;
+   for (Int_t i = 0; i <= nSteps; ++i) {
+      Double_t x = i * kStep;
+      values[i] = std::max(std::abs((*fKernelFunction)(x)), std::abs((*fKernelFunction)(-x)));
+      maxValue = std::max(maxValue, values[i]);
+   }
+   if (!(maxValue > 0)) return;
+   Int_t last = nSteps;
+   while (last > 0 && values[last] <= kEps * maxValue) --last;
+   fUserKernelSupport = std::min((last + 1) * kStep, kMaxSupport);
+}
+
 TKDE::KernelIntegrand::KernelIntegrand(const TKDE* kde, EIntegralResult intRes) : fKDE(kde), fIntegralResult(intRes) {
    // Internal class constructor
 }
@@ -27,6 +27,8 @@
 #include "THashList.h"
 #include "TMath.h"
 
+#include <vector>
+
 class TProfileHelper {
 
 public:
@@ -362,6 +364,9 @@ Long64_t TProfileHelper::Merge(T* p, TCollection *li) {
    Bool_t canExtend = p->CanExtendAllAxes();
    p->SetCanExtend(TH1::kNoAxis); // reset, otherwise setting the under/overflow will extend the axis
 
+   // arrays of the profiles with the same binning, they are added in one go
+   std::vector<const Double_t*> w, w2, b, b2;
+
    while ( (h=static_cast<T*>(next())) ) {
       // process only if the histogram has limits; otherwise it was processed before
 
@@ -372,6 +377,14 @@ Long64_t TProfileHelper::Merge(T* p, TCollection *li) {
             totstats[i] += stats[i];
          nentries += h->GetEntries();
 
+         if (allSameLimits) {
+            w.push_back(h->GetW());
+            w2.push_back(h->GetW2());
+            b.push_back(h->GetB());
+            b2.push_back(h->GetB2() ? h->GetB2() : h->GetB());
+            continue;
+         }
+
          for ( Int_t hbin = 0; hbin < h->fN; ++hbin ) {
             Int_t pbin = hbin;
             if (!allSameLimits) {
@@ -405,6 +418,13 @@ Long64_t TProfileHelper::Merge(T* p, TCollection *li) {
          }
       }
    }
+   if (!w.empty()) {
+      p->AddArrays(p->fArray, &w[0], w.size(), p->fN);
+      p->AddArrays(p->fSumw2.fArray, &w2[0], w2.size(), p->fN);
+      p->AddArrays(p->fBinEntries.fArray, &b[0], b.size(), p->fN);
+      if (p->fBinSumw2.fN)
+         p->AddArrays(p->fBinSumw2.fArray, &b2[0], b2.size(), p->fN);
+   }
    if (canExtend) p->SetCanExtend(TH1::kAllAxes);
 
    //copy merged stats
@@ -345,6 +345,10 @@ void TUnfold::InitTUnfold(void)
    fEinv = 0;
    fE = 0;
    fVxxInv = 0;
+   // tau-independent intermediate results
+   fAtVyyInv = 0;
+   fAtVyyInvA = 0;
+   fLSquared = 0;
    fEpsMatrix=1.E-13;
    fIgnoredBins=0;
 }
@@ -412,6 +416,8 @@ Double_t TUnfold::DoUnfold(void)
    // Data members modified:
    //     fVyyInv: inverse of input data covariance matrix
    //     fNdf: number of dgerres of freedom
+   //     fAtVyyInv, fAtVyyInvA, fLSquared: tau-independent products,
+   //          only calculated if they are not yet available
    //     fEinv: inverse of the matrix needed for unfolding calculations
    //     fE:    the matrix needed for unfolding calculations
    //     fX:    unfolded data points
@@ -442,14 +448,23 @@ Double_t TUnfold::DoUnfold(void)
    //              T
    //            fA fV  = mAt_V
    //
-   TMatrixDSparse *AtVyyinv=MultiplyMSparseTranspMSparse(fA,fVyyInv);
+   // the products which do not depend on tau are kept between calls,
+   // such that a scan of tau only repeats the tau-dependent part
+   if(!fAtVyyInv) {
+      fAtVyyInv=MultiplyMSparseTranspMSparse(fA,fVyyInv);
+      DeleteMatrix(&fAtVyyInvA);
+   }
+   const TMatrixDSparse *AtVyyinv=fAtVyyInv;
+   if(!fLSquared) {
+      fLSquared=MultiplyMSparseTranspMSparse(fL,fL);
+   }
+   const TMatrixDSparse *lSquared=fLSquared;
    //
    // get
    //       T
    //     fA fVyyinv fY + fTauSquared fBiasScale Lsquared fX0 = rhs
    //
    TMatrixDSparse *rhs=MultiplyMSparseM(AtVyyinv,fY);
-   TMatrixDSparse *lSquared=MultiplyMSparseTranspMSparse(fL,fL);
    if (fBiasScale != 0.0) {
       TMatrixDSparse *rhs2=MultiplyMSparseM(lSquared,fX0);
       AddMSparse(rhs, fTauSquared * fBiasScale ,rhs2);
@@ -460,7 +475,10 @@ Double_t TUnfold::DoUnfold(void)
    // get matrix
    //              T
    //           (fA fV)fA + fTauSquared*fLsquared  = fEinv
-   fEinv=MultiplyMSparseMSparse(AtVyyinv,fA);
+   if(!fAtVyyInvA) {
+      fAtVyyInvA=MultiplyMSparseMSparse(AtVyyinv,fA);
+   }
+   fEinv=new TMatrixDSparse(*fAtVyyInvA);
    AddMSparse(fEinv,fTauSquared,lSquared);
 
    //
@@ -566,8 +584,6 @@ Double_t TUnfold::DoUnfold(void)
       DeleteMatrix(&corr);
    }
 
-   DeleteMatrix(&AtVyyinv);
-
    //
    // get error matrix on x
    //   fDXDY * Vyy * fDXDY#
@@ -630,7 +646,6 @@ Double_t TUnfold::DoUnfold(void)
    DeleteMatrix(&epsilon);
 
    DeleteMatrix(&LsquaredDx);
-   DeleteMatrix(&lSquared);
 
    // calculate/store matrices defining the derivatives dx/dA
    fDXDAM[0]=new TMatrixDSparse(*fE);
@@ -727,6 +742,29 @@ TMatrixDSparse *TUnfold::CreateSparseMatrix
    return A;
 }
 
+Int_t TUnfold::CompactRows
+(Int_t nrow,const Int_t *start,const Int_t *size,
+ Int_t *row,Int_t *col,Double_t *data)
+{
+   // pack row-wise results into contiguous arrays
+   //   nrow: number of rows
+   //   start[nrow],size[nrow]: position and number of elements of each row
+   //   row[],col[],data[] : arrays holding the elements, modified in place
+   // return value: total number of elements
+   // the rows are filled in order, so the result does not depend on
+   // how the rows have been distributed over threads
+   Int_t n=0;
+   for(Int_t irow=0;irow<nrow;irow++) {
+      for(Int_t i=start[irow];i<start[irow]+size[irow];i++) {
+         row[n]=row[i];
+         col[n]=col[i];
+         data[n]=data[i];
+         n++;
+      }
+   }
+   return n;
+}
+
 TMatrixDSparse *TUnfold::MultiplyMSparseMSparse(const TMatrixDSparse *a,
                                                 const TMatrixDSparse *b) const
 {
@@ -756,39 +794,62 @@ TMatrixDSparse *TUnfold::MultiplyMSparseMSparse(const TMatrixDSparse *a,
       Int_t *r_rows=new Int_t[nMax];
       Int_t *r_cols=new Int_t[nMax];
       Double_t *r_data=new Double_t[nMax];
-      Double_t *row_data=new Double_t[b->GetNcols()];
-      Int_t n=0;
+      // each non-empty a-row owns a slice of b->GetNcols() elements
+      // of the output arrays, such that the rows can be calculated
+      // independently (and in parallel if OpenMP is enabled)
+      Int_t *r_start=new Int_t[a->GetNrows()];
+      Int_t *r_size=new Int_t[a->GetNrows()];
+      Int_t start=0;
       for (Int_t irow = 0; irow < a->GetNrows(); irow++) {
-         if(a_rows[irow+1]<=a_rows[irow]) continue;
-         // clear row data
-         for(Int_t icol=0;icol<b->GetNcols();icol++) {
-            row_data[icol]=0.0;
-         }
-         // loop over a-columns in this a-row
-         for(Int_t ia=a_rows[irow];ia<a_rows[irow+1];ia++) {
-            Int_t k=a_cols[ia];
-            // loop over b-columns in b-row k
-            for(Int_t ib=b_rows[k];ib<b_rows[k+1];ib++) {
-               row_data[b_cols[ib]] += a_data[ia]*b_data[ib];
+         r_start[irow]=start;
+         r_size[irow]=0;
+         if(a_rows[irow+1]>a_rows[irow]) start += b->GetNcols();
+      }
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+      {
+         Double_t *row_data=new Double_t[b->GetNcols()];
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+         for (Int_t irow = 0; irow < a->GetNrows(); irow++) {
+            if(a_rows[irow+1]<=a_rows[irow]) continue;
+            // clear row data
+            for(Int_t icol=0;icol<b->GetNcols();icol++) {
+               row_data[icol]=0.0;
             }
-         }
-         // store nonzero elements
-         for(Int_t icol=0;icol<b->GetNcols();icol++) {
-            if(row_data[icol] != 0.0) {
-               r_rows[n]=irow;
-               r_cols[n]=icol;
-               r_data[n]=row_data[icol];
-               n++;
+            // loop over a-columns in this a-row
+            for(Int_t ia=a_rows[irow];ia<a_rows[irow+1];ia++) {
+               Int_t k=a_cols[ia];
+               // loop over b-columns in b-row k
+               for(Int_t ib=b_rows[k];ib<b_rows[k+1];ib++) {
+                  row_data[b_cols[ib]] += a_data[ia]*b_data[ib];
+               }
+            }
+            // store nonzero elements
+            Int_t n=r_start[irow];
+            for(Int_t icol=0;icol<b->GetNcols();icol++) {
+               if(row_data[icol] != 0.0) {
+                  r_rows[n]=irow;
+                  r_cols[n]=icol;
+                  r_data[n]=row_data[icol];
+                  n++;
+               }
             }
+            r_size[irow]=n-r_start[irow];
          }
+         delete[] row_data;
       }
+      Int_t n=CompactRows(a->GetNrows(),r_start,r_size,r_rows,r_cols,r_data);
       if(n>0) {
          r->SetMatrixArray(n,r_rows,r_cols,r_data);
       }
       delete[] r_rows;
       delete[] r_cols;
       delete[] r_data;
-      delete[] row_data;
+      delete[] r_start;
+      delete[] r_size;
    }
 
    return r;
@@ -901,27 +962,46 @@ TMatrixDSparse *TUnfold::MultiplyMSparseM(const TMatrixDSparse *a,
       Int_t *r_cols=new Int_t[nMax];
       Double_t *r_data=new Double_t[nMax];
 
-      Int_t n=0;
+      // each non-empty a-row owns a slice of b->GetNcols() elements
+      Int_t *r_start=new Int_t[a->GetNrows()];
+      Int_t *r_size=new Int_t[a->GetNrows()];
+      Int_t start=0;
+      for (Int_t irow = 0; irow < a->GetNrows(); irow++) {
+         r_start[irow]=start;
+         r_size[irow]=0;
+         if(a_rows[irow+1]-a_rows[irow]>0) start += b->GetNcols();
+      }
       // fill matrix r
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
       for (Int_t irow = 0; irow < a->GetNrows(); irow++) {
          if(a_rows[irow+1]-a_rows[irow]<=0) continue;
+         Int_t n=r_start[irow];
          for(Int_t icol=0;icol<b->GetNcols();icol++) {
-            r_rows[n]=irow;
-            r_cols[n]=icol;
-            r_data[n]=0.0;
+            Double_t sum=0.0;
             for(Int_t i=a_rows[irow];i<a_rows[irow+1];i++) {
                Int_t j=a_cols[i];
-               r_data[n] += a_data[i]*(*b)(j,icol);
+               sum += a_data[i]*(*b)(j,icol);
+            }
+            if(sum!=0.0) {
+               r_rows[n]=irow;
+               r_cols[n]=icol;
+               r_data[n]=sum;
+               n++;
             }
-            if(r_data[n]!=0.0) n++;
          }
+         r_size[irow]=n-r_start[irow];
       }
+      Int_t n=CompactRows(a->GetNrows(),r_start,r_size,r_rows,r_cols,r_data);
       if(n>0) {
          r->SetMatrixArray(n,r_rows,r_cols,r_data);
       }
       delete[] r_rows;
       delete[] r_cols;
       delete[] r_data;
+      delete[] r_start;
+      delete[] r_size;
    }
    return r;
 }
@@ -970,10 +1050,25 @@ TMatrixDSparse *TUnfold::MultiplyMSparseMSparseTranspVector
    Int_t *row_r=new Int_t[num_r];
    Int_t *col_r=new Int_t[num_r];
    Double_t *data_r=new Double_t[num_r];
+   // each non-empty m1-row owns a slice of num_m2 elements
+   // of the output arrays, such that the rows can be calculated
+   // independently (and in parallel if OpenMP is enabled)
+   Int_t *start_r=new Int_t[m1->GetNrows()];
+   Int_t *size_r=new Int_t[m1->GetNrows()];
    num_r=0;
    for(Int_t i=0;i<m1->GetNrows();i++) {
+      start_r[i]=num_r;
+      size_r[i]=0;
+      if(rows_m1[i]<rows_m1[i+1]) num_r += num_m2;
+   }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+   for(Int_t i=0;i<m1->GetNrows();i++) {
+      if(rows_m1[i]>=rows_m1[i+1]) continue;
+      Int_t n=start_r[i];
       for(Int_t j=0;j<m2->GetNrows();j++) {
-         data_r[num_r]=0.0;
+         Double_t sum=0.0;
          Int_t index_m1=rows_m1[i];
          Int_t index_m2=rows_m2[j];
          while((index_m1<rows_m1[i+1])&&(index_m2<rows_m2[j+1])) {
@@ -987,33 +1082,38 @@ TMatrixDSparse *TUnfold::MultiplyMSparseMSparseTranspVector
                if(v_sparse) {
                   Int_t v_index=v_rows[k1];
                   if(v_index<v_rows[k1+1]) {
-                     data_r[num_r] += data_m1[index_m1] * data_m2[index_m2]
+                     sum += data_m1[index_m1] * data_m2[index_m2]
                      * v_data[v_index];
                   } else {
-                     data_r[num_r] =0.0;
+                     sum =0.0;
                   }
                } else if(v) {
-                  data_r[num_r] += data_m1[index_m1] * data_m2[index_m2]
+                  sum += data_m1[index_m1] * data_m2[index_m2]
                   * (*v)(k1,0);
                } else {
-                  data_r[num_r] += data_m1[index_m1] * data_m2[index_m2];
+                  sum += data_m1[index_m1] * data_m2[index_m2];
                }
                index_m1++;
                index_m2++;
             }
          }
-         if(data_r[num_r] !=0.0) {
-            row_r[num_r]=i;
-            col_r[num_r]=j;
-            num_r++;
+         if(sum !=0.0) {
+            row_r[n]=i;
+            col_r[n]=j;
+            data_r[n]=sum;
+            n++;
          }
       }
+      size_r[i]=n-start_r[i];
    }
+   num_r=CompactRows(m1->GetNrows(),start_r,size_r,row_r,col_r,data_r);
    TMatrixDSparse *r=CreateSparseMatrix(m1->GetNrows(),m2->GetNrows(),
                                         num_r,row_r,col_r,data_r);
    delete[] row_r;
    delete[] col_r;
    delete[] data_r;
+   delete[] start_r;
+   delete[] size_r;
    return r;
 }
 
@@ -1446,6 +1546,10 @@ TMatrixDSparse *TUnfold::InvertMSparseSymmPos
             c_ii=TMath::Sqrt(c_ii);
             c(i,i)=c_ii;
             // off-diagonal elements
+            // (column i only depends on columns <i, the rows are independent)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
             for(Int_t j=i+1;j<nF;j++) {
                Double_t c_ji=c(j,i);
                for(Int_t k=0;k<i;k++) {
@@ -1474,6 +1578,10 @@ TMatrixDSparse *TUnfold::InvertMSparseSymmPos
             for(Int_t i=0;i<nF;i++) {
                cinv(i,i)=1./c(i,i);
             }
+            // the columns of cinv are independent of each other
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
             for(Int_t i=0;i<nF;i++) {
                for(Int_t j=i+1;j<nF;j++) {
                   Double_t tmp=-c(j,i)*cinv(i,i);
@@ -1973,6 +2081,9 @@ TUnfold::~TUnfold(void)
    DeleteMatrix(&fVyy);
    DeleteMatrix(&fY);
    DeleteMatrix(&fX0);
+   DeleteMatrix(&fAtVyyInv);
+   DeleteMatrix(&fAtVyyInvA);
+   DeleteMatrix(&fLSquared);
 
    ClearResults();
 }
@@ -2078,6 +2189,8 @@ Bool_t TUnfold::AddRegularisationCondition
    if(r) {
       DeleteMatrix(&fL);
       fL=CreateSparseMatrix(rowMax+1,GetNx(),nF,l_row,l_col,l_data);
+      // L#L has to be recalculated
+      DeleteMatrix(&fLSquared);
    }
    delete [] l_row;
    delete [] l_col;
@@ -2246,6 +2359,8 @@ Int_t TUnfold::SetInput(const TH1 *input, Double_t scaleBias,
    //   + see ClearResults
 
    DeleteMatrix(&fVyyInv);
+   DeleteMatrix(&fAtVyyInv);
+   DeleteMatrix(&fAtVyyInvA);
    fNdf=0;
 
    fBiasScale = scaleBias;
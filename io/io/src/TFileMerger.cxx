@@ -53,6 +53,7 @@
 ClassImp(TFileMerger)
 
 TClassRef R__TH1_Class("TH1");
+TClassRef R__THnBase_Class("THnBase");
 TClassRef R__TTree_Class("TTree");
 
 static const Int_t kCpProgress = BIT(14);
@@ -523,7 +524,9 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
                if (alreadyseen) continue;
 
                TList inputs;
-               Bool_t oneGo = fHistoOneGo && cl->InheritsFrom(R__TH1_Class);
+               // histograms (including profiles) and THn's are merged with all inputs
+               // at once, which allows them to check the binning only once
+               Bool_t oneGo = fHistoOneGo && (cl->InheritsFrom(R__TH1_Class) || cl->InheritsFrom(R__THnBase_Class));
 
                // Loop over all source files and merge same-name object
                TFile *nextsource = current_file ? (TFile*)sourcelist->After( current_file ) : (TFile*)sourcelist->First();
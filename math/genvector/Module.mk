@@ -145,6 +145,18 @@ endif
 
 ##### extra rules ######
 
+# use the VDT functions in the kFast policy of LorentzVectorArray
+ifeq ($(BUILDVDT),yes)
+$(GENVECTORO): CXXFLAGS += -DR__HAS_VDT -I$(ROOT_SRCDIR)/math/vdt/include
+endif
+# gcc vectorizes the loops on the arrays of vectors only with -O3 and when
+# the floating point exceptions and errno can be ignored
+ifneq ($(GCC_MAJOR),)
+ifneq (debug,$(findstring debug,$(ROOTBUILD)))
+$(call stripsrc,$(GENVECTORDIRS)/LorentzVectorArray.o): CXXFLAGS += -O3 -fno-trapping-math -fno-math-errno
+endif
+endif
+
 # Optimize dictionary with stl containers.
 $(GENVECTORDO): NOOPT = $(OPT)
 $(GENVECTORDO32): NOOPT = $(OPT)
@@ -0,0 +1,218 @@
+// @(#)root/mathcore:$Id$
+
+ /**********************************************************************
+  *                                                                    *
+  * Copyright (c) 2015 ROOT MathLib Team                               *
+  *                                                                    *
+  *                                                                    *
+  **********************************************************************/
+
+// Header file for class LorentzVectorArray
+//
+#ifndef ROOT_Math_GenVector_LorentzVectorArray
+#define ROOT_Math_GenVector_LorentzVectorArray 1
+
+#include "Math/GenVector/LorentzVector.h"
+#include "Math/GenVector/PxPyPzE4D.h"
+
+#include <vector>
+#include <cstddef>
+
+namespace ROOT {
+
+  namespace Math {
+
+    class Boost;
+
+//__________________________________________________________________________________________
+  /**
+     Collection of N Lorentz vectors stored in structure-of-arrays layout
+     (one array for each of the Px, Py, Pz and E components), for computing
+     the same quantity (coordinate conversions, boosts, invariant masses,
+     DeltaR, ...) for all the vectors at once.
+     The loops over the vectors are vectorized by the compiler.
+
+     The accuracy policy defines how the transcendental functions are computed:
+     <ul>
+     <li>kExact (default): with the same functions and formulae as the scalar
+         LorentzVector classes, which remain the reference. The results are the same
+         as the ones of the corresponding LorentzVector and VectorUtil functions.
+     <li>kFast: with the VDT fast functions (exp, log, sin, cos, atan2) when ROOT is built
+         with vdt and without branches, such that also these loops are vectorized.
+         The differences from kExact are of a few units in the last place.
+     </ul>
+     The products, the square roots and the functions without transcendental
+     functions (e.g. InvariantMass, Boost) are computed in the same way for both policies.
+
+     @ingroup GenVector
+  */
+
+  class LorentzVectorArray {
+
+  public:
+
+    typedef double Scalar;
+
+    /// accuracy policy of the transcendental functions
+    enum EAccuracy { kExact, kFast };
+
+    /**
+       Construct an array of n vectors (with all the components equal to zero)
+    */
+    explicit LorentzVectorArray(size_t n = 0, EAccuracy accuracy = kExact) :
+      fX(n), fY(n), fZ(n), fT(n), fAccuracy(accuracy) {}
+
+    // ========== size and policy =====================
+
+    /// number of vectors
+    size_t Size() const { return fX.size(); }
+
+    /// change the number of vectors (the new vectors are set to zero)
+    void Resize(size_t n) { fX.resize(n); fY.resize(n); fZ.resize(n); fT.resize(n); }
+
+    /// reserve the memory for n vectors
+    void Reserve(size_t n) { fX.reserve(n); fY.reserve(n); fZ.reserve(n); fT.reserve(n); }
+
+    /// remove all the vectors
+    void Clear() { fX.clear(); fY.clear(); fZ.clear(); fT.clear(); }
+
+    /// accuracy policy
+    EAccuracy Accuracy() const { return fAccuracy; }
+
+    /// set the accuracy policy
+    void SetAccuracy(EAccuracy accuracy) { fAccuracy = accuracy; }
+
+    // ========== access to the vectors =====================
+
+    /**
+       Add a vector (in any coordinate system) at the end of the array
+    */
+    template <class CoordSystem>
+    void PushBack(const LorentzVector<CoordSystem> & v) {
+      fX.push_back(v.Px()); fY.push_back(v.Py()); fZ.push_back(v.Pz()); fT.push_back(v.E());
+    }
+
+    /**
+       Set the vector i (from a vector in any coordinate system)
+    */
+    template <class CoordSystem>
+    void Set(size_t i, const LorentzVector<CoordSystem> & v) {
+      fX[i] = v.Px(); fY[i] = v.Py(); fZ[i] = v.Pz(); fT[i] = v.E();
+    }
+
+    /**
+       Return the vector i
+    */
+    LorentzVector<PxPyPzE4D<Scalar> > At(size_t i) const {
+      return LorentzVector<PxPyPzE4D<Scalar> >(fX[i], fY[i], fZ[i], fT[i]);
+    }
+
+    LorentzVector<PxPyPzE4D<Scalar> > operator[](size_t i) const { return At(i); }
+
+    /// arrays of the components
+    const Scalar * Px() const { return fX.empty() ? 0 : &fX[0]; }
+    const Scalar * Py() const { return fY.empty() ? 0 : &fY[0]; }
+    const Scalar * Pz() const { return fZ.empty() ? 0 : &fZ[0]; }
+    const Scalar * E()  const { return fT.empty() ? 0 : &fT[0]; }
+    Scalar * Px() { return fX.empty() ? 0 : &fX[0]; }
+    Scalar * Py() { return fY.empty() ? 0 : &fY[0]; }
+    Scalar * Pz() { return fZ.empty() ? 0 : &fZ[0]; }
+    Scalar * E()  { return fT.empty() ? 0 : &fT[0]; }
+
+    // ========== conversions from other coordinate systems =====================
+
+    /**
+       Set the array to the n vectors given by arrays of (pt, eta, phi, mass),
+       as with PtEtaPhiM4D (a negative mass means a negative M2)
+    */
+    void SetPtEtaPhiM(size_t n, const Scalar * pt, const Scalar * eta, const Scalar * phi, const Scalar * mass);
+
+    /**
+       Set the array to the n vectors given by arrays of (pt, eta, phi, energy),
+       as with PtEtaPhiE4D
+    */
+    void SetPtEtaPhiE(size_t n, const Scalar * pt, const Scalar * eta, const Scalar * phi, const Scalar * e);
+
+    // ========== conversions to other coordinates =====================
+    // the results are written in the array result, of at least Size() elements
+
+    /// transverse momenta
+    void Pt(Scalar * result) const;
+
+    /// pseudorapidities
+    void Eta(Scalar * result) const;
+
+    /// azimuthal angles in (-pi,pi]
+    void Phi(Scalar * result) const;
+
+    /// squares of the invariant masses
+    void M2(Scalar * result) const;
+
+    /// invariant masses (negative for the vectors with a negative M2, without throwing)
+    void M(Scalar * result) const;
+
+    // ========== transformations =====================
+
+    /**
+       Apply the Lorentz boost b to all the vectors
+    */
+    void ApplyBoost(const ROOT::Math::Boost & b);
+
+    /**
+       Apply to all the vectors the boost given by the beta vector (bx,by,bz)
+    */
+    void ApplyBoost(Scalar bx, Scalar by, Scalar bz);
+
+  private:
+
+    std::vector<Scalar> fX;
+    std::vector<Scalar> fY;
+    std::vector<Scalar> fZ;
+    std::vector<Scalar> fT;
+    EAccuracy fAccuracy;
+
+  };
+
+
+  namespace VectorUtil {
+
+    /**
+       Invariant masses of the pairs (v1[i], v2[i]), as VectorUtil::InvariantMass
+       (the two arrays must have the same size)
+       @ingroup GenVector
+    */
+    void InvariantMass(const LorentzVectorArray & v1, const LorentzVectorArray & v2, double * result);
+
+    /**
+       Squares of the invariant masses of the pairs (v1[i], v2[i]), as VectorUtil::InvariantMass2
+       @ingroup GenVector
+    */
+    void InvariantMass2(const LorentzVectorArray & v1, const LorentzVectorArray & v2, double * result);
+
+    /**
+       Invariant masses of all the pairs (v[i], v[j]) with i < j, in the order
+       (0,1), (0,2), ..., (0,n-1), (1,2), ...; result must have n*(n-1)/2 elements
+       @ingroup GenVector
+    */
+    void InvariantMassPairs(const LorentzVectorArray & v, double * result);
+
+    /**
+       Differences in Phi of the pairs (v1[i], v2[i]), as VectorUtil::DeltaPhi
+       (Phi and Eta of each array are computed with its accuracy policy)
+       @ingroup GenVector
+    */
+    void DeltaPhi(const LorentzVectorArray & v1, const LorentzVectorArray & v2, double * result);
+
+    /**
+       DeltaR of the pairs (v1[i], v2[i]), as VectorUtil::DeltaR
+       @ingroup GenVector
+    */
+    void DeltaR(const LorentzVectorArray & v1, const LorentzVectorArray & v2, double * result);
+
+  }  // end namespace VectorUtil
+
+  } // end namespace Math
+
+} // end namespace ROOT
+
+#endif /* ROOT_Math_GenVector_LorentzVectorArray  */
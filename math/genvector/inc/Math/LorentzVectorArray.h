@@ -0,0 +1,10 @@
+// @(#)root/mathcore:$Id$
+
+#ifndef ROOT_Math_LorentzVectorArray
+#define ROOT_Math_LorentzVectorArray
+
+
+#include "Math/GenVector/LorentzVectorArray.h"
+
+
+#endif
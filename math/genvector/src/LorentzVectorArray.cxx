@@ -0,0 +1,391 @@
+// @(#)root/mathcore:$Id$
+
+ /**********************************************************************
+  *                                                                    *
+  * Copyright (c) 2015 ROOT MathLib Team                               *
+  *                                                                    *
+  *                                                                    *
+  **********************************************************************/
+
+// Implementation file for class LorentzVectorArray and the VectorUtil functions on arrays
+// The loops are written without branches (or with branches which can be converted by the
+// compiler in a selection) such that they can be vectorized.
+// With the kExact policy the same formulae of the scalar classes are used, in the same
+// order of the operations (PxPyPzE4D, PtEtaPhiM4D, Impl::Eta_FromRhoZ, Boost, VectorUtil).
+
+#include "Math/GenVector/LorentzVectorArray.h"
+#include "Math/GenVector/Boost.h"
+#include "Math/GenVector/eta.h"
+#include "Math/GenVector/etaMax.h"
+
+#include <cmath>
+#include <limits>
+#include <cassert>
+
+#ifdef R__HAS_VDT
+#include "vdt/exp.h"
+#include "vdt/log.h"
+#include "vdt/sincos.h"
+#include "vdt/atan2.h"
+#endif
+
+#ifndef M_PI
+#define M_PI       3.14159265358979323846264338328      // Pi
+#endif
+
+namespace ROOT {
+
+namespace Math {
+
+namespace {
+
+   typedef LorentzVectorArray::Scalar Scalar;
+
+   inline Scalar FastExp(Scalar x) {
+#ifdef R__HAS_VDT
+      return vdt::fast_exp(x);
+#else
+      return std::exp(x);
+#endif
+   }
+
+   // the argument is always > 0
+   inline Scalar FastLog(Scalar x) {
+#ifdef R__HAS_VDT
+      return vdt::fast_log(x);
+#else
+      return std::log(x);
+#endif
+   }
+
+   inline void FastSinCos(Scalar x, Scalar & s, Scalar & c) {
+#ifdef R__HAS_VDT
+      vdt::fast_sincos(x, s, c);
+#else
+      s = std::sin(x);
+      c = std::cos(x);
+#endif
+   }
+
+   inline Scalar FastAtan2(Scalar y, Scalar x) {
+#ifdef R__HAS_VDT
+      return vdt::fast_atan2(y, x);
+#else
+      return std::atan2(y, x);
+#endif
+   }
+
+   // sinh and cosh from a single exponential; for small values of x the Taylor series
+   // of sinh is used to avoid the cancellation in exp(x) - exp(-x)
+   inline void FastSinhCosh(Scalar x, Scalar & sh, Scalar & ch) {
+      Scalar ex = FastExp(x);
+      Scalar emx = 1.0/ex;
+      Scalar x2 = x*x;
+      Scalar shSmall = x*(1.0 + x2*(1.0/6 + x2*(1.0/120 + x2*(1.0/5040))));
+      sh = (std::fabs(x) < 0.01) ? shSmall : 0.5*(ex - emx);
+      ch = 0.5*(ex + emx);
+   }
+
+   // pz and p of the PtEtaPhi coordinates (as PtEtaPhiE4D::Pz() and P())
+   inline void ExactPzP(Scalar pt, Scalar eta, Scalar & pz, Scalar & p) {
+      if (pt > 0) {
+         pz = pt*std::sinh(eta);
+         p  = pt*std::cosh(eta);
+      } else {
+         const Scalar etamax = etaMax<Scalar>();
+         pz = eta == 0 ? 0 : eta > 0 ? eta - etamax : eta + etamax;
+         p  = eta > etamax ? eta - etamax : eta < -etamax ? -eta - etamax : 0;
+      }
+   }
+
+   inline void FastPzP(Scalar pt, Scalar eta, Scalar & pz, Scalar & p) {
+      Scalar sh, ch;
+      FastSinhCosh(eta, sh, ch);
+      const Scalar etamax = etaMax<Scalar>();
+      Scalar pz0 = eta == 0 ? 0 : eta > 0 ? eta - etamax : eta + etamax;
+      Scalar p0  = eta > etamax ? eta - etamax : eta < -etamax ? -eta - etamax : 0;
+      pz = (pt > 0) ? pt*sh : pz0;
+      p  = (pt > 0) ? pt*ch : p0;
+   }
+
+   // eta from rho and z, as Impl::Eta_FromRhoZ, without branches
+   inline Scalar FastEta(Scalar rho, Scalar z) {
+      static const Scalar big_z_scaled =
+         std::pow(std::numeric_limits<Scalar>::epsilon(),static_cast<Scalar>(-.25));
+      const Scalar etamax = etaMax<Scalar>();
+      // the symmetric form avoids the cancellation for negative z
+      Scalar az = std::fabs(z);
+      Scalar zs = az/((rho > 0) ? rho : 1.0);
+      Scalar arg = (zs < big_z_scaled) ? zs + std::sqrt(zs*zs + 1.0) : 2.0*zs + 0.5/zs;
+      Scalar eta = FastLog(arg);
+      Scalar eta0 = (az == 0) ? 0 : az + etamax;
+      eta = (rho > 0) ? eta : eta0;
+      return (z < 0) ? -eta : eta;
+   }
+
+   inline Scalar PhiMPiPi(Scalar dphi) {
+      return dphi > M_PI ? dphi - 2.0*M_PI : dphi <= -M_PI ? dphi + 2.0*M_PI : dphi;
+   }
+
+}
+
+void LorentzVectorArray::SetPtEtaPhiM(size_t n, const Scalar * pt, const Scalar * eta, const Scalar * phi, const Scalar * mass)
+{
+   // set the vectors from the (pt, eta, phi, mass) coordinates
+   Resize(n);
+   Scalar * x = Px();
+   Scalar * y = Py();
+   Scalar * z = Pz();
+   Scalar * t = E();
+   if (fAccuracy == kExact) {
+      for (size_t i = 0; i < n; ++i) {
+         Scalar p;
+         x[i] = pt[i]*cos(phi[i]);
+         y[i] = pt[i]*sin(phi[i]);
+         ExactPzP(pt[i], eta[i], z[i], p);
+         Scalar m2 = (mass[i] >= 0) ? mass[i]*mass[i] : -mass[i]*mass[i];
+         Scalar e2 = p*p + m2;
+         t[i] = std::sqrt(e2 > 0 ? e2 : 0);
+      }
+   }
+   else {
+      // two loops (the compiler does not vectorize the single loop)
+      for (size_t i = 0; i < n; ++i) {
+         Scalar s, c;
+         FastSinCos(phi[i], s, c);
+         x[i] = pt[i]*c;
+         y[i] = pt[i]*s;
+      }
+      for (size_t i = 0; i < n; ++i) {
+         Scalar p;
+         FastPzP(pt[i], eta[i], z[i], p);
+         Scalar m2 = (mass[i] >= 0) ? mass[i]*mass[i] : -mass[i]*mass[i];
+         Scalar e2 = p*p + m2;
+         t[i] = std::sqrt(e2 > 0 ? e2 : 0);
+      }
+   }
+}
+
+void LorentzVectorArray::SetPtEtaPhiE(size_t n, const Scalar * pt, const Scalar * eta, const Scalar * phi, const Scalar * e)
+{
+   // set the vectors from the (pt, eta, phi, energy) coordinates
+   Resize(n);
+   Scalar * x = Px();
+   Scalar * y = Py();
+   Scalar * z = Pz();
+   Scalar * t = E();
+   if (fAccuracy == kExact) {
+      for (size_t i = 0; i < n; ++i) {
+         Scalar p;
+         x[i] = pt[i]*cos(phi[i]);
+         y[i] = pt[i]*sin(phi[i]);
+         ExactPzP(pt[i], eta[i], z[i], p);
+         t[i] = e[i];
+      }
+   }
+   else {
+      for (size_t i = 0; i < n; ++i) {
+         Scalar s, c;
+         FastSinCos(phi[i], s, c);
+         x[i] = pt[i]*c;
+         y[i] = pt[i]*s;
+      }
+      for (size_t i = 0; i < n; ++i) {
+         Scalar p;
+         FastPzP(pt[i], eta[i], z[i], p);
+         t[i] = e[i];
+      }
+   }
+}
+
+void LorentzVectorArray::Pt(Scalar * result) const
+{
+   // transverse momenta (as PxPyPzE4D::Pt())
+   const size_t n = Size();
+   const Scalar * x = Px();
+   const Scalar * y = Py();
+   for (size_t i = 0; i < n; ++i)
+      result[i] = std::sqrt(x[i]*x[i] + y[i]*y[i]);
+}
+
+void LorentzVectorArray::Eta(Scalar * result) const
+{
+   // pseudorapidities (as PxPyPzE4D::Eta())
+   const size_t n = Size();
+   const Scalar * x = Px();
+   const Scalar * y = Py();
+   const Scalar * z = Pz();
+   if (fAccuracy == kExact) {
+      for (size_t i = 0; i < n; ++i)
+         result[i] = Impl::Eta_FromRhoZ(std::sqrt(x[i]*x[i] + y[i]*y[i]), z[i]);
+   }
+   else {
+      for (size_t i = 0; i < n; ++i)
+         result[i] = FastEta(std::sqrt(x[i]*x[i] + y[i]*y[i]), z[i]);
+   }
+}
+
+void LorentzVectorArray::Phi(Scalar * result) const
+{
+   // azimuthal angles (as PxPyPzE4D::Phi())
+   const size_t n = Size();
+   const Scalar * x = Px();
+   const Scalar * y = Py();
+   if (fAccuracy == kExact) {
+      for (size_t i = 0; i < n; ++i)
+         result[i] = (x[i] == 0.0 && y[i] == 0.0) ? 0 : std::atan2(y[i], x[i]);
+   }
+   else {
+      for (size_t i = 0; i < n; ++i) {
+         Scalar phi = FastAtan2(y[i], x[i]);
+         result[i] = (x[i] == 0.0 && y[i] == 0.0) ? 0 : phi;
+      }
+   }
+}
+
+void LorentzVectorArray::M2(Scalar * result) const
+{
+   // squares of the invariant masses (as PxPyPzE4D::M2())
+   const size_t n = Size();
+   const Scalar * x = Px();
+   const Scalar * y = Py();
+   const Scalar * z = Pz();
+   const Scalar * t = E();
+   for (size_t i = 0; i < n; ++i)
+      result[i] = t[i]*t[i] - x[i]*x[i] - y[i]*y[i] - z[i]*z[i];
+}
+
+void LorentzVectorArray::M(Scalar * result) const
+{
+   // invariant masses (as PxPyPzE4D::M(), but without throwing for M2 < 0)
+   const size_t n = Size();
+   M2(result);
+   for (size_t i = 0; i < n; ++i) {
+      Scalar mm = result[i];
+      Scalar m = std::sqrt(std::fabs(mm));
+      result[i] = (mm >= 0) ? m : -m;
+   }
+}
+
+void LorentzVectorArray::ApplyBoost(const ROOT::Math::Boost & b)
+{
+   // apply the boost to all the vectors (as Boost::operator())
+   Scalar r[16];
+   b.GetLorentzRotation(r);
+   const Scalar mxx = r[Boost::kLXX], mxy = r[Boost::kLXY], mxz = r[Boost::kLXZ], mxt = r[Boost::kLXT];
+   const Scalar myy = r[Boost::kLYY], myz = r[Boost::kLYZ], myt = r[Boost::kLYT];
+   const Scalar mzz = r[Boost::kLZZ], mzt = r[Boost::kLZT];
+   const Scalar mtt = r[Boost::kLTT];
+   const size_t n = Size();
+   Scalar * x = Px();
+   Scalar * y = Py();
+   Scalar * z = Pz();
+   Scalar * t = E();
+   for (size_t i = 0; i < n; ++i) {
+      Scalar xi = x[i];
+      Scalar yi = y[i];
+      Scalar zi = z[i];
+      Scalar ti = t[i];
+      x[i] = mxx*xi + mxy*yi + mxz*zi + mxt*ti;
+      y[i] = mxy*xi + myy*yi + myz*zi + myt*ti;
+      z[i] = mxz*xi + myz*yi + mzz*zi + mzt*ti;
+      t[i] = mxt*xi + myt*yi + mzt*zi + mtt*ti;
+   }
+}
+
+void LorentzVectorArray::ApplyBoost(Scalar bx, Scalar by, Scalar bz)
+{
+   // apply the boost given by the beta vector
+   ApplyBoost(Boost(bx, by, bz));
+}
+
+
+namespace VectorUtil {
+
+void InvariantMass2(const LorentzVectorArray & v1, const LorentzVectorArray & v2, double * result)
+{
+   // squares of the invariant masses of the pairs (as VectorUtil::InvariantMass2)
+   assert(v1.Size() == v2.Size());
+   const size_t n = v1.Size();
+   const double * x1 = v1.Px(); const double * y1 = v1.Py(); const double * z1 = v1.Pz(); const double * t1 = v1.E();
+   const double * x2 = v2.Px(); const double * y2 = v2.Py(); const double * z2 = v2.Pz(); const double * t2 = v2.E();
+   for (size_t i = 0; i < n; ++i) {
+      double ee = (t1[i] + t2[i]);
+      double xx = (x1[i] + x2[i]);
+      double yy = (y1[i] + y2[i]);
+      double zz = (z1[i] + z2[i]);
+      result[i] = ee*ee - xx*xx - yy*yy - zz*zz;
+   }
+}
+
+void InvariantMass(const LorentzVectorArray & v1, const LorentzVectorArray & v2, double * result)
+{
+   // invariant masses of the pairs (as VectorUtil::InvariantMass)
+   const size_t n = v1.Size();
+   InvariantMass2(v1, v2, result);
+   for (size_t i = 0; i < n; ++i) {
+      double mm2 = result[i];
+      double m = std::sqrt(std::fabs(mm2));
+      result[i] = mm2 < 0.0 ? -m : m;
+   }
+}
+
+void InvariantMassPairs(const LorentzVectorArray & v, double * result)
+{
+   // invariant masses of all the pairs (i,j) with i < j
+   // the inner loop (on j) is vectorized
+   const size_t n = v.Size();
+   const double * x = v.Px(); const double * y = v.Py(); const double * z = v.Pz(); const double * t = v.E();
+   double * r = result;
+   for (size_t i = 0; i + 1 < n; ++i) {
+      const double xi = x[i], yi = y[i], zi = z[i], ti = t[i];
+      const size_t m = n - i - 1;
+      const double * xj = x + i + 1; const double * yj = y + i + 1;
+      const double * zj = z + i + 1; const double * tj = t + i + 1;
+      for (size_t j = 0; j < m; ++j) {
+         double ee = (ti + tj[j]);
+         double xx = (xi + xj[j]);
+         double yy = (yi + yj[j]);
+         double zz = (zi + zj[j]);
+         double mm2 = ee*ee - xx*xx - yy*yy - zz*zz;
+         double mm = std::sqrt(std::fabs(mm2));
+         r[j] = mm2 < 0.0 ? -mm : mm;
+      }
+      r += m;
+   }
+}
+
+void DeltaPhi(const LorentzVectorArray & v1, const LorentzVectorArray & v2, double * result)
+{
+   // differences in phi of the pairs (as VectorUtil::DeltaPhi)
+   assert(v1.Size() == v2.Size());
+   const size_t n = v1.Size();
+   std::vector<double> phi2(n);
+   v1.Phi(result);
+   if (n > 0) v2.Phi(&phi2[0]);
+   for (size_t i = 0; i < n; ++i)
+      result[i] = PhiMPiPi(phi2[i] - result[i]);
+}
+
+void DeltaR(const LorentzVectorArray & v1, const LorentzVectorArray & v2, double * result)
+{
+   // DeltaR of the pairs (as VectorUtil::DeltaR)
+   assert(v1.Size() == v2.Size());
+   const size_t n = v1.Size();
+   if (n == 0) return;
+   std::vector<double> eta1(n), eta2(n);
+   DeltaPhi(v1, v2, result);
+   v1.Eta(&eta1[0]);
+   v2.Eta(&eta2[0]);
+   for (size_t i = 0; i < n; ++i) {
+      double dphi = result[i];
+      double deta = eta2[i] - eta1[i];
+      result[i] = std::sqrt(dphi*dphi + deta*deta);
+   }
+}
+
+}  // end namespace VectorUtil
+
+} // end namespace Math
+
+} // end namespace ROOT
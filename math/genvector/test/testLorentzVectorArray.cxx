@@ -0,0 +1,200 @@
+// test of the Lorentz vectors stored in arrays (LorentzVectorArray)
+// the conversions, the boosts and the VectorUtil functions on arrays are compared
+// with the ones of the scalar LorentzVector classes: the results must be the same
+// with the kExact policy and close (relative difference < 1.E-10) with the kFast policy.
+// The time per vector (or per pair for the invariant masses) is printed for both versions
+
+#include "Math/Vector4D.h"
+#include "Math/Boost.h"
+#include "Math/VectorUtil.h"
+#include "Math/LorentzVectorArray.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+#include "TError.h"
+#include <vector>
+#include <iostream>
+#include <cstdio>
+#include <cmath>
+#include <string>
+
+using namespace ROOT::Math;
+
+bool gVerbose = false;
+
+// number of vectors
+const unsigned int NV = 1000;
+
+int gNFail = 0;
+
+bool Compare(const char * name, const std::vector<double> & res, const std::vector<double> & ref, double tol)
+{
+   int nfail = 0;
+   for (unsigned int i = 0; i < ref.size(); ++i) {
+      double d = std::abs(res[i] - ref[i]);
+      bool ok = (tol == 0) ? (res[i] == ref[i]) : d <= tol * std::max(1., std::abs(ref[i]));
+      if (!ok) {
+         if (nfail == 0 || gVerbose)
+            Error("Compare","%s: different result for %d : %.17g (scalar %.17g)", name, i, res[i], ref[i]);
+         nfail++;
+      }
+   }
+   if (gVerbose) printf("%-20s %s\n", name, nfail == 0 ? "OK" : "FAILED");
+   gNFail += nfail;
+   return nfail == 0;
+}
+
+void MakeVectors(std::vector<PtEtaPhiMVector> & v, TRandom3 & rnd)
+{
+   for (unsigned int i = 0; i < v.size(); ++i) {
+      double pt  = rnd.Exp(20.);
+      double eta = rnd.Uniform(-5,5);
+      double phi = rnd.Uniform(-M_PI,M_PI);
+      double m   = rnd.Uniform(0,5);
+      // some special cases (pt = 0, small eta)
+      if (i % 97 == 0) pt = 0;
+      if (i % 89 == 0) eta = rnd.Uniform(-1.E-3,1.E-3);
+      v[i] = PtEtaPhiMVector(pt, eta, phi, m);
+   }
+}
+
+int testArray(LorentzVectorArray::EAccuracy acc)
+{
+   // tolerance of the comparison
+   const double tol = (acc == LorentzVectorArray::kExact) ? 0 : 1.E-10;
+   const char * sacc = (acc == LorentzVectorArray::kExact) ? "kExact" : "kFast";
+   int nfail0 = gNFail;
+
+   TRandom3 rnd(4357);
+   std::vector<PtEtaPhiMVector> v1(NV), v2(NV);
+   MakeVectors(v1, rnd);
+   MakeVectors(v2, rnd);
+
+   std::vector<double> pt(NV), eta(NV), phi(NV), m(NV);
+   for (unsigned int i = 0; i < NV; ++i) {
+      pt[i] = v1[i].Pt(); eta[i] = v1[i].Eta(); phi[i] = v1[i].Phi(); m[i] = v1[i].M();
+   }
+
+   LorentzVectorArray a1(0, acc), a2(0, acc);
+   a1.SetPtEtaPhiM(NV, &pt[0], &eta[0], &phi[0], &m[0]);
+   for (unsigned int i = 0; i < NV; ++i) a2.PushBack(v2[i]);
+
+   // conversions
+   std::vector<double> res(NV), ref(NV);
+   std::vector<PxPyPzEVector> x1(NV);
+   for (unsigned int i = 0; i < NV; ++i) x1[i] = PxPyPzEVector(v1[i]);
+   for (unsigned int i = 0; i < NV; ++i) ref[i] = x1[i].Px();
+   Compare("SetPtEtaPhiM (Px)", std::vector<double>(a1.Px(), a1.Px()+NV), ref, tol);
+   for (unsigned int i = 0; i < NV; ++i) ref[i] = x1[i].Pz();
+   Compare("SetPtEtaPhiM (Pz)", std::vector<double>(a1.Pz(), a1.Pz()+NV), ref, tol);
+   for (unsigned int i = 0; i < NV; ++i) ref[i] = x1[i].E();
+   Compare("SetPtEtaPhiM (E)", std::vector<double>(a1.E(), a1.E()+NV), ref, tol);
+
+   // the other functions are computed from the same Px,Py,Pz,E values
+   for (unsigned int i = 0; i < NV; ++i) x1[i] = a1.At(i);
+   for (unsigned int i = 0; i < NV; ++i) ref[i] = x1[i].Pt();
+   a1.Pt(&res[0]);
+   Compare("Pt", res, ref, 0);
+   for (unsigned int i = 0; i < NV; ++i) ref[i] = x1[i].Eta();
+   a1.Eta(&res[0]);
+   Compare("Eta", res, ref, tol);
+   for (unsigned int i = 0; i < NV; ++i) ref[i] = x1[i].Phi();
+   a1.Phi(&res[0]);
+   Compare("Phi", res, ref, tol);
+   for (unsigned int i = 0; i < NV; ++i) ref[i] = x1[i].M2();
+   a1.M2(&res[0]);
+   Compare("M2", res, ref, 0);
+
+   // VectorUtil functions
+   for (unsigned int i = 0; i < NV; ++i) ref[i] = VectorUtil::InvariantMass(x1[i], v2[i]);
+   VectorUtil::InvariantMass(a1, a2, &res[0]);
+   Compare("InvariantMass", res, ref, 0);
+   for (unsigned int i = 0; i < NV; ++i) ref[i] = VectorUtil::DeltaPhi(x1[i], a2.At(i));
+   VectorUtil::DeltaPhi(a1, a2, &res[0]);
+   Compare("DeltaPhi", res, ref, tol);
+   for (unsigned int i = 0; i < NV; ++i) ref[i] = VectorUtil::DeltaR(x1[i], a2.At(i));
+   VectorUtil::DeltaR(a1, a2, &res[0]);
+   Compare("DeltaR", res, ref, tol);
+
+   // boost
+   Boost b(0.1, -0.3, 0.5);
+   LorentzVectorArray ab(a1);
+   ab.ApplyBoost(b);
+   for (unsigned int i = 0; i < NV; ++i) ref[i] = b(x1[i]).Pz();
+   Compare("Boost (Pz)", std::vector<double>(ab.Pz(), ab.Pz()+NV), ref, 0);
+   for (unsigned int i = 0; i < NV; ++i) ref[i] = b(x1[i]).E();
+   Compare("Boost (E)", std::vector<double>(ab.E(), ab.E()+NV), ref, 0);
+
+   // invariant masses of all the pairs
+   const unsigned int np = NV*(NV-1)/2;
+   std::vector<double> mpairs(np), mref(np);
+   TStopwatch w;
+   const int nloop = 20;
+   w.Start();
+   for (int l = 0; l < nloop; ++l) {
+      unsigned int k = 0;
+      for (unsigned int i = 0; i < NV; ++i)
+         for (unsigned int j = i+1; j < NV; ++j) mref[k++] = VectorUtil::InvariantMass(x1[i], x1[j]);
+   }
+   w.Stop();
+   double tscalar = w.CpuTime();
+   w.Start();
+   for (int l = 0; l < nloop; ++l) VectorUtil::InvariantMassPairs(a1, &mpairs[0]);
+   w.Stop();
+   double tarray = w.CpuTime();
+   Compare("InvariantMassPairs", mpairs, mref, 0);
+
+   // conversions from PtEtaPhiM
+   const int nloop2 = 1000;
+   w.Start();
+   for (int l = 0; l < nloop2; ++l) {
+      for (unsigned int i = 0; i < NV; ++i) {
+         x1[i] = PtEtaPhiMVector(pt[i], eta[i], phi[i], m[i]);
+      }
+   }
+   w.Stop();
+   double tconvs = w.CpuTime();
+   w.Start();
+   for (int l = 0; l < nloop2; ++l) a1.SetPtEtaPhiM(NV, &pt[0], &eta[0], &phi[0], &m[0]);
+   w.Stop();
+   double tconva = w.CpuTime();
+
+   printf("%s policy, nanoseconds per vector or per pair\n", sacc);
+   printf("   InvariantMass (pairs)  scalar %8.3f   array %8.3f\n",
+          tscalar*1.E9/(double(np)*nloop), tarray*1.E9/(double(np)*nloop));
+   printf("   SetPtEtaPhiM           scalar %8.3f   array %8.3f\n",
+          tconvs*1.E9/(double(NV)*nloop2), tconva*1.E9/(double(NV)*nloop2));
+
+   int nfail = gNFail - nfail0;
+   if (nfail == 0) printf("Test of LorentzVectorArray with the %s policy:  OK\n", sacc);
+   return nfail;
+}
+
+int testLorentzVectorArray()
+{
+   int iret = 0;
+   iret += testArray(LorentzVectorArray::kExact);
+   iret += testArray(LorentzVectorArray::kFast);
+
+   if (iret) std::cerr << "testLorentzVectorArray: Test FAILED !" << std::endl;
+   return (iret == 0) ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+   // Parse command line arguments
+   for (int i=1 ;  i<argc ; i++) {
+      std::string arg = argv[i] ;
+      if (arg == "-v") {
+         gVerbose = true;
+      }
+      if (arg == "-h") {
+         std::cout << "Usage: " << argv[0] << " [-v]\n";
+         std::cout << "  where:\n";
+         std::cout << "     -v : verbose  mode";
+         std::cout << std::endl;
+         return -1;
+      }
+   }
+
+   return testLorentzVectorArray();
+}
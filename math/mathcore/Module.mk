@@ -26,6 +26,7 @@ MATHCOREDH2  := $(MODDIRI)/TRandom.h \
                 $(MODDIRI)/TRandom1.h \
                 $(MODDIRI)/TRandom2.h \
                 $(MODDIRI)/TRandom3.h \
+                $(MODDIRI)/TRandomPhilox.h \
                 $(MODDIRI)/TStatistic.h \
                 $(MODDIRI)/TKDTree.h \
                 $(MODDIRI)/TKDTreeBinning.h \
@@ -166,6 +167,23 @@ endif
 ##### extra rules ######
 $(MATHCOREO): CXXFLAGS += -DUSE_ROOT_ERROR
 $(MATHCOREDO): CXXFLAGS += -DUSE_ROOT_ERROR 
+# use the VDT exp and log in the functions evaluated on arrays
+ifeq ($(BUILDVDT),yes)
+$(MATHCOREO): CXXFLAGS += -DR__HAS_VDT -I$(ROOT_SRCDIR)/math/vdt/include
+endif
+# gcc vectorizes the loops of the functions on arrays only with -O3 and when
+# the floating point exceptions can be ignored
+ifneq ($(GCC_MAJOR),)
+ifneq (debug,$(findstring debug,$(ROOTBUILD)))
+$(call stripsrc,$(MATHCOREDIRS)/SpecFuncCephes.o $(MATHCOREDIRS)/BatchFuncMathCore.o): CXXFLAGS += -O3 -fno-trapping-math
+endif
+endif
+# the function evaluations of the adaptive multi-dimensional integration, the build
+# and the queries on arrays of points of TKDTree can optionally use OpenMP
+ifneq ($(USE_OPENMP),)
+$(call stripsrc,$(MATHCOREDIRS)/AdaptiveIntegratorMultiDim.o $(MATHCOREDIRS)/TKDTree.o): CXXFLAGS += -fopenmp
+$(MATHCORELIB): LDFLAGS += -fopenmp
+endif
 # add optimization to G__Math compilation
 # Optimize dictionary with stl containers.
 $(MATHCOREDO1) : NOOPT = $(OPT)
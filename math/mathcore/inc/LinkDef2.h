@@ -39,6 +39,7 @@
 #pragma link C++ class TRandom1+;
 #pragma link C++ class TRandom2+;
 #pragma link C++ class TRandom3-;
+#pragma link C++ class TRandomPhilox+;
 
 #pragma link C++ class TStatistic+;
 
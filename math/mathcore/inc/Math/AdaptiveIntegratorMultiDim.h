@@ -71,6 +71,13 @@ namespace Math {
      2.Numerical integration usually works best for smooth functions.
        Some analysis or suitable transformations of the integral prior to
        numerical work may contribute to numerical efficiency.
+     3.The nodes of the integration rule of the two halves of a divided region
+       are generated together and the function is evaluated on all of them at once.
+       If ROOT is built with OpenMP these evaluations can be distributed over several
+       threads (see SetNThreads). Each thread uses its own copy of the function,
+       obtained with IMultiGenFunction::Clone(), which must therefore be safe to
+       evaluate concurrently with the original one. The result does not depend on the
+       number of threads.
 
    References:
 
@@ -159,6 +166,12 @@ public:
    ///set max points
    void SetMaxPts(unsigned int n) { fMaxPts = n; }
 
+   /// set the number of threads used to evaluate the function (0 means all the available ones)
+   void SetNThreads(unsigned int n) { fNThreads = n; }
+
+   /// return the number of threads used to evaluate the function
+   unsigned int NThreads() const { return fNThreads; }
+
    /// set the options
    void SetOptions(const ROOT::Math::IntegratorMultiDimOptions & opt);
 
@@ -176,6 +189,7 @@ protected:
    unsigned int fMinPts;    // minimum number of function evaluation requested
    unsigned int fMaxPts;    // maximum number of function evaluation requested
    unsigned int fSize;    // max size of working array (explode with dimension)
+   unsigned int fNThreads; // number of threads used to evaluate the function
    double fAbsTol;        // absolute tolerance
    double fRelTol;        // relative tolerance
 
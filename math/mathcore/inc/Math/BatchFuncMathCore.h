@@ -0,0 +1,183 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2015 , LCG ROOT MathLib Team                         *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+
+
+/**
+
+Versions of the most used special functions, probability density functions
+and cumulative distributions of MathCore evaluating arrays of numbers.
+The functions compute result[i] = f(x[i]) for i = 0,...,n-1, with the same
+parameters for all the elements.
+
+They are implemented such that the loops can be vectorized by the compiler
+(the different approximations used by the scalar functions are computed for
+all the elements and then selected), using the exponential and logarithm functions
+of the VDT library when ROOT is built with it. This is faster than calling
+the scalar functions in a loop, for example in likelihood fits or in the generation of toys.
+The gain depends on the width of the vector registers: with SSE2 the functions with
+several approximations (erf, erfc and the normal cumulative distributions) are about as
+fast as the scalar ones, while with AVX (e.g. -mavx2) all the functions are 2-4 times faster.
+The results agree with the scalar functions in ROOT::Math within a few units of the
+double precision (the VDT exponential and logarithm are not correctly rounded and
+they underflow to zero for arguments below -708).
+
+The functions whose algorithm is iterative (gamma_cdf, chisquared_cdf and poisson_cdf)
+are evaluated element by element with the scalar functions.
+
+@defgroup BatchFunc Functions evaluated on arrays
+@ingroup StatFunc
+
+*/
+
+#ifndef ROOT_Math_BatchFuncMathCore
+#define ROOT_Math_BatchFuncMathCore
+
+
+namespace ROOT {
+namespace Math {
+
+namespace Batch {
+
+   /** @name Special functions on arrays
+    */
+
+  //@{
+
+  /**
+     Exponential function, result[i] = exp(x[i])
+     @ingroup BatchFunc
+  */
+  void exp(unsigned int n, const double * x, double * result);
+
+  /**
+     Natural logarithm, result[i] = log(x[i]).
+     For x = 0 -inf is returned, for x < 0 nan.
+     @ingroup BatchFunc
+  */
+  void log(unsigned int n, const double * x, double * result);
+
+  /**
+     Error function, see ROOT::Math::erf
+     @ingroup BatchFunc
+  */
+  void erf(unsigned int n, const double * x, double * result);
+
+  /**
+     Complementary error function, see ROOT::Math::erfc
+     @ingroup BatchFunc
+  */
+  void erfc(unsigned int n, const double * x, double * result);
+
+  /**
+     Logarithm of the gamma function, see ROOT::Math::lgamma
+     @ingroup BatchFunc
+  */
+  void lgamma(unsigned int n, const double * x, double * result);
+
+  //@}
+
+   /** @name Probability density functions on arrays
+    */
+
+  //@{
+
+  /**
+     Probability density function of the normal (Gaussian) distribution,
+     see ROOT::Math::normal_pdf
+     @ingroup BatchFunc
+  */
+  void normal_pdf(unsigned int n, const double * x, double * result, double sigma = 1, double x0 = 0);
+
+  /**
+     Probability density function of the lognormal distribution,
+     see ROOT::Math::lognormal_pdf
+     @ingroup BatchFunc
+  */
+  void lognormal_pdf(unsigned int n, const double * x, double * result, double m, double s, double x0 = 0);
+
+  /**
+     Probability density function of the gamma distribution,
+     see ROOT::Math::gamma_pdf
+     @ingroup BatchFunc
+  */
+  void gamma_pdf(unsigned int n, const double * x, double * result, double alpha, double theta, double x0 = 0);
+
+  /**
+     Probability density function of the \f$\chi^2\f$ distribution with \f$r\f$ degrees of freedom,
+     see ROOT::Math::chisquared_pdf
+     @ingroup BatchFunc
+  */
+  void chisquared_pdf(unsigned int n, const double * x, double * result, double r, double x0 = 0);
+
+  /**
+     Probability density function of the Poisson distribution for the
+     numbers of events k[i], see ROOT::Math::poisson_pdf
+     @ingroup BatchFunc
+  */
+  void poisson_pdf(unsigned int n, const unsigned int * k, double * result, double mu);
+
+  //@}
+
+   /** @name Cumulative distribution functions on arrays
+    */
+
+  //@{
+
+  /**
+     Cumulative distribution function (lower tail) of the normal (Gaussian) distribution,
+     see ROOT::Math::normal_cdf
+     @ingroup BatchFunc
+  */
+  void normal_cdf(unsigned int n, const double * x, double * result, double sigma = 1, double x0 = 0);
+
+  /**
+     Complement of the cumulative distribution function (upper tail) of the normal (Gaussian) distribution,
+     see ROOT::Math::normal_cdf_c
+     @ingroup BatchFunc
+  */
+  void normal_cdf_c(unsigned int n, const double * x, double * result, double sigma = 1, double x0 = 0);
+
+  /**
+     Cumulative distribution function (lower tail) of the lognormal distribution,
+     see ROOT::Math::lognormal_cdf
+     @ingroup BatchFunc
+  */
+  void lognormal_cdf(unsigned int n, const double * x, double * result, double m, double s, double x0 = 0);
+
+  /**
+     Cumulative distribution function (lower tail) of the gamma distribution,
+     see ROOT::Math::gamma_cdf
+     @ingroup BatchFunc
+  */
+  void gamma_cdf(unsigned int n, const double * x, double * result, double alpha, double theta, double x0 = 0);
+
+  /**
+     Cumulative distribution function (lower tail) of the \f$\chi^2\f$ distribution
+     with \f$r\f$ degrees of freedom, see ROOT::Math::chisquared_cdf
+     @ingroup BatchFunc
+  */
+  void chisquared_cdf(unsigned int n, const double * x, double * result, double r, double x0 = 0);
+
+  /**
+     Cumulative distribution function (lower tail) of the Poisson distribution
+     for the numbers of events k[i], see ROOT::Math::poisson_cdf
+     @ingroup BatchFunc
+  */
+  void poisson_cdf(unsigned int n, const unsigned int * k, double * result, double mu);
+
+  //@}
+
+} // end namespace Batch
+
+} // end namespace Math
+} // end namespace ROOT
+
+
+#endif // ROOT_Math_BatchFuncMathCore
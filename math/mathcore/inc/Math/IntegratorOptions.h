@@ -206,13 +206,15 @@ public:
 
    // copy constructor
    IntegratorMultiDimOptions(const IntegratorMultiDimOptions & rhs) :
-      BaseIntegratorOptions(rhs)
+      BaseIntegratorOptions(rhs),
+      fNThreads(rhs.fNThreads)
    {}
 
    // assignment operator
    IntegratorMultiDimOptions & operator=(const IntegratorMultiDimOptions & rhs) {
       if (this == &rhs) return *this;
       static_cast<BaseIntegratorOptions &>(*this) = rhs;
+      fNThreads = rhs.fNThreads;
       return *this;
    }
 
@@ -223,6 +225,12 @@ public:
    /// maximum number of function calls
    unsigned int NCalls() const { return fNCalls; }
 
+   /// set the number of threads used to evaluate the function (0 means all the available ones)
+   void SetNThreads(unsigned int n) { fNThreads = n; }
+
+   /// number of threads used to evaluate the function
+   unsigned int NThreads() const { return fNThreads; }
+
    /// name of multi-dim integrator
    std::string  Integrator() const;
 
@@ -242,6 +250,7 @@ public:
    static void SetDefaultRelTolerance(double tol);
    static void SetDefaultWKSize(unsigned int size);
    static void SetDefaultNCalls(unsigned int ncall);
+   static void SetDefaultNThreads(unsigned int n);
 
    static std::string DefaultIntegrator();
    static IntegrationMultiDim::Type DefaultIntegratorType();
@@ -249,6 +258,7 @@ public:
    static double DefaultRelTolerance();
    static unsigned int DefaultWKSize();
    static unsigned int DefaultNCalls();
+   static unsigned int DefaultNThreads();
 
    // retrieve specific options
    static ROOT::Math::IOptions & Default(const char * name);
@@ -262,6 +272,7 @@ public:
 
 private:
 
+   unsigned int fNThreads;      // number of threads used to evaluate the function
 
 };
 
@@ -50,13 +50,17 @@ public:
    Index   GetBucketSize() {return fBucketSize;}
 
    void    FindNearestNeighbors(const Value *point, Int_t k, Index *ind, Value *dist);
+   void    FindNearestNeighbors(Index nq, const Value *points, Int_t k, Index *ind, Value *dist);
    Index   FindNode(const Value * point) const;
    void    FindPoint(Value * point, Index &index, Int_t &iter);
    void    FindInRange(Value *point, Value range, std::vector<Index> &res);
+   Index   CountInRange(const Value *point, Value range);
+   void    CountInRange(Index nq, const Value *points, Value range, Index *counts);
    void    FindBNodeA(Value * point, Value * delta, Int_t &inode);
 
    Bool_t  IsTerminal(Index inode) const {return (inode>=fNNodes);}
    Int_t   IsOwner() { return fDataOwner; }
+   Int_t   GetNThreads() const { return fNThreads; }
    Value   KOrdStat(Index ntotal, Value *a, Index k, Index *index) const;
 
 
@@ -65,15 +69,21 @@ public:
    void    SetData(Index npoints, Index ndim, UInt_t bsize, Value **data);
    Int_t   SetData(Index idim, Value *data);
    void    SetOwner(Int_t owner) { fDataOwner = owner; }
+   void    SetNThreads(Int_t nthreads) { fNThreads = nthreads; }
    void    Spread(Index ntotal, Value *a, Index *index, Value &min, Value &max) const;
 
  private:
    TKDTree(const TKDTree &); // not implemented
    TKDTree<Index, Value>& operator=(const TKDTree<Index, Value>&); // not implemented
    void CookBoundaries(const Int_t node, Bool_t left);
+   void DivideNode(Int_t cnode, Int_t crow, Int_t cpos, Int_t npoints, Int_t &nleft, Int_t &nright);
+   void BuildSubtree(Int_t node, Int_t row, Int_t pos, Int_t npoints);
+   Int_t GetThreads() const;
 
-   void UpdateNearestNeighbors(Index inode, const Value *point, Int_t kNN, Index *ind, Value *dist);
    void UpdateRange(Index inode, Value *point, Value range, std::vector<Index> &res);
+   void SearchNearestNeighbors(Index inode, const Value *point, Int_t kNN, Index *ind, Double_t *dist2) const;
+   Index SearchRange(Index inode, const Value *point, Double_t range2) const;
+   Double_t DistanceToNode2(const Value *point, Index inode, Double_t &max2) const;
 
  protected:
    Int_t   fDataOwner;  //! 0 - not owner, 2 - owner of the pointer array, 1 - owner of the whole 2-d array
@@ -97,6 +107,7 @@ public:
    Int_t   fOffset;     //! offset in fIndPoints - if there are 2 rows, that contain terminal nodes
                         //  fOffset returns the index in the fIndPoints array of the first point
                         //  that belongs to the first node on the second row.
+   Int_t   fNThreads;   //! number of threads used by Build() and by the queries on arrays of points (0 - all available)
 
 
    ClassDef(TKDTree, 1)  // KD tree
@@ -0,0 +1,53 @@
+// @(#)root/mathcore:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2015, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TRandomPhilox
+#define ROOT_TRandomPhilox
+
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TRandomPhilox                                                        //
+//                                                                      //
+// counter-based random number generator Philox4x32-10                  //
+// (period 2**66 for each seed and stream)                              //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef ROOT_TRandom
+#include "TRandom.h"
+#endif
+
+class TRandomPhilox : public TRandom {
+
+protected:
+   UInt_t     fStream;     //Stream number (second word of the key)
+   ULong64_t  fCounter;    //Counter of the next block of 4 numbers
+   UInt_t     fBuffer[4];  //Last generated block
+   Int_t      fIndex;      //Index of the next number in the block
+
+   void       FillBuffer();
+
+public:
+   TRandomPhilox(UInt_t seed=1, UInt_t stream=0);
+   virtual ~TRandomPhilox();
+   virtual  UInt_t   GetStream() const {return fStream;}
+   virtual  Double_t Rndm(Int_t i=0);
+   virtual  void     RndmArray(Int_t n, Float_t *array);
+   virtual  void     RndmArray(Int_t n, Double_t *array);
+   virtual  void     SetSeed(UInt_t seed=0);
+   virtual  void     SetStream(UInt_t stream);
+   virtual  void     Skip(ULong64_t n);
+
+   ClassDef(TRandomPhilox,1)  //Counter-based random number generator Philox4x32-10
+};
+
+#endif
@@ -8,10 +8,87 @@
 
 #include <cmath>
 #include <algorithm>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace ROOT {
 namespace Math {
 
+namespace {
+
+   // generate the nodes of the integration rule of degree 7 for the region with center ctr and
+   // half-widths wth, in the order in which their function values are summed in DoIntegral
+   void GenerateRuleNodes(unsigned int n, const double * ctr, const double * wth, double * nodes)
+   {
+      static const double xl2 = 0.358568582800318073;//lambda_2
+      static const double xl4 = 0.948683298050513796;//lambda_4
+      static const double xl5 = 0.688247201611685289;//lambda_5
+
+      double * z = nodes;
+      // center
+      std::copy(ctr, ctr+n, z);
+      z += n;
+      // points on the axes
+      for (unsigned int j = 0; j < n; j++) {
+         const double d[4] = { -xl2*wth[j], xl2*wth[j], -(xl4*wth[j]), xl4*wth[j] };
+         for (unsigned int l = 0; l < 4; l++) {
+            std::copy(ctr, ctr+n, z);
+            z[j] = ctr[j] + d[l];
+            z += n;
+         }
+      }
+      // points on the planes of two coordinates
+      for (unsigned int j = 1; j < n; j++) {
+         for (unsigned int k = j; k < n; k++) {
+            for (unsigned int l = 0; l < 4; l++) {
+               std::copy(ctr, ctr+n, z);
+               z[j-1] = ctr[j-1] + ( (l < 2) ? -(xl4*wth[j-1]) : xl4*wth[j-1] );
+               z[k]   = ctr[k]   + ( (l % 2 == 0) ? -(xl4*wth[k]) : xl4*wth[k] );
+               z += n;
+            }
+         }
+      }
+      // end nodes (all combinations of the signs)
+      unsigned int nend = 1u << n;
+      for (unsigned int i = 0; i < nend; i++) {
+         for (unsigned int j = 0; j < n; j++)
+            z[j] = ctr[j] + ( ((i >> j) & 1) ? xl5*wth[j] : -(xl5*wth[j]) );
+         z += n;
+      }
+   }
+
+   // evaluate the function (or its absolute value) at npoints nodes of dimension n,
+   // made of consecutive rules of nrule nodes each.
+   // As in the original algorithm the value at the center of a rule (its first node)
+   // is never taken in absolute value.
+   // If more than one function is given (the copies used by the different threads)
+   // the points are distributed over the threads.
+   void EvalNodes(const std::vector<const IMultiGenFunction *> & funcs, unsigned int n, unsigned int npoints,
+                  unsigned int nrule, const double * nodes, double * fvalues, bool absValue)
+   {
+#ifdef _OPENMP
+      int nthreads = funcs.size();
+      if (nthreads > 1) {
+#pragma omp parallel for num_threads(nthreads) schedule(static)
+         for (int i = 0; i < int(npoints); ++i) {
+            double f = (*funcs[omp_get_thread_num()])(&nodes[i*n]);
+            fvalues[i] = (absValue && i % nrule != 0) ? std::abs(f) : f;
+         }
+         return;
+      }
+#endif
+      const IMultiGenFunction & func = *funcs[0];
+      for (unsigned int i = 0; i < npoints; ++i) {
+         double f = func(&nodes[i*n]);
+         fvalues[i] = (absValue && i % nrule != 0) ? std::abs(f) : f;
+      }
+   }
+
+}
+
 
 
 AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim(double absTol, double relTol, unsigned int maxpts, unsigned int size):
@@ -19,6 +96,7 @@ AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim(double absTol, double rel
    fMinPts(0),
    fMaxPts(maxpts),
    fSize(size),
+   fNThreads(ROOT::Math::IntegratorMultiDimOptions::DefaultNThreads()),
    fAbsTol(absTol),
    fRelTol(relTol),
    fResult(0),
@@ -39,6 +117,7 @@ AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim( const IMultiGenFunction
    fMinPts(0),
    fMaxPts(maxpts),
    fSize(size),
+   fNThreads(ROOT::Math::IntegratorMultiDimOptions::DefaultNThreads()),
    fAbsTol(absTol),
    fRelTol(relTol),
    fResult(0),
@@ -96,11 +175,8 @@ double AdaptiveIntegratorMultiDim::DoIntegral(const double* xmin, const double *
    double relerr; //an estimation of the relative accuracy of the result
 
 
-   double ctr[15], wth[15], wthl[15], z[15];
+   double ctr[15], wth[15];
 
-   static const double xl2 = 0.358568582800318073;//lambda_2
-   static const double xl4 = 0.948683298050513796;//lambda_4
-   static const double xl5 = 0.688247201611685289;//lambda_5
    static const double w2  = 980./6561; //weights/2^n
    static const double w4  = 200./19683;
    static const double wp2 = 245./486;//error weights/2^n
@@ -180,17 +256,30 @@ double AdaptiveIntegratorMultiDim::DoIntegral(const double* xmin, const double *
    double rgnvol, sum1, sum2, sum3, sum4, sum5, difmax, f2, f3, dif, aresult;
    double rgncmp=0, rgnval, rgnerr;
 
-   unsigned int j1, k, l, m, idvaxn=0, idvax0=0, isbtmp, isbtpp;
+   unsigned int k, idvaxn=0, idvax0=0, isbtmp, isbtpp;
+
+   // the nodes of the rule (irlcls points) of one region or of the two halves of a
+   // divided region and the corresponding function values
+   std::vector<double> nodes(2*irlcls*n);
+   std::vector<double> fvalues(2*irlcls);
+   const double * fv = &fvalues[0];   // function values of the current region
+
+   // each thread uses its own copy of the function
+   std::vector<const IMultiGenFunction *> funcs(1, fFun);
+#ifdef _OPENMP
+   unsigned int nthreads = (fNThreads == 0) ? omp_get_max_threads() : fNThreads;
+   for (unsigned int i = 1; i < nthreads; ++i) funcs.push_back(fFun->Clone());
+#endif
 
-   //InitArgs(z,fParams);
+   GenerateRuleNodes(n, ctr, wth, &nodes[0]);
+   EvalNodes(funcs, n, irlcls, irlcls, &nodes[0], &fvalues[0], absValue);
 
 L20:
    rgnvol = twondm;//=2^n
    for (j=0; j<n; j++) {
       rgnvol *= wth[j]; //region volume
-      z[j]    = ctr[j]; //temporary node
    }
-   sum1 = (*fFun)((const double*)z);//EvalPar(z,fParams); //evaluate function
+   sum1 = *fv++;  // value at the center
 
    difmax = 0;
    sum2   = 0;
@@ -198,19 +287,10 @@ L20:
 
    //loop over coordinates
    for (j=0; j<n; j++) {
-      z[j]    = ctr[j] - xl2*wth[j];
-      if (absValue) f2 = std::abs((*fFun)(z));
-      else          f2 = (*fFun)(z);
-      z[j]    = ctr[j] + xl2*wth[j];
-      if (absValue) f2 += std::abs((*fFun)(z));
-      else          f2 += (*fFun)(z);
-      wthl[j] = xl4*wth[j];
-      z[j]    = ctr[j] - wthl[j];
-      if (absValue) f3 = std::abs((*fFun)(z));
-      else          f3 = (*fFun)(z);
-      z[j]    = ctr[j] + wthl[j];
-      if (absValue) f3 += std::abs((*fFun)(z));
-      else          f3 += (*fFun)(z);
+      f2      = *fv++;
+      f2     += *fv++;
+      f3      = *fv++;
+      f3     += *fv++;
       sum2   += f2;//sum func eval with different weights separately
       sum3   += f3;//for a given region
       dif     = std::abs(7*f2-f3-12*sum1);
@@ -219,42 +299,16 @@ L20:
          difmax=dif;
          idvaxn=j+1;
       }
-      z[j]    = ctr[j];
    }
 
    sum4 = 0;
-   for (j=1;j<n;j++) {
-      j1 = j-1;
-      for (k=j;k<n;k++) {
-         for (l=0;l<2;l++) {
-            wthl[j1] = -wthl[j1];
-            z[j1]    = ctr[j1] + wthl[j1];
-            for (m=0;m<2;m++) {
-               wthl[k] = -wthl[k];
-               z[k]    = ctr[k] + wthl[k];
-               if (absValue) sum4 += std::abs((*fFun)(z));
-               else            sum4 += (*fFun)(z);
-            }
-         }
-         z[k] = ctr[k];
-      }
-      z[j1] = ctr[j1];
-   }
+   for (k = 0; k < 2*n*(n-1); k++)
+      sum4 += *fv++;
 
+   //sum over end nodes ~gray codes
    sum5 = 0;
-
-   for (j=0;j<n;j++) {
-      wthl[j] = -xl5*wth[j];
-      z[j] = ctr[j] + wthl[j];
-   }
-L90: //sum over end nodes ~gray codes
-   if (absValue) sum5 += std::abs((*fFun)(z));
-   else          sum5 += (*fFun)(z);
-   for (j=0;j<n;j++) {
-      wthl[j] = -wthl[j];
-      z[j] = ctr[j] + wthl[j];
-      if (wthl[j] > 0) goto L90;
-   }
+   for (k = 0; k < (unsigned int)(twondm); k++)
+      sum5 += *fv++;
 
    rgncmp  = rgnvol*(wpn1[n-2]*sum1+wp2*sum2+wpn3[n-2]*sum3+wp4*sum4);
    rgnval  = wn1[n-2]*sum1+w2*sum2+wn3[n-2]*sum3+w4*sum4+wn5[n-2]*sum5;
@@ -314,6 +368,7 @@ L160: //to divide or not
       ctr[idvax0-1] += 2*wth[idvax0-1];
       isbrgs += irgnst;//updating the number of nodes/regions(?)
       isbrgn  = isbrgs;
+      fv = &fvalues[irlcls];  // values of the second half
       goto L20;
    }
    //if no divisions to be made..
@@ -353,6 +408,14 @@ L160: //to divide or not
       }
       wth[idvax0-1]  = 0.5*wth[idvax0-1];
       ctr[idvax0-1] -= wth[idvax0-1];
+      // evaluate the function at the nodes of both halves
+      double ctr0 = ctr[idvax0-1];
+      GenerateRuleNodes(n, ctr, wth, &nodes[0]);
+      ctr[idvax0-1] += 2*wth[idvax0-1];
+      GenerateRuleNodes(n, ctr, wth, &nodes[n*irlcls]);
+      ctr[idvax0-1] = ctr0;
+      EvalNodes(funcs, n, 2*irlcls, irlcls, &nodes[0], &fvalues[0], absValue);
+      fv = &fvalues[0];
       goto L20;
    }
    nfnevl = ifncls;       //number of function evaluations performed.
@@ -361,6 +424,7 @@ L160: //to divide or not
    fRelError = relerr;
    fNEval = nfnevl;
    delete [] wk;
+   for (unsigned int i = 1; i < funcs.size(); ++i) delete funcs[i];
 
    return result;         //an approximate value of the integral
 }
@@ -382,6 +446,7 @@ ROOT::Math::IntegratorMultiDimOptions  AdaptiveIntegratorMultiDim::Options() con
    opt.SetRelTolerance(fRelTol);
    opt.SetNCalls(fMaxPts);
    opt.SetWKSize(fSize);
+   opt.SetNThreads(fNThreads);
    opt.SetIntegrator("ADAPTIVE");
    return opt;
 }
@@ -397,6 +462,7 @@ void AdaptiveIntegratorMultiDim::SetOptions(const ROOT::Math::IntegratorMultiDim
    SetRelTolerance( opt.RelTolerance() );
    SetMaxPts( opt.NCalls() );
    SetSize( opt.WKSize() );
+   SetNThreads( opt.NThreads() );
 }
 
 } // namespace Math
@@ -0,0 +1,226 @@
+// @(#)root/mathcore:$Id$
+
+// Implementation of the functions evaluated on arrays of numbers (namespace ROOT::Math::Batch)
+// The loops are written without branches (or with branches which can be converted by the
+// compiler in a selection) such that they can be vectorized.
+// When an intermediate result is needed (e.g. the error function for the cumulative
+// distributions) the arrays are processed in blocks of kBlock elements.
+
+
+#include "Math/BatchFuncMathCore.h"
+#include "Math/Math.h"
+#include "Math/SpecFuncMathCore.h"
+#include "Math/ProbFuncMathCore.h"
+#include "SpecFuncCephes.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#ifdef R__HAS_VDT
+#include "vdt/exp.h"
+#include "vdt/log.h"
+#endif
+
+
+namespace ROOT {
+namespace Math {
+
+namespace Batch {
+
+namespace {
+
+   // size of the blocks for the intermediate results
+   const unsigned int kBlock = 256;
+
+   static const double kSqrt2 = 1.41421356237309515; // sqrt(2.)
+
+   inline double VecExp(double x) {
+#ifdef R__HAS_VDT
+      return vdt::fast_exp(x);
+#else
+      return std::exp(x);
+#endif
+   }
+
+   inline double VecLog(double x) {
+#ifdef R__HAS_VDT
+      // VDT does not treat the values x <= 0
+      double y = vdt::fast_log(x);
+      if (!(x > 0)) y = (x == 0) ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::quiet_NaN();
+      return y;
+#else
+      return std::log(x);
+#endif
+   }
+
+   // table of log(k!) for the Poisson probabilities, computed with the same function
+   // used by ROOT::Math::poisson_pdf
+   struct LogFactorialTable {
+      enum { kSize = 1024 };
+      double fValues[kSize];
+      LogFactorialTable() {
+         for (unsigned int k = 0; k < kSize; ++k) fValues[k] = ROOT::Math::lgamma(k + 1.);
+      }
+   };
+
+   inline double LogFactorial(unsigned int k) {
+      static const LogFactorialTable table;
+      return (k < LogFactorialTable::kSize) ? table.fValues[k] : ROOT::Math::lgamma(k + 1.);
+   }
+
+}
+
+void exp(unsigned int n, const double * x, double * result)
+{
+   for (unsigned int i = 0; i < n; ++i)
+      result[i] = VecExp(x[i]);
+}
+
+void log(unsigned int n, const double * x, double * result)
+{
+   for (unsigned int i = 0; i < n; ++i)
+      result[i] = VecLog(x[i]);
+}
+
+void erf(unsigned int n, const double * x, double * result)
+{
+   ROOT::Math::Cephes::erf(n, x, result);
+}
+
+void erfc(unsigned int n, const double * x, double * result)
+{
+   ROOT::Math::Cephes::erfc(n, x, result);
+}
+
+void lgamma(unsigned int n, const double * x, double * result)
+{
+   ROOT::Math::Cephes::lgam(n, x, result);
+}
+
+void normal_pdf(unsigned int n, const double * x, double * result, double sigma, double x0)
+{
+   const double norm = 1.0/(std::sqrt(2 * M_PI) * std::fabs(sigma));
+   for (unsigned int i = 0; i < n; ++i) {
+      double tmp = (x[i]-x0)/sigma;
+      result[i] = norm * VecExp(-tmp*tmp/2);
+   }
+}
+
+void lognormal_pdf(unsigned int n, const double * x, double * result, double m, double s, double x0)
+{
+   const double norm = 1.0/(std::fabs(s) * std::sqrt(2 * M_PI));
+   for (unsigned int i = 0; i < n; ++i) {
+      double d = x[i] - x0;
+      // use a valid argument for the elements which are not computed
+      double tmp = (VecLog( (d > 0) ? d : 1.) - m)/s;
+      double y = norm / d * VecExp(-(tmp * tmp) /2);
+      result[i] = (d <= 0) ? 0.0 : y;
+   }
+}
+
+void gamma_pdf(unsigned int n, const double * x, double * result, double alpha, double theta, double x0)
+{
+   const double lg = ROOT::Math::lgamma(alpha);
+   // value for x = x0
+   const double y0 = (alpha == 1) ? 1.0/theta : 0.0;
+   for (unsigned int i = 0; i < n; ++i) {
+      double d = (x[i]-x0)/theta;
+      double y = VecExp((alpha - 1) * VecLog( (d > 0) ? d : 1.) - d - lg)/theta;
+      result[i] = (d < 0) ? 0.0 : ( (d == 0) ? y0 : y );
+   }
+}
+
+void chisquared_pdf(unsigned int n, const double * x, double * result, double r, double x0)
+{
+   const double lg = ROOT::Math::lgamma(r/2);
+   const double a = r/2 - 1.;
+   for (unsigned int i = 0; i < n; ++i) {
+      double d = x[i] - x0;
+      double y = VecExp(a * VecLog(d/2) - d/2 - lg)/2;
+      // special case of r = 2 (otherwise will return nan)
+      if (d == 0 && a == 0) y = 0.5;
+      result[i] = (d < 0) ? 0.0 : y;
+   }
+}
+
+void poisson_pdf(unsigned int n, const unsigned int * k, double * result, double mu)
+{
+   const double logmu = std::log(mu);
+   // when  k = 0 and mu = 0,  1 is returned and a nan for mu < 0
+   const double p0 = (mu >= 0) ? std::exp(-mu) : std::log(mu);
+   double lf[kBlock];
+   for (unsigned int i = 0; i < n; i += kBlock) {
+      unsigned int m = std::min(kBlock, n - i);
+      for (unsigned int j = 0; j < m; ++j) lf[j] = LogFactorial(k[i+j]);
+      for (unsigned int j = 0; j < m; ++j) {
+         double y = VecExp(k[i+j]*logmu - lf[j] - mu);
+         result[i+j] = (k[i+j] > 0) ? y : p0;
+      }
+   }
+}
+
+// the normal cumulative distributions are computed from the complementary error function only,
+// using 1 + erf(z) = erfc(-z)
+
+void normal_cdf(unsigned int n, const double * x, double * result, double sigma, double x0)
+{
+   double z[kBlock];
+   for (unsigned int i = 0; i < n; i += kBlock) {
+      unsigned int m = std::min(kBlock, n - i);
+      for (unsigned int j = 0; j < m; ++j)
+         z[j] = -(x[i+j]-x0)/(sigma*kSqrt2);
+      ROOT::Math::Cephes::erfc(m, z, &result[i]);
+      for (unsigned int j = 0; j < m; ++j)
+         result[i+j] *= 0.5;
+   }
+}
+
+void normal_cdf_c(unsigned int n, const double * x, double * result, double sigma, double x0)
+{
+   double z[kBlock];
+   for (unsigned int i = 0; i < n; i += kBlock) {
+      unsigned int m = std::min(kBlock, n - i);
+      for (unsigned int j = 0; j < m; ++j)
+         z[j] = (x[i+j]-x0)/(sigma*kSqrt2);
+      ROOT::Math::Cephes::erfc(m, z, &result[i]);
+      for (unsigned int j = 0; j < m; ++j)
+         result[i+j] *= 0.5;
+   }
+}
+
+void lognormal_cdf(unsigned int n, const double * x, double * result, double m, double s, double x0)
+{
+   double z[kBlock];
+   for (unsigned int i = 0; i < n; i += kBlock) {
+      unsigned int nb = std::min(kBlock, n - i);
+      for (unsigned int j = 0; j < nb; ++j)
+         z[j] = -(VecLog(x[i+j]-x0)-m)/(s*kSqrt2);
+      ROOT::Math::Cephes::erfc(nb, z, &result[i]);
+      for (unsigned int j = 0; j < nb; ++j)
+         result[i+j] *= 0.5;
+   }
+}
+
+void gamma_cdf(unsigned int n, const double * x, double * result, double alpha, double theta, double x0)
+{
+   for (unsigned int i = 0; i < n; ++i)
+      result[i] = ROOT::Math::gamma_cdf(x[i], alpha, theta, x0);
+}
+
+void chisquared_cdf(unsigned int n, const double * x, double * result, double r, double x0)
+{
+   for (unsigned int i = 0; i < n; ++i)
+      result[i] = ROOT::Math::chisquared_cdf(x[i], r, x0);
+}
+
+void poisson_cdf(unsigned int n, const unsigned int * k, double * result, double mu)
+{
+   for (unsigned int i = 0; i < n; ++i)
+      result[i] = ROOT::Math::poisson_cdf(k[i], mu);
+}
+
+} // end namespace Batch
+
+} // end namespace Math
+} // end namespace ROOT
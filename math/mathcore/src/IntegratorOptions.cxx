@@ -51,6 +51,7 @@ namespace IntegMultiDim {
    static double gDefaultRelTolerance = 1.E-09;
    static unsigned int gDefaultWKSize = 100000;
    static unsigned int gDefaultNCalls = 100000;
+   static unsigned int gDefaultNThreads = 1;
 
 
 }
@@ -280,7 +281,8 @@ IOptions * IntegratorOneDimOptions::FindDefault(const char * algo) {
 /////////////////////////////////////////////////////////
 
 IntegratorMultiDimOptions::IntegratorMultiDimOptions(IOptions * opts):
-   BaseIntegratorOptions()
+   BaseIntegratorOptions(),
+   fNThreads(IntegMultiDim::gDefaultNThreads)
 {
    fWKSize       = IntegMultiDim::gDefaultWKSize;
    fNCalls       = IntegMultiDim::gDefaultNCalls;
@@ -310,6 +312,8 @@ std::string IntegratorMultiDimOptions::Integrator() const {
 void IntegratorMultiDimOptions::Print(std::ostream & os) const {
    //print all the options
    IntegOptionsUtil::Print(os, *this);
+   if (fNThreads != 1)
+      os << std::setw(25) << "Number of threads"      << " : " << std::setw(15) << fNThreads << std::endl;
 }
 
 // multi dim integrator options:  implementation for static methods
@@ -357,12 +361,17 @@ void IntegratorMultiDimOptions::SetDefaultNCalls(unsigned int ncall) {
    // set the default (max) function calls
    IntegMultiDim::gDefaultNCalls = ncall;
 }
+void IntegratorMultiDimOptions::SetDefaultNThreads(unsigned int n) {
+   // set the default number of threads used to evaluate the function (0 = all available)
+   IntegMultiDim::gDefaultNThreads = n;
+}
 
 
 double IntegratorMultiDimOptions::DefaultAbsTolerance()        { return IntegMultiDim::gDefaultAbsTolerance; }
 double IntegratorMultiDimOptions::DefaultRelTolerance()        { return IntegMultiDim::gDefaultRelTolerance; }
 unsigned int IntegratorMultiDimOptions::DefaultWKSize()        { return IntegMultiDim::gDefaultWKSize; }
 unsigned int IntegratorMultiDimOptions::DefaultNCalls()        { return IntegMultiDim::gDefaultNCalls; }
+unsigned int IntegratorMultiDimOptions::DefaultNThreads()      { return IntegMultiDim::gDefaultNThreads; }
 
 
 IOptions & IntegratorMultiDimOptions::Default(const char * algo) {
@@ -14,6 +14,12 @@
 #include <cmath>
 
 #include <limits>
+#include <algorithm>
+
+#ifdef R__HAS_VDT
+#include "vdt/exp.h"
+#include "vdt/log.h"
+#endif
 
 
 
@@ -935,6 +941,119 @@ double erf( double x)
 
 }
 
+/*---------------------------------------------------------------------------*/
+/* versions for arrays of numbers */
+/* The branches of the scalar functions are replaced by a selection between   */
+/* the results of the different approximations, which are computed for all   */
+/* the elements, such that the loops can be vectorized by the compiler.       */
+/* The exponential and the logarithm from VDT are used when available.        */
+
+namespace {
+
+   // polynomial a[0]x^N+a[1]x^(N-1) + ... + a[N] (as Polynomialeval)
+   template <unsigned int N>
+   inline double PolEval(double x, const double * a) {
+      double pom = a[0];
+      for (unsigned int i = 1; i <= N; i++)
+         pom = pom * x + a[i];
+      return pom;
+   }
+
+   // polynomial x^N+a[0]x^(N-1) + ... + a[N-1] (as Polynomial1eval)
+   template <unsigned int N>
+   inline double Pol1Eval(double x, const double * a) {
+      double pom = x + a[0];
+      for (unsigned int i = 1; i < N; i++)
+         pom = pom * x + a[i];
+      return pom;
+   }
+
+   inline double VecExp(double x) {
+#ifdef R__HAS_VDT
+      return vdt::fast_exp(x);
+#else
+      return std::exp(x);
+#endif
+   }
+
+   inline double VecLog(double x) {
+#ifdef R__HAS_VDT
+      return vdt::fast_log(x);
+#else
+      return std::log(x);
+#endif
+   }
+
+   // erf(x) for |x| <= 1 (small = true) and erfc(|x|) for |x| > 1.
+   // The rational approximations of both cases are computed and the numerator
+   // and the denominator are selected, such that only one division is done.
+   inline double ErfOrErfc(double x, bool small) {
+      double ax = std::abs(x);
+      double z = x * x;
+      double ns = x * PolEval<4>(z, erfT);
+      double ds = Pol1Eval<5>(z, erfU);
+      double e = VecExp(-z);
+      // the argument of the polynomials is limited to avoid inf/inf
+      // (erfc is anyway zero in double precision for |x| > 27.3)
+      double px = std::min(ax, 30.);
+      double p = (ax < 8.0) ? PolEval<8>(px, erfP) : PolEval<5>(px, erfR);
+      double q = (ax < 8.0) ? Pol1Eval<8>(px, erfQ) : Pol1Eval<6>(px, erfS);
+      return (small ? ns : e * p) / (small ? ds : q);
+   }
+
+}
+
+void erf( unsigned int n, const double * x, double * y )
+{
+#ifndef R__HAS_VDT
+   // the loop cannot be vectorized with the exponential of the standard library
+   for (unsigned int i = 0; i < n; ++i)
+      y[i] = erf(x[i]);
+#else
+   for (unsigned int i = 0; i < n; ++i) {
+      bool small = !(std::abs(x[i]) > 1.0);
+      double r = ErfOrErfc(x[i], small);
+      double c = (x[i] < 0) ? 2.0 - r : r;
+      y[i] = small ? r : 1.0 - c;
+   }
+#endif
+}
+
+void erfc( unsigned int n, const double * x, double * y )
+{
+#ifndef R__HAS_VDT
+   for (unsigned int i = 0; i < n; ++i)
+      y[i] = erfc(x[i]);
+#else
+   for (unsigned int i = 0; i < n; ++i) {
+      bool small = std::abs(x[i]) < 1.0;
+      double r = ErfOrErfc(x[i], small);
+      double c = (x[i] < 0) ? 2.0 - r : r;
+      y[i] = small ? 1.0 - r : c;
+   }
+#endif
+}
+
+void lgam( unsigned int n, const double * x, double * y )
+{
+   // Stirling's formula for x >= 13, computed for all the elements
+   for (unsigned int i = 0; i < n; ++i) {
+      double xx = std::max(x[i], 13.0);
+      double q = ( xx - 0.5 ) * VecLog(xx) - xx + LS2PI;
+      double p = 1.0/(xx*xx);
+      double corr = (xx >= 1000.0) ?
+         ((   7.9365079365079365079365e-4 * p
+              - 2.7777777777777777777778e-3) *p
+          + 0.0833333333333333333333) / xx :  PolEval<4>( p, A ) / xx;
+      y[i] = (xx > 1.0e8) ? q : q + corr;
+   }
+   // the other values (x < 13, very large values and nan) with the scalar function
+   for (unsigned int i = 0; i < n; ++i) {
+      if ( !(x[i] >= 13.0) || x[i] > kMAXLGM )
+         y[i] = lgam(x[i]);
+   }
+}
+
 } // end namespace Cephes
 
 
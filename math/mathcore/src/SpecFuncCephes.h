@@ -84,6 +84,18 @@ double erf( double a );
 /* complementary error function */
 double erfc( double a );
 
+// versions for arrays of n numbers (y[i] = f(x[i]))
+// written such that the loops can be vectorized by the compiler
+
+/* logarithm of gamma function */
+void lgam( unsigned int n, const double * x, double * y );
+
+/* error function */
+void erf( unsigned int n, const double * x, double * y );
+
+/* complementary error function */
+void erfc( unsigned int n, const double * x, double * y );
+
 
 // inverse function
 
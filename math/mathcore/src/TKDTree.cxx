@@ -16,8 +16,28 @@
 #include <string.h>
 #include <limits>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 templateClassImp(TKDTree)
 
+namespace {
+
+   // subtree still to be built: first node, row of the node, position of its points
+   // in the index array and number of points
+   struct KDSubtree {
+      Int_t fNode;
+      Int_t fRow;
+      Int_t fPos;
+      Int_t fNPoints;
+   };
+
+   // number of queries given at a time to a thread by the functions working on arrays of points
+   const Int_t kQueryTile = 64;
+
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //
@@ -240,6 +260,19 @@ templateClassImp(TKDTree)
 // The nodes are arranged in the order described in section 3a.
 //
 //
+// 5. Parallel build and queries on arrays of points
+//
+// The subtrees of the kd-tree are independent: they are built on different parts of the index
+// array and fill different nodes. If ROOT is built with OpenMP and SetNThreads(n) is called with
+// n different from 1 (0 means all the available threads), Build() divides serially the first
+// rows of the tree and then builds the remaining subtrees in parallel. The tree is identical to
+// the one built with a single thread.
+// The functions FindNearestNeighbors(nq, points, k, ind, dist) and CountInRange(nq, points, range, counts)
+// process an array of nq query points (stored row-wise: the coordinates of the first point, then
+// the ones of the second point, ...), distributing them over the threads in tiles of consecutive
+// points. The results are the same as the ones obtained querying the points one by one.
+// The searches use the squared distances and the exact boundaries of the nodes (see MakeBoundariesExact).
+//
 // Note: the storage of the TKDTree in a file which include also the contained data is not
 //       supported. One must store the data separatly in a file (e.g. using a TTree) and then
 //       re-creating the TKDTree from the data, after having read them from the file
@@ -268,6 +301,7 @@ TKDTree<Index, Value>::TKDTree() :
    ,fRowT0(0)
    ,fCrossNode(0)
    ,fOffset(0)
+   ,fNThreads(1)
 {
 }
 
@@ -290,6 +324,7 @@ TKDTree<Index, Value>::TKDTree(Index npoints, Index ndim, UInt_t bsize) :
    ,fRowT0(0)
    ,fCrossNode(0)
    ,fOffset(0)
+   ,fNThreads(1)
 {
 // Create the kd-tree of npoints from ndim-dimensional space. Parameter bsize stands for the
 // maximal number of points in the terminal nodes (buckets).
@@ -342,6 +377,7 @@ TKDTree<Index, Value>::TKDTree(Index npoints, Index ndim, UInt_t bsize, Value **
    ,fRowT0(0)
    ,fCrossNode(0)
    ,fOffset(0)
+   ,fNThreads(1)
 {
 
    //Build();
@@ -432,76 +468,71 @@ void TKDTree<Index, Value>::Build()
    //
    //
    //4.
+   Int_t nthreads = GetThreads();
+   if (nthreads <= 1) {
+      BuildSubtree(0, 0, 0, fNPoints);
+      return;
+   }
+   // divide serially the first rows until there are enough subtrees for the threads.
+   // The subtrees use different parts of fIndPoints and fill different nodes, so they
+   // can be built in parallel
+   std::vector<KDSubtree> subtrees(1), next;
+   subtrees[0].fNode = 0;
+   subtrees[0].fRow = 0;
+   subtrees[0].fPos = 0;
+   subtrees[0].fNPoints = fNPoints;
+   while (!subtrees.empty() && Int_t(subtrees.size()) < 8*nthreads) {
+      next.clear();
+      for (UInt_t i = 0; i < subtrees.size(); i++) {
+         const KDSubtree &st = subtrees[i];
+         if (st.fNPoints <= fBucketSize) continue; // terminal node
+         Int_t nleft = 0, nright = 0;
+         DivideNode(st.fNode, st.fRow, st.fPos, st.fNPoints, nleft, nright);
+         KDSubtree left  = { st.fNode*2+1, st.fRow+1, st.fPos,       nleft  };
+         KDSubtree right = { st.fNode*2+2, st.fRow+1, st.fPos+nleft, nright };
+         next.push_back(left);
+         next.push_back(right);
+      }
+      subtrees.swap(next);
+   }
+   Int_t nsubtrees = subtrees.size();
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic,1)
+#endif
+   for (Int_t i = 0; i < nsubtrees; i++)
+      BuildSubtree(subtrees[i].fNode, subtrees[i].fRow, subtrees[i].fPos, subtrees[i].fNPoints);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the subtree starting from the node with the given row, using npoints
+/// points starting from the position pos in the index array (non recursive)
+
+template <typename  Index, typename Value>
+void TKDTree<Index, Value>::BuildSubtree(Int_t node, Int_t row, Int_t pos, Int_t npoints)
+{
    //    stack for non recursive build - size 128 bytes enough
    Int_t rowStack[128];
    Int_t nodeStack[128];
    Int_t npointStack[128];
    Int_t posStack[128];
    Int_t currentIndex = 0;
-   Int_t iter =0;
-   rowStack[0]    = 0;
-   nodeStack[0]   = 0;
-   npointStack[0] = fNPoints;
-   posStack[0]   = 0;
+   rowStack[0]    = row;
+   nodeStack[0]   = node;
+   npointStack[0] = npoints;
+   posStack[0]    = pos;
    //
-   Int_t nbucketsall =0;
    while (currentIndex>=0){
-      iter++;
       //
-      Int_t npoints  = npointStack[currentIndex];
-      if (npoints<=fBucketSize) {
-         //printf("terminal node : index %d iter %d\n", currentIndex, iter);
+      Int_t cnpoints = npointStack[currentIndex];
+      if (cnpoints<=fBucketSize) {
          currentIndex--;
-         nbucketsall++;
          continue; // terminal node
       }
       Int_t crow     = rowStack[currentIndex];
       Int_t cpos     = posStack[currentIndex];
       Int_t cnode    = nodeStack[currentIndex];
-      //printf("currentIndex %d npoints %d node %d\n", currentIndex, npoints, cnode);
-      //
-      // divide points
-      Int_t nbuckets0 = npoints/fBucketSize;           //current number of  buckets
-      if (npoints%fBucketSize) nbuckets0++;            //
-      Int_t restRows = fRowT0-rowStack[currentIndex];  // rest of fully occupied node row
-      if (restRows<0) restRows =0;
-      for (;nbuckets0>(2<<restRows); restRows++) {}
-      Int_t nfull = 1<<restRows;
-      Int_t nrest = nbuckets0-nfull;
-      Int_t nleft =0, nright =0;
-      //
-      if (nrest>(nfull/2)){
-         nleft  = nfull*fBucketSize;
-         nright = npoints-nleft;
-      }else{
-         nright = nfull*fBucketSize/2;
-         nleft  = npoints-nright;
-      }
-
-      //
-      //find the axis with biggest spread
-      Value maxspread=0;
-      Value tempspread, min, max;
-      Index axspread=0;
-      Value *array;
-      for (Int_t idim=0; idim<fNDim; idim++){
-         array = fData[idim];
-         Spread(npoints, array, fIndPoints+cpos, min, max);
-         tempspread = max - min;
-         if (maxspread < tempspread) {
-            maxspread=tempspread;
-            axspread = idim;
-         }
-         if(cnode) continue;
-         //printf("set %d %6.3f %6.3f\n", idim, min, max);
-         fRange[2*idim] = min; fRange[2*idim+1] = max;
-      }
-      array = fData[axspread];
-      KOrdStat(npoints, array, nleft, fIndPoints+cpos);
-      fAxis[cnode]  = axspread;
-      fValue[cnode] = array[fIndPoints[cpos+nleft]];
-      //printf("Set node %d : ax %d val %f\n", cnode, node->fAxis, node->fValue);
-      //
+      Int_t nleft = 0, nright = 0;
+      DivideNode(cnode, crow, cpos, cnpoints, nleft, nright);
       //
       npointStack[currentIndex] = nleft;
       rowStack[currentIndex]    = crow+1;
@@ -512,20 +543,78 @@ void TKDTree<Index, Value>::Build()
       rowStack[currentIndex]    = crow+1;
       posStack[currentIndex]    = cpos+nleft;
       nodeStack[currentIndex]   = (cnode*2)+2;
-      //
-      if (0){
-         // consistency check
-         Info("Build()", "%s", Form("points %d left %d right %d", npoints, nleft, nright));
-         if (nleft<nright) Warning("Build", "Problem Left-Right");
-         if (nleft<0 || nright<0) Warning("Build()", "Problem Negative number");
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Divide the npoints points of the node cnode (in row crow) starting at position
+/// cpos of the index array: set the axis and the value of the node and return the
+/// number of points of the left and right daughters.
+/// See class description, section 4b for the details of the division alogrithm
+
+template <typename  Index, typename Value>
+void TKDTree<Index, Value>::DivideNode(Int_t cnode, Int_t crow, Int_t cpos, Int_t npoints, Int_t &nleft, Int_t &nright)
+{
+   // divide points
+   Int_t nbuckets0 = npoints/fBucketSize;           //current number of  buckets
+   if (npoints%fBucketSize) nbuckets0++;            //
+   Int_t restRows = fRowT0-crow;                    // rest of fully occupied node row
+   if (restRows<0) restRows =0;
+   for (;nbuckets0>(2<<restRows); restRows++) {}
+   Int_t nfull = 1<<restRows;
+   Int_t nrest = nbuckets0-nfull;
+   //
+   if (nrest>(nfull/2)){
+      nleft  = nfull*fBucketSize;
+      nright = npoints-nleft;
+   }else{
+      nright = nfull*fBucketSize/2;
+      nleft  = npoints-nright;
+   }
+
+   //
+   //find the axis with biggest spread
+   Value maxspread=0;
+   Value tempspread, min, max;
+   Index axspread=0;
+   Value *array;
+   for (Int_t idim=0; idim<fNDim; idim++){
+      array = fData[idim];
+      Spread(npoints, array, fIndPoints+cpos, min, max);
+      tempspread = max - min;
+      if (maxspread < tempspread) {
+         maxspread=tempspread;
+         axspread = idim;
       }
+      if(cnode) continue;
+      //printf("set %d %6.3f %6.3f\n", idim, min, max);
+      fRange[2*idim] = min; fRange[2*idim+1] = max;
    }
+   array = fData[axspread];
+   KOrdStat(npoints, array, nleft, fIndPoints+cpos);
+   fAxis[cnode]  = axspread;
+   fValue[cnode] = array[fIndPoints[cpos+nleft]];
+   //printf("Set node %d : ax %d val %f\n", cnode, node->fAxis, node->fValue);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of threads used by Build() and by the queries on arrays of points
+
+template <typename  Index, typename Value>
+Int_t TKDTree<Index, Value>::GetThreads() const
+{
+#ifdef _OPENMP
+   return (fNThreads > 0) ? fNThreads : omp_get_max_threads();
+#else
+   return 1;
+#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 ///Find kNN nearest neighbors to the point in the first argument
-///Returns 1 on success, 0 on failure
 ///Arrays ind and dist are provided by the user and are assumed to be at least kNN elements long
+///The neighbors are sorted by increasing distance. If the tree has less than kNN points,
+///the remaining elements of ind are set to -1.
 
 template <typename  Index, typename Value>
 void TKDTree<Index, Value>::FindNearestNeighbors(const Value *point, const Int_t kNN, Index *ind, Value *dist)
@@ -535,61 +624,126 @@ void TKDTree<Index, Value>::FindNearestNeighbors(const Value *point, const Int_t
       Error("FindNearestNeighbors", "Working arrays must be allocated by the user!");
       return;
    }
-   for (Int_t i=0; i<kNN; i++){
-      dist[i]=std::numeric_limits<Value>::max();
-      ind[i]=-1;
+   if (kNN <= 0) return;
+   MakeBoundariesExact();
+   std::vector<Double_t> dist2(kNN, std::numeric_limits<Double_t>::max());
+   for (Int_t i=0; i<kNN; i++) ind[i]=-1;
+   SearchNearestNeighbors(0, point, kNN, ind, &dist2[0]);
+   for (Int_t i=0; i<kNN; i++)
+      dist[i] = (ind[i] >= 0) ? TMath::Sqrt(dist2[i]) : std::numeric_limits<Value>::max();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///Find the kNN nearest neighbors of the nq points in the array points, stored row-wise
+///(points[iq*ndim + idim] is the coordinate idim of the point iq).
+///The indices and the distances of the neighbors of the point iq are returned in
+///ind[iq*kNN + i] and dist[iq*kNN + i], i = 0,...,kNN-1, as in the function for a single point.
+///The points are distributed over the threads (see SetNThreads) in tiles of consecutive points.
+
+template <typename  Index, typename Value>
+void TKDTree<Index, Value>::FindNearestNeighbors(Index nq, const Value *points, const Int_t kNN, Index *ind, Value *dist)
+{
+   if (!ind || !dist) {
+      Error("FindNearestNeighbors", "Working arrays must be allocated by the user!");
+      return;
    }
+   if (kNN <= 0) return;
+   // the boundaries must exist before the parallel region, which only reads the tree
    MakeBoundariesExact();
-   UpdateNearestNeighbors(0, point, kNN, ind, dist);
 
+#ifdef _OPENMP
+#pragma omp parallel num_threads(GetThreads())
+#endif
+   {
+      std::vector<Double_t> dist2(kNN);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic,kQueryTile)
+#endif
+      for (Index iq = 0; iq < nq; iq++) {
+         Index *qind = ind + ULong64_t(iq)*kNN;
+         Value *qdist = dist + ULong64_t(iq)*kNN;
+         for (Int_t i=0; i<kNN; i++) {
+            dist2[i] = std::numeric_limits<Double_t>::max();
+            qind[i] = -1;
+         }
+         SearchNearestNeighbors(0, points + ULong64_t(iq)*fNDim, kNN, qind, &dist2[0]);
+         for (Int_t i=0; i<kNN; i++)
+            qdist[i] = (qind[i] >= 0) ? TMath::Sqrt(dist2[i]) : std::numeric_limits<Value>::max();
+      }
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-///Update the nearest neighbors values by examining the node inode
+///Update the nearest neighbors (with squared distances dist2) by examining the node inode.
+///The exact boundaries of the nodes must have been built.
 
 template <typename Index, typename Value>
-void TKDTree<Index, Value>::UpdateNearestNeighbors(Index inode, const Value *point, Int_t kNN, Index *ind, Value *dist)
+void TKDTree<Index, Value>::SearchNearestNeighbors(Index inode, const Value *point, Int_t kNN, Index *ind, Double_t *dist2) const
 {
-   Value min=0;
-   Value max=0;
-   DistanceToNode(point, inode, min, max);
-   if (min > dist[kNN-1]){
+   Double_t max2;
+   if (DistanceToNode2(point, inode, max2) > dist2[kNN-1]){
       //there are no closer points in this node
       return;
    }
    if (IsTerminal(inode)) {
       //examine points one by one
-      Index f1, l1, f2, l2;
-      GetNodePointsIndexes(inode, f1, l1, f2, l2);
-      for (Int_t ipoint=f1; ipoint<=l1; ipoint++){
-         Double_t d = Distance(point, fIndPoints[ipoint]);
-         if (d<dist[kNN-1]){
+      Index first = (inode >= fCrossNode) ? (inode-fCrossNode)*fBucketSize : fOffset+(inode-fNNodes)*fBucketSize;
+      Index last = first + GetNPointsNode(inode);
+      for (Index ipoint=first; ipoint<last; ipoint++){
+         Index ip = fIndPoints[ipoint];
+         Double_t d = 0;
+         for (Index idim=0; idim<fNDim; idim++){
+            Double_t dx = Double_t(point[idim]) - fData[idim][ip];
+            d += dx*dx;
+         }
+         if (d<dist2[kNN-1]){
             //found a closer point
             Int_t ishift=0;
-            while(ishift<kNN && d>dist[ishift])
+            while(ishift<kNN && d>dist2[ishift])
                ishift++;
             //replace the neighbor #ishift with the found point
             //and shift the rest 1 index value to the right
             for (Int_t i=kNN-1; i>ishift; i--){
-               dist[i]=dist[i-1];
+               dist2[i]=dist2[i-1];
                ind[i]=ind[i-1];
             }
-            dist[ishift]=d;
-            ind[ishift]=fIndPoints[ipoint];
+            dist2[ishift]=d;
+            ind[ishift]=ip;
          }
       }
       return;
    }
    if (point[fAxis[inode]]<fValue[inode]){
       //first examine the node that contains the point
-      UpdateNearestNeighbors(GetLeft(inode), point, kNN, ind, dist);
-      UpdateNearestNeighbors(GetRight(inode), point, kNN, ind, dist);
+      SearchNearestNeighbors(GetLeft(inode), point, kNN, ind, dist2);
+      SearchNearestNeighbors(GetRight(inode), point, kNN, ind, dist2);
    } else {
-      UpdateNearestNeighbors(GetRight(inode), point, kNN, ind, dist);
-      UpdateNearestNeighbors(GetLeft(inode), point, kNN, ind, dist);
+      SearchNearestNeighbors(GetRight(inode), point, kNN, ind, dist2);
+      SearchNearestNeighbors(GetLeft(inode), point, kNN, ind, dist2);
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///Return the minimal squared L2 distance from the point to the node inode, computed using
+///the exact boundaries of the node (which must have been built), and the maximal one in max2.
+///The squared distance computed for any point of the node is within these two values.
+
+template <typename Index, typename Value>
+Double_t TKDTree<Index, Value>::DistanceToNode2(const Value *point, Index inode, Double_t &max2) const
+{
+   const Value *bound = &fBoundaries[inode*fNDimm];
+   Double_t min2 = 0;
+   max2 = 0;
+   for (Index idim=0; idim<fNDim; idim++){
+      Double_t dlow  = Double_t(point[idim]) - bound[2*idim];
+      Double_t dhigh = Double_t(bound[2*idim+1]) - point[idim];
+      if (dlow < 0) min2 += dlow*dlow;
+      else if (dhigh < 0) min2 += dhigh*dhigh;
+      max2 += (dlow*dlow > dhigh*dhigh) ? dlow*dlow : dhigh*dhigh;
+   }
+   return min2;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///Find the distance between point of the first argument and the point at index value ind
 ///Type argument specifies the metric: type=2 - L2 metric, type=1 - L1 metric
@@ -791,6 +945,71 @@ void TKDTree<Index, Value>::UpdateRange(Index inode, Value* point, Value range,
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///Return the number of points at a distance smaller or equal than range from the given point.
+///The points are not examined one by one in the nodes which are completely inside the range.
+
+template <typename  Index, typename Value>
+Index TKDTree<Index, Value>::CountInRange(const Value *point, Value range)
+{
+   MakeBoundariesExact();
+   return SearchRange(0, point, Double_t(range)*range);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///Return in counts[iq] the number of points at a distance smaller or equal than range from
+///the point iq of the array points, stored row-wise (points[iq*ndim + idim] is the coordinate
+///idim of the point iq). The points are distributed over the threads (see SetNThreads)
+///in tiles of consecutive points.
+
+template <typename  Index, typename Value>
+void TKDTree<Index, Value>::CountInRange(Index nq, const Value *points, Value range, Index *counts)
+{
+   // the boundaries must exist before the parallel region, which only reads the tree
+   MakeBoundariesExact();
+   Double_t range2 = Double_t(range)*range;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(GetThreads()) schedule(dynamic,kQueryTile)
+#endif
+   for (Index iq = 0; iq < nq; iq++)
+      counts[iq] = SearchRange(0, points + ULong64_t(iq)*fNDim, range2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///Internal recursive function counting the points of the node inode at a squared
+///distance smaller or equal than range2
+
+template <typename  Index, typename Value>
+Index TKDTree<Index, Value>::SearchRange(Index inode, const Value *point, Double_t range2) const
+{
+   Double_t max2;
+   if (DistanceToNode2(point, inode, max2) > range2) {
+      //all points of this node are outside the range
+      return 0;
+   }
+   if (max2 <= range2) {
+      //all points of this node are inside the range
+      return GetNPointsNode(inode);
+   }
+   if (IsTerminal(inode)){
+      //examine the points one by one
+      Index first = (inode >= fCrossNode) ? (inode-fCrossNode)*fBucketSize : fOffset+(inode-fNNodes)*fBucketSize;
+      Index last = first + GetNPointsNode(inode);
+      Index n = 0;
+      for (Index ipoint=first; ipoint<last; ipoint++){
+         Index ip = fIndPoints[ipoint];
+         Double_t d = 0;
+         for (Index idim=0; idim<fNDim; idim++){
+            Double_t dx = Double_t(point[idim]) - fData[idim][ip];
+            d += dx*dx;
+         }
+         if (d <= range2) n++;
+      }
+      return n;
+   }
+   return SearchRange(GetLeft(inode), point, range2) + SearchRange(GetRight(inode), point, range2);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///return the indices of the points in that terminal node
 ///for all the nodes except last, the size is fBucketSize
@@ -0,0 +1,220 @@
+// @(#)root/mathcore:$Id$
+
+//////////////////////////////////////////////////////////////////////////
+//
+// TRandomPhilox
+//
+// Counter-based random number generator Philox4x32-10 from
+//   J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw,
+//   Parallel Random Numbers: As Easy as 1, 2, 3,
+//   Proceedings of SC'11 (2011).
+//
+// The n-th block of 4 random 32 bit integers is obtained by applying
+// 10 rounds of a bijection to the counter n, using as key the seed and
+// the stream number. The state is therefore only the key and the counter:
+//  - any position of the sequence can be reached in constant time (Skip)
+//  - different streams (e.g. one for each thread or for each job) are
+//    statistically independent sequences, obtained simply by
+//    using a different stream number with the same seed:
+//       TRandomPhilox r(seed, ithread);
+//  - the blocks are independent of each other, so RndmArray generates
+//    many of them at the same time in a loop which is vectorized by the compiler.
+//
+// The period of each stream is 2**66 numbers. The generator passes the
+// BigCrush test suite of TestU01.
+// The numbers are generated in the open interval (0,1), with 32 bit resolution.
+// The same sequence is obtained calling Rndm or RndmArray.
+//
+// For more information see
+//   http://www.deshawresearch.com/resources_random123.html
+//////////////////////////////////////////////////////////////////////////
+
+#include "TRandomPhilox.h"
+
+ClassImp(TRandomPhilox)
+
+namespace {
+
+   // multipliers and Weyl sequence constants of Philox4x32
+   const UInt_t kPhiloxM0 = 0xD2511F53;
+   const UInt_t kPhiloxM1 = 0xCD9E8D57;
+   const UInt_t kPhiloxW0 = 0x9E3779B9;
+   const UInt_t kPhiloxW1 = 0xBB67AE85;
+
+   // number of blocks generated together in RndmArray
+   const Int_t kLanes = 8;
+
+   // scale by 1./(Max<UINT> + 1) = 1./4294967296
+   const Double_t kScale = 2.3283064365386963e-10;
+
+   // largest float smaller than 1 (1 - 2**-24)
+   const Float_t kFloatBelowOne = 0.99999994f;
+
+   // convert a number in (0,1) to float: the numbers closer to 1 than
+   // 2**-25 would be rounded to 1, they are set to the largest float below 1
+   inline Float_t ToFloat(Double_t x)
+   {
+      Float_t y = Float_t(x);
+      return (y < 1.f) ? y : kFloatBelowOne;
+   }
+
+   // Philox4x32-10 for the NL consecutive counters starting from counter,
+   // with key (k0,k1). The output is stored in blocks of 4 numbers.
+   template <Int_t NL>
+   inline void PhiloxBlocks(UInt_t k0, UInt_t k1, ULong64_t counter, UInt_t *out)
+   {
+      UInt_t c0[NL], c1[NL], c2[NL], c3[NL];
+      for (Int_t l = 0; l < NL; ++l) {
+         ULong64_t c = counter + l;
+         c0[l] = UInt_t(c);
+         c1[l] = UInt_t(c >> 32);
+         c2[l] = 0;
+         c3[l] = 0;
+      }
+      for (Int_t r = 0; r < 10; ++r) {
+         for (Int_t l = 0; l < NL; ++l) {
+            ULong64_t p0 = ULong64_t(kPhiloxM0) * c0[l];
+            ULong64_t p1 = ULong64_t(kPhiloxM1) * c2[l];
+            c0[l] = UInt_t(p1 >> 32) ^ c1[l] ^ k0;
+            c1[l] = UInt_t(p1);
+            c2[l] = UInt_t(p0 >> 32) ^ c3[l] ^ k1;
+            c3[l] = UInt_t(p0);
+         }
+         k0 += kPhiloxW0;
+         k1 += kPhiloxW1;
+      }
+      for (Int_t l = 0; l < NL; ++l) {
+         out[4*l]   = c0[l];
+         out[4*l+1] = c1[l];
+         out[4*l+2] = c2[l];
+         out[4*l+3] = c3[l];
+      }
+   }
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Default constructor.
+/// The seed and the stream number define the key of the generator.
+/// Sequences with the same seed and different streams are independent.
+/// For seed=0 see SetSeed().
+
+TRandomPhilox::TRandomPhilox(UInt_t seed, UInt_t stream) : fStream(stream)
+{
+   SetName("RandomPhilox");
+   SetTitle("Random number generator: Philox4x32-10");
+   SetSeed(seed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Default destructor.
+
+TRandomPhilox::~TRandomPhilox()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the block of the current counter and increment the counter.
+
+void TRandomPhilox::FillBuffer()
+{
+   PhiloxBlocks<1>(fSeed, fStream, fCounter, fBuffer);
+   fCounter++;
+   fIndex = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Produces uniformly-distributed floating points in (0,1).
+/// Method: Philox4x32-10
+
+Double_t TRandomPhilox::Rndm(Int_t)
+{
+   if (fIndex >= 4) FillBuffer();
+   // adding 0.5 the returned value cannot be 0 or 1
+   return kScale*(Double_t(fBuffer[fIndex++]) + 0.5);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return an array of n random numbers uniformly distributed in ]0,1[.
+/// The sequence is the same obtained by calling Rndm n times, converted
+/// to float (the numbers which would be rounded to 1 are set to the largest
+/// float smaller than 1).
+
+void TRandomPhilox::RndmArray(Int_t n, Float_t *array)
+{
+   Int_t i = 0;
+   while (i < n && fIndex < 4) array[i++] = ToFloat(kScale*(Double_t(fBuffer[fIndex++]) + 0.5));
+
+   UInt_t out[4*kLanes];
+   for ( ; i + 4*kLanes <= n; i += 4*kLanes) {
+      PhiloxBlocks<kLanes>(fSeed, fStream, fCounter, out);
+      fCounter += kLanes;
+      for (Int_t j = 0; j < 4*kLanes; ++j)
+         array[i+j] = ToFloat(kScale*(Double_t(out[j]) + 0.5));
+   }
+
+   while (i < n) array[i++] = ToFloat(Rndm());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return an array of n random numbers uniformly distributed in ]0,1[.
+/// The sequence is the same obtained by calling Rndm n times.
+
+void TRandomPhilox::RndmArray(Int_t n, Double_t *array)
+{
+   Int_t i = 0;
+   while (i < n && fIndex < 4) array[i++] = kScale*(Double_t(fBuffer[fIndex++]) + 0.5);
+
+   // the blocks of kLanes counters are independent and computed together
+   UInt_t out[4*kLanes];
+   for ( ; i + 4*kLanes <= n; i += 4*kLanes) {
+      PhiloxBlocks<kLanes>(fSeed, fStream, fCounter, out);
+      fCounter += kLanes;
+      for (Int_t j = 0; j < 4*kLanes; ++j)
+         array[i+j] = kScale*(Double_t(out[j]) + 0.5);
+   }
+
+   while (i < n) array[i++] = Rndm();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the generator seed and restart the sequence from the beginning.
+/// If the seed is zero, the seed is generated automatically using a TUUID
+/// (see TRandom::SetSeed). The stream number is not changed.
+
+void TRandomPhilox::SetSeed(UInt_t seed)
+{
+   TRandom::SetSeed(seed);
+   fCounter = 0;
+   fIndex = 4;
+   fBuffer[0] = fBuffer[1] = fBuffer[2] = fBuffer[3] = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the stream number and restart the sequence from the beginning.
+/// Generators with the same seed and different streams produce independent
+/// sequences: use for example the thread number as stream for parallel
+/// generation.
+
+void TRandomPhilox::SetStream(UInt_t stream)
+{
+   fStream = stream;
+   fCounter = 0;
+   fIndex = 4;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Skip the next n random numbers of the sequence.
+/// The time needed does not depend on n.
+
+void TRandomPhilox::Skip(ULong64_t n)
+{
+   // number of values already used
+   ULong64_t pos = 4*fCounter - (4 - fIndex) + n;
+   fCounter = pos >> 2;
+   fIndex = 4;
+   if (pos & 3) {
+      FillBuffer();
+      fIndex = pos & 3;
+   }
+}
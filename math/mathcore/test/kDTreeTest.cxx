@@ -4,6 +4,7 @@
   TestBuild();       // test build function of kdTree for memory leaks
   TestSpeed();       // test the CPU consumption to build kdTree
   TestkdtreeIF();    // test functionality of the kdTree
+  TestBatch();       // test the parallel build and the queries on arrays of points
   TestSizeIF();      // test the size of kdtree - search application - Alice TPC tracker situation
   //
 */
@@ -26,6 +27,7 @@ bool showGraphics = false;
 void TestBuild(const Int_t npoints = 1000000, const Int_t bsize = 100);
 void TestConstr(const Int_t npoints = 1000000, const Int_t bsize = 100);
 void TestSpeed(Int_t npower2 = 20, Int_t bsize = 10);
+Int_t TestBatch(Int_t npoints = 100000, Int_t ndim = 5, Int_t bsize = 10, Int_t nthreads = 4);
 
 //void TestkdtreeIF(Int_t npoints=1000, Int_t bsize=9, Int_t nloop=1000, Int_t mode = 2);
 //void TestSizeIF(Int_t nsec=36, Int_t nrows=159, Int_t npoints=1000,  Int_t bsize=10, Int_t mode=1);
@@ -45,12 +47,16 @@ Float_t Mem()
 ///
 ///
 
-void kDTreeTest()
+Int_t kDTreeTest()
 {
   printf("\n\tTesting kDTree memory usage ...\n");
   TestBuild();
   printf("\n\tTesting kDTree speed ...\n");
   TestSpeed();
+  printf("\n\tTesting kDTree parallel build and queries on arrays ...\n");
+  Int_t ndiff = TestBatch();
+  if (ndiff) std::cerr << "kDTreeTest: Test FAILED !" << std::endl;
+  return ndiff;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -552,6 +558,80 @@ void TestRange()
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+///Test the parallel build and the functions working on arrays of points
+///(FindNearestNeighbors and CountInRange), comparing them with the serial build
+///and with the queries of single points. Returns the number of differences
+
+Int_t TestBatch(Int_t npoints, Int_t ndim, Int_t bsize, Int_t nthreads)
+{
+   std::vector<Double_t> data(npoints*ndim);
+   for (Int_t i=0; i<npoints*ndim; i++) data[i] = gRandom->Uniform(-1, 1);
+
+   TKDTreeID *kdtree1 = new TKDTreeID(npoints, ndim, bsize);
+   TKDTreeID *kdtree2 = new TKDTreeID(npoints, ndim, bsize);
+   for (Int_t idim=0; idim<ndim; idim++){
+      kdtree1->SetData(idim, &data[idim*npoints]);
+      kdtree2->SetData(idim, &data[idim*npoints]);
+   }
+   TStopwatch timer;
+   timer.Start();
+   kdtree1->Build();
+   timer.Stop();
+   printf("Build with 1 thread:  %f s\n", timer.RealTime());
+   kdtree2->SetNThreads(nthreads);
+   timer.Start();
+   kdtree2->Build();
+   timer.Stop();
+   printf("Build with %d threads: %f s\n", nthreads, timer.RealTime());
+
+   Int_t ndiff = 0;
+   for (Int_t inode=0; inode<kdtree1->GetNNodes(); inode++){
+      if (kdtree1->GetNodeAxis(inode) != kdtree2->GetNodeAxis(inode) ||
+          kdtree1->GetNodeValue(inode) != kdtree2->GetNodeValue(inode)) ndiff++;
+   }
+   for (Int_t i=0; i<npoints; i++)
+      if (kdtree1->GetIndPoints()[i] != kdtree2->GetIndPoints()[i]) ndiff++;
+   printf("%d differences found between the trees built with 1 and %d threads\n", ndiff, nthreads);
+   Int_t ntot = ndiff;
+
+   // queries
+   const Int_t nq = 10000;
+   const Int_t nn = 10;
+   const Double_t range = 0.3;
+   std::vector<Double_t> points(nq*ndim);
+   for (Int_t i=0; i<nq*ndim; i++) points[i] = gRandom->Uniform(-1, 1);
+   std::vector<Int_t> ind1(nq*nn), ind2(nq*nn), count2(nq);
+   std::vector<Double_t> dist1(nq*nn), dist2(nq*nn);
+   std::vector<Int_t> res;
+
+   timer.Start();
+   for (Int_t iq=0; iq<nq; iq++)
+      kdtree1->FindNearestNeighbors(&points[iq*ndim], nn, &ind1[iq*nn], &dist1[iq*nn]);
+   timer.Stop();
+   printf("FindNearestNeighbors for %d single points: %f s\n", nq, timer.RealTime());
+   timer.Start();
+   kdtree2->FindNearestNeighbors(nq, &points[0], nn, &ind2[0], &dist2[0]);
+   timer.Stop();
+   printf("FindNearestNeighbors for an array of %d points: %f s\n", nq, timer.RealTime());
+   kdtree2->CountInRange(nq, &points[0], range, &count2[0]);
+
+   ndiff = 0;
+   for (Int_t i=0; i<nq*nn; i++)
+      if (ind1[i] != ind2[i] || dist1[i] != dist2[i]) ndiff++;
+   for (Int_t iq=0; iq<nq; iq+=100){
+      res.clear();
+      kdtree1->FindInRange(&points[iq*ndim], range, res);
+      if (Int_t(res.size()) != count2[iq] || kdtree1->CountInRange(&points[iq*ndim], range) != count2[iq]) ndiff++;
+   }
+   printf("%d differences found between the queries of single points and of arrays\n", ndiff);
+   ntot += ndiff;
+
+   delete kdtree1;
+   delete kdtree2;
+   return ntot;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 int main(int argc, char **argv) {
@@ -579,7 +659,7 @@ int main(int argc, char **argv) {
    if ( showGraphics )
       theApp = new TApplication("App",&argc,argv);
 
-   kDTreeTest();
+   Int_t ret = kDTreeTest();
 
    if ( showGraphics )
    {
@@ -588,5 +668,5 @@ int main(int argc, char **argv) {
       theApp = 0;
    }
 
-   return 0;
+   return (ret != 0);
 }
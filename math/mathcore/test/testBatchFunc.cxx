@@ -0,0 +1,205 @@
+// test of the functions evaluated on arrays of numbers (namespace ROOT::Math::Batch)
+// the results are compared with the scalar functions of ROOT::Math
+// and the time per element is printed for both versions
+
+#include "Math/BatchFuncMathCore.h"
+#include "Math/SpecFuncMathCore.h"
+#include "Math/PdfFuncMathCore.h"
+#include "Math/ProbFuncMathCore.h"
+#include "TStopwatch.h"
+#include "TError.h"
+#include <vector>
+#include <iostream>
+#include <cstdio>
+#include <cmath>
+#include <string>
+
+bool gVerbose = false;
+
+// relative tolerance (the VDT exp and log are not correctly rounded)
+const double kTol = 1.E-13;
+
+// compare the array and the scalar results; values below the smallest normalized
+// double are considered equal, since VDT flushes them to zero
+int compare(const char * name, const std::vector<double> & x, const std::vector<double> & vb, const std::vector<double> & vs)
+{
+   int nfail = 0;
+   for (unsigned int i = 0; i < vb.size(); ++i) {
+      if (std::isnan(vb[i]) && std::isnan(vs[i])) continue;
+      if (vb[i] == vs[i]) continue;
+      double delta = std::abs(vb[i]-vs[i]);
+      if (delta < 2.3E-308 || delta <= kTol * std::abs(vs[i]) ) continue;
+      if (nfail == 0 || gVerbose)
+         Error("testBatchFunc","%s : wrong value for x = %g : %.17g (scalar %.17g)", name, x[i], vb[i], vs[i]);
+      nfail++;
+   }
+   if (gVerbose) printf("Test of Batch::%-16s %s\n", name, (nfail == 0) ? "OK" : "FAILED");
+   return (nfail == 0) ? 0 : 1;
+}
+
+int testValues()
+{
+   int iret = 0;
+   // include negative values, zero, the values where the approximations change and large values
+   const int n = 20001;
+   std::vector<double> x(n), vb(n), vs(n);
+   std::vector<unsigned int> k(n);
+   for (int i = 0; i < n; ++i) {
+      x[i] = -30. + 60.*i/(n-1);
+      k[i] = i % 2000;
+   }
+   // the special values
+   x[0] = 0; x[1] = -1; x[2] = 1; x[3] = 13; x[4] = 1.E10; x[5] = -1.E10; x[6] = std::sqrt(-1.);
+
+   ROOT::Math::Batch::erf(n, &x[0], &vb[0]);
+   for (int i = 0; i < n; ++i) vs[i] = ROOT::Math::erf(x[i]);
+   iret |= compare("erf", x, vb, vs);
+
+   ROOT::Math::Batch::erfc(n, &x[0], &vb[0]);
+   for (int i = 0; i < n; ++i) vs[i] = ROOT::Math::erfc(x[i]);
+   iret |= compare("erfc", x, vb, vs);
+
+   ROOT::Math::Batch::lgamma(n, &x[0], &vb[0]);
+   for (int i = 0; i < n; ++i) vs[i] = ROOT::Math::lgamma(x[i]);
+   iret |= compare("lgamma", x, vb, vs);
+
+   ROOT::Math::Batch::exp(n, &x[0], &vb[0]);
+   for (int i = 0; i < n; ++i) vs[i] = std::exp(x[i]);
+   iret |= compare("exp", x, vb, vs);
+
+   ROOT::Math::Batch::log(n, &x[0], &vb[0]);
+   for (int i = 0; i < n; ++i) vs[i] = std::log(x[i]);
+   iret |= compare("log", x, vb, vs);
+
+   ROOT::Math::Batch::normal_pdf(n, &x[0], &vb[0], 2., 1.);
+   for (int i = 0; i < n; ++i) vs[i] = ROOT::Math::normal_pdf(x[i], 2., 1.);
+   iret |= compare("normal_pdf", x, vb, vs);
+
+   ROOT::Math::Batch::lognormal_pdf(n, &x[0], &vb[0], 1., 0.5, -1.);
+   for (int i = 0; i < n; ++i) vs[i] = ROOT::Math::lognormal_pdf(x[i], 1., 0.5, -1.);
+   iret |= compare("lognormal_pdf", x, vb, vs);
+
+   ROOT::Math::Batch::gamma_pdf(n, &x[0], &vb[0], 2.5, 2., -3.);
+   for (int i = 0; i < n; ++i) vs[i] = ROOT::Math::gamma_pdf(x[i], 2.5, 2., -3.);
+   iret |= compare("gamma_pdf", x, vb, vs);
+
+   ROOT::Math::Batch::gamma_pdf(n, &x[0], &vb[0], 1., 2.);
+   for (int i = 0; i < n; ++i) vs[i] = ROOT::Math::gamma_pdf(x[i], 1., 2.);
+   iret |= compare("gamma_pdf", x, vb, vs);
+
+   ROOT::Math::Batch::chisquared_pdf(n, &x[0], &vb[0], 5., -3.);
+   for (int i = 0; i < n; ++i) vs[i] = ROOT::Math::chisquared_pdf(x[i], 5., -3.);
+   iret |= compare("chisquared_pdf", x, vb, vs);
+
+   ROOT::Math::Batch::chisquared_pdf(n, &x[0], &vb[0], 2.);
+   for (int i = 0; i < n; ++i) vs[i] = ROOT::Math::chisquared_pdf(x[i], 2.);
+   iret |= compare("chisquared_pdf", x, vb, vs);
+
+   double mu[3] = { 0., 3.5, 300. };
+   for (int j = 0; j < 3; ++j) {
+      ROOT::Math::Batch::poisson_pdf(n, &k[0], &vb[0], mu[j]);
+      for (int i = 0; i < n; ++i) vs[i] = ROOT::Math::poisson_pdf(k[i], mu[j]);
+      iret |= compare("poisson_pdf", x, vb, vs);
+
+      ROOT::Math::Batch::poisson_cdf(n, &k[0], &vb[0], mu[j]);
+      for (int i = 0; i < n; ++i) vs[i] = ROOT::Math::poisson_cdf(k[i], mu[j]);
+      iret |= compare("poisson_cdf", x, vb, vs);
+   }
+
+   ROOT::Math::Batch::normal_cdf(n, &x[0], &vb[0], 2., 1.);
+   for (int i = 0; i < n; ++i) vs[i] = ROOT::Math::normal_cdf(x[i], 2., 1.);
+   iret |= compare("normal_cdf", x, vb, vs);
+
+   ROOT::Math::Batch::normal_cdf_c(n, &x[0], &vb[0], 2., 1.);
+   for (int i = 0; i < n; ++i) vs[i] = ROOT::Math::normal_cdf_c(x[i], 2., 1.);
+   iret |= compare("normal_cdf_c", x, vb, vs);
+
+   ROOT::Math::Batch::lognormal_cdf(n, &x[0], &vb[0], 1., 0.5, -1.);
+   for (int i = 0; i < n; ++i) vs[i] = ROOT::Math::lognormal_cdf(x[i], 1., 0.5, -1.);
+   iret |= compare("lognormal_cdf", x, vb, vs);
+
+   ROOT::Math::Batch::gamma_cdf(n, &x[0], &vb[0], 2.5, 2., -3.);
+   for (int i = 0; i < n; ++i) vs[i] = ROOT::Math::gamma_cdf(x[i], 2.5, 2., -3.);
+   iret |= compare("gamma_cdf", x, vb, vs);
+
+   ROOT::Math::Batch::chisquared_cdf(n, &x[0], &vb[0], 5., -3.);
+   for (int i = 0; i < n; ++i) vs[i] = ROOT::Math::chisquared_cdf(x[i], 5., -3.);
+   iret |= compare("chisquared_cdf", x, vb, vs);
+
+   if (iret == 0) printf("Test of the values of the batch functions:  OK\n");
+   return iret;
+}
+
+// time per element (in ns) of the scalar and array functions
+void testTime()
+{
+   const int n = 1000;
+   const int nloop = 10000;
+   std::vector<double> x(n), v(n);
+   for (int i = 0; i < n; ++i) x[i] = -5. + 15.*i/n;
+   double sum = 0;
+
+   printf("\nFunction          nanoseconds/call\n");
+   printf("                    scalar     batch\n");
+   const char * names[6] = { "exp.............", "erf.............", "lgamma..........",
+                             "normal_pdf......", "normal_cdf......", "gamma_pdf......." };
+   TStopwatch w;
+   for (int itest = 0; itest < 6; ++itest) {
+      printf("%s", names[itest]);
+      for (int batch = 0; batch < 2; ++batch) {
+         w.Start();
+         for (int l = 0; l < nloop; ++l) {
+            switch (10*itest + batch) {
+            case  0 : for (int i = 0; i < n; ++i) v[i] = std::exp(x[i]); break;
+            case  1 : ROOT::Math::Batch::exp(n, &x[0], &v[0]); break;
+            case 10 : for (int i = 0; i < n; ++i) v[i] = ROOT::Math::erf(x[i]); break;
+            case 11 : ROOT::Math::Batch::erf(n, &x[0], &v[0]); break;
+            case 20 : for (int i = 0; i < n; ++i) v[i] = ROOT::Math::lgamma(x[i] + 6.); break;
+            case 21 : for (int i = 0; i < n; ++i) v[i] = x[i] + 6.;
+                      ROOT::Math::Batch::lgamma(n, &v[0], &v[0]); break;
+            case 30 : for (int i = 0; i < n; ++i) v[i] = ROOT::Math::normal_pdf(x[i], 2.); break;
+            case 31 : ROOT::Math::Batch::normal_pdf(n, &x[0], &v[0], 2.); break;
+            case 40 : for (int i = 0; i < n; ++i) v[i] = ROOT::Math::normal_cdf(x[i], 2.); break;
+            case 41 : ROOT::Math::Batch::normal_cdf(n, &x[0], &v[0], 2.); break;
+            case 50 : for (int i = 0; i < n; ++i) v[i] = ROOT::Math::gamma_pdf(x[i], 2.5, 2.); break;
+            case 51 : ROOT::Math::Batch::gamma_pdf(n, &x[0], &v[0], 2.5, 2.); break;
+            }
+            sum += v[l % n];
+         }
+         w.Stop();
+         printf(" %9.3f", w.CpuTime()*1.E9/(double(n)*nloop));
+      }
+      printf("\n");
+   }
+   if (gVerbose) printf("(sum of computed values %f)\n", sum);
+}
+
+int testBatchFunc()
+{
+   int iret = testValues();
+
+   testTime();
+
+   if (iret) std::cerr << "testBatchFunc: Test FAILED !" << std::endl;
+   return iret;
+}
+
+int main(int argc, char **argv)
+{
+   // Parse command line arguments
+   for (int i=1 ;  i<argc ; i++) {
+      std::string arg = argv[i] ;
+      if (arg == "-v") {
+         gVerbose = true;
+      }
+      if (arg == "-h") {
+         std::cout << "Usage: " << argv[0] << " [-v]\n";
+         std::cout << "  where:\n";
+         std::cout << "     -v : verbose  mode";
+         std::cout << std::endl;
+         return -1;
+      }
+   }
+
+   return testBatchFunc();
+}
@@ -201,6 +201,112 @@ void performance()
 
 }
 
+  // ################################################################
+  //
+  //      result of AdaptiveIntegratorMultiDim using several threads
+  //      (must be identical to the one obtained with a single thread)
+  //
+  // ################################################################
+int threads()
+{
+   int iret = 0;
+   for (unsigned int N = 2; N <= 4; N++) {
+      double * a = new double[N];
+      double * b = new double[N];
+      double p[1];
+      p[0] = N;
+      for (unsigned int i=0; i < N; i++) {
+         a[i] = -1.;
+         b[i] = 1;
+      }
+      ROOT::Math::WrappedParamFunction<> funptr(&SimpleFun, N, p, p+1);
+      ROOT::Math::AdaptiveIntegratorMultiDim ig(funptr, 1.E-5, 1.E-5, (unsigned int) 1.E7);
+      ig.SetNThreads(1);
+      double r1 = ig.Integral(a, b);
+      int n1 = ig.NEval();
+      ig.SetNThreads(4);
+      double r4 = ig.Integral(a, b);
+      int n4 = ig.NEval();
+      if (r1 != r4 || n1 != n4) {
+         std::cerr << "Different results using 4 threads for dim=" << N << " : "
+                   << r1 << " (" << n1 << " calls) " << r4 << " (" << n4 << " calls)" << std::endl;
+         iret = 1;
+      }
+      delete [] a;
+      delete [] b;
+   }
+   if (iret == 0) std::cout << "Test of the integration using several threads: OK" << std::endl;
+   return iret;
+}
+
+  // ################################################################
+  //
+  //      integral of the absolute value of the function (absValue)
+  //
+  // ################################################################
+
+// give access to the integration of the absolute value of the function
+class AbsIntegrator : public ROOT::Math::AdaptiveIntegratorMultiDim {
+public:
+   AbsIntegrator(const ROOT::Math::IMultiGenFunction &f, double absTol, double relTol, unsigned int maxpts) :
+      ROOT::Math::AdaptiveIntegratorMultiDim(f, absTol, relTol, maxpts) {}
+   double AbsIntegral(const double* xmin, const double * xmax) { return DoIntegral(xmin, xmax, true); }
+};
+
+Double_t GausFun( const double* x, const double *p)
+{
+  double prod = 1.;
+  for(int i = 0; i < p[0]; i++)
+    prod *= std::exp(-x[i]*x[i]);
+  return prod;
+}
+
+int absValue()
+{
+   int iret = 0;
+   for (unsigned int N = 2; N <= 4; N++) {
+      double * a = new double[N];
+      double * b = new double[N];
+      double p[1];
+      p[0] = N;
+      for (unsigned int i=0; i < N; i++) {
+         a[i] = -1.;
+         b[i] = 1;
+      }
+
+      // positive function: same result as the integral of the function
+      ROOT::Math::WrappedParamFunction<> gausptr(&GausFun, N, p, p+1);
+      AbsIntegrator ig1(gausptr, 1.E-5, 1.E-5, (unsigned int) 1.E7);
+      double r = ig1.Integral(a, b);
+      double rabs = ig1.AbsIntegral(a, b);
+      double expected = std::pow(std::sqrt(TMath::Pi())*TMath::Erf(1.), int(N));
+      if (r != rabs || std::abs(rabs - expected) > 1.E-4*expected) {
+         std::cerr << "Wrong integral of the absolute value for dim=" << N << " : "
+                   << rabs << " instead of " << r << " (expected " << expected << ")" << std::endl;
+         iret = 1;
+      }
+
+      // function changing sign: the result must not depend on the number of threads
+      ROOT::Math::WrappedParamFunction<> funptr(&SimpleFun, N, p, p+1);
+      AbsIntegrator ig2(funptr, 1.E-5, 1.E-5, (unsigned int) 1.E7);
+      ig2.SetNThreads(1);
+      double r1 = ig2.AbsIntegral(a, b);
+      int n1 = ig2.NEval();
+      ig2.SetNThreads(4);
+      double r4 = ig2.AbsIntegral(a, b);
+      int n4 = ig2.NEval();
+      if (r1 != r4 || n1 != n4 || !(r1 > std::abs(ig2.Integral(a, b))) ) {
+         std::cerr << "Wrong integral of the absolute value using 4 threads for dim=" << N << " : "
+                   << r1 << " (" << n1 << " calls) " << r4 << " (" << n4 << " calls)" << std::endl;
+         iret = 1;
+      }
+      delete [] a;
+      delete [] b;
+   }
+   if (iret == 0) std::cout << "Test of the integration of the absolute value: OK" << std::endl;
+   return iret;
+}
+
 int main(int argc, char **argv)
 {
   // Parse command line arguments
@@ -229,6 +335,9 @@ int main(int argc, char **argv)
 
    performance();
 
+   int iret = threads();
+   iret |= absValue();
+
    if ( showGraphics )
    {
       theApp->Run();
@@ -236,6 +345,6 @@ int main(int argc, char **argv)
       theApp = 0;
    }
 
-   return 0;
+   return iret;
 
 }
@@ -0,0 +1,211 @@
+// test of the counter-based random number generator TRandomPhilox
+// and of the functions generating arrays of random numbers (RndmArray, GausArray, ExpArray, PoissonArray)
+// compare the time per number with the other generators (TRandom1,2 and 3):
+// the timing is only printed, it never makes the test fail
+
+#include "TRandom1.h"
+#include "TRandom2.h"
+#include "TRandom3.h"
+#include "TRandomPhilox.h"
+#include "TStopwatch.h"
+#include "TMath.h"
+#include "TError.h"
+#include <vector>
+#include <iostream>
+#include <cstdio>
+#include <string>
+
+bool gVerbose = false;
+
+// test that the numbers do not depend on the way they are generated
+int testSequence()
+{
+   int iret = 0;
+   const int n = 1001;
+   std::vector<double> v1(n), v2(n);
+
+   TRandomPhilox r1(123, 7);
+   for (int i = 0; i < n; ++i) v1[i] = r1.Rndm();
+
+   // arrays of different sizes
+   TRandomPhilox r2(123, 7);
+   r2.RndmArray(3, &v2[0]);
+   r2.RndmArray(500, &v2[3]);
+   r2.RndmArray(n-503, &v2[503]);
+   for (int i = 0; i < n; ++i) {
+      if (v1[i] != v2[i] || v1[i] <= 0 || v1[i] >= 1) {
+         Error("testSequence","Different numbers generated with Rndm and RndmArray at %d: %f %f", i, v1[i], v2[i]);
+         iret = 1;
+         break;
+      }
+   }
+
+   // float arrays: same sequence converted to float, numbers in (0,1)
+   std::vector<float> vf(n);
+   TRandomPhilox r5(123, 7);
+   r5.RndmArray(3, &vf[0]);
+   r5.RndmArray(n-3, &vf[3]);
+   for (int i = 0; i < n; ++i) {
+      if (vf[i] <= 0 || vf[i] >= 1 || (float(v1[i]) < 1.f && vf[i] != float(v1[i])) ) {
+         Error("testSequence","Wrong float number generated with RndmArray at %d: %f %f", i, vf[i], v1[i]);
+         iret = 1;
+         break;
+      }
+   }
+
+   // jump ahead
+   TRandomPhilox r3(123, 7);
+   r3.Skip(499);
+   double x1 = r3.Rndm();
+   r3.Skip(2);
+   double x2 = r3.Rndm();
+   r3.Skip(0);
+   double x3 = r3.Rndm();
+   if (x1 != v1[499] || x2 != v1[502] || x3 != v1[503]) {
+      Error("testSequence","Wrong numbers generated after Skip");
+      iret = 1;
+   }
+
+   // streams with the same seed must be different
+   TRandomPhilox r4(123, 8);
+   int nequal = 0;
+   for (int i = 0; i < n; ++i) if (r4.Rndm() == v1[i]) nequal++;
+   if (nequal > 2) {
+      Error("testSequence","Same numbers generated with different streams");
+      iret = 1;
+   }
+
+   // restart the sequence
+   r4.SetStream(7);
+   r4.SetSeed(123);
+   if (r4.Rndm() != v1[0]) {
+      Error("testSequence","Wrong number generated after SetSeed");
+      iret = 1;
+   }
+
+   if (iret == 0) printf("Test of the TRandomPhilox sequence:  OK\n");
+   return iret;
+}
+
+// test the moments of the generated arrays
+int testArrays(TRandom & r)
+{
+   int iret = 0;
+   const int n = 1000000;
+   std::vector<double> v(n);
+   std::vector<int> k(n);
+
+   double mean = 0, var = 0;
+
+   r.GausArray(n, &v[0], 1., 2.);
+   mean = TMath::Mean(n, &v[0]);
+   var = TMath::RMS(n, &v[0]); var *= var;
+   if (!TMath::AreEqualAbs(mean, 1., 5*2./sqrt(double(n))) || !TMath::AreEqualAbs(var, 4., 5*4.*sqrt(2./n)) ) {
+      Error("testArrays","Wrong mean or variance from %s::GausArray: %f %f", r.ClassName(), mean, var);
+      iret = 1;
+   }
+
+   r.ExpArray(n, &v[0], 3.);
+   mean = TMath::Mean(n, &v[0]);
+   if (!TMath::AreEqualAbs(mean, 3., 5*3./sqrt(double(n))) ) {
+      Error("testArrays","Wrong mean from %s::ExpArray: %f", r.ClassName(), mean);
+      iret = 1;
+   }
+
+   double pmean[3] = { 0.2, 7.5, 40. };
+   for (int j = 0; j < 3; ++j) {
+      r.PoissonArray(n, &k[0], pmean[j]);
+      mean = TMath::Mean(n, &k[0]);
+      var = TMath::RMS(n, &k[0]); var *= var;
+      double err = sqrt(pmean[j]/n);
+      if (!TMath::AreEqualAbs(mean, pmean[j], 5*err) || !TMath::AreEqualAbs(var, pmean[j], 10*pmean[j]*sqrt(2./n) + 5*err) ) {
+         Error("testArrays","Wrong mean or variance from %s::PoissonArray(%f): %f %f", r.ClassName(), pmean[j], mean, var);
+         iret = 1;
+      }
+   }
+
+   if (iret == 0) printf("Test of the arrays generated by %-14s OK\n", r.ClassName());
+   return iret;
+}
+
+// time per number (in ns) of the scalar and array functions
+void testTime()
+{
+   const int n = 10000000;
+   const int nr = 1000;
+   std::vector<double> v(nr);
+   std::vector<int> k(nr);
+   double x = 0;
+
+   TRandom * gens[4] = { new TRandom1(), new TRandom2(), new TRandom3(), new TRandomPhilox() };
+
+   printf("\nDistribution         nanoseconds/call\n");
+   printf("                  TRandom1 TRandom2 TRandom3 TRandomPhilox\n");
+   TStopwatch w;
+   const char * names[8] = { "Rndm............", "RndmArray.......", "Gaus............", "GausArray.......",
+                             "Exp.............", "ExpArray........", "Poisson(5)......", "PoissonArray(5)." };
+   for (int itest = 0; itest < 8; ++itest) {
+      printf("%s", names[itest]);
+      for (int ig = 0; ig < 4; ++ig) {
+         TRandom & r = *gens[ig];
+         // RANLUX is much slower
+         int ntot = (ig == 0) ? n/10 : n;
+         w.Start();
+         for (int i = 0; i < ntot; i += nr) {
+            switch (itest) {
+            case 0 : for (int j = 0; j < nr; ++j) x += r.Rndm(); break;
+            case 1 : r.RndmArray(nr, &v[0]); break;
+            case 2 : for (int j = 0; j < nr; ++j) x += r.Gaus(0,1); break;
+            case 3 : r.GausArray(nr, &v[0]); break;
+            case 4 : for (int j = 0; j < nr; ++j) x += r.Exp(1); break;
+            case 5 : r.ExpArray(nr, &v[0]); break;
+            case 6 : for (int j = 0; j < nr; ++j) x += r.Poisson(5); break;
+            case 7 : r.PoissonArray(nr, &k[0], 5); break;
+            }
+            x += v[0];
+         }
+         w.Stop();
+         printf(" %8.3f", w.CpuTime()*1.E9/ntot);
+      }
+      printf("\n");
+   }
+   if (gVerbose) printf("(sum of generated numbers %f)\n", x);
+
+   for (int ig = 0; ig < 4; ++ig) delete gens[ig];
+}
+
+int testRandomPhilox()
+{
+   int iret = 0;
+   iret |= testSequence();
+
+   TRandom3 r3(111);
+   TRandomPhilox rp(111);
+   iret |= testArrays(r3);
+   iret |= testArrays(rp);
+
+   testTime();
+
+   if (iret) std::cerr << "testRandomPhilox: Test FAILED !" << std::endl;
+   return iret;
+}
+
+int main(int argc, char **argv)
+{
+   // Parse command line arguments
+   for (Int_t i=1 ;  i<argc ; i++) {
+      std::string arg = argv[i] ;
+      if (arg == "-v") {
+         gVerbose = true;
+      }
+      if (arg == "-h") {
+         std::cout << "Usage: " << argv[0] << " [-v]\n";
+         std::cout << "  where:\n";
+         std::cout << "     -v : verbose  mode";
+         std::cout << std::endl;
+         return -1;
+      }
+   }
+
+   return testRandomPhilox();
+}
@@ -120,6 +120,11 @@ distclean::     distclean-$(MODNAME)
 ##### extra rules ######
 $(MATHMOREO): CXXFLAGS += $(GSLFLAGS)  -DUSE_ROOT_ERROR
 $(MATHMOREDO): CXXFLAGS += $(ROOT_SRCDIR:%=-I%) $(GSLFLAGS) -DUSE_ROOT_ERROR
+# the VEGAS integration can optionally run on several threads using OpenMP
+ifneq ($(USE_OPENMP),)
+$(call stripsrc,$(MATHMOREDIRS)/GSLMCIntegrator.o): CXXFLAGS += -fopenmp
+$(MATHMORELIB): LDFLAGS += -fopenmp
+endif
 
 # Optimize dictionary with stl containers.
 $(MATHMOREDO): NOOPT = $(OPT)
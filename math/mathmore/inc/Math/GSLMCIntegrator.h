@@ -87,6 +87,14 @@ namespace Math {
     It implements also the interface ROOT::Math::VirtualIntegratorMultiDim so it can be
     instantiate using the plugin manager (plugin name is "GSLMCIntegrator")
 
+    When ROOT is built with OpenMP the VEGAS integration of a function set as IMultiGenFunction
+    can be run on several threads (see SetNThreads). The calls are then divided among
+    independent VEGAS integrations, one for each thread, each with its own grid, its own
+    copy of the function (obtained with IMultiGenFunction::Clone) and its own random
+    number generator, seeded from the generator of the integrator. The results are combined
+    using the inverse of their variances as weights. For a given number of threads the
+    result is reproducible, but it depends on the number of threads used.
+
     @ingroup MCIntegration
 
    */
@@ -213,6 +221,16 @@ public:
       */
       int NEval() const { return fCalls; }
 
+      /**
+         set the number of threads used for the VEGAS integration (0 means all the available ones)
+      */
+      void SetNThreads(unsigned int n) { fNThreads = n; }
+
+      /**
+         return the number of threads used for the VEGAS integration
+      */
+      unsigned int NThreads() const { return fNThreads; }
+
 
       // setter for control Parameters  (getters are not needed so far )
 
@@ -277,11 +295,13 @@ public:
 
       /**
        returns the error sigma from the last iteration of the Vegas algorithm
+       (not available when the integration is run on several threads)
       */
       double Sigma();
 
       /**
        returns chi-squared per degree of freedom for the estimate of the integral in the Vegas algorithm
+       (not available when the integration is run on several threads)
       */
       double ChiSqr();
 
@@ -316,6 +336,9 @@ public:
       // set internally the type of integration method
       void DoInitialize( );
 
+      // VEGAS integration with independent integrations on nthreads threads
+      void DoVegasIntegralMT(const double* a, const double* b, unsigned int nthreads);
+
 
    private:
       //type of intergation method
@@ -327,6 +350,7 @@ public:
       unsigned int fCalls;
       double fAbsTol;
       double fRelTol;
+      unsigned int fNThreads;
 
       // cache Error, Result and Status of integration
 
@@ -337,6 +361,7 @@ public:
 
       GSLMCIntegrationWorkspace * fWorkspace;
       GSLMonteFunctionWrapper * fFunction;
+      const IMultiGenFunction * fFunc;  // function used for the integration on several threads
 
    };
 
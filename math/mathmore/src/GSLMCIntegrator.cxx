@@ -41,12 +41,17 @@
 #include <algorithm>
 #include <functional>
 #include <ctype.h>   // need to use c version of tolower defined here
+#include <cmath>
 
 
 #include "gsl/gsl_monte_vegas.h"
 #include "gsl/gsl_monte_miser.h"
 #include "gsl/gsl_monte_plain.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 
 
 namespace ROOT {
@@ -77,9 +82,11 @@ GSLMCIntegrator::GSLMCIntegrator(MCIntegration::Type type, double absTol, double
    fCalls((calls > 0)  ? calls : IntegratorMultiDimOptions::DefaultNCalls()),
    fAbsTol((absTol >0) ? absTol : IntegratorMultiDimOptions::DefaultAbsTolerance() ),
    fRelTol((relTol >0) ? relTol : IntegratorMultiDimOptions::DefaultRelTolerance() ),
+   fNThreads(IntegratorMultiDimOptions::DefaultNThreads()),
    fResult(0),fError(0),fStatus(-1),
    fWorkspace(0),
-   fFunction(0)
+   fFunction(0),
+   fFunc(0)
 {
    // constructor of GSL MCIntegrator using enumeration as type
    SetType(type);
@@ -104,9 +111,11 @@ GSLMCIntegrator::GSLMCIntegrator(const char * type, double absTol, double relTol
    fCalls(calls),
    fAbsTol(absTol),
    fRelTol(relTol),
+   fNThreads(IntegratorMultiDimOptions::DefaultNThreads()),
    fResult(0),fError(0),fStatus(-1),
    fWorkspace(0),
-   fFunction(0)
+   fFunction(0),
+   fFunc(0)
 {
    // constructor of GSL MCIntegrator. Vegas MC is set as default integration type if type == 0
    SetTypeName(type);
@@ -157,6 +166,7 @@ void GSLMCIntegrator::SetFunction(const IMultiGenFunction &f)
    // method to set the a generic integration function
    if(fFunction == 0) fFunction = new  GSLMonteFunctionWrapper();
    fFunction->SetFunction(f);
+   fFunc = &f;
    fDim = f.NDim();
 }
 
@@ -166,6 +176,7 @@ void GSLMCIntegrator::SetFunction( GSLMonteFuncPointer f,  unsigned int dim, voi
    if(fFunction == 0) fFunction = new  GSLMonteFunctionWrapper();
    fFunction->SetFuncPointer( f );
    fFunction->SetParams ( p );
+   fFunc = 0;
    fDim = dim;
 }
 
@@ -185,6 +196,14 @@ double GSLMCIntegrator::Integral(const double* a, const double* b)
 
    if ( fType == MCIntegration::kVEGAS)
    {
+#ifdef _OPENMP
+      // the function pointers cannot be copied for the other threads
+      unsigned int nthreads = (fNThreads == 0) ? omp_get_max_threads() : fNThreads;
+      if (nthreads > 1 && fFunc != 0) {
+         DoVegasIntegralMT(a, b, nthreads);
+         return fResult;
+      }
+#endif
       GSLVegasIntegrationWorkspace * ws = dynamic_cast<GSLVegasIntegrationWorkspace *>(fWorkspace);
       assert(ws != 0);
       fStatus = gsl_monte_vegas_integrate( fFunction->GetFunc(), (double *) a, (double*) b , fDim, fCalls, fr, ws->GetWS(),  &fResult, &fError);
@@ -336,6 +355,7 @@ void GSLMCIntegrator::SetOptions(const ROOT::Math::IntegratorMultiDimOptions & o
    SetAbsTolerance( opt.AbsTolerance() );
    SetRelTolerance( opt.RelTolerance() );
    fCalls = opt.NCalls();
+   fNThreads = opt.NThreads();
 
    //std::cout << fType << "   " <<  MCIntegration::kVEGAS << std::endl;
 
@@ -403,6 +423,69 @@ void GSLMCIntegrator::DoInitialize ( )
 
 //----------- methods specific for VEGAS
 
+void GSLMCIntegrator::DoVegasIntegralMT(const double* a, const double* b, unsigned int nthreads)
+{
+   // run nthreads independent VEGAS integrations, each with fCalls/nthreads calls,
+   // and combine them using the inverse of the variances as weights.
+   // The workspaces, generators and function copies are created before the parallel region,
+   // the seeds are drawn from the generator of the integrator so that the result is reproducible
+   GSLVegasIntegrationWorkspace * ws0 = dynamic_cast<GSLVegasIntegrationWorkspace *>(fWorkspace);
+   assert(ws0 != 0);
+
+   std::vector<GSLVegasIntegrationWorkspace *> wsList(nthreads);
+   std::vector<GSLRngWrapper *> rngList(nthreads);
+   std::vector<const IMultiGenFunction *> funcList(nthreads);
+   std::vector<GSLMonteFunctionWrapper> wrapList(nthreads);
+   std::vector<double> result(nthreads), error(nthreads);
+   std::vector<int> status(nthreads);
+   for (unsigned int i = 0; i < nthreads; ++i) {
+      wsList[i] = new GSLVegasIntegrationWorkspace(fDim);
+      wsList[i]->SetParameters(ws0->Parameters());
+      rngList[i] = new GSLRngWrapper(*fRng);
+      gsl_rng_set(rngList[i]->Rng(), gsl_rng_get(fRng->Rng()));
+      funcList[i] = (i == 0) ? fFunc : fFunc->Clone();
+      wrapList[i].SetFunction(*funcList[i]);
+   }
+   unsigned int ncalls = std::max(fCalls/nthreads, 1u);
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthreads) schedule(static,1)
+#endif
+   for (int i = 0; i < int(nthreads); ++i) {
+      status[i] = gsl_monte_vegas_integrate( wrapList[i].GetFunc(), (double *) a, (double*) b , fDim, ncalls,
+                                             rngList[i]->Rng(), wsList[i]->GetWS(), &result[i], &error[i]);
+   }
+
+   double sumw = 0, sumwr = 0, sumr = 0, sume2 = 0;
+   bool zeroError = false;
+   fStatus = 0;
+   for (unsigned int i = 0; i < nthreads; ++i) {
+      if (status[i] != 0 && fStatus == 0) fStatus = status[i];
+      sumr += result[i];
+      sume2 += error[i]*error[i];
+      if (error[i] > 0) {
+         double w = 1./(error[i]*error[i]);
+         sumw += w;
+         sumwr += w*result[i];
+      }
+      else
+         zeroError = true;
+
+      delete wsList[i];
+      delete rngList[i];
+      if (i > 0) delete funcList[i];
+   }
+   if (!zeroError) {
+      fResult = sumwr/sumw;
+      fError = 1./std::sqrt(sumw);
+   }
+   else {
+      // an error equal to zero (e.g. for a constant function): use the plain average
+      fResult = sumr/nthreads;
+      fError = std::sqrt(sume2)/nthreads;
+   }
+}
+
 double GSLMCIntegrator::Sigma()
 {
    // returns the error sigma from the last iteration of the VEGAS algorithm
@@ -466,6 +549,7 @@ ROOT::Math::IntegratorMultiDimOptions  GSLMCIntegrator::Options() const {
    opt.SetAbsTolerance(fAbsTol);
    opt.SetRelTolerance(fRelTol);
    opt.SetNCalls(fCalls);
+   opt.SetNThreads(fNThreads);
    opt.SetWKSize(0);
    opt.SetIntegrator(GetTypeName() );
    return opt;
@@ -75,6 +75,15 @@ Double_t SimpleFun( const double* x, const double *p)
 
 }
 
+//product of Gaussians, with integral (sqrt(pi)*erf(1))^dim over [-1,1]^dim
+Double_t GausProd( const double* x, const double *p)
+{
+  double prod = 1.;
+  for(int i = 0; i < p[0]; i++)
+    prod *= TMath::Exp(-x[i]*x[i]);
+  return prod;
+}
+
 //singularity at (0,0, ..., 0)
 Double_t SingularFun( const double* x, const double *p)
 {
@@ -337,6 +346,59 @@ bool performance()
 }
 
 
+  // ################################################################
+  //
+  //      testing VEGAS on several threads
+  //
+  // ################################################################
+
+bool testVegasThreads()
+{
+  // the calls are divided among the threads when mathmore is built with OpenMP,
+  // otherwise the usual single integration is done
+  const unsigned int dim = 3;
+  const unsigned int nthreads = 4;
+  double a[dim], b[dim];
+  double p[1];
+  p[0] = dim;
+  for (unsigned int i=0; i < dim; i++) {
+     a[i] = -1.;
+     b[i] = 1.;
+  }
+  double exact = TMath::Power(TMath::Sqrt(TMath::Pi())*TMath::Erf(1.), (double) dim);
+  ROOT::Math::WrappedParamFunction<> funptr(&GausProd, dim, p, p+1);
+
+  // two integrations with the same (default) seed must give the same result
+  double value[2], error[2];
+  bool ok = true;
+  for (int k = 0; k < 2; ++k) {
+     ROOT::Math::GSLMCIntegrator ig(ROOT::Math::MCIntegration::kVEGAS);
+     ig.SetFunction(funptr);
+     ig.SetNThreads(nthreads);
+     ig.Integral(a, b);
+     value[k] = ig.Result();
+     error[k] = ig.Error();
+     if (ig.Status() != 0) {
+        Error("testMCIntegration","VEGAS on %d threads failed with status %d",nthreads,ig.Status());
+        ok = false;
+     }
+  }
+  if (verbose) {
+     std::cout << "\nVEGAS on " << nthreads << " threads: " << value[0] << " +/- " << error[0]
+               << "\t exact: " << exact << std::endl;
+  }
+  if (!(error[0] > 0) || TMath::Abs(value[0]-exact) > 5 * error[0]) {
+     Error("testMCIntegration","Result of VEGAS on %d threads %f +/- %f is not consistent with %f",nthreads,value[0],error[0],exact);
+     ok = false;
+  }
+  if (value[0] != value[1] || error[0] != error[1]) {
+     Error("testMCIntegration","Result of VEGAS on %d threads is not reproducible: %f %f",nthreads,value[0],value[1]);
+     ok = false;
+  }
+  return ok;
+}
+
+
 int main(int argc, char **argv)
 {
    int status = 0;
@@ -367,7 +429,9 @@ int main(int argc, char **argv)
    if ( showGraphics )
       theApp = new TApplication("App",&argc,argv);
 
-   status = performance() ? 0 : 1;
+   bool ok = performance();
+   ok &= testVegasThreads();
+   status = ok ? 0 : 1;
 
    if ( showGraphics )
    {
@@ -35,6 +35,20 @@ ALLMAPS     += $(MATRIXMAP)
 # include all dependency files
 INCLUDEFILES += $(MATRIXDEP)
 
+# the blocked kernels of the products and of the LU and Cholesky decompositions
+# can optionally use OpenMP
+ifneq ($(USE_OPENMP),)
+$(call stripsrc,$(addprefix $(MATRIXDIRS)/,TMatrixTBase.o TMatrixT.o TMatrixTSym.o TDecompLU.o TDecompChol.o)): CXXFLAGS += -fopenmp
+$(MATRIXLIB): LDFLAGS += -fopenmp
+endif
+
+# the dense matrix products can optionally be delegated to a system CBLAS library,
+# e.g. make CBLASLIB=-lopenblas [CBLASINCDIR=/usr/include/openblas]
+ifneq ($(CBLASLIB),)
+$(MATRIXO): CXXFLAGS += -DCBLAS $(CBLASINCDIR:%=-I%)
+MATRIXLIBEXTRA += $(CBLASLIB)
+endif
+
 ##### local rules #####
 .PHONY:         all-$(MODNAME) clean-$(MODNAME) distclean-$(MODNAME)
 
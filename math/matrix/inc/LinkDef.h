@@ -15,6 +15,7 @@
 #pragma link off all functions;
 
 #pragma link C++ global gMatrixCheck;
+#pragma link C++ global gMatrixNThreads;
 
 #pragma link C++ namespace TMatrixTCramerInv;
 #pragma link C++ function  TMatrixTCramerInv::Inv2x2(TMatrixT<float>&,Double_t*);
@@ -27,11 +27,6 @@
 #include "TMatrixTUtils.h"
 #endif
 
-#ifdef CBLAS
-#include <vecLib/vBLAS.h>
-//#include <cblas.h>
-#endif
-
 
 template<class Element> class TMatrixTSym;
 template<class Element> class TMatrixTSparse;
@@ -91,6 +91,7 @@ template<class Element> class TElementActionT;
 template<class Element> class TElementPosActionT;
 
 R__EXTERN Int_t gMatrixCheck;
+R__EXTERN Int_t gMatrixNThreads;
 
 template<class Element> class TMatrixTBase : public TObject {
 
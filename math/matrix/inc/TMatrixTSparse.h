@@ -20,11 +20,6 @@
 #endif
 
 
-#ifdef CBLAS
-#include <vecLib/vBLAS.h>
-//#include <cblas.h>
-#endif
-
 //////////////////////////////////////////////////////////////////////////
 //                                                                      //
 // TMatrixTSparse                                                       //
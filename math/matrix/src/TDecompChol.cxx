@@ -26,6 +26,7 @@
 
 #include "TDecompChol.h"
 #include "TMath.h"
+#include "TMatrixTKernels.h"
 
 ClassImp(TDecompChol)
 
@@ -112,40 +113,93 @@ Bool_t TDecompChol::Decompose()
       return kFALSE;
    }
 
-   Int_t i,j,icol,irow;
+   // The rows of U are computed in blocks of kBlockRows rows: first the rows of
+   // the block are updated with all the rows already computed (the bulk of the
+   // operations, done for chunks of columns which are distributed over the threads),
+   // then the diagonal block is factorized and finally the rest of the rows of the
+   // block are updated with it (again in chunks of columns).
+   // Each element is computed with the same sequence of operations as in the
+   // unblocked algorithm, so the result does not depend on the blocking.
+
+   using TMatrixTKernels::kBlockRows;
+   using TMatrixTKernels::kBlockInner;
+   using TMatrixTKernels::kBlockCols;
+
    const Int_t     n  = fU.GetNrows();
          Double_t *pU = fU.GetMatrixArray();
-   for (icol = 0; icol < n; icol++) {
-      const Int_t rowOff = icol*n;
-
-      //Compute fU(j,j) and test for non-positive-definiteness.
-      Double_t ujj = pU[rowOff+icol];
-      for (irow = 0; irow < icol; irow++) {
-         const Int_t pos_ij = irow*n+icol;
-         ujj -= pU[pos_ij]*pU[pos_ij];
-      }
-      if (ujj <= 0) {
-         Error("Decompose()","matrix not positive definite");
-         return kFALSE;
+#ifdef _OPENMP
+   const Int_t nthreads = TMatrixTKernels::GetNThreads(Double_t(n)*n*n/6);
+#endif
+
+   for (Int_t row0 = 0; row0 < n; row0 += kBlockRows) {
+      const Int_t row1 = TMath::Min(row0+kBlockRows,n);
+
+      // u(irow,j) -= Sum_{i < row0} u(i,j)*u(i,irow) for irow in the block, j >= irow
+      Int_t nchunks = (n-row0+kBlockCols-1)/kBlockCols;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads) if(nthreads > 1)
+#endif
+      for (Int_t ichunk = 0; ichunk < nchunks; ichunk++) {
+         const Int_t col0 = row0+ichunk*kBlockCols;
+         const Int_t col1 = TMath::Min(col0+kBlockCols,n);
+         for (Int_t i0 = 0; i0 < row0; i0 += kBlockInner) {
+            const Int_t ni = TMath::Min(Int_t(kBlockInner),row0-i0);
+            for (Int_t irow = row0; irow < row1; irow++) {
+               const Int_t j0 = TMath::Max(col0,irow);
+               if (j0 < col1)
+                  TMatrixTKernels::MultRow(ni,pU+i0*n+irow,n,pU+i0*n+j0,n,pU+irow*n+j0,col1-j0,-1.);
+            }
+         }
       }
-      ujj = TMath::Sqrt(ujj);
-      pU[rowOff+icol] = ujj;
 
-      if (icol < n-1) {
-         for (j = icol+1; j < n; j++) {
-            for (i = 0; i < icol; i++) {
+      // factorize the diagonal block
+      for (Int_t icol = row0; icol < row1; icol++) {
+         const Int_t rowOff = icol*n;
+
+         //Compute fU(j,j) and test for non-positive-definiteness.
+         Double_t ujj = pU[rowOff+icol];
+         for (Int_t irow = row0; irow < icol; irow++) {
+            const Int_t pos_ij = irow*n+icol;
+            ujj -= pU[pos_ij]*pU[pos_ij];
+         }
+         if (ujj <= 0) {
+            Error("Decompose()","matrix not positive definite");
+            return kFALSE;
+         }
+         ujj = TMath::Sqrt(ujj);
+         pU[rowOff+icol] = ujj;
+
+         for (Int_t j = icol+1; j < row1; j++) {
+            for (Int_t i = row0; i < icol; i++) {
                const Int_t rowOff2 = i*n;
                pU[rowOff+j] -= pU[rowOff2+j]*pU[rowOff2+icol];
             }
          }
-         for (j = icol+1; j < n; j++)
+         for (Int_t j = icol+1; j < row1; j++)
             pU[rowOff+j] /= ujj;
       }
+
+      // u(irow,j) = (u(irow,j) - Sum_{row0 <= i < irow} u(i,j)*u(i,irow))/u(irow,irow) for j >= row1
+      nchunks = (n-row1+kBlockCols-1)/kBlockCols;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads) if(nthreads > 1)
+#endif
+      for (Int_t ichunk = 0; ichunk < nchunks; ichunk++) {
+         const Int_t col0 = row1+ichunk*kBlockCols;
+         const Int_t col1 = TMath::Min(col0+kBlockCols,n);
+         for (Int_t irow = row0; irow < row1; irow++) {
+            Double_t * const uj = pU+irow*n;
+            TMatrixTKernels::MultRow(irow-row0,pU+row0*n+irow,n,pU+row0*n+col0,n,uj+col0,col1-col0,-1.);
+            const Double_t ujj = uj[irow];
+            for (Int_t j = col0; j < col1; j++)
+               uj[j] /= ujj;
+         }
+      }
    }
 
-   for (irow = 0; irow < n; irow++) {
+   for (Int_t irow = 0; irow < n; irow++) {
       const Int_t rowOff = irow*n;
-      for (icol = 0; icol < irow; icol++)
+      for (Int_t icol = 0; icol < irow; icol++)
          pU[rowOff+icol] = 0.;
    }
 
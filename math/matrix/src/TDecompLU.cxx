@@ -11,6 +11,7 @@
 
 #include "TDecompLU.h"
 #include "TMath.h"
+#include "TMatrixTKernels.h"
 
 ClassImp(TDecompLU)
 
@@ -624,69 +625,112 @@ Bool_t TDecompLU::DecomposeLUCrout(TMatrixD &lu,Int_t *index,Double_t &sign,
       scale[i] = (max == 0.0 ? 0.0 : 1.0/max);
    }
 
-   for (Int_t j = 0; j < n; j++) {
-      const Int_t off_j = j*n;
-      // Run down jth column from top to diag, to form the elements of U.
-      for (Int_t i = 0; i < j; i++) {
-         const Int_t off_i = i*n;
-         Double_t r = pLU[off_i+j];
-         for (Int_t k = 0; k < i; k++) {
-            const Int_t off_k = k*n;
-            r -= pLU[off_i+k]*pLU[off_k+j];
-         }
-         pLU[off_i+j] = r;
-      }
+   // The columns are processed in panels of kBlockRows columns. The panel is
+   // factorized column by column as in the Crout algorithm, then the rows of U to
+   // the right of the panel and the remaining submatrix are updated with it (the
+   // bulk of the operations, distributed over the threads).
+   // Each element is computed with the same sequence of operations and the same
+   // pivots are chosen as in the unblocked algorithm.
 
-      // Run down jth subdiag to form the residuals after the elimination of
-      // the first j-1 subdiags.  These residuals divided by the appropriate
-      // diagonal term will become the multipliers in the elimination of the jth.
-      // subdiag. Find fIndex of largest scaled term in imax.
+   using TMatrixTKernels::kBlockRows;
+   using TMatrixTKernels::kBlockCols;
 
-      Double_t max = 0.0;
-      Int_t imax = 0;
-      for (Int_t i = j; i < n; i++) {
-         const Int_t off_i = i*n;
-         Double_t r = pLU[off_i+j];
-         for (Int_t k = 0; k < j; k++) {
-            const Int_t off_k = k*n;
-            r -= pLU[off_i+k]*pLU[off_k+j];
+#ifdef _OPENMP
+   const Int_t nthreads = TMatrixTKernels::GetNThreads(Double_t(n)*n*n/3);
+#endif
+
+   for (Int_t j0 = 0; j0 < n; j0 += kBlockRows) {
+      const Int_t j1 = TMath::Min(j0+kBlockRows,n);
+
+      for (Int_t j = j0; j < j1; j++) {
+         const Int_t off_j = j*n;
+         // Run down jth column from top to diag, to form the elements of U.
+         for (Int_t i = j0; i < j; i++) {
+            const Int_t off_i = i*n;
+            Double_t r = pLU[off_i+j];
+            for (Int_t k = j0; k < i; k++) {
+               const Int_t off_k = k*n;
+               r -= pLU[off_i+k]*pLU[off_k+j];
+            }
+            pLU[off_i+j] = r;
          }
-         pLU[off_i+j] = r;
-         const Double_t tmp = scale[i]*TMath::Abs(r);
-         if (tmp >= max) {
-            max = tmp;
-            imax = i;
+
+         // Run down jth subdiag to form the residuals after the elimination of
+         // the first j-1 subdiags.  These residuals divided by the appropriate
+         // diagonal term will become the multipliers in the elimination of the jth.
+         // subdiag. Find fIndex of largest scaled term in imax.
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) num_threads(nthreads) if(nthreads > 1 && n-j > kBlockCols)
+#endif
+         for (Int_t i = j; i < n; i++) {
+            const Int_t off_i = i*n;
+            Double_t r = pLU[off_i+j];
+            for (Int_t k = j0; k < j; k++) {
+               const Int_t off_k = k*n;
+               r -= pLU[off_i+k]*pLU[off_k+j];
+            }
+            pLU[off_i+j] = r;
          }
-      }
 
-      // Permute current row with imax
-      if (j != imax) {
-         const Int_t off_imax = imax*n;
-         for (Int_t k = 0; k < n; k++ ) {
-            const Double_t tmp = pLU[off_imax+k];
-            pLU[off_imax+k] = pLU[off_j+k];
-            pLU[off_j+k]    = tmp;
+         Double_t max = 0.0;
+         Int_t imax = 0;
+         for (Int_t i = j; i < n; i++) {
+            const Double_t tmp = scale[i]*TMath::Abs(pLU[i*n+j]);
+            if (tmp >= max) {
+               max = tmp;
+               imax = i;
+            }
          }
-         sign = -sign;
-         scale[imax] = scale[j];
-      }
-      index[j] = imax;
 
-      // If diag term is not zero divide subdiag to form multipliers.
-      if (pLU[off_j+j] != 0.0) {
-         if (TMath::Abs(pLU[off_j+j]) < tol)
-            nrZeros++;
-         if (j != n-1) {
-            const Double_t tmp = 1.0/pLU[off_j+j];
-            for (Int_t i = j+1; i < n; i++) {
-               const Int_t off_i = i*n;
-               pLU[off_i+j] *= tmp;
+         // Permute current row with imax
+         if (j != imax) {
+            const Int_t off_imax = imax*n;
+            for (Int_t k = 0; k < n; k++ ) {
+               const Double_t tmp = pLU[off_imax+k];
+               pLU[off_imax+k] = pLU[off_j+k];
+               pLU[off_j+k]    = tmp;
             }
+            sign = -sign;
+            scale[imax] = scale[j];
          }
-      } else {
-         ::Error("TDecompLU::DecomposeLUCrout","matrix is singular");
-         if (isAllocated)  delete [] scale;
-         return kFALSE;
+         index[j] = imax;
+
+         // If diag term is not zero divide subdiag to form multipliers.
+         if (pLU[off_j+j] != 0.0) {
+            if (TMath::Abs(pLU[off_j+j]) < tol)
+               nrZeros++;
+            if (j != n-1) {
+               const Double_t tmp = 1.0/pLU[off_j+j];
+               for (Int_t i = j+1; i < n; i++) {
+                  const Int_t off_i = i*n;
+                  pLU[off_i+j] *= tmp;
+               }
+            }
+         } else {
+            ::Error("TDecompLU::DecomposeLUCrout","matrix is singular");
+            if (isAllocated)  delete [] scale;
+            return kFALSE;
+         }
+      }
+
+      if (j1 == n) break;
+
+      // Rows j0..j1-1 of U to the right of the panel :
+      //   lu(i,j) -= Sum_{j0 <= k < i} lu(i,k)*lu(k,j)
+      // and remaining submatrix :
+      //   lu(i,j) -= Sum_{j0 <= k < j1} lu(i,k)*lu(k,j) for i,j >= j1
+      const Int_t nchunks = (n-j1+kBlockCols-1)/kBlockCols;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads) if(nthreads > 1)
+#endif
+      for (Int_t ichunk = 0; ichunk < nchunks; ichunk++) {
+         const Int_t col0 = j1+ichunk*kBlockCols;
+         const Int_t ncol = TMath::Min(Int_t(kBlockCols),n-col0);
+         for (Int_t i = j0+1; i < j1; i++)
+            TMatrixTKernels::MultRow(i-j0,pLU+i*n+j0,1,pLU+j0*n+col0,n,pLU+i*n+col0,ncol,-1.);
+         for (Int_t i = j1; i < n; i++)
+            TMatrixTKernels::MultRow(j1-j0,pLU+i*n+j0,1,pLU+j0*n+col0,n,pLU+i*n+col0,ncol,-1.);
       }
    }
 
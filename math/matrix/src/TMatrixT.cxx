@@ -18,7 +18,6 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include <iostream>
-#include <typeinfo>
 
 #include "TMatrixT.h"
 #include "TMatrixTSym.h"
@@ -28,6 +27,7 @@
 #include "TMatrixDEigen.h"
 #include "TClass.h"
 #include "TMath.h"
+#include "TMatrixTKernels.h"
 
 templateClassImp(TMatrixT)
 
@@ -655,19 +655,6 @@ void TMatrixT<Element>::Mult(const TMatrixT<Element> &a,const TMatrixT<Element>
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemm (CblasRowMajor,CblasNoTrans,CblasNoTrans,fNrows,fNcols,a.GetNcols(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemm (CblasRowMajor,CblasNoTrans,CblasNoTrans,fNrows,fNcols,a.GetNcols(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else
-      Error("Mult","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t na     = a.GetNoElements();
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
@@ -677,7 +664,6 @@ void TMatrixT<Element>::Mult(const TMatrixT<Element> &a,const TMatrixT<Element>
          Element *       cp = this->GetMatrixArray();
 
    AMultB(ap,na,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -706,19 +692,6 @@ void TMatrixT<Element>::Mult(const TMatrixTSym<Element> &a,const TMatrixT<Elemen
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dsymm (CblasRowMajor,CblasLeft,CblasUpper,fNrows,fNcols,1.0,
-                   ap,a.GetNcols(),bp,b.GetNcols(),0.0,cp,fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_ssymm (CblasRowMajor,CblasLeft,CblasUpper,fNrows,fNcols,1.0,
-                   ap,a.GetNcols(),bp,b.GetNcols(),0.0,cp,fNcols);
-   else
-      Error("Mult","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t na     = a.GetNoElements();
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
@@ -729,7 +702,6 @@ void TMatrixT<Element>::Mult(const TMatrixTSym<Element> &a,const TMatrixT<Elemen
 
    AMultB(ap,na,ncolsa,bp,nb,ncolsb,cp);
 
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -758,19 +730,6 @@ void TMatrixT<Element>::Mult(const TMatrixT<Element> &a,const TMatrixTSym<Elemen
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dsymm (CblasRowMajor,CblasRight,CblasUpper,fNrows,fNcols,1.0,
-                   bp,b.GetNcols(),ap,a.GetNcols(),0.0,cp,fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_ssymm (CblasRowMajor,CblasRight,CblasUpper,fNrows,fNcols,1.0,
-                   bp,b.GetNcols(),ap,a.GetNcols(),0.0,cp,fNcols);
-   else
-      Error("Mult","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t na     = a.GetNoElements();
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
@@ -780,7 +739,6 @@ void TMatrixT<Element>::Mult(const TMatrixT<Element> &a,const TMatrixTSym<Elemen
          Element *       cp = this->GetMatrixArray();
 
    AMultB(ap,na,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -810,19 +768,6 @@ void TMatrixT<Element>::Mult(const TMatrixTSym<Element> &a,const TMatrixTSym<Ele
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dsymm (CblasRowMajor,CblasLeft,CblasUpper,fNrows,fNcols,1.0,
-                   ap,a.GetNcols(),bp,b.GetNcols(),0.0,cp,fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_ssymm (CblasRowMajor,CblasLeft,CblasUpper,fNrows,fNcols,1.0,
-                   ap,a.GetNcols(),bp,b.GetNcols(),0.0,cp,fNcols);
-   else
-      Error("Mult","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t na     = a.GetNoElements();
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
@@ -832,7 +777,6 @@ void TMatrixT<Element>::Mult(const TMatrixTSym<Element> &a,const TMatrixTSym<Ele
          Element *       cp = this->GetMatrixArray();
 
    AMultB(ap,na,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -861,19 +805,6 @@ void TMatrixT<Element>::TMult(const TMatrixT<Element> &a,const TMatrixT<Element>
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemm (CblasRowMajor,CblasTrans,CblasNoTrans,this->fNrows,this->fNcols,a.GetNrows(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,this->fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemm (CblasRowMajor,CblasTrans,CblasNoTrans,fNrows,fNcols,a.GetNrows(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else
-      Error("TMult","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
    const Int_t ncolsb = b.GetNcols();
@@ -882,7 +813,6 @@ void TMatrixT<Element>::TMult(const TMatrixT<Element> &a,const TMatrixT<Element>
          Element *       cp = this->GetMatrixArray();
 
    AtMultB(ap,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -911,19 +841,6 @@ void TMatrixT<Element>::TMult(const TMatrixT<Element> &a,const TMatrixTSym<Eleme
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemm (CblasRowMajor,CblasTrans,CblasNoTrans,fNrows,fNcols,a.GetNrows(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemm (CblasRowMajor,CblasTrans,CblasNoTrans,fNrows,fNcols,a.GetNrows(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else
-      Error("TMult","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
    const Int_t ncolsb = b.GetNcols();
@@ -932,7 +849,6 @@ void TMatrixT<Element>::TMult(const TMatrixT<Element> &a,const TMatrixTSym<Eleme
          Element *       cp = this->GetMatrixArray();
 
    AtMultB(ap,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -961,19 +877,6 @@ void TMatrixT<Element>::MultT(const TMatrixT<Element> &a,const TMatrixT<Element>
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemm (CblasRowMajor,CblasNoTrans,CblasTrans,fNrows,fNcols,a.GetNcols(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemm (CblasRowMajor,CblasNoTrans,CblasTrans,fNrows,fNcols,a.GetNcols(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else
-      Error("MultT","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t na     = a.GetNoElements();
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
@@ -983,7 +886,6 @@ void TMatrixT<Element>::MultT(const TMatrixT<Element> &a,const TMatrixT<Element>
          Element *       cp = this->GetMatrixArray();
 
    AMultBt(ap,na,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1012,19 +914,6 @@ void TMatrixT<Element>::MultT(const TMatrixTSym<Element> &a,const TMatrixT<Eleme
       }
    }
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemm (CblasRowMajor,CblasNoTrans,CblasTrans,this->fNrows,this->fNcols,a.GetNcols(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,this->fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemm (CblasRowMajor,CblasNoTrans,CblasTrans,fNrows,fNcols,a.GetNcols(),
-                   1.0,ap,a.GetNcols(),bp,b.GetNcols(),1.0,cp,fNcols);
-   else
-      Error("MultT","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Int_t na     = a.GetNoElements();
    const Int_t nb     = b.GetNoElements();
    const Int_t ncolsa = a.GetNcols();
@@ -1034,7 +923,6 @@ void TMatrixT<Element>::MultT(const TMatrixTSym<Element> &a,const TMatrixT<Eleme
          Element *       cp = this->GetMatrixArray();
 
    AMultBt(ap,na,ncolsa,bp,nb,ncolsb,cp);
-#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3063,25 +2951,23 @@ TMatrixT<Element> &ElementDiv(TMatrixT<Element> &target,const TMatrixTSym<Elemen
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Elementary routine to calculate matrix multiplication A*B
+/// (see TMatrixTKernels.h for the blocked and multi-threaded kernel)
 
 template<class Element>
 void AMultB(const Element * const ap,Int_t na,Int_t ncolsa,
             const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
-   const Element *arp0 = ap;                     // Pointer to  A[i,0];
-   while (arp0 < ap+na) {
-      for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of B, Start bcp = B[0,0]
-         const Element *arp = arp0;                       // Pointer to the i-th row of A, reset to A[i,0]
-         Element cij = 0;
-         while (bcp < bp+nb) {                     // Scan the i-th row of A and
-            cij += *arp++ * *bcp;                   // the j-th col of B
-            bcp += ncolsb;
-         }
-         *cp++ = cij;
-         bcp -= nb-1;                              // Set bcp to the (j+1)-th col
-      }
-      arp0 += ncolsa;                             // Set ap to the (i+1)-th row
+   if (ncolsa == 0 || ncolsb == 0) return;
+   const Int_t nrowsa = na/ncolsa;
+   const Int_t nrowsb = nb/ncolsb;
+
+#ifdef CBLAS
+   if (Double_t(nrowsa)*ncolsb*nrowsb >= TMatrixTKernels::kMinBlockedOps) {
+      TMatrixTKernels::Gemm(kFALSE,kFALSE,nrowsa,ncolsb,nrowsb,ap,ncolsa,bp,ncolsb,cp,ncolsb);
+      return;
    }
+#endif
+   TMatrixTKernels::Mult(nrowsa,ncolsb,nrowsb,ap,ncolsa,1,bp,ncolsb,cp,ncolsb,kFALSE);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3091,21 +2977,16 @@ template<class Element>
 void AtMultB(const Element * const ap,Int_t ncolsa,
              const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
-   const Element *acp0 = ap;           // Pointer to  A[i,0];
-   while (acp0 < ap+ncolsa) {
-      for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of B, Start bcp = B[0,0]
-         const Element *acp = acp0;                       // Pointer to the i-th column of A, reset to A[0,i]
-         Element cij = 0;
-         while (bcp < bp+nb) {           // Scan the i-th column of A and
-            cij += *acp * *bcp;           // the j-th col of B
-            acp += ncolsa;
-            bcp += ncolsb;
-         }
-         *cp++ = cij;
-         bcp -= nb-1;                    // Set bcp to the (j+1)-th col
-      }
-      acp0++;                           // Set acp0 to the (i+1)-th col
+   if (ncolsa == 0 || ncolsb == 0) return;
+   const Int_t nrowsb = nb/ncolsb;
+
+#ifdef CBLAS
+   if (Double_t(ncolsa)*ncolsb*nrowsb >= TMatrixTKernels::kMinBlockedOps) {
+      TMatrixTKernels::Gemm(kTRUE,kFALSE,ncolsa,ncolsb,nrowsb,ap,ncolsa,bp,ncolsb,cp,ncolsb);
+      return;
    }
+#endif
+   TMatrixTKernels::Mult(ncolsa,ncolsb,nrowsb,ap,1,ncolsa,bp,ncolsb,cp,ncolsb,kFALSE);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3115,20 +2996,17 @@ template<class Element>
 void AMultBt(const Element * const ap,Int_t na,Int_t ncolsa,
              const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
-   const Element *arp0 = ap;                    // Pointer to  A[i,0];
-   while (arp0 < ap+na) {
-      const Element *brp0 = bp;                  // Pointer to  B[j,0];
-      while (brp0 < bp+nb) {
-         const Element *arp = arp0;               // Pointer to the i-th row of A, reset to A[i,0]
-         const Element *brp = brp0;               // Pointer to the j-th row of B, reset to B[j,0]
-         Element cij = 0;
-         while (brp < brp0+ncolsb)                 // Scan the i-th row of A and
-            cij += *arp++ * *brp++;                 // the j-th row of B
-         *cp++ = cij;
-         brp0 += ncolsb;                           // Set brp0 to the (j+1)-th row
-      }
-      arp0 += ncolsa;                             // Set arp0 to the (i+1)-th row
+   if (ncolsa == 0) return;
+   const Int_t nrowsa = na/ncolsa;
+   const Int_t nrowsb = nb/ncolsb;
+
+#ifdef CBLAS
+   if (Double_t(nrowsa)*nrowsb*ncolsa >= TMatrixTKernels::kMinBlockedOps) {
+      TMatrixTKernels::Gemm(kFALSE,kTRUE,nrowsa,nrowsb,ncolsa,ap,ncolsa,bp,ncolsb,cp,nrowsb);
+      return;
    }
+#endif
+   TMatrixTKernels::MultBt(nrowsa,nrowsb,ncolsa,ap,bp,cp,nrowsb,kFALSE);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
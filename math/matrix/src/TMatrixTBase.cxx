@@ -189,6 +189,19 @@
 //    recipe and makes the matrix haar() right in place. No matrix      //
 //    element is moved whatsoever!                                      //
 //                                                                      //
+// 7. Large matrices: the products (Mult, TMult, MultT, Similarity)     //
+//    and the LU and Cholesky decompositions use cache-blocked kernels  //
+//    which give exactly the same results as the simple loops. When     //
+//    the library is compiled with OpenMP (USE_OPENMP), they are split  //
+//    over gMatrixNThreads threads (default 1, 0 = all the available    //
+//    threads) for matrices larger than about 100x100:                  //
+//       gMatrixNThreads = 8;                                           //
+//       TMatrixDSym cov(TMatrixDSym::kAtA,a);                          //
+//    With the configure option cblas the general products are          //
+//    delegated to the system CBLAS library (e.g. OpenBLAS); they then  //
+//    agree with the simple loops only within rounding errors.          //
+//    The benchmark $ROOTSYS/test/benchLinear.cxx compares the times.   //
+//                                                                      //
 //////////////////////////////////////////////////////////////////////////
 
 //////////////////////////////////////////////////////////////////////////
@@ -207,9 +220,31 @@
 #include "TROOT.h"
 #include "TClass.h"
 #include "TMath.h"
+#include "TMatrixTKernels.h"
 #include <limits.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 Int_t gMatrixCheck = 1;
+Int_t gMatrixNThreads = 1;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Number of threads used by a matrix kernel performing nops multiply-adds:
+/// gMatrixNThreads (all the available threads if gMatrixNThreads <= 0) for
+/// large problems, 1 for small ones or if the library is compiled without OpenMP.
+
+Int_t TMatrixTKernels::GetNThreads(Double_t nops)
+{
+#ifdef _OPENMP
+   if (nops < kMinThreadOps) return 1;
+   return (gMatrixNThreads > 0) ? gMatrixNThreads : omp_get_max_threads();
+#else
+   (void) nops;
+   return 1;
+#endif
+}
 
 templateClassImp(TMatrixTBase)
 
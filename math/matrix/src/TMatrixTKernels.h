@@ -0,0 +1,263 @@
+// @(#)root/matrix:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2000, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TMatrixTKernels
+#define ROOT_TMatrixTKernels
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TMatrixTKernels                                                      //
+//                                                                      //
+// Cache-blocked kernels of the dense matrix products, used by the      //
+// matrix classes and by the decompositions (internal header).          //
+//                                                                      //
+// The products are computed row by row: a row of C is updated with     //
+// a few rows of B at a time, such that the inner loop runs over        //
+// contiguous elements and is vectorized by the compiler, and the       //
+// rows of B are reused from the cache for a block of rows of C.        //
+// Each element c[i,j] is still accumulated in increasing k starting    //
+// from zero, i.e. with exactly the same operations as the simple       //
+// loops, so the results do not depend on the blocking nor on the       //
+// number of threads.                                                   //
+//                                                                      //
+// For large matrices the blocks of rows of C are distributed over      //
+// gMatrixNThreads threads when the library is compiled with OpenMP.    //
+// If compiled with -DCBLAS the general products are delegated to the   //
+// system CBLAS library. CBLAS sums the products in its own order, so   //
+// these results agree with the simple loops only within rounding       //
+// errors and may depend on the number of BLAS threads.                 //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef ROOT_Rtypes
+#include "Rtypes.h"
+#endif
+#ifndef ROOT_TMath
+#include "TMath.h"
+#endif
+
+#ifdef CBLAS
+#include <cblas.h>
+#endif
+
+namespace TMatrixTKernels {
+
+   enum {
+      kBlockRows  = 64,   // rows of C computed together (and unit of work of a thread)
+      kBlockInner = 128,  // rows of B (columns of A) used together
+      kBlockCols  = 256   // columns of B and C used together
+   };
+
+   // products with fewer multiply-adds use the simple loops
+   const Double_t kMinBlockedOps = 4096;
+   // products with fewer multiply-adds are not split over threads
+   const Double_t kMinThreadOps  = 1.e6;
+
+   Int_t GetNThreads(Double_t nops);
+
+   /////////////////////////////////////////////////////////////////////////////
+   /// c[j] += sign * Sum_k a[k*as] * b[k*ldb+j]  for j < nj and k < nk
+   /// The sum for each c[j] is done in increasing k; sign is +1 or -1.
+
+   template<class Element>
+   inline void MultRow(Int_t nk,const Element *a,Int_t as,const Element *b,Int_t ldb,
+                       Element *c,Int_t nj,Element sign)
+   {
+      Int_t k = 0;
+      for ( ; k+4 <= nk; k += 4) {
+         const Element a0 = sign*a[k*as];
+         const Element a1 = sign*a[(k+1)*as];
+         const Element a2 = sign*a[(k+2)*as];
+         const Element a3 = sign*a[(k+3)*as];
+         const Element *b0 = b+k*ldb;
+         const Element *b1 = b0+ldb;
+         const Element *b2 = b1+ldb;
+         const Element *b3 = b2+ldb;
+         for (Int_t j = 0; j < nj; j++)
+            c[j] = (((c[j]+a0*b0[j])+a1*b1[j])+a2*b2[j])+a3*b3[j];
+      }
+      for ( ; k < nk; k++) {
+         const Element a0 = sign*a[k*as];
+         const Element *b0 = b+k*ldb;
+         for (Int_t j = 0; j < nj; j++)
+            c[j] += a0*b0[j];
+      }
+   }
+
+   /////////////////////////////////////////////////////////////////////////////
+   /// Same as MultRow for the two rows c and c+ldc, with a[i,k] = a[i*ais+k*as] for i = 0,1
+   /// (the rows of B are used for both rows of C while in the registers)
+
+   template<class Element>
+   inline void MultRow2(Int_t nk,const Element *a,Int_t ais,Int_t as,const Element *b,Int_t ldb,
+                        Element *c,Int_t ldc,Int_t nj,Element sign)
+   {
+      const Element *a_1 = a+ais;
+            Element *c_1 = c+ldc;
+      Int_t k = 0;
+      for ( ; k+4 <= nk; k += 4) {
+         const Element a0 = sign*a[k*as];
+         const Element a1 = sign*a[(k+1)*as];
+         const Element a2 = sign*a[(k+2)*as];
+         const Element a3 = sign*a[(k+3)*as];
+         const Element a0_1 = sign*a_1[k*as];
+         const Element a1_1 = sign*a_1[(k+1)*as];
+         const Element a2_1 = sign*a_1[(k+2)*as];
+         const Element a3_1 = sign*a_1[(k+3)*as];
+         const Element *b0 = b+k*ldb;
+         const Element *b1 = b0+ldb;
+         const Element *b2 = b1+ldb;
+         const Element *b3 = b2+ldb;
+         for (Int_t j = 0; j < nj; j++) {
+            c[j]   = (((c[j]  +a0  *b0[j])+a1  *b1[j])+a2  *b2[j])+a3  *b3[j];
+            c_1[j] = (((c_1[j]+a0_1*b0[j])+a1_1*b1[j])+a2_1*b2[j])+a3_1*b3[j];
+         }
+      }
+      for ( ; k < nk; k++) {
+         const Element a0   = sign*a[k*as];
+         const Element a0_1 = sign*a_1[k*as];
+         const Element *b0 = b+k*ldb;
+         for (Int_t j = 0; j < nj; j++) {
+            c[j]   += a0*b0[j];
+            c_1[j] += a0_1*b0[j];
+         }
+      }
+   }
+
+   /////////////////////////////////////////////////////////////////////////////
+   /// C = A * B  with C (ni x nj), A (ni x nk) and B (nk x nj)
+   /// Element a[i,k] is ap[i*ais+k*aks], b[k,j] is bp[k*ldb+j] and c[i,j] is cp[i*ldc+j]
+   /// (A^T is used by swapping the strides ais and aks).
+   /// If upper is true, only the elements with j >= i are computed.
+
+   template<class Element>
+   void Mult(Int_t ni,Int_t nj,Int_t nk,const Element *ap,Int_t ais,Int_t aks,
+             const Element *bp,Int_t ldb,Element *cp,Int_t ldc,Bool_t upper)
+   {
+      const Double_t nops = Double_t(ni)*nj*nk;
+      if (nops < kMinBlockedOps) {
+         for (Int_t i = 0; i < ni; i++) {
+            for (Int_t j = (upper ? i : 0); j < nj; j++) {
+               Element cij = 0;
+               for (Int_t k = 0; k < nk; k++)
+                  cij += ap[i*ais+k*aks]*bp[k*ldb+j];
+               cp[i*ldc+j] = cij;
+            }
+         }
+         return;
+      }
+
+      const Int_t nblocks  = (ni+kBlockRows-1)/kBlockRows;
+#ifdef _OPENMP
+      const Int_t nthreads = GetNThreads(upper ? nops/2 : nops);
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads) if(nthreads > 1)
+#endif
+      for (Int_t ib = 0; ib < nblocks; ib++) {
+         const Int_t i0 = ib*kBlockRows;
+         const Int_t i1 = TMath::Min(i0+kBlockRows,ni);
+         for (Int_t i = i0; i < i1; i++)
+            for (Int_t j = (upper ? i : 0); j < nj; j++)
+               cp[i*ldc+j] = 0;
+         for (Int_t j0 = (upper ? i0 : 0); j0 < nj; j0 += kBlockCols) {
+            const Int_t j1 = TMath::Min(j0+kBlockCols,nj);
+            for (Int_t k0 = 0; k0 < nk; k0 += kBlockInner) {
+               const Int_t nkb = TMath::Min(Int_t(kBlockInner),nk-k0);
+               Int_t i = i0;
+               if (!upper) {
+                  for ( ; i+2 <= i1; i += 2)
+                     MultRow2(nkb,ap+i*ais+k0*aks,ais,aks,bp+k0*ldb+j0,ldb,cp+i*ldc+j0,ldc,j1-j0,Element(1));
+               }
+               for ( ; i < i1; i++) {
+                  const Int_t js = (upper ? TMath::Max(i,j0) : j0);
+                  if (js < j1)
+                     MultRow(nkb,ap+i*ais+k0*aks,aks,bp+k0*ldb+js,ldb,cp+i*ldc+js,j1-js,Element(1));
+               }
+            }
+         }
+      }
+   }
+
+   /////////////////////////////////////////////////////////////////////////////
+   /// C = A * B^T  with C (ni x nj), A (ni x nk) and B (nj x nk) stored row-wise
+   /// For large matrices B is first transposed, to access both matrices row-wise.
+   /// If upper is true, only the elements with j >= i are computed.
+
+   template<class Element>
+   void MultBt(Int_t ni,Int_t nj,Int_t nk,const Element *ap,const Element *bp,
+               Element *cp,Int_t ldc,Bool_t upper)
+   {
+      if (Double_t(ni)*nj*nk < kMinBlockedOps) {
+         for (Int_t i = 0; i < ni; i++) {
+            for (Int_t j = (upper ? i : 0); j < nj; j++) {
+               Element cij = 0;
+               for (Int_t k = 0; k < nk; k++)
+                  cij += ap[i*nk+k]*bp[j*nk+k];
+               cp[i*ldc+j] = cij;
+            }
+         }
+         return;
+      }
+
+      Element *btp = new Element[nj*nk];
+      for (Int_t j = 0; j < nj; j++)
+         for (Int_t k = 0; k < nk; k++)
+            btp[k*nj+j] = bp[j*nk+k];
+
+      Mult(ni,nj,nk,ap,nk,1,btp,nj,cp,ldc,upper);
+
+      delete [] btp;
+   }
+
+   /////////////////////////////////////////////////////////////////////////////
+   /// Copy the upper triangle of the (n x n) matrix into the lower one
+
+   template<class Element>
+   void SymmetrizeUpper(Int_t n,Element *cp)
+   {
+      for (Int_t i = 1; i < n; i++)
+         for (Int_t j = 0; j < i; j++)
+            cp[i*n+j] = cp[j*n+i];
+   }
+
+#ifdef CBLAS
+   /////////////////////////////////////////////////////////////////////////////
+   /// C = op(A) * op(B) (row-wise storage) with the CBLAS library
+
+   inline void Gemm(Bool_t transa,Bool_t transb,Int_t m,Int_t n,Int_t k,const Double_t *ap,Int_t lda,
+                    const Double_t *bp,Int_t ldb,Double_t *cp,Int_t ldc)
+   {
+      cblas_dgemm(CblasRowMajor,(transa ? CblasTrans : CblasNoTrans),(transb ? CblasTrans : CblasNoTrans),
+                  m,n,k,1.0,ap,lda,bp,ldb,0.0,cp,ldc);
+   }
+
+   inline void Gemm(Bool_t transa,Bool_t transb,Int_t m,Int_t n,Int_t k,const Float_t *ap,Int_t lda,
+                    const Float_t *bp,Int_t ldb,Float_t *cp,Int_t ldc)
+   {
+      cblas_sgemm(CblasRowMajor,(transa ? CblasTrans : CblasNoTrans),(transb ? CblasTrans : CblasNoTrans),
+                  m,n,k,1.0f,ap,lda,bp,ldb,0.0f,cp,ldc);
+   }
+
+   /////////////////////////////////////////////////////////////////////////////
+   /// Upper triangle of C = A^T * A (row-wise storage) with the CBLAS library
+
+   inline void Syrk(Int_t n,Int_t k,const Double_t *ap,Int_t lda,Double_t *cp,Int_t ldc)
+   {
+      cblas_dsyrk(CblasRowMajor,CblasUpper,CblasTrans,n,k,1.0,ap,lda,0.0,cp,ldc);
+   }
+
+   inline void Syrk(Int_t n,Int_t k,const Float_t *ap,Int_t lda,Float_t *cp,Int_t ldc)
+   {
+      cblas_ssyrk(CblasRowMajor,CblasUpper,CblasTrans,n,k,1.0f,ap,lda,0.0f,cp,ldc);
+   }
+#endif
+
+}
+
+#endif
@@ -28,6 +28,7 @@
 #include "TMatrixDSymEigen.h"
 #include "TClass.h"
 #include "TMath.h"
+#include "TMatrixTKernels.h"
 
 templateClassImp(TMatrixTSym)
 
@@ -378,43 +379,20 @@ void TMatrixTSym<Element>::TMult(const TMatrixT<Element> &a)
 {
    R__ASSERT(a.IsValid());
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemm (CblasRowMajor,CblasTrans,CblasNoTrans,this->fNrows,this->fNcols,a.GetNrows(),
-                   1.0,ap,a.GetNcols(),ap,a.GetNcols(),1.0,cp,this->fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemm (CblasRowMajor,CblasTrans,CblasNoTrans,fNrows,fNcols,a.GetNrows(),
-                   1.0,ap,a.GetNcols(),ap,a.GetNcols(),1.0,cp,fNcols);
-  else
-      Error("TMult","type %s not implemented in BLAS library",typeid(Element));
-#else
-   const Int_t nb     = a.GetNoElements();
+   const Int_t nrowsa = a.GetNrows();
    const Int_t ncolsa = a.GetNcols();
-   const Int_t ncolsb = ncolsa;
-  const Element * const ap = a.GetMatrixArray();
-   const Element * const bp = ap;
+   const Element * const ap = a.GetMatrixArray();
          Element *       cp = this->GetMatrixArray();
 
-   const Element *acp0 = ap;           // Pointer to  A[i,0];
-   while (acp0 < ap+a.GetNcols()) {
-      for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of A, Start bcp = A[0,0]
-         const Element *acp = acp0;                       // Pointer to the i-th column of A, reset to A[0,i]
-         Element cij = 0;
-         while (bcp < bp+nb) {           // Scan the i-th column of A and
-            cij += *acp * *bcp;           // the j-th col of A
-            acp += ncolsa;
-            bcp += ncolsb;
-         }
-         *cp++ = cij;
-         bcp -= nb-1;                    // Set bcp to the (j+1)-th col
-      }
-      acp0++;                           // Set acp0 to the (i+1)-th col
-   }
-
-   R__ASSERT(cp == this->GetMatrixArray()+this->fNelems && acp0 == ap+ncolsa);
+   // only the upper triangle is computed
+#ifdef CBLAS
+   if (Double_t(ncolsa)*ncolsa*nrowsa >= TMatrixTKernels::kMinBlockedOps)
+      TMatrixTKernels::Syrk(ncolsa,nrowsa,ap,ncolsa,cp,ncolsa);
+   else
 #endif
+      TMatrixTKernels::Mult(ncolsa,ncolsa,nrowsa,ap,1,ncolsa,ap,ncolsa,cp,ncolsa,kTRUE);
+
+   TMatrixTKernels::SymmetrizeUpper(ncolsa,cp);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -426,43 +404,19 @@ void TMatrixTSym<Element>::TMult(const TMatrixTSym<Element> &a)
 {
    R__ASSERT(a.IsValid());
 
-#ifdef CBLAS
-   const Element *ap = a.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dsymm (CblasRowMajor,CblasLeft,CblasUpper,this->fNrows,this->fNcols,1.0,
-                   ap,a.GetNcols(),ap,a.GetNcols(),0.0,cp,this->fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_ssymm (CblasRowMajor,CblasLeft,CblasUpper,fNrows,fNcols,1.0,
-                   ap1,a.GetNcols(),ap,a.GetNcols(),0.0,cp,fNcols);
-   else
-      Error("TMult","type %s not implemented in BLAS library",typeid(Element));
-#else
-   const Int_t nb     = a.GetNoElements();
-   const Int_t ncolsa = a.GetNcols();
-   const Int_t ncolsb = ncolsa;
+   const Int_t n = a.GetNcols();
    const Element * const ap = a.GetMatrixArray();
-   const Element * const bp = ap;
          Element *       cp = this->GetMatrixArray();
 
-   const Element *acp0 = ap;           // Pointer to  A[i,0];
-   while (acp0 < ap+a.GetNcols()) {
-      for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of A, Start bcp = A[0,0]
-         const Element *acp = acp0;                       // Pointer to the i-th column of A, reset to A[0,i]
-         Element cij = 0;
-         while (bcp < bp+nb) {           // Scan the i-th column of A and
-            cij += *acp * *bcp;           // the j-th col of A
-            acp += ncolsa;
-            bcp += ncolsb;
-         }
-         *cp++ = cij;
-         bcp -= nb-1;                    // Set bcp to the (j+1)-th col
-      }
-      acp0++;                           // Set acp0 to the (i+1)-th col
-   }
-
-   R__ASSERT(cp == this->GetMatrixArray()+this->fNelems && acp0 == ap+ncolsa);
+   // only the upper triangle is computed
+#ifdef CBLAS
+   if (Double_t(n)*n*n >= TMatrixTKernels::kMinBlockedOps)
+      TMatrixTKernels::Syrk(n,n,ap,n,cp,n);
+   else
 #endif
+      TMatrixTKernels::Mult(n,n,n,ap,1,n,ap,n,cp,n,kTRUE);
+
+   TMatrixTKernels::SymmetrizeUpper(n,cp);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1123,52 +1077,10 @@ TMatrixTSym<Element> &TMatrixTSym<Element>::Similarity(const TMatrixT<Element> &
    if (nrowsb != this->fNrows)
       this->ResizeTo(nrowsb,nrowsb);
 
-#ifdef CBLAS
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemm (CblasRowMajor,CblasNoTrans,CblasTrans,this->fNrows,this->fNcols,ba.GetNcols(),
-                   1.0,bap,ba.GetNcols(),bp,b.GetNcols(),1.0,cp,this->fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemm (CblasRowMajor,CblasNoTrans,CblasTrans,this->fNrows,this->fNcols,ba.GetNcols(),
-                   1.0,bap,ba.GetNcols(),bp,b.GetNcols(),1.0,cp,this->fNcols);
-   else
-      Error("Similarity","type %s not implemented in BLAS library",typeid(Element));
-#else
-   const Int_t nba     = nrowsb*ncolsa;
-   const Int_t ncolsba = ncolsa;
-   const Element *       bi1p = bp;
-         Element *       cp   = this->GetMatrixArray();
-         Element * const cp0  = cp;
-
-   Int_t ishift = 0;
-   const Element *barp0 = bap;
-   while (barp0 < bap+nba) {
-      const Element *brp0 = bi1p;
-      while (brp0 < bp+nb) {
-         const Element *barp = barp0;
-         const Element *brp  = brp0;
-         Element cij = 0;
-         while (brp < brp0+ncolsb)
-            cij += *barp++ * *brp++;
-         *cp++ = cij;
-         brp0 += ncolsb;
-      }
-      barp0 += ncolsba;
-      bi1p += ncolsb;
-      cp += ++ishift;
-   }
-
-   R__ASSERT(cp == cp0+this->fNelems+ishift && barp0 == bap+nba);
-
-   cp = cp0;
-   for (Int_t irow = 0; irow < this->fNrows; irow++) {
-      const Int_t rowOff1 = irow*this->fNrows;
-      for (Int_t icol = 0; icol < irow; icol++) {
-         const Int_t rowOff2 = icol*this->fNrows;
-         cp[rowOff1+icol] = cp[rowOff2+irow];
-      }
-   }
-#endif
+   // upper triangle of (B*A)*B^T
+   Element * const cp = this->GetMatrixArray();
+   TMatrixTKernels::MultBt(nrowsb,nrowsb,ncolsb,bap,bp,cp,nrowsb,kTRUE);
+   TMatrixTKernels::SymmetrizeUpper(nrowsb,cp);
 
    if (isAllocated)
       delete [] bap;
@@ -1194,34 +1106,6 @@ TMatrixTSym<Element> &TMatrixTSym<Element>::Similarity(const TMatrixTSym<Element
       }
    }
 
-#ifdef CBLAS
-   const Int_t nrowsb = b.GetNrows();
-   const Int_t ncolsa = this->GetNcols();
-
-   Element work[kWorkMax];
-   Bool_t isAllocated = kFALSE;
-   Element *abtp = work;
-   if (this->fNcols > kWorkMax) {
-      isAllocated = kTRUE;
-      abtp = new Element[this->fNcols];
-   }
-
-   const TMatrixT<Element> abt(*this,TMatrixT<Element>::kMultTranspose,b);
-
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dsymm (CblasRowMajor,CblasLeft,CblasUpper,this->fNrows,this->fNcols,1.0,
-                   bp,b.GetNcols(),abtp,abt.GetNcols(),0.0,cp,this->fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_ssymm (CblasRowMajor,CblasLeft,CblasUpper,this->fNrows,this->fNcols,1.0,
-                   bp,b.GetNcols(),abtp,abt.GetNcols(),0.0,cp,this->fNcols);
-   else
-      Error("Similarity","type %s not implemented in BLAS library",typeid(Element));
-
-   if (isAllocated)
-      delete [] abtp;
-#else
    const Int_t ncolsa = this->GetNcols();
    const Int_t nb     = b.GetNoElements();
    const Int_t nrowsb = b.GetNrows();
@@ -1239,44 +1123,13 @@ TMatrixTSym<Element> &TMatrixTSym<Element>::Similarity(const TMatrixTSym<Element
 
    AMultB(bp,nb,ncolsb,this->fElements,this->fNelems,this->fNcols,bap);
 
-   const Int_t nba     = nrowsb*ncolsa;
-   const Int_t ncolsba = ncolsa;
-   const Element *       bi1p = bp;
-         Element *       cp   = this->GetMatrixArray();
-         Element * const cp0  = cp;
-
-   Int_t ishift = 0;
-   const Element *barp0 = bap;
-   while (barp0 < bap+nba) {
-      const Element *brp0 = bi1p;
-      while (brp0 < bp+nb) {
-         const Element *barp = barp0;
-         const Element *brp  = brp0;
-         Element cij = 0;
-         while (brp < brp0+ncolsb)
-            cij += *barp++ * *brp++;
-         *cp++ = cij;
-         brp0 += ncolsb;
-      }
-      barp0 += ncolsba;
-      bi1p += ncolsb;
-      cp += ++ishift;
-   }
-
-   R__ASSERT(cp == cp0+this->fNelems+ishift && barp0 == bap+nba);
-
-   cp = cp0;
-   for (Int_t irow = 0; irow < this->fNrows; irow++) {
-      const Int_t rowOff1 = irow*this->fNrows;
-      for (Int_t icol = 0; icol < irow; icol++) {
-         const Int_t rowOff2 = icol*this->fNrows;
-         cp[rowOff1+icol] = cp[rowOff2+irow];
-      }
-   }
+   // upper triangle of (B*A)*B^T
+   Element * const cp = this->GetMatrixArray();
+   TMatrixTKernels::MultBt(nrowsb,nrowsb,ncolsb,bap,bp,cp,nrowsb,kTRUE);
+   TMatrixTKernels::SymmetrizeUpper(nrowsb,cp);
 
    if (isAllocated)
       delete [] bap;
-#endif
 
    return *this;
 }
@@ -1348,55 +1201,10 @@ TMatrixTSym<Element> &TMatrixTSym<Element>::SimilarityT(const TMatrixT<Element>
    if (ncolsb != this->fNcols)
       this->ResizeTo(ncolsb,ncolsb);
 
-#ifdef CBLAS
-   const Element *bp = b.GetMatrixArray();
-         Element *cp = this->GetMatrixArray();
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemm (CblasRowMajor,CblasNoTrans,CblasNoTrans,this->fNrows,this->fNcols,bta.GetNcols(),
-                   1.0,btap,bta.GetNcols(),bp,b.GetNcols(),1.0,cp,this->fNcols);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemm (CblasRowMajor,CblasNoTrans,CblasNoTrans,this->fNrows,this->fNcols,bta.GetNcols(),
-                   1.0,btap,bta.GetNcols(),bp,b.GetNcols(),1.0,cp,this->fNcols);
-   else
-      Error("similarityT","type %s not implemented in BLAS library",typeid(Element));
-#else
-   const Int_t nbta     = bta.GetNoElements();
-   const Int_t nb       = b.GetNoElements();
-   const Int_t ncolsbta = bta.GetNcols();
-   const Element * const bp   = b.GetMatrixArray();
-         Element *       cp   = this->GetMatrixArray();
-         Element * const cp0  = cp;
-
-   Int_t ishift = 0;
-   const Element *btarp0 = btap;                     // Pointer to  A[i,0];
-   const Element *bcp0   = bp;
-   while (btarp0 < btap+nbta) {
-      for (const Element *bcp = bcp0; bcp < bp+ncolsb; ) { // Pointer to the j-th column of B, Start bcp = B[0,0]
-         const Element *btarp = btarp0;                   // Pointer to the i-th row of A, reset to A[i,0]
-         Element cij = 0;
-         while (bcp < bp+nb) {                         // Scan the i-th row of A and
-            cij += *btarp++ * *bcp;                     // the j-th col of B
-            bcp += ncolsb;
-         }
-         *cp++ = cij;
-         bcp -= nb-1;                                  // Set bcp to the (j+1)-th col
-      }
-      btarp0 += ncolsbta;                             // Set ap to the (i+1)-th row
-      bcp0++;
-      cp += ++ishift;
-   }
-
-   R__ASSERT(cp == cp0+this->fNelems+ishift && btarp0 == btap+nbta);
-
-   cp = cp0;
-   for (Int_t irow = 0; irow < this->fNrows; irow++) {
-      const Int_t rowOff1 = irow*this->fNrows;
-      for (Int_t icol = 0; icol < irow; icol++) {
-         const Int_t rowOff2 = icol*this->fNrows;
-         cp[rowOff1+icol] = cp[rowOff2+irow];
-      }
-   }
-#endif
+   // upper triangle of (B^T*A)*B
+   Element * const cp = this->GetMatrixArray();
+   TMatrixTKernels::Mult(ncolsb,ncolsb,b.GetNrows(),btap,ncolsa,1,b.GetMatrixArray(),ncolsb,cp,ncolsb,kTRUE);
+   TMatrixTKernels::SymmetrizeUpper(ncolsb,cp);
 
    if (isAllocated)
       delete [] btap;
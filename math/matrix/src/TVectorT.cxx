@@ -982,16 +982,6 @@ TVectorT<Element> &TVectorT<Element>::operator*=(const TMatrixT<Element> &a)
 
    const Element *mp = a.GetMatrixArray();     // Matrix row ptr
          Element *tp = this->GetMatrixArray(); // Target vector ptr
-#ifdef CBLAS
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dgemv(CblasRowMajor,CblasNoTrans,a.GetNrows(),a.GetNcols(),1.0,mp,
-                  a.GetNcols(),elements_old,1,0.0,tp,1);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_sgemv(CblasRowMajor,CblasNoTrans,a.GetNrows(),a.GetNcols(),1.0,mp,
-                  a.GetNcols(),elements_old,1,0.0,tp,1);
-   else
-      Error("operator*=","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Element * const tp_last = tp+fNrows;
    while (tp < tp_last) {
       Element sum = 0;
@@ -1000,7 +990,6 @@ TVectorT<Element> &TVectorT<Element>::operator*=(const TMatrixT<Element> &a)
       *tp++ = sum;
    }
    R__ASSERT(mp == a.GetMatrixArray()+a.GetNoElements());
-#endif
 
    if (isAllocated)
       delete [] elements_old;
@@ -1100,16 +1089,6 @@ TVectorT<Element> &TVectorT<Element>::operator*=(const TMatrixTSym<Element> &a)
 
    const Element *mp = a.GetMatrixArray();     // Matrix row ptr
          Element *tp = this->GetMatrixArray(); // Target vector ptr
-#ifdef CBLAS
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dsymv(CblasRowMajor,CblasUpper,fNrows,1.0,mp,
-                  fNrows,elements_old,1,0.0,tp,1);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_ssymv(CblasRowMajor,CblasUpper,fNrows,1.0,mp,
-                  fNrows,elements_old,1,0.0,tp,1);
-   else
-      Error("operator*=","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Element * const tp_last = tp+fNrows;
    while (tp < tp_last) {
       Element sum = 0;
@@ -1118,7 +1097,6 @@ TVectorT<Element> &TVectorT<Element>::operator*=(const TMatrixTSym<Element> &a)
       *tp++ = sum;
    }
    R__ASSERT(mp == a.GetMatrixArray()+a.GetNoElements());
-#endif
 
    if (isAllocated)
       delete [] elements_old;
@@ -1631,16 +1609,6 @@ TVectorT<Element> &Add(TVectorT<Element> &target,Element scalar,
    const Element * const sp = source.GetMatrixArray();  // sources vector ptr
    const Element *       mp = a.GetMatrixArray();       // Matrix row ptr
          Element *       tp = target.GetMatrixArray();  // Target vector ptr
-#ifdef CBLAS
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dsymv(CblasRowMajor,CblasUpper,fNrows,scalar,mp,
-                  fNrows,sp,1,0.0,tp,1);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_ssymv(CblasRowMajor,CblasUpper,fNrows,scalar,mp,
-                  fNrows,sp,1,0.0,tp,1);
-   else
-      Error("operator*=","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Element * const sp_last = sp+source.GetNrows();
    const Element * const tp_last = tp+target.GetNrows();
    if (scalar == 1.0) {
@@ -1678,7 +1646,6 @@ TVectorT<Element> &Add(TVectorT<Element> &target,Element scalar,
    }
 
    if (gMatrixCheck) R__ASSERT(mp == a.GetMatrixArray()+a.GetNoElements());
-#endif
 
    return target;
 }
@@ -1704,16 +1671,6 @@ TVectorT<Element> &Add(TVectorT<Element> &target,Element scalar,
    const Element * const sp = source.GetMatrixArray();  // sources vector ptr
    const Element *       mp = a.GetMatrixArray();       // Matrix row ptr
          Element *       tp = target.GetMatrixArray();  // Target vector ptr
-#ifdef CBLAS
-   if (typeid(Element) == typeid(Double_t))
-      cblas_dsymv(CblasRowMajor,CblasUpper,fNrows,1.0,mp,
-                  fNrows,sp,1,0.0,tp,1);
-   else if (typeid(Element) != typeid(Float_t))
-      cblas_ssymv(CblasRowMajor,CblasUpper,fNrows,1.0,mp,
-                  fNrows,sp,1,0.0,tp,1);
-   else
-      Error("operator*=","type %s not implemented in BLAS library",typeid(Element));
-#else
    const Element * const sp_last = sp+source.GetNrows();
    const Element * const tp_last = tp+target.GetNrows();
    if (scalar == 1.0) {
@@ -1750,7 +1707,6 @@ TVectorT<Element> &Add(TVectorT<Element> &target,Element scalar,
       }
    }
    R__ASSERT(mp == a.GetMatrixArray()+a.GetNoElements());
-#endif
 
    return target;
 }
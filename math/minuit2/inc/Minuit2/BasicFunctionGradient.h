@@ -14,6 +14,8 @@
 
 #include "Minuit2/StackAllocator.h"
 
+#include <vector>
+
 namespace ROOT {
 
    namespace Minuit2 {
@@ -30,26 +32,45 @@ public:
   explicit BasicFunctionGradient(unsigned int n) :
     fGradient(MnAlgebraicVector(n)), fG2ndDerivative(MnAlgebraicVector(n)),
     fGStepSize(MnAlgebraicVector(n)), fValid(false),
-    fAnalytical(false) {}
+    fAnalytical(false), fFPlus(), fFMinus() {}
 
   explicit BasicFunctionGradient(const MnAlgebraicVector& grd) :
     fGradient(grd), fG2ndDerivative(MnAlgebraicVector(grd.size())),
     fGStepSize(MnAlgebraicVector(grd.size())), fValid(true),
-    fAnalytical(true) {}
+    fAnalytical(true), fFPlus(), fFMinus() {}
 
   BasicFunctionGradient(const MnAlgebraicVector& grd, const MnAlgebraicVector& g2, const MnAlgebraicVector& gstep) :
     fGradient(grd), fG2ndDerivative(g2),
-    fGStepSize(gstep), fValid(true), fAnalytical(false) {}
+    fGStepSize(gstep), fValid(true), fAnalytical(false),
+    fFPlus(), fFMinus() {}
+
+  // gradient with second derivatives and step sizes, keeping the analytical flag
+  // (e.g. the analytical gradient after MnHesse)
+  BasicFunctionGradient(const MnAlgebraicVector& grd, const MnAlgebraicVector& g2, const MnAlgebraicVector& gstep, bool analytical) :
+    fGradient(grd), fG2ndDerivative(g2),
+    fGStepSize(gstep), fValid(true), fAnalytical(analytical),
+    fFPlus(), fFMinus() {}
+
+  // numerical gradient storing also the function values at x + gstep and x - gstep
+  // used for the last evaluation (they can be re-used by MnHesse)
+  BasicFunctionGradient(const MnAlgebraicVector& grd, const MnAlgebraicVector& g2, const MnAlgebraicVector& gstep,
+                        const std::vector<double>& fplus, const std::vector<double>& fminus) :
+    fGradient(grd), fG2ndDerivative(g2),
+    fGStepSize(gstep), fValid(true), fAnalytical(false),
+    fFPlus(fplus), fFMinus(fminus) {}
 
   ~BasicFunctionGradient() {}
 
-  BasicFunctionGradient(const BasicFunctionGradient& grad) : fGradient(grad.fGradient), fG2ndDerivative(grad.fG2ndDerivative), fGStepSize(grad.fGStepSize), fValid(grad.fValid) {}
+  BasicFunctionGradient(const BasicFunctionGradient& grad) : fGradient(grad.fGradient), fG2ndDerivative(grad.fG2ndDerivative), fGStepSize(grad.fGStepSize), fValid(grad.fValid), fAnalytical(grad.fAnalytical), fFPlus(grad.fFPlus), fFMinus(grad.fFMinus) {}
 
   BasicFunctionGradient& operator=(const BasicFunctionGradient& grad) {
     fGradient = grad.fGradient;
     fG2ndDerivative = grad.fG2ndDerivative;
     fGStepSize = grad.fGStepSize;
     fValid = grad.fValid;
+    fAnalytical = grad.fAnalytical;
+    fFPlus = grad.fFPlus;
+    fFMinus = grad.fFMinus;
     return *this;
   }
 
@@ -69,6 +90,10 @@ public:
   const MnAlgebraicVector& G2() const {return fG2ndDerivative;}
   const MnAlgebraicVector& Gstep() const {return fGStepSize;}
 
+  bool HasFunctionValues() const {return fFPlus.size() > 0 && fFPlus.size() == fGradient.size();}
+  const std::vector<double>& FPlus() const {return fFPlus;}
+  const std::vector<double>& FMinus() const {return fFMinus;}
+
 private:
 
   MnAlgebraicVector fGradient;
@@ -76,6 +101,8 @@ private:
   MnAlgebraicVector fGStepSize;
   bool fValid;
   bool fAnalytical;
+  std::vector<double> fFPlus;   // function values at x + gstep (empty if not available)
+  std::vector<double> fFMinus;  // function values at x - gstep (empty if not available)
 };
 
   }  // namespace Minuit2
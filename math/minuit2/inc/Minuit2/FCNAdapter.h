@@ -34,12 +34,14 @@ class FCNAdapter : public FCNBase {
 
 public:
 
-   FCNAdapter(const Function & f, double up = 1.) :
+   FCNAdapter(const Function & f, double up = 1., bool cloneable = false) :
       fFunc(f) ,
-      fUp (up)
+      fUp (up),
+      fOwnedFunc(0),
+      fCloneable(cloneable)
    {}
 
-   ~FCNAdapter() {}
+   ~FCNAdapter() { if (fOwnedFunc) delete fOwnedFunc; }
 
 
    double operator()(const std::vector<double>& v) const {
@@ -52,14 +54,41 @@ public:
 
    void SetErrorDef(double up) { fUp = up; }
 
+   // the wrapped function is not assumed to be thread safe. A copy of it is used in each
+   // additional thread only if the function was declared cloneable, i.e. its Clone()
+   // returns an object independent of the original (not the case e.g. for a function
+   // referring to shared, mutable objects)
+   bool IsThreadSafe() const { return false; }
+
+   FCNBase * Clone() const {
+      if (!fCloneable) return 0;
+      Function * f = dynamic_cast<Function *>(fFunc.Clone() );
+      if (!f) return 0;
+      return new FCNAdapter(f, fUp);
+   }
+
    //virtual std::vector<double> Gradient(const std::vector<double>&) const;
 
    // forward interface
    //virtual double operator()(int npar, double* params,int iflag = 4) const;
 
 private:
+
+   // constructor taking ownership of the function (used by Clone)
+   FCNAdapter(Function * f, double up) :
+      fFunc(*f),
+      fUp(up),
+      fOwnedFunc(f),
+      fCloneable(true)
+   {}
+
+   FCNAdapter(const FCNAdapter &);             // not implemented
+   FCNAdapter & operator=(const FCNAdapter &); // not implemented
+
    const Function & fFunc;
    double fUp;
+   Function * fOwnedFunc;
+   bool fCloneable;
 };
 
    } // end namespace Minuit2
@@ -111,6 +111,21 @@ public:
    */
    virtual void SetErrorDef(double ) {};
 
+   /**
+       return true if the function can be evaluated concurrently from several threads.
+       The default is false: only functions known to be safe should re-implement it
+       and return true. A function which is not thread safe can implement Clone(),
+       so that each additional thread used for the numerical gradient uses its own copy.
+   */
+   virtual bool IsThreadSafe() const { return false; }
+
+   /**
+       create a copy of the function, to be used by a different thread. The returned
+       object is owned by the caller. Return zero (default) if the function cannot be copied,
+       in which case a non thread-safe function is always evaluated serially.
+   */
+   virtual FCNBase * Clone() const { return 0; }
+
 };
 
   }  // namespace Minuit2
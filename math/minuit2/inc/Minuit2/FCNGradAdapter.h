@@ -39,14 +39,16 @@ class FCNGradAdapter : public FCNGradientBase {
 
 public:
 
-   FCNGradAdapter(const Function & f, double up = 1.) :
+   FCNGradAdapter(const Function & f, double up = 1., bool cloneable = false) :
       fFunc(f) ,
       fUp (up) ,
-      fGrad(std::vector<double>(fFunc.NDim() ) )
+      fGrad(std::vector<double>(fFunc.NDim() ) ),
+      fOwnedFunc(0),
+      fCloneable(cloneable)
 
    {}
 
-   ~FCNGradAdapter() {}
+   ~FCNGradAdapter() { if (fOwnedFunc) delete fOwnedFunc; }
 
 
    double operator()(const std::vector<double>& v) const {
@@ -73,10 +75,38 @@ public:
    //virtual double operator()(int npar, double* params,int iflag = 4) const;
    bool CheckGradient() const { return false; }
 
+   // the wrapped function is not assumed to be thread safe. A copy of it is used in each
+   // additional thread only if the function was declared cloneable, i.e. its Clone()
+   // returns an object independent of the original (not the case e.g. for a function
+   // referring to shared, mutable objects)
+   bool IsThreadSafe() const { return false; }
+
+   FCNBase * Clone() const {
+      if (!fCloneable) return 0;
+      Function * f = dynamic_cast<Function *>(fFunc.Clone() );
+      if (!f) return 0;
+      return new FCNGradAdapter(f, fUp);
+   }
+
 private:
+
+   // constructor taking ownership of the function (used by Clone)
+   FCNGradAdapter(Function * f, double up) :
+      fFunc(*f),
+      fUp(up),
+      fGrad(std::vector<double>(fFunc.NDim() ) ),
+      fOwnedFunc(f),
+      fCloneable(true)
+   {}
+
+   FCNGradAdapter(const FCNGradAdapter &);             // not implemented
+   FCNGradAdapter & operator=(const FCNGradAdapter &); // not implemented
+
    const Function & fFunc;
    double fUp;
    mutable std::vector<double> fGrad;
+   Function * fOwnedFunc;
+   bool fCloneable;
 };
 
    } // end namespace Minuit2
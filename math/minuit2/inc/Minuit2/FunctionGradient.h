@@ -34,6 +34,14 @@ public:
                    const MnAlgebraicVector& gstep) :
    fData(MnRefCountedPointer<BasicFunctionGradient>(new BasicFunctionGradient(grd, g2, gstep))) {}
 
+  FunctionGradient(const MnAlgebraicVector& grd, const MnAlgebraicVector& g2,
+                   const MnAlgebraicVector& gstep, bool analytical) :
+   fData(MnRefCountedPointer<BasicFunctionGradient>(new BasicFunctionGradient(grd, g2, gstep, analytical))) {}
+
+  FunctionGradient(const MnAlgebraicVector& grd, const MnAlgebraicVector& g2,
+                   const MnAlgebraicVector& gstep, const std::vector<double>& fplus, const std::vector<double>& fminus) :
+   fData(MnRefCountedPointer<BasicFunctionGradient>(new BasicFunctionGradient(grd, g2, gstep, fplus, fminus))) {}
+
   ~FunctionGradient() {}
 
   FunctionGradient(const FunctionGradient& grad) : fData(grad.fData) {}
@@ -51,6 +59,11 @@ public:
   const MnAlgebraicVector& G2() const {return fData->G2();}
   const MnAlgebraicVector& Gstep() const {return fData->Gstep();}
 
+  /// function values at x + Gstep() and x - Gstep() of the last evaluation of a numerical gradient
+  bool HasFunctionValues() const {return fData->HasFunctionValues();}
+  const std::vector<double>& FPlus() const {return fData->FPlus();}
+  const std::vector<double>& FMinus() const {return fData->FMinus();}
+
 private:
 
   MnRefCountedPointer<BasicFunctionGradient> fData;
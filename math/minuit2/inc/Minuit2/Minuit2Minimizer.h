@@ -35,6 +35,7 @@ namespace ROOT {
       class FCNBase;
       class FunctionMinimum;
       class MnTraceObject;
+      class MnStrategy;
 
       // enumeration specifying the type of Minuit2 minimizers
       enum EMinimizerType {
@@ -306,6 +307,14 @@ protected:
    /// examine the minimum result
    bool ExamineMinimum(const ROOT::Minuit2::FunctionMinimum & min);
 
+   /// set in the strategy the number of threads given in the Minuit2 extra options
+   /// ("GradientNThreads" and "MinosNThreads")
+   void SetThreadOptions(ROOT::Minuit2::MnStrategy & strategy) const;
+
+   /// return true if the function can be cloned for the use in several threads
+   /// (Minuit2 extra option "CloneFCN")
+   bool CloneFCN() const;
+
 private:
 
    unsigned int fDim;       // dimension of the function to be minimized
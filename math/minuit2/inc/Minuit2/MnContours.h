@@ -25,6 +25,8 @@ namespace ROOT {
 class FCNBase;
 class FunctionMinimum;
 class ContoursError;
+class MinosError;
+class MnThreadFcns;
 
 //_____________________________________________________________
 /**
@@ -61,6 +63,11 @@ public:
 
 private:
 
+   /// find the contour points after the Minos errors running the minimizations in parallel
+   ContoursError ParallelContour(unsigned int px, unsigned int py, unsigned int npoints,
+                                 const MinosError& mex, const MinosError& mey, unsigned int nfcn,
+                                 unsigned int maxcalls, double toler, const MnThreadFcns& fcns, unsigned int nthreads) const;
+
    const FCNBase& fFCN;
    const FunctionMinimum& fMinimum;
    MnStrategy fStrategy;
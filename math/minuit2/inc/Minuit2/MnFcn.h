@@ -42,6 +42,12 @@ public:
   virtual double operator()(const MnAlgebraicVector&) const;
   unsigned int NumOfCalls() const {return fNumCall;}
 
+  /// evaluate the given FCN (e.g. a clone of Fcn() used by another thread) with the same
+  /// conversion as operator(), without incrementing the call counter
+  virtual double Eval(const FCNBase& fcn, const MnAlgebraicVector&) const;
+  /// add to the call counter the calls made via Eval
+  void AddCalls(int ncall) const {fNumCall += ncall;}
+
   //
   //forward interface
   //
@@ -13,6 +13,7 @@
 #include "Minuit2/MnStrategy.h"
 
 #include <utility>
+#include <vector>
 
 namespace ROOT {
 
@@ -60,11 +61,20 @@ public:
    /// can be printed via std::cout
    MinosError Minos(unsigned int, unsigned int maxcalls = 0, double toler = 0.1) const;
 
+   /// ask for the MinosError of a list of parameters. The lower and upper crossings
+   /// are independent minimizations, run concurrently on a copy of the state (and a clone
+   /// of the FCN if it is not thread safe) when required by the strategy (MnStrategy::SetMinosNThreads).
+   /// The result does not depend on the number of threads
+   std::vector<MinosError> Minos(const std::vector<unsigned int>& pars, unsigned int maxcalls = 0, double toler = 0.1) const;
+
 protected:
 
    /// internal method to get crossing value via MnFunctionCross
    MnCross FindCrossValue(int dir , unsigned int, unsigned int maxcalls, double toler) const;
 
+   /// get crossing value using the given FCN instance and strategy
+   MnCross FindCrossValue(int dir , unsigned int, unsigned int maxcalls, double toler, const FCNBase& fcn, const MnStrategy& stra) const;
+
 private:
 
    const FCNBase& fFCN;
@@ -47,6 +47,14 @@ public:
    double HessianG2Tolerance() const {return fHessTlrG2;}
    unsigned int HessianGradientNCycles() const {return fHessGradNCyc;}
 
+   // number of threads used for the numerical gradient calculation
+   // 0 = default (all available threads when compiled with OpenMP), 1 = serial
+   unsigned int GradientNThreads() const {return fGradNThreads;}
+
+   // number of threads used to run concurrently the independent minimizations of
+   // Minos (lower and upper errors) and of MnContours, 1 = serial (default), 0 = all available
+   unsigned int MinosNThreads() const {return fMinosNThreads;}
+
    int StorageLevel() const { return fStoreLevel; }
 
    bool IsLow() const {return fStrategy == 0;}
@@ -66,6 +74,14 @@ public:
    void SetHessianG2Tolerance(double toler) {fHessTlrG2 = toler;}
    void SetHessianGradientNCycles(unsigned int n) {fHessGradNCyc = n;}
 
+   // set the number of threads for the numerical gradient. The result does not depend
+   // on the number of threads, since each derivative is computed independently
+   void SetGradientNThreads(unsigned int n) {fGradNThreads = n;}
+
+   // set the number of threads for Minos and contours. The Minos result does not depend on it,
+   // the contour points do only between serial (1) and parallel (!= 1) mode
+   void SetMinosNThreads(unsigned int n) {fMinosNThreads = n;}
+
    // set storage level of iteration quantities
    // 0 = store only last iterations 1 = full storage (default)
    void SetStorageLevel(unsigned int level) { fStoreLevel = level; }
@@ -80,6 +96,8 @@ private:
    double fHessTlrStp;
    double fHessTlrG2;
    unsigned int fHessGradNCyc;
+   unsigned int fGradNThreads;
+   unsigned int fMinosNThreads;
    int fStoreLevel;
 };
 
@@ -0,0 +1,62 @@
+// @(#)root/minuit2:$Id$
+// Authors: M. Winkler, F. James, L. Moneta, A. Zsenei   2003-2005
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2005 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#ifndef ROOT_Minuit2_MnThreadFcns
+#define ROOT_Minuit2_MnThreadFcns
+
+#include <vector>
+
+namespace ROOT {
+
+   namespace Minuit2 {
+
+
+class FCNBase;
+
+/**
+   helper class providing the FCN instance to be used by each thread of a
+   parallel computation (numerical gradient, Minos, contours):
+   the original FCN when it is thread safe, a clone of it for each additional
+   thread otherwise (see FCNBase::IsThreadSafe and FCNBase::Clone).
+   The clones are owned by this class.
+ */
+
+class MnThreadFcns {
+
+public:
+
+   explicit MnThreadFcns(const FCNBase& fcn) : fFCN(fcn) {}
+
+   ~MnThreadFcns();
+
+   /// return the number of threads to be used for ntasks independent tasks, when nthreads are
+   /// requested (0 = all available threads), creating the needed clones of the FCN.
+   /// Return 1 when not compiled with OpenMP or when a non thread-safe FCN cannot be cloned
+   unsigned int Init(unsigned int nthreads, unsigned int ntasks);
+
+   /// FCN to be used by thread ithread (0 <= ithread < number of threads returned by Init)
+   const FCNBase& operator()(unsigned int ithread) const;
+
+   /// index of the calling thread (0 when not running in parallel)
+   static unsigned int ThreadId();
+
+private:
+
+   MnThreadFcns(const MnThreadFcns &);             // not implemented
+   MnThreadFcns & operator=(const MnThreadFcns &); // not implemented
+
+   const FCNBase& fFCN;
+   std::vector<FCNBase*> fClones;
+};
+
+  }  // namespace Minuit2
+
+}  // namespace ROOT
+
+#endif  // ROOT_Minuit2_MnThreadFcns
@@ -34,6 +34,8 @@ public:
 
   virtual double operator()(const MnAlgebraicVector&) const;
 
+  virtual double Eval(const FCNBase& fcn, const MnAlgebraicVector&) const;
+
 private:
 
   const MnUserTransformation& fTransform;
@@ -18,6 +18,18 @@
 #include "Minuit2/GradientCalculator.h"
 #endif
 
+#ifndef ROOT_Minuit2_MnMatrix
+#include "Minuit2/MnMatrix.h"
+#endif
+
+#ifndef ROOT_Minuit2_MnFcn
+#include "Minuit2/MnFcn.h"
+#endif
+
+#ifndef ROOT_Minuit2_MnThreadFcns
+#include "Minuit2/MnThreadFcns.h"
+#endif
+
 #include <vector>
 
 namespace ROOT {
@@ -25,7 +37,6 @@ namespace ROOT {
    namespace Minuit2 {
 
 
-class MnFcn;
 class MnUserTransformation;
 class MnMachinePrecision;
 class MnStrategy;
@@ -41,7 +52,7 @@ public:
   Numerical2PGradientCalculator(const MnFcn& fcn,
                                 const MnUserTransformation& par,
                                 const MnStrategy& stra) :
-    fFcn(fcn), fTransformation(par), fStrategy(stra) {}
+    fFcn(fcn), fTransformation(par), fStrategy(stra), fThreadFcns(fcn.Fcn()) {}
 
   virtual ~Numerical2PGradientCalculator() {}
 
@@ -69,9 +80,15 @@ public:
 
 private:
 
+  // compute the derivative for the internal parameter i, return the number of function calls
+  unsigned int Derivative(unsigned int i, const FCNBase& fcn, MnAlgebraicVector& x, double fcnmin,
+                          MnAlgebraicVector& grd, MnAlgebraicVector& g2, MnAlgebraicVector& gstep,
+                          std::vector<double>& fplus, std::vector<double>& fminus) const;
+
   const MnFcn& fFcn;
   const MnUserTransformation& fTransformation;
   const MnStrategy& fStrategy;
+  mutable MnThreadFcns fThreadFcns;  // FCN instances used by the threads (clones if not thread safe)
 };
 
   }  // namespace Minuit2
@@ -341,12 +341,23 @@ bool Minuit2Minimizer::GetVariableSettings(unsigned int ivar, ROOT::Fit::Paramet
 
 
 
+bool Minuit2Minimizer::CloneFCN() const {
+   // return true if the Minuit2 extra option "CloneFCN" is set. The user declares in this way
+   // that a clone of the function is independent of the original, so that the clones can be
+   // evaluated concurrently by the threads of the gradient, Minos and contour calculations.
+   // Otherwise these are done serially.
+   ROOT::Math::IOptions * minuit2Opt = ROOT::Math::MinimizerOptions::FindDefault("Minuit2");
+   int cloneFCN = 0;
+   if (minuit2Opt) minuit2Opt->GetValue("CloneFCN",cloneFCN);
+   return cloneFCN != 0;
+}
+
 void Minuit2Minimizer::SetFunction(const  ROOT::Math::IMultiGenFunction & func) {
    // set function to be minimized
    if (fMinuitFCN) delete fMinuitFCN;
    fDim = func.NDim();
    if (!fUseFumili) {
-      fMinuitFCN = new ROOT::Minuit2::FCNAdapter<ROOT::Math::IMultiGenFunction> (func, ErrorDef() );
+      fMinuitFCN = new ROOT::Minuit2::FCNAdapter<ROOT::Math::IMultiGenFunction> (func, ErrorDef(), CloneFCN() );
    }
    else {
       // for Fumili the fit method function interface is required
@@ -364,7 +375,7 @@ void Minuit2Minimizer::SetFunction(const  ROOT::Math::IMultiGradFunction & func)
    fDim = func.NDim();
    if (fMinuitFCN) delete fMinuitFCN;
    if (!fUseFumili) {
-      fMinuitFCN = new ROOT::Minuit2::FCNGradAdapter<ROOT::Math::IMultiGradFunction> (func, ErrorDef() );
+      fMinuitFCN = new ROOT::Minuit2::FCNGradAdapter<ROOT::Math::IMultiGradFunction> (func, ErrorDef(), CloneFCN() );
    }
    else {
       // for Fumili the fit method function interface is required
@@ -456,6 +467,8 @@ bool Minuit2Minimizer::Minimize() {
       bool ret = minuit2Opt->GetValue("StorageLevel",storageLevel);
       if (ret) SetStorageLevel(storageLevel);
 
+      SetThreadOptions(strategy);
+
       if (printLevel > 0) {
          std::cout << "Minuit2Minimizer::Minuit  - Changing default options" << std::endl;
          minuit2Opt->Print();
@@ -800,7 +813,9 @@ bool Minuit2Minimizer::GetMinosError(unsigned int i, double & errLow, double & e
    if (Precision() > 0) fState.SetPrecision(Precision());
 
 
-   ROOT::Minuit2::MnMinos minos( *fMinuitFCN, *fMinimum);
+   ROOT::Minuit2::MnStrategy strategy(1);
+   SetThreadOptions(strategy);
+   ROOT::Minuit2::MnMinos minos( *fMinuitFCN, *fMinimum, strategy);
 
    // run MnCross
    MnCross low;
@@ -827,10 +842,16 @@ bool Minuit2Minimizer::GetMinosError(unsigned int i, double & errLow, double & e
    }
 
 
-   if (runLower) low = minos.Loval(i,maxfcn,tol);
-   if (runUpper) up  = minos.Upval(i,maxfcn,tol);
-
-   ROOT::Minuit2::MinosError me(i, fMinimum->UserState().Value(i),low, up);
+   ROOT::Minuit2::MinosError me;
+   if (runLower && runUpper) {
+      // lower and upper errors (run concurrently if requested by the "MinosNThreads" option)
+      me = minos.Minos(i,maxfcn,tol);
+   }
+   else {
+      if (runLower) low = minos.Loval(i,maxfcn,tol);
+      if (runUpper) up  = minos.Upval(i,maxfcn,tol);
+      me = ROOT::Minuit2::MinosError(i, fMinimum->UserState().Value(i),low, up);
+   }
 
    if (prev_level > -2) RestoreGlobalPrintLevel(prev_level);
 
@@ -991,7 +1012,9 @@ bool Minuit2Minimizer::Contour(unsigned int ipar, unsigned int jpar, unsigned in
    if (Precision() > 0) fState.SetPrecision(Precision());
 
    // eventually one should specify tolerance in contours
-   MnContours contour(*fMinuitFCN, *fMinimum, Strategy() );
+   ROOT::Minuit2::MnStrategy strategy(Strategy());
+   SetThreadOptions(strategy);
+   MnContours contour(*fMinuitFCN, *fMinimum, strategy );
 
    if (prev_level > -2) RestoreGlobalPrintLevel(prev_level);
 
@@ -1128,6 +1151,16 @@ void Minuit2Minimizer::SetTraceObject(MnTraceObject & obj) {
    fMinimizer->Builder().SetTraceObject(obj);
 }
 
+void Minuit2Minimizer::SetThreadOptions(ROOT::Minuit2::MnStrategy & strategy) const {
+   // read the number of threads for the numerical gradient (0 = all available, 1 = serial)
+   // and for the Minos and contour minimizations from the Minuit2 extra options
+   ROOT::Math::IOptions * minuit2Opt = ROOT::Math::MinimizerOptions::FindDefault("Minuit2");
+   if (!minuit2Opt) return;
+   int nthreads = 0;
+   if (minuit2Opt->GetValue("GradientNThreads",nthreads) ) strategy.SetGradientNThreads(nthreads);
+   if (minuit2Opt->GetValue("MinosNThreads",nthreads) ) strategy.SetMinosNThreads(nthreads);
+}
+
 void Minuit2Minimizer::SetStorageLevel(int level) {
    // set storage level
    if (!fMinimizer) return;
@@ -16,6 +16,9 @@
 #include "Minuit2/MnCross.h"
 #include "Minuit2/MinosError.h"
 #include "Minuit2/ContoursError.h"
+#include "Minuit2/MnThreadFcns.h"
+
+#include <algorithm>
 
 #include "Minuit2/MnPrint.h"
 
@@ -30,6 +33,46 @@ void PrintContourPoint(const std::pair<double,double> & point)  {
    std::cout << "\t x  = " << point.first << "  y = " << point.second << std::endl;
 }
 
+static bool FindContourPoint(const MnFunctionCross & cross, const std::vector<unsigned int> & par,
+                             const std::pair<double,double> & p1, const std::pair<double,double> & p2,
+                             double scalx, double scaly, double toler, unsigned int maxcalls,
+                             std::pair<double,double> & point, unsigned int & nfcn) {
+   // find the contour point on the perpendicular bisector of the segment (p1,p2), trying the
+   // opposite direction if the first search fails (same procedure as in the serial scan).
+   // Return false if no point is found
+   nfcn = 0;
+   double xdir = p2.second - p1.second;
+   double ydir = p1.first - p2.first;
+   std::vector<double> pmid(2);
+   pmid[0] = 0.5*p1.first + 0.5*p2.first;
+   pmid[1] = 0.5*p1.second + 0.5*p2.second;
+   for (double sca = 1.; sca > -2.; sca -= 2.) {
+      double scalfac = sca*std::max(fabs(xdir*scalx), fabs(ydir*scaly));
+      std::vector<double> pdir(2); pdir[0] = xdir/scalfac; pdir[1] = ydir/scalfac;
+      MnCross opt = cross(par, pmid, pdir, toler, maxcalls);
+      nfcn += opt.NFcn();
+      if (opt.IsValid()) {
+         point = std::pair<double,double>(pmid[0] + opt.Value()*pdir[0], pmid[1] + opt.Value()*pdir[1]);
+         return true;
+      }
+   }
+   return false;
+}
+
+struct ContourSegment {
+   // segment of the contour (between points i and i+1, or between the last and the first point)
+   // ordered by decreasing length, the closing segment first for equal length as in the serial scan
+   ContourSegment(unsigned int i, double dist, bool closing) : fIndex(i), fDist(dist), fClosing(closing) {}
+   bool operator<(const ContourSegment & s) const {
+      if (fDist != s.fDist) return fDist > s.fDist;
+      if (fClosing != s.fClosing) return fClosing;
+      return fIndex < s.fIndex;
+   }
+   unsigned int fIndex;
+   double fDist;
+   bool fClosing;
+};
+
 std::vector<std::pair<double,double> > MnContours::operator()(unsigned int px, unsigned int py, unsigned int npoints) const {
    // get contour as a pair of (x,y) points passing the parameter index (px, py)  and the number of requested points (>=4)
    ContoursError cont = Contour(px, py, npoints);
@@ -57,7 +100,18 @@ ContoursError MnContours::Contour(unsigned int px, unsigned int py, unsigned int
    double valx = fMinimum.UserState().Value(px);
    double valy = fMinimum.UserState().Value(py);
 
-   MinosError mex = minos.Minos(px);
+   // with more threads, the contour points are found in parallel: see below
+   MnThreadFcns fcns(fFCN);
+   unsigned int nthreads = fcns.Init(fStrategy.MinosNThreads(), npoints);
+
+   // the Minos errors of both parameters are computed concurrently in parallel mode
+   std::vector<MinosError> mexy;
+   if (nthreads > 1) {
+      std::vector<unsigned int> pxy(2); pxy[0] = px; pxy[1] = py;
+      mexy = minos.Minos(pxy);
+   }
+
+   MinosError mex = (nthreads > 1) ? mexy[0] : minos.Minos(px);
    nfcn += mex.NFcn();
    if(!mex.IsValid()) {
       MN_ERROR_MSG("MnContours is unable to find first two points.");
@@ -65,7 +119,7 @@ ContoursError MnContours::Contour(unsigned int px, unsigned int py, unsigned int
    }
    std::pair<double,double> ex = mex();
 
-   MinosError mey = minos.Minos(py);
+   MinosError mey = (nthreads > 1) ? mexy[1] : minos.Minos(py);
    nfcn += mey.NFcn();
    if(!mey.IsValid()) {
       MN_ERROR_MSG("MnContours is unable to find second two points.");
@@ -73,6 +127,11 @@ ContoursError MnContours::Contour(unsigned int px, unsigned int py, unsigned int
    }
    std::pair<double,double> ey = mey();
 
+#ifdef _OPENMP
+   if (nthreads > 1)
+      return ParallelContour(px, py, npoints, mex, mey, nfcn, maxcalls, toler, fcns, nthreads);
+#endif
+
    MnMigrad migrad(fFCN, fMinimum.UserState(), MnStrategy(std::max(0, int(fStrategy.Strategy()-1))));
 
    migrad.Fix(px);
@@ -213,6 +272,147 @@ L300:
    return ContoursError(px, py, result, mex, mey, nfcn);
 }
 
+ContoursError MnContours::ParallelContour(unsigned int px, unsigned int py, unsigned int npoints,
+                                          const MinosError & mex, const MinosError & mey, unsigned int nfcn,
+                                          unsigned int maxcalls, double toler, const MnThreadFcns & fcns, unsigned int nthreads) const {
+   // find the contour points running the independent minimizations concurrently.
+   // The four first points (minimum of the other parameter at the Minos errors) are found in parallel,
+   // each one starting from the function minimum. Then, in each round the largest segments of the
+   // contour (at most as many as the points already found) are bisected concurrently.
+   // The result does not depend on the number of threads, but it is in general not identical
+   // to the one of the serial scan, which bisects one segment at a time
+#ifdef _OPENMP
+   std::vector<std::pair<double,double> > result; result.reserve(npoints);
+
+   // the user state is computed on demand: do it before running in parallel
+   const MnUserParameterState & ustate = fMinimum.UserState();
+   double valx = ustate.Value(px);
+   double valy = ustate.Value(py);
+   std::pair<double,double> ex = mex();
+   std::pair<double,double> ey = mey();
+
+   // the minimizations inside each task compute the gradient serially
+   MnStrategy stra(fStrategy);
+   stra.SetGradientNThreads(1);
+   MnStrategy migradStra(std::max(0, int(fStrategy.Strategy()-1)));
+   migradStra.SetGradientNThreads(1);
+
+   // first four points: fix x at its upper/lower Minos error, y at its upper/lower Minos error
+   unsigned int fixPar[4]    = { px, px, py, py };
+   unsigned int freePar[4]   = { py, py, px, px };
+   double fixValue[4] = { valx + ex.second, valx + ex.first, valy + ey.second, valy + ey.first };
+   double freeValue[4] = { 0, 0, 0, 0 };
+   int valid[4] = { 0, 0, 0, 0 };
+   unsigned int ncalls[4] = { 0, 0, 0, 0 };
+
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic)
+   for (int k = 0; k < 4; ++k) {
+      MnMigrad migrad(fcns(MnThreadFcns::ThreadId()), ustate, migradStra);
+      migrad.Fix(fixPar[k]);
+      migrad.SetValue(fixPar[k], fixValue[k]);
+      FunctionMinimum fmin = migrad();
+      ncalls[k] = fmin.NFcn();
+      valid[k] = fmin.IsValid();
+      if (valid[k]) freeValue[k] = fmin.UserState().Value(freePar[k]);
+   }
+
+   for (int k = 0; k < 4; ++k) {
+      nfcn += ncalls[k];
+      if (!valid[k]) {
+         if (k == 0) MN_ERROR_VAL2("MnContours: unable to find Upper y Value for x Parameter",px);
+         if (k == 1) MN_ERROR_VAL2("MnContours: unable to find Lower y Value for x Parameter",px);
+         if (k == 2) MN_ERROR_VAL2("MnContours: unable to find Upper x Value for y Parameter",py);
+         if (k == 3) MN_ERROR_VAL2("MnContours: unable to find Lower x Value for y Parameter",py);
+         return ContoursError(px, py, result, mex, mey, nfcn);
+      }
+   }
+
+   double scalx = 1./(ex.second - ex.first);
+   double scaly = 1./(ey.second - ey.first);
+
+   result.push_back(std::pair<double,double>(fixValue[1], freeValue[1]));
+   result.push_back(std::pair<double,double>(freeValue[3], fixValue[3]));
+   result.push_back(std::pair<double,double>(fixValue[0], freeValue[0]));
+   result.push_back(std::pair<double,double>(freeValue[2], fixValue[2]));
+
+   int printLevel = MnPrint::Level();
+
+   if (printLevel > 0 ) {
+      std::cout << "MnContour : List of found points " << std::endl;
+      std::cout << "\t Parameter x is " << ustate.Name(px) << std::endl;
+      std::cout << "\t Parameter y is " << ustate.Name(py) << std::endl;
+      for (unsigned int i = 0; i < 4; ++i)
+         PrintContourPoint(result[i] );
+   }
+
+   MnUserParameterState upar = ustate;
+   upar.Fix(px);
+   upar.Fix(py);
+
+   std::vector<unsigned int> par(2); par[0] = px; par[1] = py;
+
+   while (result.size() < npoints) {
+
+      if(nfcn > maxcalls) {
+         MN_ERROR_MSG("MnContours: maximum number of function calls exhausted.");
+         return ContoursError(px, py, result, mex, mey, nfcn);
+      }
+
+      // select the largest segments
+      unsigned int n = result.size();
+      std::vector<ContourSegment> segments;
+      segments.reserve(n);
+      for (unsigned int i = 0; i < n; ++i) {
+         const std::pair<double,double> & p1 = result[i];
+         const std::pair<double,double> & p2 = result[(i+1)%n];
+         double dx = p1.first - p2.first;
+         double dy = p1.second - p2.second;
+         segments.push_back(ContourSegment(i, scalx*scalx*dx*dx + scaly*scaly*dy*dy, i == n-1) );
+      }
+      std::sort(segments.begin(), segments.end() );
+      unsigned int nnew = std::min(n, npoints - n);
+      segments.erase(segments.begin() + nnew, segments.end() );
+
+      std::vector<std::pair<double,double> > points(nnew);
+      std::vector<int> found(nnew);
+      std::vector<unsigned int> ncross(nnew);
+
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic)
+      for (int k = 0; k < int(nnew); ++k) {
+         MnFunctionCross cross(fcns(MnThreadFcns::ThreadId()), upar, fMinimum.Fval(), stra);
+         unsigned int i = segments[k].fIndex;
+         found[k] = FindContourPoint(cross, par, result[i], result[(i+1)%n], scalx, scaly, toler, maxcalls, points[k], ncross[k]);
+      }
+
+      // insert the new points, starting from the end of the list
+      std::vector<std::pair<unsigned int, unsigned int> > order(nnew);
+      for (unsigned int k = 0; k < nnew; ++k) order[k] = std::make_pair(segments[k].fIndex, k);
+      std::sort(order.begin(), order.end() );
+      bool ok = true;
+      for (unsigned int j = nnew; j > 0; --j) {
+         unsigned int k = order[j-1].second;
+         nfcn += ncross[k];
+         if (!found[k]) { ok = false; continue; }
+         result.insert(result.begin() + segments[k].fIndex + 1, points[k]);
+         if (printLevel > 0) PrintContourPoint( points[k] );
+      }
+      if (!ok) {
+         MN_ERROR_MSG("MnContours : unable to find point on Contour");
+         MN_ERROR_VAL2("MnContours : found  only i points",result.size());
+         return ContoursError(px, py, result, mex, mey, nfcn);
+      }
+   }
+   if (printLevel >0)
+      std::cout << "MnContour: Number of contour points = " << result.size() << std::endl;
+
+   return ContoursError(px, py, result, mex, mey, nfcn);
+#else
+   // not used without OpenMP
+   (void) npoints; (void) maxcalls; (void) toler; (void) fcns; (void) nthreads;
+   return ContoursError(px, py, std::vector<std::pair<double,double> >(), mex, mey, nfcn);
+#endif
+}
+
 
    }  // namespace Minuit2
 
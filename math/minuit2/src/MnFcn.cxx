@@ -23,7 +23,12 @@ MnFcn::~MnFcn() {
 double MnFcn::operator()(const MnAlgebraicVector& v) const {
    // evaluate FCN converting from from MnAlgebraicVector to std::vector
    fNumCall++;
-   return fFCN(MnVectorTransform()(v));
+   return Eval(fFCN, v);
+}
+
+double MnFcn::Eval(const FCNBase& fcn, const MnAlgebraicVector& v) const {
+   // evaluate a given FCN converting from MnAlgebraicVector to std::vector
+   return fcn(MnVectorTransform()(v));
 }
 
 // double MnFcn::operator()(const std::vector<double>& par) const {
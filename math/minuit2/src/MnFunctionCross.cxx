@@ -95,7 +95,10 @@ MnCross MnFunctionCross::operator()(const std::vector<unsigned int>& par, const
    if(aulim  < aopt+tla) limset = true;
 
 
-   MnMigrad migrad(fFCN, fState, MnStrategy(std::max(0, int(fStrategy.Strategy()-1))));
+   // use a lower strategy for the minimizations, keeping the same thread settings
+   MnStrategy migradStrategy(std::max(0, int(fStrategy.Strategy()-1)));
+   migradStrategy.SetGradientNThreads(fStrategy.GradientNThreads());
+   MnMigrad migrad(fFCN, fState, migradStrategy);
 
    for(unsigned int i = 0; i < npar; i++) {
 #ifdef DEBUG
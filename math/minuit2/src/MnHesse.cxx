@@ -18,6 +18,9 @@
 #include "Minuit2/MinimumState.h"
 #include "Minuit2/VariableMetricEDMEstimator.h"
 #include "Minuit2/FunctionMinimum.h"
+#include "Minuit2/FCNGradientBase.h"
+#include "Minuit2/AnalyticalGradientCalculator.h"
+#include "Minuit2/MnThreadFcns.h"
 
 //#define DEBUG
 
@@ -68,9 +71,18 @@ MnUserParameterState MnHesse::operator()(const FCNBase& fcn, const MnUserParamet
    MnAlgebraicVector x(n);
    for(unsigned int i = 0; i < n; i++) x(i) = state.IntParameters()[i];
    double amin = mfcn(x);
-   Numerical2PGradientCalculator gc(mfcn, state.Trafo(), fStrategy);
    MinimumParameters par(x, amin);
-   FunctionGradient gra = gc(par);
+   // use the analytical gradient when the function provides it
+   const FCNGradientBase * gfcn = dynamic_cast<const FCNGradientBase *>(&fcn);
+   FunctionGradient gra(n);
+   if (gfcn != 0) {
+      AnalyticalGradientCalculator gc(*gfcn, state.Trafo());
+      gra = gc(par);
+   }
+   else {
+      Numerical2PGradientCalculator gc(mfcn, state.Trafo(), fStrategy);
+      gra = gc(par);
+   }
    MinimumState tmp = (*this)(mfcn, MinimumState(par, MinimumError(MnAlgebraicSymMatrix(n), 1.), gra, state.Edm(), state.NFcn()), state.Trafo(), maxcalls);
 
    return MnUserParameterState(tmp, fcn.Up(), state.Trafo());
@@ -85,9 +97,122 @@ void MnHesse::operator()(const FCNBase& fcn, FunctionMinimum& min, unsigned int
    min.Add(st);
 }
 
+static bool HesseDiagonal(unsigned int i, const MnHesse& hesse, const MnFcn& mfcn, const FCNBase& fcn,
+                          const MnUserTransformation& trafo, double amin, double aimsag,
+                          const std::vector<double>* fplus, const std::vector<double>* fminus,
+                          MnAlgebraicVector& x, MnAlgebraicVector& g2, MnAlgebraicVector& grd,
+                          MnAlgebraicVector& gst, MnAlgebraicVector& dirin, MnAlgebraicVector& yy,
+                          unsigned int& ncall) {
+   // compute the second derivative of the internal parameter i (diagonal element of the Hessian)
+   // evaluating the given FCN instance. Only the i-th component of the vectors is used (x(i) is restored).
+   // The function values at x(i) +/- gst(i) of the last numerical gradient are used for the first step,
+   // when available (fplus, fminus). Return false if the second derivative is zero
+
+   const MnMachinePrecision& prec = trafo.Precision();
+   ncall = 0;
+
+   double xtf = x(i);
+   double dmin = 8.*prec.Eps2()*(fabs(xtf) + prec.Eps2());
+   double d = fabs(gst(i));
+   if(d < dmin) d = dmin;
+   bool useCache = (fplus != 0 && d == fabs(gst(i)) );
+
+#ifdef DEBUG
+   std::cout << "\nDerivative parameter  " << i << " d = " << d << " dmin = " << dmin << std::endl;
+#endif
+
+
+   for(unsigned int icyc = 0; icyc < hesse.Ncycles(); icyc++) {
+      double sag = 0.;
+      double fs1 = 0.;
+      double fs2 = 0.;
+      bool found = false;
+      for(unsigned int multpy = 0; multpy < 5; multpy++) {
+         if (useCache) {
+            // same points as in the last gradient evaluation
+            fs1 = (*fplus)[i];
+            fs2 = (*fminus)[i];
+            useCache = false;
+         }
+         else {
+            x(i) = xtf + d;
+            fs1 = mfcn.Eval(fcn, x);
+            x(i) = xtf - d;
+            fs2 = mfcn.Eval(fcn, x);
+            x(i) = xtf;
+            ncall += 2;
+         }
+         sag = 0.5*(fs1+fs2-2.*amin);
+
+#ifdef DEBUG
+         std::cout << "cycle " << icyc << " mul " << multpy << "\t sag = " << sag << " d = " << d << std::endl;
+#endif
+         //  Now as F77 Minuit - check taht sag is not zero
+         if (sag != 0) {
+            found = true;
+            break;
+         }
+         if(trafo.Parameter(i).HasLimits()) {
+            if(d > 0.5) break;
+            d *= 10.;
+            if(d > 0.5) d = 0.51;
+            continue;
+         }
+         d *= 10.;
+      }
+
+      if (!found) return false;
+
+      double g2bfor = g2(i);
+      g2(i) = 2.*sag/(d*d);
+      grd(i) = (fs1-fs2)/(2.*d);
+      gst(i) = d;
+      dirin(i) = d;
+      yy(i) = fs1;
+      double dlast = d;
+      d = sqrt(2.*aimsag/fabs(g2(i)));
+      if(trafo.Parameter(i).HasLimits()) d = std::min(0.5, d);
+      if(d < dmin) d = dmin;
+
+#ifdef DEBUG
+      std::cout << "\t g1 = " << grd(i) << " g2 = " << g2(i) << " step = " << gst(i) << " d = " << d
+                << " diffd = " <<  fabs(d-dlast)/d << " diffg2 = " << fabs(g2(i)-g2bfor)/g2(i) << std::endl;
+#endif
+
+
+      // see if converged
+      if(fabs((d-dlast)/d) < hesse.Tolerstp()) break;
+      if(fabs((g2(i)-g2bfor)/g2(i)) < hesse.TolerG2()) break;
+      d = std::min(d, 10.*dlast);
+      d = std::max(d, 0.1*dlast);
+   }
+   return true;
+}
+
+static void HesseGradientColumn(unsigned int i, const FCNGradientBase& fcn, const MnUserTransformation& trafo,
+                                MnAlgebraicVector& x, double d, std::vector<double>& hcol) {
+   // compute column i of the Hessian by central differences of the analytical gradient
+   // with step d in the internal parameter i (x(i) is restored)
+   AnalyticalGradientCalculator gc(fcn, trafo);
+   double xtf = x(i);
+   x(i) = xtf + d;
+   FunctionGradient gp = gc(MinimumParameters(x, 0.));
+   x(i) = xtf - d;
+   FunctionGradient gm = gc(MinimumParameters(x, 0.));
+   x(i) = xtf;
+   for (unsigned int k = 0; k < hcol.size(); ++k)
+      hcol[k] = (gp.Grad()(k) - gm.Grad()(k))/(2.*d);
+}
+
 MinimumState MnHesse::operator()(const MnFcn& mfcn, const MinimumState& st, const MnUserTransformation& trafo, unsigned int maxcalls) const {
    // internal interface from MinimumState and MnUserTransformation
    // Function who does the real Hessian calculations
+   // When the gradient of the state is analytical and the FCN provides it (FCNGradientBase), the Hessian
+   // is obtained from finite differences of the gradient (2n gradient evaluations). Otherwise it is
+   // computed numerically, re-using the function values of the last numerical gradient for the first step
+   // of the diagonal elements. The diagonal and off-diagonal elements can be computed in parallel
+   // (using the number of threads of the numerical gradient, see MnStrategy::SetGradientNThreads);
+   // the result does not depend on the number of threads.
 
    const MnMachinePrecision& prec = trafo.Precision();
    // make sure starting at the right place
@@ -106,178 +231,251 @@ MinimumState MnHesse::operator()(const MnFcn& mfcn, const MinimumState& st, cons
    MnAlgebraicVector dirin = st.Gradient().Gstep();
    MnAlgebraicVector yy(n);
 
+   MnThreadFcns fcns(mfcn.Fcn());
+   unsigned int nthreads = fcns.Init(fStrategy.GradientNThreads(), n);
 
-   // case gradient is not numeric (could be analytical or from FumiliGradientCalculator)
-
-   if(st.Gradient().IsAnalytical()  ) {
-      Numerical2PGradientCalculator igc(mfcn, trafo, fStrategy);
-      FunctionGradient tmp = igc(st.Parameters());
-      gst = tmp.Gstep();
-      dirin = tmp.Gstep();
-      g2 = tmp.G2();
-   }
+   // Hessian from the analytical gradient
+   const FCNGradientBase * gfcn = dynamic_cast<const FCNGradientBase *>(&mfcn.Fcn());
+   bool analytical = st.Gradient().IsAnalytical() && gfcn != 0;
 
-   MnAlgebraicVector x = st.Parameters().Vec();
+   if (analytical) {
 
-#ifdef DEBUG
-   std::cout << "\nMnHesse " << std::endl;
-   std::cout << " x " << x << std::endl;
-   std::cout << " amin " << amin << "  " << st.Fval() << std::endl;
-   std::cout << " grd " << grd << std::endl;
-   std::cout << " gst " << gst << std::endl;
-   std::cout << " g2  " << g2 << std::endl;
-   std::cout << " Gradient is analytical  " << st.Gradient().IsAnalytical() << std::endl;
+      // each gradient evaluation is counted as a function call
+      unsigned int ncall = 2*n;
+      if(mfcn.NumOfCalls() + ncall > maxcalls) {
+#ifdef WARNINGMSG
+         MN_INFO_MSG("MnHesse: maximum number of allowed function calls exhausted.");
+         MN_INFO_MSG("MnHesse fails and will return diagonal matrix ");
 #endif
+         for(unsigned int j = 0; j < n; j++) {
+            double tmp = g2(j) < prec.Eps2() ? 1. : 1./g2(j);
+            vhmat(j,j) = tmp < prec.Eps2() ? 1. : tmp;
+         }
+         return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnHesseFailed()), st.Gradient(), st.Edm(), mfcn.NumOfCalls());
+      }
 
+      MnAlgebraicVector x = st.Parameters().Vec();
 
-   for(unsigned int i = 0; i < n; i++) {
+      // steps: a fraction of the parameter errors when an error matrix is available
+      for (unsigned int i = 0; i < n; i++) {
+         double dmin = 8.*prec.Eps2()*(fabs(x(i)) + prec.Eps2());
+         double d = sqrt(prec.Eps2())*(fabs(x(i)) + 1.);
+         if (st.Error().IsAvailable() && st.Error().InvHessian()(i,i) > 0)
+            d = 0.01*sqrt(2.*mfcn.Up()*st.Error().InvHessian()(i,i));
+         if (trafo.Parameter(trafo.ExtOfInt(i)).HasLimits()) d = std::min(0.5, d);
+         gst(i) = std::max(d, dmin);
+      }
 
-      double xtf = x(i);
-      double dmin = 8.*prec.Eps2()*(fabs(xtf) + prec.Eps2());
-      double d = fabs(gst(i));
-      if(d < dmin) d = dmin;
+      std::vector<std::vector<double> > hmat(n, std::vector<double>(n));
 
-#ifdef DEBUG
-      std::cout << "\nDerivative parameter  " << i << " d = " << d << " dmin = " << dmin << std::endl;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nthreads) if(nthreads > 1)
+#endif
+      {
+         const FCNGradientBase & fcn = (nthreads > 1) ? dynamic_cast<const FCNGradientBase &>(fcns(MnThreadFcns::ThreadId())) : *gfcn;
+         MnAlgebraicVector xt = x;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
 #endif
+         for (int i = 0; i < int(n); i++)
+            HesseGradientColumn(i, fcn, trafo, xt, gst(i), hmat[i]);
+      }
 
+      // symmetrize
+      for (unsigned int i = 0; i < n; i++) {
+         g2(i) = hmat[i][i];
+         for (unsigned int j = i; j < n; j++)
+            vhmat(i,j) = 0.5*(hmat[i][j] + hmat[j][i]);
+      }
+      mfcn.AddCalls(ncall);
+   }
+   else {
+
+      // case gradient is not numeric (could be analytical or from FumiliGradientCalculator)
+
+      const FunctionGradient * grad = &st.Gradient();
+      FunctionGradient tmp(n);
+      if(st.Gradient().IsAnalytical()  ) {
+         Numerical2PGradientCalculator igc(mfcn, trafo, fStrategy);
+         tmp = igc(st.Parameters());
+         grad = &tmp;
+         gst = tmp.Gstep();
+         dirin = tmp.Gstep();
+         g2 = tmp.G2();
+      }
 
-      for(unsigned int icyc = 0; icyc < Ncycles(); icyc++) {
-         double sag = 0.;
-         double fs1 = 0.;
-         double fs2 = 0.;
-         for(unsigned int multpy = 0; multpy < 5; multpy++) {
-            x(i) = xtf + d;
-            fs1 = mfcn(x);
-            x(i) = xtf - d;
-            fs2 = mfcn(x);
-            x(i) = xtf;
-            sag = 0.5*(fs1+fs2-2.*amin);
+      // function values of the last numerical gradient (valid if evaluated at the same point)
+      const std::vector<double> * fplus = 0;
+      const std::vector<double> * fminus = 0;
+      if (grad->HasFunctionValues() && amin == st.Fval() ) {
+         fplus = &grad->FPlus();
+         fminus = &grad->FMinus();
+      }
+
+      MnAlgebraicVector x = st.Parameters().Vec();
 
 #ifdef DEBUG
-            std::cout << "cycle " << icyc << " mul " << multpy << "\t sag = " << sag << " d = " << d << std::endl;
+      std::cout << "\nMnHesse " << std::endl;
+      std::cout << " x " << x << std::endl;
+      std::cout << " amin " << amin << "  " << st.Fval() << std::endl;
+      std::cout << " grd " << grd << std::endl;
+      std::cout << " gst " << gst << std::endl;
+      std::cout << " g2  " << g2 << std::endl;
+      std::cout << " Gradient is analytical  " << st.Gradient().IsAnalytical() << std::endl;
 #endif
-            //  Now as F77 Minuit - check taht sag is not zero
-            if (sag != 0) goto L30; // break
-            if(trafo.Parameter(i).HasLimits()) {
-               if(d > 0.5) goto L26;
-               d *= 10.;
-               if(d > 0.5) d = 0.51;
-               continue;
-            }
-            d *= 10.;
-         }
 
-L26:
-#ifdef WARNINGMSG
+      MnAlgebraicVector g2in = g2;
+      std::vector<int> diagOk(n, 1);
+      std::vector<unsigned int> diagCalls(n, 0);
 
-         // get parameter name for i
-         // (need separate scope for avoiding compl error when declaring name)
+#ifdef _OPENMP
+      if (nthreads > 1) {
+#pragma omp parallel num_threads(nthreads)
          {
-            const char * name = trafo.Name( trafo.ExtOfInt(i));
-            MN_INFO_VAL2("MnHesse: 2nd derivative zero for Parameter ", name);
-            MN_INFO_MSG("MnHesse fails and will return diagonal matrix ");
+            const FCNBase & fcn = fcns(MnThreadFcns::ThreadId());
+            MnAlgebraicVector xt = x;
+#pragma omp for schedule(dynamic)
+            for (int i = 0; i < int(n); i++)
+               diagOk[i] = HesseDiagonal(i, *this, mfcn, fcn, trafo, amin, aimsag, fplus, fminus, xt, g2, grd, gst, dirin, yy, diagCalls[i]);
          }
+      }
 #endif
 
-         for(unsigned int j = 0; j < n; j++) {
-            double tmp = g2(j) < prec.Eps2() ? 1. : 1./g2(j);
-            vhmat(j,j) = tmp < prec.Eps2() ? 1. : tmp;
-         }
+      // check the results in the order of the parameters: the serial calculation stops at the first failure
+      unsigned int ncall0 = mfcn.NumOfCalls();
+      unsigned int ncall = 0;
+      for(unsigned int i = 0; i < n; i++) {
 
-         return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnHesseFailed()), st.Gradient(), st.Edm(), mfcn.NumOfCalls());
-
-L30:
-            double g2bfor = g2(i);
-         g2(i) = 2.*sag/(d*d);
-         grd(i) = (fs1-fs2)/(2.*d);
-         gst(i) = d;
-         dirin(i) = d;
-         yy(i) = fs1;
-         double dlast = d;
-         d = sqrt(2.*aimsag/fabs(g2(i)));
-         if(trafo.Parameter(i).HasLimits()) d = std::min(0.5, d);
-         if(d < dmin) d = dmin;
+         if (nthreads <= 1)
+            diagOk[i] = HesseDiagonal(i, *this, mfcn, mfcn.Fcn(), trafo, amin, aimsag, fplus, fminus, x, g2, grd, gst, dirin, yy, diagCalls[i]);
+         ncall += diagCalls[i];
 
-#ifdef DEBUG
-         std::cout << "\t g1 = " << grd(i) << " g2 = " << g2(i) << " step = " << gst(i) << " d = " << d
-                   << " diffd = " <<  fabs(d-dlast)/d << " diffg2 = " << fabs(g2(i)-g2bfor)/g2(i) << std::endl;
+         bool failed = false;
+         if (!diagOk[i]) {
+#ifdef WARNINGMSG
+            // get parameter name for i
+            // (need separate scope for avoiding compl error when declaring name)
+            {
+               const char * name = trafo.Name( trafo.ExtOfInt(i));
+               MN_INFO_VAL2("MnHesse: 2nd derivative zero for Parameter ", name);
+               MN_INFO_MSG("MnHesse fails and will return diagonal matrix ");
+            }
+#endif
+            failed = true;
+         }
+         else {
+            vhmat(i,i) = g2(i);
+            if(ncall0 + ncall  > maxcalls) {
+#ifdef WARNINGMSG
+               //std::cout<<"maxcalls " << maxcalls << " " << mfcn.NumOfCalls() << "  " <<   st.NFcn() << std::endl;
+               MN_INFO_MSG("MnHesse: maximum number of allowed function calls exhausted.");
+               MN_INFO_MSG("MnHesse fails and will return diagonal matrix ");
 #endif
+               failed = true;
+            }
+         }
 
+         if (failed) {
+            // add all the calls done (also by the other threads)
+            unsigned int ntot = 0;
+            for (unsigned int j = 0; j < n; j++) ntot += diagCalls[j];
+            mfcn.AddCalls(ntot);
+
+            for(unsigned int j = 0; j < n; j++) {
+               // parameters after i are not used, as in the serial calculation
+               double g2j = (j > i) ? g2in(j) : g2(j);
+               double tmp = g2j < prec.Eps2() ? 1. : 1./g2j;
+               vhmat(j,j) = tmp < prec.Eps2() ? 1. : tmp;
+            }
 
-         // see if converged
-         if(fabs((d-dlast)/d) < Tolerstp()) break;
-         if(fabs((g2(i)-g2bfor)/g2(i)) < TolerG2()) break;
-         d = std::min(d, 10.*dlast);
-         d = std::max(d, 0.1*dlast);
+            return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnHesseFailed()), st.Gradient(), st.Edm(), mfcn.NumOfCalls());
+         }
       }
-      vhmat(i,i) = g2(i);
-      if(mfcn.NumOfCalls()  > maxcalls) {
+      mfcn.AddCalls(ncall);
 
-#ifdef WARNINGMSG
-         //std::cout<<"maxcalls " << maxcalls << " " << mfcn.NumOfCalls() << "  " <<   st.NFcn() << std::endl;
-         MN_INFO_MSG("MnHesse: maximum number of allowed function calls exhausted.");
-         MN_INFO_MSG("MnHesse fails and will return diagonal matrix ");
+#ifdef DEBUG
+      std::cout << "\n Second derivatives " << g2 << std::endl;
 #endif
 
-         for(unsigned int j = 0; j < n; j++) {
-            double tmp = g2(j) < prec.Eps2() ? 1. : 1./g2(j);
-            vhmat(j,j) = tmp < prec.Eps2() ? 1. : tmp;
-         }
-
-         return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnHesseFailed()), st.Gradient(), st.Edm(), mfcn.NumOfCalls());
+      if(fStrategy.Strategy() > 0) {
+         // refine first derivative
+         HessianGradientCalculator hgc(mfcn, trafo, fStrategy);
+         FunctionGradient gr = hgc(st.Parameters(), FunctionGradient(grd, g2, gst));
+         // update gradient and step values
+         grd = gr.Grad();
+         gst = gr.Gstep();
       }
 
-   }
+      //off-diagonal Elements
+      // The function is evaluated at x + dirin(i) + dirin(j), restoring exactly the original
+      // parameter values after each evaluation
 
-#ifdef DEBUG
-   std::cout << "\n Second derivatives " << g2 << std::endl;
-#endif
+      const MnAlgebraicVector & x0 = st.Parameters().Vec();
 
-   if(fStrategy.Strategy() > 0) {
-      // refine first derivative
-      HessianGradientCalculator hgc(mfcn, trafo, fStrategy);
-      FunctionGradient gr = hgc(st.Parameters(), FunctionGradient(grd, g2, gst));
-      // update gradient and step values
-      grd = gr.Grad();
-      gst = gr.Gstep();
-   }
+#ifdef _OPENMP
+      if (nthreads > 1 && n > 1) {
+         std::vector<unsigned int> rowCalls(n, 0);
+#pragma omp parallel num_threads(nthreads)
+         {
+            const FCNBase & fcn = fcns(MnThreadFcns::ThreadId());
+            MnAlgebraicVector xt = x0;
+#pragma omp for schedule(dynamic)
+            for (int i = 0; i < int(n)-1; i++) {
+               xt(i) += dirin(i);
+               for (unsigned int j = i+1; j < n; j++) {
+                  xt(j) += dirin(j);
+                  double fs1 = mfcn.Eval(fcn, xt);
+                  double elem = (fs1 + amin - yy(i) - yy(j))/(dirin(i)*dirin(j));
+                  vhmat(i,j) = elem;
+                  xt(j) = x0(j);
+               }
+               xt(i) = x0(i);
+               rowCalls[i] = n-1-i;
+            }
+         }
+         unsigned int noff = 0;
+         for (unsigned int i = 0; i < n; i++) noff += rowCalls[i];
+         mfcn.AddCalls(noff);
+      }
+      else
+#endif
+      {
+      // initial starting values
+      MPIProcess mpiprocOffDiagonal(n*(n-1)/2,0);
+      unsigned int startParIndexOffDiagonal = mpiprocOffDiagonal.StartElementIndex();
+      unsigned int endParIndexOffDiagonal = mpiprocOffDiagonal.EndElementIndex();
 
-   //off-diagonal Elements
-   // initial starting values
-   MPIProcess mpiprocOffDiagonal(n*(n-1)/2,0);
-   unsigned int startParIndexOffDiagonal = mpiprocOffDiagonal.StartElementIndex();
-   unsigned int endParIndexOffDiagonal = mpiprocOffDiagonal.EndElementIndex();
+      unsigned int offsetVect = 0;
+      for (unsigned int in = 0; in<startParIndexOffDiagonal; in++)
+         if ((in+offsetVect)%(n-1)==0) offsetVect += (in+offsetVect)/(n-1);
 
-   unsigned int offsetVect = 0;
-   for (unsigned int in = 0; in<startParIndexOffDiagonal; in++)
-      if ((in+offsetVect)%(n-1)==0) offsetVect += (in+offsetVect)/(n-1);
+      for (unsigned int in = startParIndexOffDiagonal;
+           in<endParIndexOffDiagonal; in++) {
 
-   for (unsigned int in = startParIndexOffDiagonal;
-        in<endParIndexOffDiagonal; in++) {
+         int i = (in+offsetVect)/(n-1);
+         if ((in+offsetVect)%(n-1)==0) offsetVect += i;
+         int j = (in+offsetVect)%(n-1)+1;
 
-      int i = (in+offsetVect)/(n-1);
-      if ((in+offsetVect)%(n-1)==0) offsetVect += i;
-      int j = (in+offsetVect)%(n-1)+1;
+         if ((i+1)==j || in==startParIndexOffDiagonal)
+            x(i) += dirin(i);
 
-      if ((i+1)==j || in==startParIndexOffDiagonal)
-         x(i) += dirin(i);
+         x(j) += dirin(j);
 
-      x(j) += dirin(j);
+         double fs1 = mfcn(x);
+         double elem = (fs1 + amin - yy(i) - yy(j))/(dirin(i)*dirin(j));
+         vhmat(i,j) = elem;
 
-      double fs1 = mfcn(x);
-      double elem = (fs1 + amin - yy(i) - yy(j))/(dirin(i)*dirin(j));
-      vhmat(i,j) = elem;
+         x(j) = x0(j);
 
-      x(j) -= dirin(j);
+         if (j%(n-1)==0 || in==endParIndexOffDiagonal-1)
+            x(i) = x0(i);
 
-      if (j%(n-1)==0 || in==endParIndexOffDiagonal-1)
-         x(i) -= dirin(i);
+      }
 
+      mpiprocOffDiagonal.SyncSymMatrixOffDiagonal(vhmat);
+      }
    }
 
-   mpiprocOffDiagonal.SyncSymMatrixOffDiagonal(vhmat);
-
    //verify if matrix pos-def (still 2nd derivative)
 
 #ifdef DEBUG
@@ -314,7 +512,7 @@ L30:
       return MinimumState(st.Parameters(), MinimumError(tmpsym, MinimumError::MnInvertFailed()), st.Gradient(), st.Edm(), mfcn.NumOfCalls());
    }
 
-   FunctionGradient gr(grd, g2, gst);
+   FunctionGradient gr(grd, g2, gst, analytical);
    VariableMetricEDMEstimator estim;
 
    // if matrix is made pos def returns anyway edm
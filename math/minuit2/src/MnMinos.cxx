@@ -13,6 +13,7 @@
 #include "Minuit2/MnFunctionCross.h"
 #include "Minuit2/MnCross.h"
 #include "Minuit2/MinosError.h"
+#include "Minuit2/MnThreadFcns.h"
 
 //#define DEBUG
 
@@ -87,30 +88,78 @@ double MnMinos::Upper(unsigned int par, unsigned int maxcalls, double toler) con
 
 MinosError MnMinos::Minos(unsigned int par, unsigned int maxcalls, double toler) const {
    // do full minos error anlysis (lower + upper) for parameter par
+   return Minos(std::vector<unsigned int>(1, par), maxcalls, toler)[0];
+}
+
+std::vector<MinosError> MnMinos::Minos(const std::vector<unsigned int>& pars, unsigned int maxcalls, double toler) const {
+   // do full minos error analysis (lower + upper) for a list of parameters
+   // The 2*npar crossings are independent: they can be found in parallel, each task working
+   // on its own copy of the user state and, if needed, on a clone of the FCN.
+   // The results are assembled in the order of the given parameters
    assert(fMinimum.IsValid());
-   assert(!fMinimum.UserState().Parameter(par).IsFixed());
-   assert(!fMinimum.UserState().Parameter(par).IsConst());
+   unsigned int npar = pars.size();
+   for (unsigned int i = 0; i < npar; ++i) {
+      assert(!fMinimum.UserState().Parameter(pars[i]).IsFixed());
+      assert(!fMinimum.UserState().Parameter(pars[i]).IsConst());
+   }
 
-   MnCross up = Upval(par, maxcalls,toler);
+   // crossings: lower error of pars[i] in 2*i, upper error in 2*i+1
+   std::vector<MnCross> crosses(2*npar);
+   int ntasks = 2*npar;
+
+   MnThreadFcns fcns(fFCN);
+   unsigned int nthreads = fcns.Init(fStrategy.MinosNThreads(), ntasks);
+
+#ifdef _OPENMP
+   if (nthreads > 1) {
+      // the user state is computed on demand: do it before running in parallel
+      fMinimum.UserState();
+      // the gradient in the minimizations of each task is computed serially
+      MnStrategy stra(fStrategy);
+      stra.SetGradientNThreads(1);
+
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic)
+      for (int k = 0; k < ntasks; ++k) {
+         int direction = (k%2 == 0) ? -1 : 1;
+         crosses[k] = FindCrossValue(direction, pars[k/2], maxcalls, toler, fcns(MnThreadFcns::ThreadId()), stra);
+      }
+   }
+   else
+#endif
+   {
+      (void) nthreads;
+      for (unsigned int i = 0; i < npar; ++i) {
+         crosses[2*i+1] = Upval(pars[i], maxcalls,toler);
 #ifdef DEBUG
-   std::cout << "Function calls to find upper error " << up.NFcn() << std::endl;
+         std::cout << "Function calls to find upper error " << crosses[2*i+1].NFcn() << std::endl;
 #endif
-
-   MnCross lo = Loval(par, maxcalls,toler);
-
+         crosses[2*i] = Loval(pars[i], maxcalls,toler);
 #ifdef DEBUG
-   std::cout << "Function calls to find lower error " << lo.NFcn() << std::endl;
+         std::cout << "Function calls to find lower error " << crosses[2*i].NFcn() << std::endl;
 #endif
+      }
+   }
 
-   return MinosError(par, fMinimum.UserState().Value(par), lo, up);
+   std::vector<MinosError> result;
+   result.reserve(npar);
+   for (unsigned int i = 0; i < npar; ++i)
+      result.push_back(MinosError(pars[i], fMinimum.UserState().Value(pars[i]), crosses[2*i], crosses[2*i+1]));
+
+   return result;
 }
 
 
 MnCross MnMinos::FindCrossValue(int direction, unsigned int par, unsigned int maxcalls, double toler) const {
+   // get crossing value in the parameter direction using the FCN and the strategy of MnMinos
+   return FindCrossValue(direction, par, maxcalls, toler, fFCN, fStrategy);
+}
+
+MnCross MnMinos::FindCrossValue(int direction, unsigned int par, unsigned int maxcalls, double toler, const FCNBase& fcn, const MnStrategy& stra) const {
    // get crossing value in the parameter direction :
    // direction = + 1 upper value
    // direction = -1 lower value
    // pass now tolerance used for Migrad minimizations
+   // The given FCN (the one of MnMinos or a clone of it) and strategy are used for the minimizations
 
    assert(direction == 1 || direction == -1);
 #ifdef DEBUG
@@ -138,7 +187,7 @@ MnCross MnMinos::FindCrossValue(int direction, unsigned int par, unsigned int ma
    std::vector<double> xmid(1, val);
    std::vector<double> xdir(1, err);
 
-   double up = fFCN.Up();
+   double up = fcn.Up();
    unsigned int ind = upar.IntOfExt(par);
    // get error matrix (methods return a copy)
    MnAlgebraicSymMatrix m = fMinimum.Error().Matrix();
@@ -171,7 +220,7 @@ MnCross MnMinos::FindCrossValue(int direction, unsigned int par, unsigned int ma
 #endif
 
 
-   MnFunctionCross cross(fFCN, upar, fMinimum.Fval(), fStrategy);
+   MnFunctionCross cross(fcn, upar, fMinimum.Fval(), stra);
    MnCross aopt = cross(para, xmid, xdir, toler, maxcalls);
 
 
@@ -0,0 +1,84 @@
+// @(#)root/minuit2:$Id$
+// Authors: M. Winkler, F. James, L. Moneta, A. Zsenei   2003-2005
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2005 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#include "Minuit2/MnThreadFcns.h"
+#include "Minuit2/FCNBase.h"
+
+#if defined(DEBUG) || defined(WARNINGMSG)
+#include "Minuit2/MnPrint.h"
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <cassert>
+
+namespace ROOT {
+
+   namespace Minuit2 {
+
+
+MnThreadFcns::~MnThreadFcns() {
+   // delete the FCN clones
+   for (unsigned int i = 0; i < fClones.size(); ++i)
+      delete fClones[i];
+}
+
+unsigned int MnThreadFcns::Init(unsigned int nthreads, unsigned int ntasks) {
+   // return the number of threads to use and create the FCN clones if the function is not thread safe.
+   // If the function cannot be cloned the computation is done serially
+#ifdef _OPENMP
+   // no nested parallelism (e.g. gradient inside a parallel Minos task) unless enabled
+   if (omp_in_parallel() && !omp_get_nested()) return 1;
+   if (nthreads == 0) nthreads = omp_get_max_threads();
+   if (nthreads > ntasks) nthreads = ntasks;
+   if (nthreads <= 1) return 1;
+
+   if (fFCN.IsThreadSafe()) return nthreads;
+
+   while (fClones.size() < nthreads-1) {
+      FCNBase * clone = fFCN.Clone();
+      if (!clone) {
+#ifdef WARNINGMSG
+         MN_INFO_MSG("MnThreadFcns: FCN is not thread safe and cannot be cloned - run serially");
+#endif
+         return 1;
+      }
+      fClones.push_back(clone);
+   }
+   return nthreads;
+#else
+   // no thread support
+   (void) nthreads;
+   (void) ntasks;
+   return 1;
+#endif
+}
+
+const FCNBase& MnThreadFcns::operator()(unsigned int ithread) const {
+   // return the original FCN for the first thread or when the function is thread safe,
+   // a clone otherwise
+   if (ithread == 0 || fClones.empty()) return fFCN;
+   assert(ithread <= fClones.size());
+   return *fClones[ithread-1];
+}
+
+unsigned int MnThreadFcns::ThreadId() {
+   // index of the calling thread in the current team
+#ifdef _OPENMP
+   return omp_get_thread_num();
+#else
+   return 0;
+#endif
+}
+
+   }  // namespace Minuit2
+
+}  // namespace ROOT
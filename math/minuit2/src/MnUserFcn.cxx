@@ -19,6 +19,12 @@ namespace ROOT {
 double MnUserFcn::operator()(const MnAlgebraicVector& v) const {
    // call Fcn function transforming from a MnAlgebraicVector of internal values to a std::vector of external ones
    fNumCall++;
+   return Eval(Fcn(), v);
+}
+
+double MnUserFcn::Eval(const FCNBase& fcn, const MnAlgebraicVector& v) const {
+   // call the given FCN (Fcn() or a clone of it) transforming the internal values to external ones.
+   // The call counter is not incremented
 
    // calling fTransform() like here was not thread safe because it was using a cached vector
    //return Fcn()( fTransform(v) );
@@ -39,7 +45,7 @@ double MnUserFcn::operator()(const MnAlgebraicVector& v) const {
          vpar[ext] = v(i);
       }
    }
-   return Fcn()(vpar);
+   return fcn(vpar);
 }
 
    }  // namespace Minuit2
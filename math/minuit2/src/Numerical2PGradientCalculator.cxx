@@ -17,16 +17,12 @@
 #include "Minuit2/MnStrategy.h"
 
 
+#include "Minuit2/FCNBase.h"
+
+
 //#define DEBUG
 #if defined(DEBUG) || defined(WARNINGMSG)
 #include "Minuit2/MnPrint.h"
-#ifdef _OPENMP
-#include <omp.h>
-#include <iomanip>
-#ifdef DEBUG
-#define DEBUG_MP
-#endif
-#endif
 #endif
 
 #include <math.h>
@@ -72,6 +68,12 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const std::vector<dou
 FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParameters& par, const FunctionGradient& Gradient) const {
    // calculate numerical gradient from MinimumParameters object
    // the algorithm takes correctly care when the gradient is approximatly zero
+   // The derivatives with respect to the different parameters are independent and they can be
+   // computed in parallel (see MnStrategy::SetGradientNThreads). Each thread uses its own copy
+   // of the parameter vector and, if the FCN is not thread safe, its own clone of the FCN.
+   // The result does not depend on the number of threads used.
+   // The function values of the last evaluation for each parameter are stored in the
+   // returned gradient, so that they can be re-used by MnHesse.
 
    //    std::cout<<"########### Numerical2PDerivative"<<std::endl;
    //    std::cout<<"initial grd: "<<Gradient.Grad()<<std::endl;
@@ -83,26 +85,13 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
    double fcnmin = par.Fval();
    //   std::cout<<"fval: "<<fcnmin<<std::endl;
 
-   double eps2 = Precision().Eps2();
-   double eps = Precision().Eps();
-
-   double dfmin = 8.*eps2*(fabs(fcnmin)+Fcn().Up());
-   double vrysml = 8.*eps*eps;
-   //   double vrysml = std::max(1.e-4, eps2);
-   //    std::cout<<"dfmin= "<<dfmin<<std::endl;
-   //    std::cout<<"vrysml= "<<vrysml<<std::endl;
-   //    std::cout << " ncycle " << Ncycle() << std::endl;
-
    unsigned int n = (par.Vec()).size();
-   unsigned int ncycle = Ncycle();
    //   MnAlgebraicVector vgrd(n), vgrd2(n), vgstp(n);
    MnAlgebraicVector grd = Gradient.Grad();
    MnAlgebraicVector g2 = Gradient.G2();
    MnAlgebraicVector gstep = Gradient.Gstep();
-
-#ifndef _OPENMP
-   MPIProcess mpiproc(n,0);
-#endif
+   std::vector<double> fplus(n);
+   std::vector<double> fminus(n);
 
 #ifdef DEBUG
    std::cout << "Calculating Gradient at x =   " << par.Vec() << std::endl;
@@ -111,121 +100,155 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
    std::cout.precision(pr);
 #endif
 
-#ifndef _OPENMP
-   // for serial execution this can be outside the loop
-   MnAlgebraicVector x = par.Vec();
-
-   unsigned int startElementIndex = mpiproc.StartElementIndex();
-   unsigned int endElementIndex = mpiproc.EndElementIndex();
+#ifdef _OPENMP
+   unsigned int nthreads = fThreadFcns.Init(Strategy().GradientNThreads(), n);
+   if (nthreads > 1) {
 
-   for(unsigned int i = startElementIndex; i < endElementIndex; i++) {
+      // number of function calls per parameter, summed at the end in a fixed order
+      std::vector<unsigned int> ncalls(n);
 
-#else
+#pragma omp parallel num_threads(nthreads)
+      {
+         const FCNBase& fcn = fThreadFcns(MnThreadFcns::ThreadId());
+         // each thread uses its own copy of the parameter vector
+         MnAlgebraicVector x = par.Vec();
 
- // parallelize this loop using OpenMP
-//#define N_PARALLEL_PAR 5
-#pragma omp parallel
-#pragma omp for
-//#pragma omp for schedule (static, N_PARALLEL_PAR)
+#pragma omp for schedule(dynamic)
+         for(int i = 0; i < int(n); i++)
+            ncalls[i] = Derivative(i, fcn, x, fcnmin, grd, g2, gstep, fplus, fminus);
+      }
 
-   for(int i = 0; i < int(n); i++) {
+      int ncall = 0;
+      bool allEvaluated = true;
+      for(unsigned int i = 0; i < n; i++) {
+         ncall += ncalls[i];
+         if (ncalls[i] == 0) allEvaluated = false;
+      }
+      Fcn().AddCalls(ncall);
 
+      if (allEvaluated) return FunctionGradient(grd, g2, gstep, fplus, fminus);
+      return FunctionGradient(grd, g2, gstep);
+   }
 #endif
 
-#ifdef DEBUG_MP
-      int ith = omp_get_thread_num();
-      //std::cout << "Thread number " << ith << "  " << i << std::endl;
-#endif
+   // serial calculation (parameters are eventually distributed among the MPI processes)
+   MPIProcess mpiproc(n,0);
 
-#ifdef _OPENMP
-       // create in loop since each thread will use its own copy
-      MnAlgebraicVector x = par.Vec();
-#endif
+   MnAlgebraicVector x = par.Vec();
+
+   unsigned int startElementIndex = mpiproc.StartElementIndex();
+   unsigned int endElementIndex = mpiproc.EndElementIndex();
 
-      double xtf = x(i);
-      double epspri = eps2 + fabs(grd(i)*eps2);
-      double stepb4 = 0.;
-      for(unsigned int j = 0; j < ncycle; j++)  {
-         double optstp = sqrt(dfmin/(fabs(g2(i))+epspri));
-         double step = std::max(optstp, fabs(0.1*gstep(i)));
-         //       std::cout<<"step: "<<step;
-         if(Trafo().Parameter(Trafo().ExtOfInt(i)).HasLimits()) {
-            if(step > 0.5) step = 0.5;
-         }
-         double stpmax = 10.*fabs(gstep(i));
-         if(step > stpmax) step = stpmax;
-         //       std::cout<<" "<<step;
-         double stpmin = std::max(vrysml, 8.*fabs(eps2*x(i)));
-         if(step < stpmin) step = stpmin;
-         //       std::cout<<" "<<step<<std::endl;
-         //       std::cout<<"step: "<<step<<std::endl;
-         if(fabs((step-stepb4)/step) < StepTolerance()) {
-            //    std::cout<<"(step-stepb4)/step"<<std::endl;
-            //    std::cout<<"j= "<<j<<std::endl;
-            //    std::cout<<"step= "<<step<<std::endl;
-            break;
-         }
-         gstep(i) = step;
-         stepb4 = step;
-         //       MnAlgebraicVector pstep(n);
-         //       pstep(i) = step;
-         //       double fs1 = Fcn()(pstate + pstep);
-         //       double fs2 = Fcn()(pstate - pstep);
-
-         x(i) = xtf + step;
-         double fs1 = Fcn()(x);
-         x(i) = xtf - step;
-         double fs2 = Fcn()(x);
-         x(i) = xtf;
-
-         double grdb4 = grd(i);
-         grd(i) = 0.5*(fs1 - fs2)/step;
-         g2(i) = (fs1 + fs2 - 2.*fcnmin)/step/step;
+   int ncall = 0;
+   // the function values are kept only if all the parameters have been evaluated by this process
+   bool allEvaluated = (startElementIndex == 0 && endElementIndex == n);
+   for(unsigned int i = startElementIndex; i < endElementIndex; i++) {
+      unsigned int nc = Derivative(i, Fcn().Fcn(), x, fcnmin, grd, g2, gstep, fplus, fminus);
+      if (nc == 0) allEvaluated = false;
+      ncall += nc;
+   }
+   Fcn().AddCalls(ncall);
 
-#ifdef DEBUG
-         pr = std::cout.precision(13);
-         std::cout << "cycle " << j << " x " << x(i) << " step " << step << " f1 " << fs1 << " f2 " << fs2
-                   << " grd " << grd(i) << " g2 " << g2(i) << std::endl;
-         std::cout.precision(pr);
-#endif
+   mpiproc.SyncVector(grd);
+   mpiproc.SyncVector(g2);
+   mpiproc.SyncVector(gstep);
 
-         if(fabs(grdb4-grd(i))/(fabs(grd(i))+dfmin/step) < GradTolerance())  {
-            //    std::cout<<"j= "<<j<<std::endl;
-            //    std::cout<<"step= "<<step<<std::endl;
-            //    std::cout<<"fs1, fs2: "<<fs1<<" "<<fs2<<std::endl;
-            //    std::cout<<"fs1-fs2: "<<fs1-fs2<<std::endl;
-            break;
-         }
-      }
+   if (allEvaluated) return FunctionGradient(grd, g2, gstep, fplus, fminus);
+   return FunctionGradient(grd, g2, gstep);
+}
 
+unsigned int Numerical2PGradientCalculator::Derivative(unsigned int i, const FCNBase& fcn, MnAlgebraicVector& x, double fcnmin,
+                                                       MnAlgebraicVector& grd, MnAlgebraicVector& g2, MnAlgebraicVector& gstep,
+                                                       std::vector<double>& fplus, std::vector<double>& fminus) const {
+   // compute first and second derivative and the step size for the internal parameter i,
+   // evaluating the given FCN instance. Only the i-th component of x, grd, g2, gstep, fplus and fminus
+   // is used (x(i) is restored on exit). fplus and fminus store the function values at x(i) +/- gstep(i).
+   // Return the number of function calls
 
-#ifdef DEBUG_MP
-#pragma omp critical
-      {
-         std::cout << "Gradient for thread " << ith << "  " << i << "  " << std::setprecision(15)  << grd(i) << "  " << g2(i) << std::endl;
-      }
-#endif
+   double eps2 = Precision().Eps2();
+   double eps = Precision().Eps();
 
-      //     vgrd(i) = grd;
-      //     vgrd2(i) = g2;
-      //     vgstp(i) = gstep;
+   double dfmin = 8.*eps2*(fabs(fcnmin)+Fcn().Up());
+   double vrysml = 8.*eps*eps;
+   //   double vrysml = std::max(1.e-4, eps2);
+   //    std::cout<<"dfmin= "<<dfmin<<std::endl;
+   //    std::cout<<"vrysml= "<<vrysml<<std::endl;
+   //    std::cout << " ncycle " << Ncycle() << std::endl;
 
+   unsigned int ncycle = Ncycle();
+   unsigned int ncall = 0;
+
+   double xtf = x(i);
+   double epspri = eps2 + fabs(grd(i)*eps2);
+   double stepb4 = 0.;
+   for(unsigned int j = 0; j < ncycle; j++)  {
+      double optstp = sqrt(dfmin/(fabs(g2(i))+epspri));
+      double step = std::max(optstp, fabs(0.1*gstep(i)));
+      //       std::cout<<"step: "<<step;
+      if(Trafo().Parameter(Trafo().ExtOfInt(i)).HasLimits()) {
+         if(step > 0.5) step = 0.5;
+      }
+      double stpmax = 10.*fabs(gstep(i));
+      if(step > stpmax) step = stpmax;
+      //       std::cout<<" "<<step;
+      double stpmin = std::max(vrysml, 8.*fabs(eps2*x(i)));
+      if(step < stpmin) step = stpmin;
+      //       std::cout<<" "<<step<<std::endl;
+      //       std::cout<<"step: "<<step<<std::endl;
+      if(fabs((step-stepb4)/step) < StepTolerance()) {
+         //    std::cout<<"(step-stepb4)/step"<<std::endl;
+         //    std::cout<<"j= "<<j<<std::endl;
+         //    std::cout<<"step= "<<step<<std::endl;
+         break;
+      }
+      gstep(i) = step;
+      stepb4 = step;
+      //       MnAlgebraicVector pstep(n);
+      //       pstep(i) = step;
+      //       double fs1 = Fcn()(pstate + pstep);
+      //       double fs2 = Fcn()(pstate - pstep);
+
+      x(i) = xtf + step;
+      double fs1 = Fcn().Eval(fcn, x);
+      x(i) = xtf - step;
+      double fs2 = Fcn().Eval(fcn, x);
+      x(i) = xtf;
+      ncall += 2;
+      fplus[i] = fs1;
+      fminus[i] = fs2;
+
+      double grdb4 = grd(i);
+      grd(i) = 0.5*(fs1 - fs2)/step;
+      g2(i) = (fs1 + fs2 - 2.*fcnmin)/step/step;
 
 #ifdef DEBUG
-      pr = std::cout.precision(13);
-      int iext = Trafo().ExtOfInt(i);
-      std::cout << "Parameter " << Trafo().Name(iext) << " Gradient =   " << grd(i) << " g2 = " << g2(i) << " step " << gstep(i) << std::endl;
+      int pr = std::cout.precision(13);
+      std::cout << "cycle " << j << " x " << x(i) << " step " << step << " f1 " << fs1 << " f2 " << fs2
+                << " grd " << grd(i) << " g2 " << g2(i) << std::endl;
       std::cout.precision(pr);
 #endif
+
+      if(fabs(grdb4-grd(i))/(fabs(grd(i))+dfmin/step) < GradTolerance())  {
+         //    std::cout<<"j= "<<j<<std::endl;
+         //    std::cout<<"step= "<<step<<std::endl;
+         //    std::cout<<"fs1, fs2: "<<fs1<<" "<<fs2<<std::endl;
+         //    std::cout<<"fs1-fs2: "<<fs1-fs2<<std::endl;
+         break;
+      }
    }
 
-#ifndef _OPENMP
-   mpiproc.SyncVector(grd);
-   mpiproc.SyncVector(g2);
-   mpiproc.SyncVector(gstep);
+   //     vgrd(i) = grd;
+   //     vgrd2(i) = g2;
+   //     vgstp(i) = gstep;
+
+#ifdef DEBUG
+   int pr = std::cout.precision(13);
+   int iext = Trafo().ExtOfInt(i);
+   std::cout << "Parameter " << Trafo().Name(iext) << " Gradient =   " << grd(i) << " g2 = " << g2(i) << " step " << gstep(i) << std::endl;
+   std::cout.precision(pr);
 #endif
 
-   return FunctionGradient(grd, g2, gstep);
+   return ncall;
 }
 
 const MnMachinePrecision& Numerical2PGradientCalculator::Precision() const {
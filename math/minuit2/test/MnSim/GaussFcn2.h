@@ -37,6 +37,9 @@ public:
   virtual double operator()(const std::vector<double>&) const;
   virtual double ErrorDef() const {return Up();}
 
+  // the function only reads the data: it can be evaluated concurrently
+  virtual bool IsThreadSafe() const {return true;}
+
   std::vector<double> Measurements() const {return fMeasurements;}
   std::vector<double> Positions() const {return fPositions;}
   std::vector<double> Variances() const {return fMVariances;}
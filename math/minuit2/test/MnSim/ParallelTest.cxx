@@ -13,7 +13,9 @@
 #include "Minuit2/MnUserParameterState.h"
 #include "Minuit2/MnPrint.h"
 #include "Minuit2/MnMigrad.h"
+#include "Minuit2/MnStrategy.h"
 #include "Minuit2/MnMinos.h"
+#include "Minuit2/MnHesse.h"
 #include "Minuit2/MnPlot.h"
 #include "Minuit2/MinosError.h"
 #include "Minuit2/FCNBase.h"
@@ -107,15 +109,65 @@ int doFit(int ndim, int ndata) {
   for (int k = 0; k < 2*ndim; ++k) {
      init_err[k] = 0.1;
   }
-  // create minimizer (default constructor)
-  VariableMetricMinimizer fMinimizer;
+  MnUserParameterState init_state(init_par, init_err);
 
-  // Minimize
-  FunctionMinimum min = fMinimizer.Minimize(fcn, init_par, init_err);
+  // minimize computing the gradient serially
+  MnStrategy serial(1);
+  serial.SetGradientNThreads(1);
+  MnMigrad migrad1(fcn, init_state, serial);
+  FunctionMinimum min1 = migrad1();
+
+  // minimize using all the available threads for the gradient
+  // (define OMP_NUM_THREADS to change their number)
+  MnStrategy parallel(1);
+  parallel.SetGradientNThreads(0);
+  MnMigrad migrad2(fcn, init_state, parallel);
+  FunctionMinimum min = migrad2();
 
   // output
   std::cout<<"minimum: "<<min<<std::endl;
 
+  // the result must not depend on the number of threads
+  int iret = 0;
+  if (min.Fval() != min1.Fval() || min.NFcn() != min1.NFcn() ) iret = 1;
+  for (unsigned int i = 0; i < init_par.size(); ++i) {
+     if (min.UserState().Value(i) != min1.UserState().Value(i) ) iret = 1;
+  }
+  if (iret) std::cout << "Error: serial and parallel gradient calculation give different results" << std::endl;
+
+  // error matrix from Hesse, computed serially and in parallel
+  MnUserParameterState hstate1 = MnHesse(serial)(fcn, min.UserState());
+  MnUserParameterState hstate2 = MnHesse(parallel)(fcn, min.UserState());
+  bool hesseOk = hstate1.IsValid() && hstate2.IsValid() && hstate1.NFcn() == hstate2.NFcn();
+  for (unsigned int i = 0; hesseOk && i < init_par.size(); ++i) {
+     for (unsigned int j = 0; j <= i; ++j)
+        if (hstate1.Covariance()(i,j) != hstate2.Covariance()(i,j) ) hesseOk = false;
+  }
+  if (!hesseOk) {
+     std::cout << "Error: serial and parallel Hesse give different results" << std::endl;
+     iret = 3;
+  }
+
+  // Minos errors of the first parameters, computed serially and running
+  // the lower and upper crossings of all parameters concurrently
+  std::vector<unsigned int> minosPars;
+  for (unsigned int i = 0; i < 4 && i < init_par.size(); ++i) minosPars.push_back(i);
+
+  MnMinos minos1(fcn, min, serial);
+  std::vector<MinosError> merr1 = minos1.Minos(minosPars);
+
+  parallel.SetMinosNThreads(0);
+  MnMinos minos2(fcn, min, parallel);
+  std::vector<MinosError> merr2 = minos2.Minos(minosPars);
+
+  for (unsigned int i = 0; i < minosPars.size(); ++i) {
+     std::cout << "par " << minosPars[i] << " Minos errors: " << merr2[i].Lower() << "  " << merr2[i].Upper() << std::endl;
+     if (merr1[i].Lower() != merr2[i].Lower() || merr1[i].Upper() != merr2[i].Upper() || merr1[i].NFcn() != merr2[i].NFcn() ) {
+        std::cout << "Error: serial and parallel Minos give different results for parameter " << minosPars[i] << std::endl;
+        iret = 2;
+     }
+  }
+
 
 //     // create MINOS Error factory
 //     MnMinos Minos(fFCN, min);
@@ -141,7 +193,7 @@ int doFit(int ndim, int ndata) {
 //   }
 
 
-  return 0;
+  return iret;
 }
 
 int main(int argc, char **argv) {
@@ -154,5 +206,5 @@ int main(int argc, char **argv) {
       ndata = atoi(argv[2] );
    }
    std::cout << "do fit of " << ndim << " dimensional data on " << ndata << " events " << std::endl;
-   doFit(ndim,ndata);
+   return doFit(ndim,ndata);
 }
@@ -13,6 +13,8 @@
 #include "Minuit2/MnHesse.h"
 #include "Minuit2/MnUserParameters.h"
 #include "Minuit2/MnPrint.h"
+
+#include <cmath>
 // #include "TimingUtilities/PentiumTimer.h"
 
 // StackAllocator gStackAllocator;
@@ -21,6 +23,7 @@ using namespace ROOT::Minuit2;
 
 int main() {
 
+  int iret = 0;
   Quad4F fcn;
 
 //   PentiumTimer stopwatch;
@@ -58,8 +61,44 @@ int main() {
 
      // try to run hesse
      MnHesse hesse;
+     unsigned int nfcn = min.NFcn();
      hesse( gfcn, min);
      std::cout<<"minimum after hesse: "<<min<<std::endl;
+
+     // the Hessian from the analytical gradient keeps the gradient analytical
+     // and counts each of the 2n gradient calls
+     if (!min.IsValid() || !min.State().Gradient().IsAnalytical() || min.NFcn() < nfcn + 2*upar.VariableParameters()) {
+        std::cout<<"Error: wrong state after hesse with the analytical gradient"<<std::endl;
+        iret = 1;
+     }
+
+     // same error matrix as from the numerical second derivatives
+     MnUserParameterState gstate = hesse(gfcn, min.UserState());
+     MnUserParameterState nstate = hesse(fcn, min.UserState());
+     if (!gstate.IsValid() || !nstate.IsValid()) {
+        std::cout<<"Error: invalid state after hesse"<<std::endl;
+        iret = 1;
+     }
+     for (unsigned int i = 0; iret == 0 && i < upar.VariableParameters(); ++i) {
+        for (unsigned int j = 0; j <= i; ++j) {
+           double cg = gstate.Covariance()(i,j);
+           double cn = nstate.Covariance()(i,j);
+           double cmax = std::sqrt(nstate.Covariance()(i,i)*nstate.Covariance()(j,j));
+           if (std::abs(cg - cn) > 1.E-4*cmax) {
+              std::cout<<"Error: hesse covariance ("<<i<<","<<j<<") is "<<cg<<" with the analytical gradient and "
+                       <<cn<<" with the numerical one"<<std::endl;
+              iret = 2;
+           }
+        }
+     }
+
+     // the maximum number of calls applies also with the analytical gradient
+     FunctionMinimum min2 = migrad();
+     hesse( gfcn, min2, min2.NFcn() + 1);
+     if (!min2.HesseFailed()) {
+        std::cout<<"Error: hesse with the analytical gradient does not respect the maximum number of calls"<<std::endl;
+        iret = 3;
+     }
   }
 
 //   stop = stopwatch.lap().ticks();
@@ -108,5 +147,5 @@ int main() {
   }
 */
 
-  return 0;
+  return iret;
 }
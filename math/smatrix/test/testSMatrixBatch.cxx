@@ -0,0 +1,228 @@
+// test of the batches of matrices and vectors (SMatrixBatch, SVectorBatch)
+// a Kalman filter update of many tracks is computed with the batch classes
+// and with SMatrix for each track: the results are compared and the time
+// per track is printed for both versions
+
+#include "Math/SMatrix.h"
+#include "Math/SVector.h"
+#include "Math/SMatrixBatch.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+#include "TError.h"
+#include <vector>
+#include <iostream>
+#include <cstdio>
+#include <cmath>
+#include <string>
+
+using namespace ROOT::Math;
+
+bool gVerbose = false;
+
+// number of tracks in a batch
+const unsigned int NB = 16;
+// number of batches
+const unsigned int NBATCH = 400;
+
+typedef SMatrix<double,5,5,MatRepSym<double,5> > SymMatrix5;
+typedef SMatrix<double,2,2,MatRepSym<double,2> > SymMatrix2;
+typedef SMatrix<double,2,5>                      Matrix25;
+typedef SMatrix<double,5,2>                      Matrix52;
+typedef SMatrix<double,5,5>                      Matrix5;
+typedef SVector<double,5>                        Vector5;
+typedef SVector<double,2>                        Vector2;
+
+typedef SMatrixBatch<double,5,5,NB> BMatrix5;
+typedef SMatrixBatch<double,2,2,NB> BMatrix2;
+typedef SMatrixBatch<double,2,5,NB> BMatrix25;
+typedef SMatrixBatch<double,5,2,NB> BMatrix52;
+typedef SVectorBatch<double,5,NB>   BVector5;
+typedef SVectorBatch<double,2,NB>   BVector2;
+
+// input of the Kalman update of one track
+struct TrackState {
+   Vector5    x;    // state
+   SymMatrix5 C;    // covariance
+   Vector2    m;    // measurement
+   SymMatrix2 V;    // covariance of the measurement
+};
+
+// common transport matrix, process noise and projection
+Matrix5    gF;
+SymMatrix5 gQ;
+Matrix25   gH;
+
+// Kalman update with SMatrix
+void UpdateSMatrix(TrackState & t, double & chi2)
+{
+   Vector5 xp = gF * t.x;
+   SymMatrix5 Cp = Similarity(gF, t.C) + gQ;
+   Vector2 r = t.m - gH * xp;
+   SymMatrix2 R = Similarity(gH, Cp) + t.V;
+   R.InvertChol();
+   Matrix52 K = Cp * Transpose(gH) * R;
+   t.x = xp + K * r;
+   Matrix5 KH = K * gH;
+   Matrix5 Cn = Cp - KH * Cp;
+   for (unsigned int i = 0; i < 5; ++i)
+      for (unsigned int j = 0; j <= i; ++j) t.C(i,j) = Cn(i,j);
+   chi2 = Similarity(R, r);
+}
+
+// Kalman update of NB tracks with the batch classes
+void UpdateBatch(BVector5 & x, BMatrix5 & C, const BVector2 & m, const BMatrix2 & V,
+                 const BMatrix5 & F, const BMatrix5 & Q, const BMatrix25 & H, double * chi2)
+{
+   BVector5 xp = F * x;
+   BMatrix5 Cp = Similarity(F, C) + Q;
+   BVector2 r = m - H * xp;
+   BMatrix2 R = Similarity(H, Cp) + V;
+   R.InvertChol();
+   BMatrix52 K = Cp * Transpose(H) * R;
+   x = xp + K * r;
+   C = Cp - (K * H) * Cp;
+   Similarity(R, r, chi2);
+}
+
+void MakeTracks(std::vector<TrackState> & tracks)
+{
+   TRandom3 rnd(4357);
+   for (unsigned int it = 0; it < tracks.size(); ++it) {
+      TrackState & t = tracks[it];
+      Matrix5 A;
+      for (unsigned int i = 0; i < 5; ++i) {
+         t.x[i] = rnd.Uniform(-1,1);
+         for (unsigned int j = 0; j < 5; ++j) A(i,j) = rnd.Uniform(-1,1);
+      }
+      t.C = SimilarityT(A, SymMatrix5(SMatrixIdentity()));
+      for (unsigned int i = 0; i < 5; ++i) t.C(i,i) += 0.1;
+      t.m[0] = rnd.Gaus(0,1); t.m[1] = rnd.Gaus(0,1);
+      t.V(0,0) = 0.01; t.V(1,1) = 0.02; t.V(0,1) = 0.001;
+   }
+   for (unsigned int i = 0; i < 5; ++i) {
+      gF(i,i) = 1;
+      if (i < 4) gF(i,i+1) = 0.1;
+      gQ(i,i) = 1.E-4;
+   }
+   gH(0,0) = 1; gH(1,1) = 1; gH(1,2) = 0.5;
+}
+
+bool Equal(double a, double b)
+{
+   return std::abs(a-b) <= 1.E-10 * std::max(1., std::abs(b));
+}
+
+int testKalmanBatch()
+{
+   const unsigned int ntrack = NB*NBATCH;
+   std::vector<TrackState> tracks(ntrack);
+   MakeTracks(tracks);
+   std::vector<TrackState> tracks0 = tracks;
+
+   // the batches
+   std::vector<BVector5> x(NBATCH);
+   std::vector<BMatrix5> C(NBATCH);
+   std::vector<BVector2> m(NBATCH);
+   std::vector<BMatrix2> V(NBATCH);
+   for (unsigned int ib = 0; ib < NBATCH; ++ib) {
+      for (unsigned int n = 0; n < NB; ++n) {
+         const TrackState & t = tracks[ib*NB+n];
+         x[ib].Place(n, t.x);
+         C[ib].Place(n, t.C);
+         m[ib].Place(n, t.m);
+         V[ib].Place(n, t.V);
+      }
+   }
+   const BMatrix5  F(gF);
+   const BMatrix5  Q(gQ);
+   const BMatrix25 H(gH);
+
+   const int nloop = 100;
+   std::vector<double> chi2(ntrack), chi2b(ntrack);
+   TStopwatch w;
+
+   // the filter is applied nloop times to each track
+   w.Start();
+   for (int l = 0; l < nloop; ++l)
+      for (unsigned int it = 0; it < ntrack; ++it) UpdateSMatrix(tracks[it], chi2[it]);
+   w.Stop();
+   double tsmatrix = w.CpuTime();
+
+   w.Start();
+   for (int l = 0; l < nloop; ++l)
+      for (unsigned int ib = 0; ib < NBATCH; ++ib) UpdateBatch(x[ib], C[ib], m[ib], V[ib], F, Q, H, &chi2b[ib*NB]);
+   w.Stop();
+   double tbatch = w.CpuTime();
+
+   int nfail = 0;
+   for (unsigned int ib = 0; ib < NBATCH; ++ib) {
+      for (unsigned int n = 0; n < NB; ++n) {
+         const unsigned int it = ib*NB+n;
+         bool ok = Equal(chi2b[it], chi2[it]);
+         for (unsigned int i = 0; i < 5; ++i) {
+            ok &= Equal(x[ib](i,n), tracks[it].x[i]);
+            for (unsigned int j = 0; j < 5; ++j) ok &= Equal(C[ib](i,j,n), tracks[it].C(i,j));
+         }
+         if (!ok) {
+            if (nfail == 0 || gVerbose)
+               Error("testKalmanBatch","different result for track %d : chi2 = %.17g (SMatrix %.17g)", it, chi2b[it], chi2[it]);
+            nfail++;
+         }
+      }
+   }
+
+   // test of the inversion of matrices which are not positive definite
+   BMatrix2 R(V[0]);
+   SymMatrix2 Rbad; Rbad(0,0) = 1; Rbad(1,1) = 1; Rbad(0,1) = 2;
+   R.Place(3, Rbad);
+   bool okInv[NB];
+   bool allok = R.InvertChol(okInv);
+   for (unsigned int n = 0; n < NB; ++n) {
+      SymMatrix2 Rn = tracks0[n].V;
+      if (n == 3) Rn = Rbad;
+      bool okn = Rn.InvertChol();
+      if (okn != okInv[n] || !Equal(R(0,0,n), Rn(0,0)) || !Equal(R(0,1,n), Rn(0,1)) || !Equal(R(1,1,n), Rn(1,1))) {
+         Error("testKalmanBatch","wrong inversion of the instance %d", n);
+         nfail++;
+      }
+   }
+   if (allok) {
+      Error("testKalmanBatch","inversion of a matrix which is not positive definite");
+      nfail++;
+   }
+
+   printf("Kalman update (5x5 covariance, 2-d measurement), microseconds/track\n");
+   printf("   SMatrix  %8.4f\n", tsmatrix*1.E6/(double(ntrack)*nloop));
+   printf("   batch    %8.4f   (%d tracks per batch)\n", tbatch*1.E6/(double(ntrack)*nloop), NB);
+
+   if (nfail == 0) printf("Test of the Kalman update with SMatrixBatch:  OK\n");
+   return (nfail == 0) ? 0 : 1;
+}
+
+int testSMatrixBatch()
+{
+   int iret = testKalmanBatch();
+
+   if (iret) std::cerr << "testSMatrixBatch: Test FAILED !" << std::endl;
+   return iret;
+}
+
+int main(int argc, char **argv)
+{
+   // Parse command line arguments
+   for (int i=1 ;  i<argc ; i++) {
+      std::string arg = argv[i] ;
+      if (arg == "-v") {
+         gVerbose = true;
+      }
+      if (arg == "-h") {
+         std::cout << "Usage: " << argv[0] << " [-v]\n";
+         std::cout << "  where:\n";
+         std::cout << "     -v : verbose  mode";
+         std::cout << std::endl;
+         return -1;
+      }
+   }
+
+   return testSMatrixBatch();
+}
@@ -37,8 +37,6 @@ public:
   Int_t getGenerator(const RooArgSet& directVars, RooArgSet &generateVars, Bool_t staticInitOK=kTRUE) const;
   void generateEvent(Int_t code);
 
-  Double_t getLogVal(const RooArgSet* set) const ;
-
 protected:
 
   RooRealProxy x ;
@@ -46,6 +44,7 @@ protected:
   RooRealProxy sigma ;
   
   Double_t evaluate() const ;
+  Bool_t evaluateBatch(Double_t* output, Int_t firstEvent, Int_t nEvents, const RooVectorDataStore& data) const ;
 
 private:
 
@@ -62,6 +62,22 @@ Double_t RooExponential::evaluate() const{
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate() for a range of events of a vector data store
+
+Bool_t RooExponential::evaluateBatch(Double_t* output, Int_t firstEvent, Int_t nEvents, const RooVectorDataStore& data) const
+{
+  std::vector<Double_t> xbuf, cbuf ;
+  const Double_t* xv = batchValues(x.arg(),firstEvent,nEvents,data,xbuf,x.nset()) ;
+  const Double_t* cv = batchValues(c.arg(),firstEvent,nEvents,data,cbuf,c.nset()) ;
+
+  for (Int_t i=0 ; i<nEvents ; i++) {
+    output[i] = exp(cv[i]*xv[i]) ;
+  }
+  return kTRUE ;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooExponential::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const 
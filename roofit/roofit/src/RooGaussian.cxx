@@ -78,26 +78,25 @@ Double_t RooGaussian::evaluate() const
 
 
 ////////////////////////////////////////////////////////////////////////////////
-/// calculate and return the negative log-likelihood of the Poisson                                                                                                                                    
+/// Batch version of evaluate() for a range of events of a vector data store
 
-Double_t RooGaussian::getLogVal(const RooArgSet* set) const 
+Bool_t RooGaussian::evaluateBatch(Double_t* output, Int_t firstEvent, Int_t nEvents, const RooVectorDataStore& data) const
 {
-  return RooAbsPdf::getLogVal(set) ;
-//   Double_t prob = getVal(set) ;
-//   return log(prob) ;
-
-  Double_t arg= x - mean;  
-  Double_t sig = sigma ;
-  
-  //static const Double_t rootPiBy2 = sqrt(atan2(0.0,-1.0)/2.0);
-  //Double_t extra = -0.5*arg*arg/(sig*sig) - log(2*rootPiBy2*sig) ;
-  Double_t extra = -0.5*arg*arg/(sig*sig) - log(analyticalIntegral(1,0)) ;
-  
-  return extra ; 
-  
+  std::vector<Double_t> xbuf, meanbuf, sigmabuf ;
+  const Double_t* xv = batchValues(x.arg(),firstEvent,nEvents,data,xbuf,x.nset()) ;
+  const Double_t* mv = batchValues(mean.arg(),firstEvent,nEvents,data,meanbuf,mean.nset()) ;
+  const Double_t* sv = batchValues(sigma.arg(),firstEvent,nEvents,data,sigmabuf,sigma.nset()) ;
+
+  for (Int_t i=0 ; i<nEvents ; i++) {
+    Double_t arg = xv[i] - mv[i] ;
+    Double_t sig = sv[i] ;
+    output[i] = exp(-0.5*arg*arg/(sig*sig)) ;
+  }
+  return kTRUE ;
 }
 
 
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooGaussian::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const 
@@ -152,6 +152,36 @@ Double_t RooPolynomial::evaluate() const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate() for a range of events of a vector data store
+
+Bool_t RooPolynomial::evaluateBatch(Double_t* output, Int_t firstEvent, Int_t nEvents, const RooVectorDataStore& data) const
+{
+  std::vector<Double_t> xbuf, cbuf ;
+  const Double_t* xv = batchValues(_x.arg(),firstEvent,nEvents,data,xbuf,_x.nset()) ;
+
+  Int_t order(_lowestOrder) ;
+  Double_t sum0(order<1 ? 0 : 1) ;
+  for (Int_t i=0 ; i<nEvents ; i++) {
+    output[i] = sum0 ;
+  }
+
+  _coefIter->Reset() ;
+
+  RooAbsReal* coef ;
+  const RooArgSet* nset = _coefList.nset() ;
+  while((coef=(RooAbsReal*)_coefIter->Next())) {
+    const Double_t* cv = batchValues(*coef,firstEvent,nEvents,data,cbuf,nset) ;
+    for (Int_t i=0 ; i<nEvents ; i++) {
+      output[i] += cv[i]*TMath::Power(xv[i],order) ;
+    }
+    order++ ;
+  }
+  return kTRUE ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooPolynomial::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const 
@@ -150,3 +150,8 @@ distclean::     distclean-$(MODNAME)
 $(ROOFITCOREDO): NOOPT = $(OPT)
 # FIXME: Temporarily until we understand where the errors come from.
 $(ROOFITCOREDO): CXXFLAGS := $(filter-out -Xclang -fmodules -Xclang -fmodules-cache-path=$(ROOTSYS)/pcm/, $(CXXFLAGS))
+# the partitions of the test statistics can optionally be calculated in OpenMP threads
+ifneq ($(USE_OPENMP),)
+$(call stripsrc,$(ROOFITCOREDIRS)/RooAbsTestStatistic.o $(ROOFITCOREDIRS)/RooAbsReal.o): CXXFLAGS += -fopenmp
+$(ROOFITCORELIB): LDFLAGS += -fopenmp
+endif
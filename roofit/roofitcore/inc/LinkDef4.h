@@ -52,6 +52,9 @@
 #pragma link C++ class RooVectorDataStore::RealVector- ;
 #pragma link C++ class RooVectorDataStore::RealFullVector- ;
 #pragma link C++ class RooVectorDataStore::CatVector- ;
+#pragma link C++ class std::vector<RooCatType>+ ;
+#pragma read sourceClass="RooVectorDataStore::CatVector" targetClass="RooVectorDataStore::CatVector" version="[1]" source="std::vector<RooCatType> _vec" target="_vec" \
+  code="{ _vec.clear() ; _vec.reserve(onfile._vec.size()) ; for (UInt_t i=0 ; i<onfile._vec.size() ; i++) { _vec.push_back(onfile._vec[i].getVal()) ; } }" 
 #pragma link C++ class std::pair<std::string,RooAbsData*>+ ;
 #pragma link C++ class std::pair<int,RooLinkedListElem*>+ ;
 #pragma link C++ class RooUnitTest+ ;
@@ -281,6 +281,8 @@ public:
   void printDirty(Bool_t depth=kTRUE) const ;
 
   static void setDirtyInhibit(Bool_t flag) ;
+  static Bool_t setThreadedCalculation(Bool_t flag) ;
+  static Bool_t threadedCalculation() { return _threadedCalc ; }
 
   virtual Bool_t operator==(const RooAbsArg& other) = 0 ;
   virtual Bool_t isIdentical(const RooAbsArg& other, Bool_t assumeSameType=kFALSE) = 0 ;
@@ -532,6 +534,7 @@ public:
   friend class RooVectorDataStore ;
   friend class RooTreeData ;
   friend class RooDataSet ;
+  friend class RooDataHist ;
   friend class RooRealMPFE ;
   virtual void syncCache(const RooArgSet* nset=0) = 0 ;
   virtual void copyCache(const RooAbsArg* source, Bool_t valueOnly=kFALSE, Bool_t setValDirty=kTRUE) = 0 ;
@@ -551,8 +554,12 @@ public:
   // Debug stuff
   static Bool_t _verboseDirty ; // Static flag controlling verbose messaging for dirty state changes
   static Bool_t _inhibitDirty ; // Static flag controlling global inhibit of dirty state propagation
+  static Bool_t _threadedCalc ; // Static flag set during multi-threaded calculations, when the inhibit flag is kept per thread
+  static Bool_t& threadInhibitDirty() ;
   Bool_t _deleteWatch ; //! Delete watch flag 
 
+  // Global dirty inhibit flag (of the current thread during multi-threaded calculations)
+  static Bool_t globalInhibitDirty() { return _threadedCalc ? threadInhibitDirty() : _inhibitDirty ; }
   Bool_t inhibitDirty() const ;
  
  public:
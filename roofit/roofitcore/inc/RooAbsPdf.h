@@ -295,6 +295,7 @@ protected:
   static Int_t _verboseEval ;
 
   virtual Bool_t syncNormalization(const RooArgSet* dset, Bool_t adjustProxies=kTRUE) const ;
+  virtual Bool_t getValBatchV(Double_t* output, Int_t firstEvent, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* set) const ;
 
   friend class RooAbsAnaConvPdf ;
   mutable Double_t _rawValue ;
@@ -48,6 +48,7 @@ class TH3F;
 
 #include <list>
 #include <string>
+#include <vector>
 #include <iostream>
 
 class RooAbsReal : public RooAbsArg {
@@ -64,7 +65,7 @@ public:
   inline Double_t getVal(const RooArgSet* set=0) const { 
 /*     if (_fast && !_inhibitDirty && std::string("RooHistFunc")==IsA()->GetName()) std::cout << "RooAbsReal::getVal(" << GetName() << ") CLEAN value = " << _value << std::endl ;  */
 #ifndef _WIN32
-    return (_fast && !_inhibitDirty) ? _value : getValV(set) ; 
+    return (_fast && !globalInhibitDirty()) ? _value : getValV(set) ; 
 #else
     return (_fast && !inhibitDirty()) ? _value : getValV(set) ;     
 #endif
@@ -73,6 +74,9 @@ public:
 
   virtual Double_t getValV(const RooArgSet* set=0) const ;
 
+  // Values for a range of events of a vector data store
+  void getValBatch(Double_t* output, Int_t firstEvent, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* set=0) const ;
+
   Double_t getPropagatedError(const RooFitResult& fr) ;
 
   Bool_t operator==(Double_t value) const ;
@@ -196,8 +200,8 @@ public:
   static RooNumIntConfig* defaultIntegratorConfig()  ;
   RooNumIntConfig* specialIntegratorConfig() const ;
   RooNumIntConfig* specialIntegratorConfig(Bool_t createOnTheFly) ;
-  void setIntegratorConfig() ;
-  void setIntegratorConfig(const RooNumIntConfig& config) ;
+  virtual void setIntegratorConfig() ;
+  virtual void setIntegratorConfig(const RooNumIntConfig& config) ;
 
   virtual void fixAddCoefNormalization(const RooArgSet& addNormSet=RooArgSet(),Bool_t force=kTRUE) ;
   virtual void fixAddCoefRange(const char* rangeName=0,Bool_t force=kTRUE) ;
@@ -372,6 +376,15 @@ protected:
   }
   virtual Double_t evaluate() const = 0 ;
 
+  // Batch evaluation on ranges of events of a vector data store
+  virtual Bool_t getValBatchV(Double_t* output, Int_t firstEvent, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* set) const ;
+  virtual Bool_t evaluateBatch(Double_t* /*output*/, Int_t /*firstEvent*/, Int_t /*nEvents*/, const RooVectorDataStore& /*data*/) const {
+    // Hook function for derived classes implementing the batch evaluation of evaluate()
+    return kFALSE ;
+  }
+  static const Double_t* batchValues(const RooAbsReal& arg, Int_t firstEvent, Int_t nEvents, const RooVectorDataStore& data,
+				     std::vector<Double_t>& buffer, const RooArgSet* set=0) ;
+
   // Hooks for RooDataSet interface
   friend class RooRealIntegral ;
   friend class RooVectorDataStore ;
@@ -22,6 +22,7 @@
 #include "RooRealProxy.h"
 #include "TStopwatch.h"
 #include <string>
+#include <vector>
 
 class RooArgSet ;
 class RooAbsData ;
@@ -64,6 +65,18 @@ public:
   virtual Double_t offset() const { return _offset ; }
   virtual Double_t offsetCarry() const { return _offsetCarry; }
 
+  void setThreadedMode(Bool_t flag) ;
+  Bool_t threadedMode() const { 
+    // Return true if partitions are calculated in threads rather than in separate processes
+    return _mpThreads ; 
+  }
+
+  void setComponentThreads(Int_t nThreads) ;
+  Int_t componentThreads() const { 
+    // Return number of threads calculating the components of a simultaneous p.d.f concurrently
+    return _simThreads ; 
+  }
+
 protected:
 
   virtual void printCompactTreeHook(std::ostream& os, const char* indent="") ;
@@ -113,6 +126,7 @@ protected:
   Bool_t _verbose ;                // Verbose messaging if true
 
   virtual Bool_t setDataSlave(RooAbsData& /*data*/, Bool_t /*cloneData*/=kTRUE, Bool_t /*ownNewDataAnyway*/=kFALSE) { return kTRUE ; }
+  virtual void cloneSharedHistograms() ;
 
   //private:  
 
@@ -122,6 +136,8 @@ protected:
   Bool_t initialize() ;
   void initSimMode(RooSimultaneous* pdf, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName) ;    
   void initMPMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName) ;
+  void initThreadMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName) ;
+  void calculateComponents() const ;
 
   mutable Bool_t _init ;          //! Is object initialized  
   GOFOpMode   _gofOpMode ;        // Operation mode of test statistic instance 
@@ -135,10 +151,18 @@ protected:
   Int_t          _nGof        ; // Number of sub-contexts 
   pRooAbsTestStatistic* _gofArray ; //! Array of sub-contexts representing part of the combined test statistic
   std::vector<RooFit::MPSplit> _gofSplitMode ; //! GOF MP Split mode specified by component (when Auto is active)
+  Int_t          _simThreads ; //! Number of threads calculating the sub-contexts concurrently
+  mutable std::vector<Double_t> _gofCost ; //! Measured calculation time of each sub-context
+  mutable std::vector<Int_t> _gofOrder ; //! Sub-contexts to calculate, in order of decreasing calculation time
   
   // Parallel mode data
   Int_t          _nCPU ;      //  Number of processors to use in parallel calculation mode
   pRooRealMPFE*  _mpfeArray ; //! Array of parallel execution frond ends
+  Bool_t         _mpThreads ; //! Calculate partitions in threads of this process rather than in separate processes
+  pRooAbsTestStatistic* _threadGofArray ; //! Array of test statistics calculating the partitions in threads
+  mutable std::vector<Double_t> _threadVal ; //! Values of partitions calculated in threads
+  mutable std::vector<Double_t> _threadCarry ; //! Carries of partitions calculated in threads
+  mutable Bool_t _threadsReady ; //! Partitions may be calculated concurrently (false until first sequential calculation)
 
   RooFit::MPSplit        _mpinterl ; // Use interleaving strategy rather than N-wise split for partioning of dataset for multiprocessor-split
   Bool_t         _doOffset ; // Apply interval value offset to control numeric precision?
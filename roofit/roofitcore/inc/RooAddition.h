@@ -56,6 +56,9 @@ public:
 
   virtual void enableOffsetting(Bool_t) ;
 
+  virtual CacheMode canNodeBeCached() const { return RooAbsArg::NotAdvised ; } ;
+  virtual void setCacheAndTrackHints(RooArgSet&) ;
+
 protected:
 
   RooArgList   _ownedList ;      // List of owned components
@@ -62,6 +62,12 @@ public:
     _value = other._value ; 
   } 
 
+  inline void assignFast(Int_t value) { 
+    // Fast assignment of index value
+    _label[0] = 0 ;
+    _value = value ; 
+  } 
+
   inline Bool_t operator==(const RooCatType& other) {
     // Equality operator with other RooCatType
     return (_value==other._value) ;
@@ -39,6 +39,10 @@ public:
   static RooAbsPdf* makePdfInstance(const char* className, const char* name, const char* expression, const RooArgList& vars, const char* intExpression=0) ;
   static RooAbsPdf* makePdfInstance(const char* name, const char* expression, const RooArgList& vars, const char* intExpression=0) ;
 
+  static RooAbsReal* makeCompiledFunction(const char* name, const RooAbsReal& func, const char* className=0) ;
+  static RooAbsPdf* makeCompiledPdf(const char* name, const RooAbsReal& shape, const char* className=0) ;
+  static Bool_t flattenExpression(const RooAbsReal& func, std::string& expression, RooArgList& inputs) ;
+
   static Bool_t makeAndCompilePdf(const char* name, const char* expression, const RooArgList& vars, const char* intExpression=0) ;
   static Bool_t makeAndCompileFunction(const char* name, const char* expression, const RooArgList& args, const char* intExpression=0) ;
 
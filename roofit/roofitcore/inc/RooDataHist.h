@@ -128,6 +128,12 @@ public:
 
   Int_t getIndex(const RooArgSet& coord, Bool_t fast=kFALSE) ;
 
+  // Direct access to the bin contents, indexed by the bin number (see getIndex()),
+  // for loops over all bins without loading the bin coordinates
+  const Double_t* weightArray() const { return _wgt ; }
+  const Double_t* sumW2Array() const { return _sumw2 ; }
+  const Double_t* binVolumeArray() const { return _binv ; }
+
   void removeSelfFromDir() { removeFromDir(this) ; }
   
 protected:
@@ -138,6 +144,7 @@ protected:
   friend class RooAbsOptTestStatistic ;
 
   Int_t calcTreeIndex() const ;
+  void assignCoordinates(const RooArgSet& coord, Bool_t oneSafe=kFALSE) const ;
   void cacheValidEntries() ;
 
   void setAllWeights(Double_t value) ;
@@ -184,6 +191,9 @@ protected:
   std::vector<RooAbsLValue*> _lvvars ; //! List of observables casted as RooAbsLValue
   std::vector<const RooAbsBinning*> _lvbins ; //! List of used binnings associated with lvalues
   mutable std::vector<std::vector<Double_t> > _binbounds; //! list of bin bounds per dimension
+  mutable std::vector<std::pair<const RooAbsArg*,const TNamed*> > _lookupCoord ; //! Elements of last coordinate set passed to assignCoordinates()
+  mutable std::vector<RooAbsArg*> _lookupSrc ; //! Element of that set matching each observable
+  mutable std::vector<const TNamed*> _lookupVars ; //! Names of the observables when that matching was made
 
   mutable Int_t _cache_sum_valid ; //! Is cache sum valid
   mutable Double_t _cache_sum ; //! Cache for sum of entries ;
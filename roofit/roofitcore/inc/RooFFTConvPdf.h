@@ -19,8 +19,10 @@
 #include "RooHistPdf.h"
 #include "TVirtualFFT.h"
 class RooRealVar ;
+class RooChangeTracker ;
 
 #include <map>
+#include <vector>
  
 class RooFFTConvPdf : public RooAbsCachedPdf {
 public:
@@ -34,7 +36,7 @@ public:
   virtual TObject* clone(const char* newname) const { return new RooFFTConvPdf(*this,newname); }
   virtual ~RooFFTConvPdf() ;
 
-  void setShift(Double_t val1, Double_t val2) { _shift1 = val1 ; _shift2 = val2 ; }
+  void setShift(Double_t val1, Double_t val2) ;
   void setCacheObservables(const RooArgSet& obs) { _cacheObs.removeAll() ; _cacheObs.add(obs) ; }
   const RooArgSet& cacheObservables() const { return _cacheObs ; }
   
@@ -92,6 +94,20 @@ protected:
     RooAbsBinning* histBinning ;
     RooAbsBinning* scanBinning ;
 
+    RooChangeTracker* pdf1Tracker ; // Tracks changes in parameters of p.d.f. 1
+    RooChangeTracker* pdf2Tracker ; // Tracks changes in parameters of p.d.f. 2
+
+    // Fourier transforms of the samplings of both p.d.f.s for each cache slice,
+    // reused while the parameters of that p.d.f. do not change
+    std::vector<std::vector<Double_t> > spec1 ;
+    std::vector<std::vector<Double_t> > spec2 ;
+    Bool_t reuse1 ;
+    Bool_t reuse2 ;
+    Int_t curSlice ;
+    Int_t nBins ;
+    Int_t nBins2 ;
+    Int_t binShift1 ;
+
   };
 
   friend class FFTCacheElem ;  
@@ -45,6 +45,10 @@ public:
     return _actualVars.at(index) ; 
   }
 
+  // Access to formula expression and the arguments it refers to
+  const char* expression() const { return _formExpr.Data() ; }
+  const RooArgList& dependents() const { return _actualVars ; }
+
   // I/O streaming interface (machine readable)
   virtual Bool_t readFromStream(std::istream& is, Bool_t compact, Bool_t verbose=kFALSE) ;
   virtual void writeToStream(std::ostream& os, Bool_t compact) const ;
@@ -53,6 +57,8 @@ public:
   virtual void printMultiline(std::ostream& os, Int_t contents, Bool_t verbose=kFALSE, TString indent= "") const ;
   void printMetaArgs(std::ostream& os) const ;
 
+  virtual void setCacheAndTrackHints(RooArgSet&) ;
+
   // Debugging
   void dumpFormula() { formula().dump() ; }
 
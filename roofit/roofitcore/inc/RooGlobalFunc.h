@@ -137,6 +137,7 @@ RooCmdArg OwnLinked() ;
 RooCmdArg Extended(Bool_t flag=kTRUE) ;
 RooCmdArg DataError(Int_t) ;
 RooCmdArg NumCPU(Int_t nCPU, Int_t interleave=0) ;
+RooCmdArg NumThreads(Int_t nThreads, Int_t interleave=0) ;
 
 // RooAbsPdf::printLatex arguments
 RooCmdArg Columns(Int_t ncol) ;
@@ -194,6 +195,7 @@ RooCmdArg CloneData(Bool_t flag) ;
 RooCmdArg Integrate(Bool_t flag) ;
 RooCmdArg Minimizer(const char* type, const char* alg=0) ;
 RooCmdArg Offset(Bool_t flag=kTRUE) ;
+RooCmdArg BatchMode(Bool_t flag=kTRUE) ;
 
 // RooAbsPdf::paramOn arguments
 RooCmdArg Label(const char* str) ;
@@ -43,6 +43,8 @@ public:
     // Return RooDataHist that is represented
     return *_dataHist ; 
   }
+
+  void cloneDataHist() ;
   
   void setInterpolationOrder(Int_t order) { 
     // Set histogram interpolation order 
@@ -91,6 +93,7 @@ protected:
   TIterator*         _histObsIter ; //! 
   TIterator*         _pdfObsIter ; //! 
   RooDataHist*      _dataHist ;  // Unowned pointer to underlying histogram
+  RooDataHist*      _ownedDataHist ; //! Private copy of the histogram made by cloneDataHist(), if any
   mutable RooAICRegistry _codeReg ; //! Auxiliary class keeping tracking of analytical integration code
   Int_t             _intOrder ; // Interpolation order
   Bool_t            _cdfBoundaries ; // Use boundary conditions for CDFs.
@@ -42,6 +42,8 @@ public:
     // Return RooDataHist that is represented
     return *_dataHist ; 
   }
+
+  void cloneDataHist() ;
   
   void setInterpolationOrder(Int_t order) { 
     // Set histogram interpolation order 
@@ -97,6 +99,7 @@ protected:
   RooArgSet         _histObsList ; // List of observables defining dimensions of histogram
   RooSetProxy       _pdfObsList ;  // List of observables mapped onto histogram observables
   RooDataHist*      _dataHist ;  // Unowned pointer to underlying histogram
+  RooDataHist*      _ownedDataHist ; //! Private copy of the histogram made by cloneDataHist(), if any
   TIterator*         _histObsIter ; //! 
   TIterator*         _pdfObsIter ; //! 
   mutable RooAICRegistry _codeReg ; //! Auxiliary class keeping tracking of analytical integration code
@@ -22,6 +22,8 @@
 #include "RooRealProxy.h"
 #include "RooSetProxy.h"
 #include "RooListProxy.h"
+#include <vector>
+#include <atomic>
 
 class RooArgSet ;
 class TH1F ;
@@ -70,6 +72,22 @@ public:
 
   static Int_t getCacheAllNumeric() ;
 
+  static void setNumIntMemoSize(Int_t n) ;
+  static Int_t getNumIntMemoSize() ;
+
+  static Long64_t numIntCount() { 
+    // Number of numeric integral calculations since the last call to resetNumIntCounters()
+    return _nNumInt ; 
+  }
+  static Long64_t numIntMemoHitCount() { 
+    // Number of numeric integrals taken from the memo since the last call to resetNumIntCounters()
+    return _nNumIntMemoHit ; 
+  }
+  static void resetNumIntCounters() ;
+
+  virtual void setIntegratorConfig() ;
+  virtual void setIntegratorConfig(const RooNumIntConfig& config) ;
+
   virtual std::list<Double_t>* plotSamplingHint(RooAbsRealLValue& obs, Double_t xlo, Double_t xhi) const {
     // Forward plot sampling hint of integrand
     return _function.arg().plotSamplingHint(obs,xlo,xhi) ;
@@ -102,6 +120,10 @@ protected:
   virtual Bool_t redirectServersHook(const RooAbsCollection& newServerList, 
 				     Bool_t mustReplaceAll, Bool_t nameChange, Bool_t isRecursive) ;
 
+  Bool_t findNumIntMemo(Double_t& value) const ;
+  void storeNumIntMemo(Double_t value) const ;
+  void clearNumIntMemo() const ;
+
   // Function pointer and integrands list
   mutable RooSetProxy _sumList ; // Set of discrete observable over which is summed numerically
   mutable RooSetProxy _intList ; // Set of continuous observables over which is integrated numerically
@@ -137,6 +159,13 @@ protected:
   Bool_t _cacheNum ;           // Cache integral if numeric
   static Int_t _cacheAllNDim ; //! Cache all integrals with given numeric dimension
 
+  mutable std::vector<Double_t> _memoCurKey ; //! Parameter values and integration limits of current evaluation
+  mutable std::vector<std::vector<Double_t> > _memoKey ; //! Parameter values and integration limits of memoized numeric integrals
+  mutable std::vector<Double_t> _memoVal ; //! Memoized numeric integrals
+  static Int_t _memoSize ; //! Number of numeric integrals memoized per integral object
+  static std::atomic<Long64_t> _nNumInt ; //! Number of numeric integral calculations (also counted in parallel threads)
+  static std::atomic<Long64_t> _nNumIntMemoHit ; //! Number of numeric integrals taken from memo
+
 
   virtual void operModeHook() ; // cache operation mode
 
@@ -41,6 +41,9 @@ public:
   // Interactive running
   void run(Int_t nExperiments) ;
 
+  // Parallel running in forked processes on the local host
+  void runParallel(Int_t nExperiments, Int_t nWorkers) ;
+
   // PROOF-based paralllel running
   void runProof(Int_t nExperiments, const char* proofHost="", Bool_t showGui=kTRUE) ;
   static void closeProof(Option_t *option = "s") ;
@@ -110,6 +110,10 @@ public:
 
   const RooVectorDataStore* cache() const { return _cache ; }
 
+  // Direct access to the stored columns for batch evaluation of functions
+  const Double_t* realColumn(const RooAbsReal& real) const ;
+  const Double_t* weightColumn() const ;
+
   void loadValues(const RooAbsDataStore *tds, const RooFormulaVar* select=0, const char* rangeName=0, Int_t nStart=0, Int_t nStop=2000000000) ;
   
   void dump() ;
@@ -460,13 +464,13 @@ public:
 
   class CatVector {
   public:
-    CatVector(UInt_t initialCapacity=(VECTOR_BUFFER_SIZE / sizeof(RooCatType))) : 
+    CatVector(UInt_t initialCapacity=(VECTOR_BUFFER_SIZE / sizeof(Int_t))) : 
       _cat(0), _buf(0), _nativeBuf(0), _vec0(0)
     {
       _vec.reserve(initialCapacity);
     }
 
-    CatVector(RooAbsCategory* cat, UInt_t initialCapacity=(VECTOR_BUFFER_SIZE / sizeof(RooCatType))) : 
+    CatVector(RooAbsCategory* cat, UInt_t initialCapacity=(VECTOR_BUFFER_SIZE / sizeof(Int_t))) : 
       _cat(cat), _buf(0), _nativeBuf(0), _vec0(0)
     {
       _vec.reserve(initialCapacity);
@@ -486,9 +490,9 @@ public:
       _cat = other._cat;
       _buf = other._buf;
       _nativeBuf = other._nativeBuf;
-      if (other._vec.size() <= _vec.capacity() / 2 && _vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(RooCatType))) {
-	std::vector<RooCatType> tmp;
-	tmp.reserve(std::max(other._vec.size(), VECTOR_BUFFER_SIZE / sizeof(RooCatType)));
+      if (other._vec.size() <= _vec.capacity() / 2 && _vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(Int_t))) {
+	std::vector<Int_t> tmp;
+	tmp.reserve(std::max(other._vec.size(), VECTOR_BUFFER_SIZE / sizeof(Int_t)));
 	tmp.assign(other._vec.begin(), other._vec.end());
 	_vec.swap(tmp);
       } else {
@@ -508,15 +512,15 @@ public:
     }
     
     void fill() { 
-      _vec.push_back(*_buf) ; 
+      _vec.push_back(_buf->getVal()) ; 
       _vec0 = &_vec.front() ;
     } ;
     void write(Int_t i) { 
-      _vec[i]=*_buf ; 
+      _vec[i]=_buf->getVal() ; 
     } ;
     void reset() { 
       // make sure the vector releases the underlying memory
-      std::vector<RooCatType> tmp;
+      std::vector<Int_t> tmp;
       _vec.swap(tmp);
       _vec0 = 0;
     }
@@ -529,10 +533,10 @@ public:
     Int_t size() const { return _vec.size() ; }
 
     void resize(Int_t siz) {
-      if (siz < Int_t(_vec.capacity()) / 2 && _vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(RooCatType))) {
+      if (siz < Int_t(_vec.capacity()) / 2 && _vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(Int_t))) {
 	// do an expensive copy, if we save at least a factor 2 in size
-	std::vector<RooCatType> tmp;
-	tmp.reserve(std::max(siz, Int_t(VECTOR_BUFFER_SIZE / sizeof(RooCatType))));
+	std::vector<Int_t> tmp;
+	tmp.reserve(std::max(siz, Int_t(VECTOR_BUFFER_SIZE / sizeof(Int_t))));
 	if (!_vec.empty())
 	    tmp.assign(_vec.begin(), std::min(_vec.end(), _vec.begin() + siz));
 	if (Int_t(tmp.size()) != siz) 
@@ -557,9 +561,9 @@ public:
     RooAbsCategory* _cat ;
     RooCatType* _buf ;  //!
     RooCatType* _nativeBuf ;  //!
-    std::vector<RooCatType> _vec ;
-    RooCatType* _vec0 ; //!
-    ClassDef(CatVector,1) // STL-vector-based Data Storage class
+    std::vector<Int_t> _vec ; // Index values of the stored states (their labels are given by the category)
+    Int_t* _vec0 ; //!
+    ClassDef(CatVector,2) // STL-vector-based Data Storage class
   } ;
   
 
@@ -67,6 +67,8 @@
 #include <algorithm>
 #include <sstream>
 
+#include "ThreadLocalStorage.h"
+
 using namespace std ;
 
 #if (__GNUC__==3&&__GNUC_MINOR__==2&&__GNUC_PATCHLEVEL__==3)
@@ -78,7 +80,20 @@ ClassImp(RooAbsArg)
 
 Bool_t RooAbsArg::_verboseDirty(kFALSE) ;
 Bool_t RooAbsArg::_inhibitDirty(kFALSE) ;
-Bool_t RooAbsArg::inhibitDirty() const { return _inhibitDirty && !_localNoInhibitDirty; }
+Bool_t RooAbsArg::_threadedCalc(kFALSE) ;
+Bool_t RooAbsArg::inhibitDirty() const { return globalInhibitDirty() && !_localNoInhibitDirty; }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Flag controlling global inhibit of dirty state propagation during multi-threaded
+/// calculations. It is kept separately for each thread, so that the numeric integrations
+/// calculated in concurrent threads do not switch the dirty state propagation on or off
+/// in the other threads
+
+Bool_t& RooAbsArg::threadInhibitDirty()
+{
+  TTHREAD_TLS(Bool_t) flag(kFALSE) ;
+  return flag ;
+}
 
 std::map<RooAbsArg*,TRefArray*> RooAbsArg::_ioEvoList ;
 std::stack<RooAbsArg*> RooAbsArg::_ioReadStack ;
@@ -236,7 +251,31 @@ RooAbsArg::~RooAbsArg()
 
 void RooAbsArg::setDirtyInhibit(Bool_t flag)
 {
-  _inhibitDirty = flag ;
+  if (_threadedCalc) {
+    threadInhibitDirty() = flag ;
+  } else {
+    _inhibitDirty = flag ;
+  }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Declare the start (flag=kTRUE) or the end of a calculation in several threads.
+/// During the calculation the global dirty inhibit flag is kept separately
+/// for each thread, at the cost of a slightly slower access. Must be called
+/// from the main thread, outside of the parallel region. Returns the previous
+/// state: nested multi-threaded calculations must not change it.
+
+Bool_t RooAbsArg::setThreadedCalculation(Bool_t flag)
+{
+  Bool_t old = _threadedCalc ;
+  if (flag && !_threadedCalc) {
+    threadInhibitDirty() = _inhibitDirty ;
+  } else if (!flag && _threadedCalc) {
+    _inhibitDirty = threadInhibitDirty() ;
+  }
+  _threadedCalc = flag ;
+  return old ;
 }
 
 
@@ -839,7 +878,7 @@ Bool_t RooAbsArg::observableOverlaps(const RooArgSet* nset, const RooAbsArg& tes
 
 void RooAbsArg::setValueDirty(const RooAbsArg* source) const
 {
-  if (_operMode!=Auto || _inhibitDirty) return ;
+  if (_operMode!=Auto || globalInhibitDirty()) return ;
 
   // Handle no-propagation scenarios first
   if (_clientListValue.GetSize()==0) {
@@ -58,6 +58,8 @@
 #include "RooAddPdf.h"
 #include "RooProduct.h"
 #include "RooRealSumPdf.h"
+#include "RooHistPdf.h"
+#include "RooHistFunc.h"
 #include "RooTrace.h"
 #include "RooVectorDataStore.h" 
 
@@ -496,6 +498,29 @@ void RooAbsOptTestStatistic::printCompactTreeHook(ostream& os, const char* inden
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Give the histogram based p.d.f.s and functions of the function clone
+/// private copies of their histograms, so that this test statistic can be
+/// calculated concurrently with others made from the same function
+
+void RooAbsOptTestStatistic::cloneSharedHistograms()
+{
+  RooAbsTestStatistic::cloneSharedHistograms() ;
+  if (operMode()!=Slave) return ;
+  RooArgSet branches ;
+  _funcClone->branchNodeServerList(&branches) ;
+  RooFIter iter = branches.fwdIterator() ;
+  RooAbsArg* arg ;
+  while((arg=iter.next())) {
+    RooHistPdf* hpdf = dynamic_cast<RooHistPdf*>(arg) ;
+    if (hpdf) hpdf->cloneDataHist() ;
+    RooHistFunc* hfunc = dynamic_cast<RooHistFunc*>(arg) ;
+    if (hfunc) hfunc->cloneDataHist() ;
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Driver function to propagate constant term optimizations in test statistic.
 /// If code Activate is sent, constant term optimization will be executed.
@@ -621,7 +646,8 @@ void RooAbsOptTestStatistic::optimizeConstantTerms(Bool_t activate, Bool_t apply
     // Apply tracking optimization here. Default strategy is to track components
     // of RooAddPdfs and RooRealSumPdfs. If these components are a RooProdPdf
     // or a RooProduct respectively, track the components of these products instead
-    // of the product term
+    // of the product term. Likewise the terms of RooAdditions and the derived
+    // arguments of formula expressions are tracked
     RooArgSet trackNodes ;
 
 
@@ -152,6 +152,7 @@
 #include "RooChi2Var.h"
 #include "RooMinimizer.h"
 #include "RooRealIntegral.h"
+#include "RooVectorDataStore.h"
 #include "Math/CholeskyDecomp.h"
 #include <string>
 
@@ -307,6 +308,61 @@ Double_t RooAbsPdf::getValV(const RooArgSet* nset) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Batch equivalent of getValV(): calculate the normalized values of this p.d.f
+/// for a range of events of the given vector data store with evaluateBatch().
+/// Return kFALSE if the values cannot be calculated in batch mode, e.g.
+/// if the normalization integral depends on the observables of the data.
+/// Events for which the unnormalized value is negative or not a number are
+/// evaluated again with getVal() so that the evaluation errors are logged
+/// as in the scalar evaluation
+
+Bool_t RooAbsPdf::getValBatchV(Double_t* output, Int_t firstEvent, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* nset) const
+{
+  Double_t normVal(1) ;
+
+  if (!nset) {
+    RooArgSet* tmp = _normSet ;
+    _normSet = 0 ;
+    Bool_t ok = evaluateBatch(output,firstEvent,nEvents,data) ;
+    _normSet = tmp ;
+    if (!ok) {
+      return kFALSE ;
+    }
+  } else {
+    if (nset!=_normSet || _norm==0) {
+      syncNormalization(nset) ;
+    }
+
+    // The normalization must be the same for all events
+    if (_norm->dependsOn(*data.get(),0,kTRUE)) {
+      return kFALSE ;
+    }
+    normVal = _norm->getVal() ;
+    if (normVal<=0.) {
+      return kFALSE ;
+    }
+
+    if (!evaluateBatch(output,firstEvent,nEvents,data)) {
+      return kFALSE ;
+    }
+  }
+
+  for (Int_t i=0 ; i<nEvents ; i++) {
+    Double_t rawVal = output[i] ;
+    if (rawVal<0 || TMath::IsNaN(rawVal)) {
+      data.get(firstEvent+i) ;
+      output[i] = getVal(nset) ;
+    } else {
+      output[i] = nset ? rawVal/normVal : rawVal ;
+    }
+  }
+
+  return kTRUE ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Analytical integral with normalization (see RooAbsReal::analyticalIntegralWN() for further information)
 ///
@@ -730,6 +786,13 @@ Double_t RooAbsPdf::extendedTerm(Double_t observed, const RooArgSet* nset) const
 ///                                    Strategy 3 = RooFit::Hybrid --> Follow strategy 0 for all RooSimultaneous components, except those with less than
 ///                                                 30 dataset entries, for which strategy 2 is followed.
 ///
+/// NumThreads(int num, int strat)  -- Parallelize NLL calculation in num threads of the current process rather than in num processes.
+///                                    The partitioning strategies are the same as for NumCPU. The threads share the parameters and
+///                                    each holds its own copy of the p.d.f and data (see RooAbsTestStatistic::setThreadedMode()).
+///                                    With strategy 2 (RooFit::SimComponents) the component likelihoods of a RooSimultaneous are
+///                                    instead distributed dynamically over the threads, the most expensive ones first
+///                                    (see RooAbsTestStatistic::setComponentThreads())
+///
 /// Optimize(Bool_t flag)           -- Activate constant term optimization (on by default)
 /// SplitRange(Bool_t flag)         -- Use separate fit ranges in a simultaneous fit. Actual range name for each
 ///                                    subsample is assumed to by rangeName_{indexState} where indexState
@@ -744,6 +807,9 @@ Double_t RooAbsPdf::extendedTerm(Double_t observed, const RooArgSet* nset) const
 /// CloneData(Bool flag)           -- Use clone of dataset in NLL (default is true)
 /// Offset(Bool_t)                  -- Offset likelihood by initial value (so that starting value of FCN in minuit is zero). This
 ///                                    can improve numeric stability in simultaneously fits with components with large likelihood values
+/// BatchMode(Bool_t flag)          -- Evaluate the p.d.f for blocks of events at once, reading the observables from the columns of the
+///                                    dataset, instead of one event at a time. The likelihood value is the same, p.d.f.s without a
+///                                    batch implementation are evaluated event by event (see RooNLLVar::setBatchMode())
 /// 
 /// 
 
@@ -785,6 +851,8 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
   pc.defineInt("ext","Extended",0,2) ;
   pc.defineInt("numcpu","NumCPU",0,1) ;
   pc.defineInt("interleave","NumCPU",1,0) ;
+  pc.defineInt("numthreads","NumThreads",0,0) ;
+  pc.defineInt("interleaveThr","NumThreads",1,0) ;
   pc.defineInt("verbose","Verbose",0,0) ;
   pc.defineInt("optConst","Optimize",0,0) ;
   pc.defineInt("cloneData","CloneData",2,0) ;
@@ -793,10 +861,12 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
   pc.defineSet("glObs","GlobalObservables",0,0) ;
   pc.defineInt("constrAll","Constrained",0,0) ;
   pc.defineInt("doOffset","OffsetLikelihood",0,0) ;
+  pc.defineInt("batchMode","BatchMode",0,0) ;
   pc.defineSet("extCons","ExternalConstraints",0,0) ;
   pc.defineMutex("Range","RangeWithName") ;
   pc.defineMutex("Constrain","Constrained") ;
   pc.defineMutex("GlobalObservables","GlobalObservablesTag") ;
+  pc.defineMutex("NumCPU","NumThreads") ;
     
   // Process and check varargs 
   pc.process(cmdList) ;
@@ -811,12 +881,26 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
   Int_t ext      = pc.getInt("ext") ;
   Int_t numcpu   = pc.getInt("numcpu") ;
   RooFit::MPSplit interl = (RooFit::MPSplit) pc.getInt("interleave") ;
+  Bool_t threads = kFALSE ;
+  Int_t compThreads = 1 ;
+  if (pc.hasProcessed("NumThreads")) {
+    numcpu  = pc.getInt("numthreads") ;
+    interl  = (RooFit::MPSplit) pc.getInt("interleaveThr") ;
+    threads = kTRUE ;
+    if (interl==RooFit::SimComponents && InheritsFrom("RooSimultaneous")) {
+      // Calculate the components concurrently in a single likelihood
+      compThreads = numcpu ;
+      numcpu = 1 ;
+      interl = RooFit::BulkPartition ;
+    }
+  }
 
   Int_t splitr   = pc.getInt("splitRange") ;
   Bool_t verbose = pc.getInt("verbose") ;
   Int_t optConst = pc.getInt("optConst") ;
   Int_t cloneData = pc.getInt("cloneData") ;
   Int_t doOffset = pc.getInt("doOffset") ;
+  Int_t batchMode = pc.getInt("batchMode") ;
   
   // If no explicit cloneData command is specified, cloneData is set to true if optimization is activated
   if (cloneData==2) {
@@ -895,7 +979,11 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
     // Simple case: default range, or single restricted range
     //cout<<"FK: Data test 1: "<<data.sumEntries()<<endl;
 
-    nll = new RooNLLVar(baseName.c_str(),"-log(likelihood)",*this,data,projDeps,ext,rangeName,addCoefRangeName,numcpu,interl,verbose,splitr,cloneData) ;
+    RooNLLVar* nllVar = new RooNLLVar(baseName.c_str(),"-log(likelihood)",*this,data,projDeps,ext,rangeName,addCoefRangeName,numcpu,interl,verbose,splitr,cloneData) ;
+    nllVar->setBatchMode(batchMode) ;
+    nllVar->setThreadedMode(threads) ;
+    nllVar->setComponentThreads(compThreads) ;
+    nll = nllVar ;
 
   } else {
     // Composite case: multiple ranges
@@ -905,7 +993,10 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
     strlcpy(buf,rangeName,bufSize) ;
     char* token = strtok(buf,",") ;
     while(token) {
-      RooAbsReal* nllComp = new RooNLLVar(Form("%s_%s",baseName.c_str(),token),"-log(likelihood)",*this,data,projDeps,ext,token,addCoefRangeName,numcpu,interl,verbose,splitr,cloneData) ;
+      RooNLLVar* nllComp = new RooNLLVar(Form("%s_%s",baseName.c_str(),token),"-log(likelihood)",*this,data,projDeps,ext,token,addCoefRangeName,numcpu,interl,verbose,splitr,cloneData) ;
+      nllComp->setBatchMode(batchMode) ;
+      nllComp->setThreadedMode(threads) ;
+      nllComp->setComponentThreads(compThreads) ;
       nllList.add(*nllComp) ;
       token = strtok(0,",") ;
     }
@@ -993,6 +1084,8 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
 ///                                    Strategy 3 = RooFit::Hybrid --> Follow strategy 0 for all RooSimultaneous components, except those with less than
 ///                                                 30 dataset entries, for which strategy 2 is followed.
 ///
+/// NumThreads(int num, int strat)  -- Parallelize NLL calculation in num threads (see createNLL())
+///
 /// SplitRange(Bool_t flag)         -- Use separate fit ranges in a simultaneous fit. Actual range name for each
 ///                                    subsample is assumed to by rangeName_{indexState} where indexState
 ///                                    is the state of the master index category of the simultaneous fit
@@ -1003,6 +1096,7 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
 /// ExternalConstraints(const RooArgSet& ) -- Include given external constraints to likelihood
 /// Offset(Bool_t)                  -- Offset likelihood by initial value (so that starting value of FCN in minuit is zero). This
 ///                                    can improve numeric stability in simultaneously fits with components with large likelihood values
+/// BatchMode(Bool_t flag)          -- Evaluate the p.d.f for blocks of events at once in the likelihood (see createNLL())
 ///
 /// Options to control flow of fit procedure
 /// ----------------------------------------
@@ -1022,6 +1116,8 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
 /// 
 /// InitialHesse(Bool_t flag)      -- Flag controls if HESSE before MIGRAD as well, off by default
 /// Optimize(Bool_t flag)          -- Activate constant term optimization of test statistic during minimization (on by default)
+///                                   With level 2 (the default) the per-event values of components that depend on parameters
+///                                   are also cached, and recalculated only when one of their parameters has changed
 /// Hesse(Bool_t flag)             -- Flag controls if HESSE is run after MIGRAD, on by default
 /// Minos(Bool_t flag)             -- Flag controls if MINOS is run after HESSE, off by default
 /// Minos(const RooArgSet& set)    -- Only run MINOS on given subset of arguments
@@ -1079,7 +1175,7 @@ RooFitResult* RooAbsPdf::fitTo(RooAbsData& data, const RooLinkedList& cmdList)
   RooCmdConfig pc(Form("RooAbsPdf::fitTo(%s)",GetName())) ;
 
   RooLinkedList fitCmdList(cmdList) ;
-  RooLinkedList nllCmdList = pc.filterCmdList(fitCmdList,"ProjectedObservables,Extended,Range,RangeWithName,SumCoefRange,NumCPU,SplitRange,Constrained,Constrain,ExternalConstraints,CloneData,GlobalObservables,GlobalObservablesTag,OffsetLikelihood") ;
+  RooLinkedList nllCmdList = pc.filterCmdList(fitCmdList,"ProjectedObservables,Extended,Range,RangeWithName,SumCoefRange,NumCPU,NumThreads,SplitRange,Constrained,Constrain,ExternalConstraints,CloneData,GlobalObservables,GlobalObservablesTag,OffsetLikelihood,BatchMode") ;
 
   pc.defineString("fitOpt","FitOptions",0,"") ;
   pc.defineInt("optConst","Optimize",0,2) ;
@@ -1093,11 +1189,13 @@ RooFitResult* RooAbsPdf::fitTo(RooAbsData& data, const RooLinkedList& cmdList)
   pc.defineInt("minos","Minos",0,0) ;
   pc.defineInt("ext","Extended",0,2) ;
   pc.defineInt("numcpu","NumCPU",0,1) ;
+  pc.defineInt("numthreads","NumThreads",0,0) ;
   pc.defineInt("numee","PrintEvalErrors",0,10) ;
   pc.defineInt("doEEWall","EvalErrorWall",0,1) ;
   pc.defineInt("doWarn","Warnings",0,1) ;
   pc.defineInt("doSumW2","SumW2Error",0,-1) ;
   pc.defineInt("doOffset","OffsetLikelihood",0,0) ;
+  pc.defineInt("batchMode","BatchMode",0,0) ;
   pc.defineString("mintype","Minimizer",0,"OldMinuit") ;
   pc.defineString("minalg","Minimizer",1,"minuit") ;
   pc.defineObject("minosSet","Minos",0,0) ;
@@ -1169,6 +1267,10 @@ RooFitResult* RooAbsPdf::fitTo(RooAbsData& data, const RooLinkedList& cmdList)
   RooAbsReal* nll = createNLL(data,nllCmdList) ;  
   RooFitResult *ret = 0 ;    
 
+  // Count numeric integrals calculated during the fit
+  Long64_t nNumInt0 = RooRealIntegral::numIntCount() ;
+  Long64_t nNumIntMemo0 = RooRealIntegral::numIntMemoHitCount() ;
+
   // Instantiate MINUIT
 
   if (string(minType)!="OldMinuit") {
@@ -1432,7 +1534,12 @@ RooFitResult* RooAbsPdf::fitTo(RooAbsData& data, const RooLinkedList& cmdList)
     
   }
 
-
+  Long64_t nNumInt = RooRealIntegral::numIntCount() - nNumInt0 ;
+  Long64_t nNumIntMemo = RooRealIntegral::numIntMemoHitCount() - nNumIntMemo0 ;
+  if (nNumInt>0 || nNumIntMemo>0) {
+    coutI(Fitting) << "RooAbsPdf::fitTo(" << GetName() << ") " << nNumInt << " numeric integrals calculated, " 
+		   << nNumIntMemo << " reused from memo" << endl ;
+  }
   
   // Cleanup
   delete nll ;
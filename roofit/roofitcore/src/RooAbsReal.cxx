@@ -100,6 +100,7 @@
 #include "TF3.h"
 #include "TMatrixD.h"
 #include "TVector.h"
+#include "ThreadLocalStorage.h"
 
 #include <sstream>
 
@@ -263,6 +264,90 @@ Double_t RooAbsReal::getValV(const RooArgSet* nset) const
 }
 
 
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill output[i] with the value of this object for the event firstEvent+i
+/// of the given vector data store, for i=0..nEvents-1, with the normalization
+/// set 'nset' as in getVal(nset). The observables of this object must be
+/// attached to the store, as in the likelihood of a fit.
+///
+/// Values that are stored in the data (the observables themselves and the
+/// cached constant terms of the constant-term optimization) are copied from
+/// the columns of the store, values that do not depend on the observables
+/// are calculated once, and objects that implement evaluateBatch() calculate
+/// all values in one call, asking their servers for ranges of values in turn.
+/// All other objects are evaluated event by event, loading each event in the
+/// observables first, so that the values are always the same as with getVal()
+
+void RooAbsReal::getValBatch(Double_t* output, Int_t firstEvent, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* nset) const
+{
+  const Double_t* column = data.realColumn(*this) ;
+  if (column) {
+    for (Int_t i=0 ; i<nEvents ; i++) {
+      output[i] = column[firstEvent+i] ;
+    }
+    return ;
+  }
+
+  if (!dependsOn(*data.get(),0,kTRUE)) {
+    Double_t val = getVal(nset) ;
+    for (Int_t i=0 ; i<nEvents ; i++) {
+      output[i] = val ;
+    }
+    return ;
+  }
+
+  if (getValBatchV(output,firstEvent,nEvents,data,nset)) {
+    return ;
+  }
+
+  // Scalar fallback
+  for (Int_t i=0 ; i<nEvents ; i++) {
+    data.get(firstEvent+i) ;
+    output[i] = getVal(nset) ;
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Batch equivalent of getValV(): calculate the values of this object for a
+/// range of events with evaluateBatch(). Return kFALSE if the values cannot
+/// be calculated in batch mode, in which case getValBatch() evaluates them
+/// event by event
+
+Bool_t RooAbsReal::getValBatchV(Double_t* output, Int_t firstEvent, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* nset) const
+{
+  if (nset && nset!=_lastNSet) {
+    ((RooAbsReal*) this)->setProxyNormSet(nset) ;    
+    _lastNSet = (RooArgSet*) nset ;
+  }
+
+  return evaluateBatch(output,firstEvent,nEvents,data) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Helper function for the implementations of evaluateBatch(): return a pointer
+/// to the values of 'arg' for the events firstEvent..firstEvent+nEvents-1.
+/// Values stored in the data are returned without copy, the others are
+/// calculated with getValBatch() into 'buffer'
+
+const Double_t* RooAbsReal::batchValues(const RooAbsReal& arg, Int_t firstEvent, Int_t nEvents, const RooVectorDataStore& data,
+					std::vector<Double_t>& buffer, const RooArgSet* nset)
+{
+  const Double_t* column = data.realColumn(arg) ;
+  if (column) {
+    return column+firstEvent ;
+  }
+
+  buffer.resize(nEvents) ;
+  arg.getValBatch(&buffer[0],firstEvent,nEvents,data,nset) ;
+  return &buffer[0] ;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooAbsReal::numEvalErrorItems() 
@@ -3579,11 +3664,15 @@ void RooAbsReal::logEvalError(const RooAbsReal* originator, const char* origName
   }
 
   if (_evalErrorMode==CountErrors) {
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
     _evalErrorCount++ ;
     return ;
   }
 
-  static Bool_t inLogEvalError = kFALSE ;  
+  // Errors may be logged concurrently by test statistics calculated in threads
+  TTHREAD_TLS(Bool_t) inLogEvalError = kFALSE ;  
 
   if (inLogEvalError) {
     return ;
@@ -3597,6 +3686,10 @@ void RooAbsReal::logEvalError(const RooAbsReal* originator, const char* origName
     ee.setServerValues(serverValueString) ;
   } 
 
+#ifdef _OPENMP
+#pragma omp critical (RooAbsReal_logEvalError)
+#endif
+  {
   if (_evalErrorMode==PrintErrors) {
    oocoutE((TObject*)0,Eval) << "RooAbsReal::logEvalError(" << "<STATIC>" << ") evaluation error, " << endl 
 		   << " origin       : " << origName << endl 
@@ -3606,6 +3699,7 @@ void RooAbsReal::logEvalError(const RooAbsReal* originator, const char* origName
     _evalErrorList[originator].first = origName ;
     _evalErrorList[originator].second.push_back(ee) ;
   }
+  }
 
 
   inLogEvalError = kFALSE ;
@@ -3634,11 +3728,15 @@ void RooAbsReal::logEvalError(const char* message, const char* serverValueString
   }
 
   if (_evalErrorMode==CountErrors) {
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
     _evalErrorCount++ ;
     return ;
   }
 
-  static Bool_t inLogEvalError = kFALSE ;  
+  // Errors may be logged concurrently by test statistics calculated in threads
+  TTHREAD_TLS(Bool_t) inLogEvalError = kFALSE ;  
 
   if (inLogEvalError) {
     return ;
@@ -3671,6 +3769,10 @@ void RooAbsReal::logEvalError(const char* message, const char* serverValueString
   ostringstream oss2 ;
   printStream(oss2,kName|kClassName|kArgs,kInline)  ;
 
+#ifdef _OPENMP
+#pragma omp critical (RooAbsReal_logEvalError)
+#endif
+  {
   if (_evalErrorMode==PrintErrors) {
    coutE(Eval) << "RooAbsReal::logEvalError(" << GetName() << ") evaluation error, " << endl 
 	       << " origin       : " << oss2.str() << endl 
@@ -3680,6 +3782,7 @@ void RooAbsReal::logEvalError(const char* message, const char* serverValueString
     _evalErrorList[this].first = oss2.str().c_str() ;
     _evalErrorList[this].second.push_back(ee) ;
   }
+  }
 
   inLogEvalError = kFALSE ;
   //coutE(Tracing) << "RooAbsReal::logEvalError(" << GetName() << ") message = " << message << endl ;
@@ -29,7 +29,8 @@
 // organizes multi-processor parallel calculation of test statistic
 // values. For the latter, the test statistic value is calculated in
 // partitions in parallel executing processes and a posteriori
-// combined in the main thread.
+// combined in the main thread. Alternatively, the partitions can be
+// calculated in threads of the same process (see setThreadedMode()).
 // END_HTML
 //
 
@@ -52,6 +53,11 @@
 #include "RooRealSumPdf.h"
 
 #include <string>
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace std;
 
@@ -65,7 +71,8 @@ ClassImp(RooAbsTestStatistic)
 RooAbsTestStatistic::RooAbsTestStatistic() :
   _func(0), _data(0), _projDeps(0), _splitRange(0), _simCount(0),
   _verbose(kFALSE), _init(kFALSE), _gofOpMode(Slave), _nEvents(0), _setNum(0),
-  _numSets(0), _extSet(0), _nGof(0), _gofArray(0), _nCPU(1), _mpfeArray(0),
+  _numSets(0), _extSet(0), _nGof(0), _gofArray(0), _simThreads(1), _nCPU(1), _mpfeArray(0),
+  _mpThreads(kFALSE), _threadGofArray(0), _threadsReady(kFALSE),
   _mpinterl(RooFit::BulkPartition), _doOffset(kFALSE), _offset(0),
   _offsetCarry(0), _evalCarry(0)
 {
@@ -102,8 +109,12 @@ RooAbsTestStatistic::RooAbsTestStatistic(const char *name, const char *title, Ro
   _verbose(verbose),
   _nGof(0),
   _gofArray(0),
+  _simThreads(1),
   _nCPU(nCPU),
   _mpfeArray(0),
+  _mpThreads(kFALSE),
+  _threadGofArray(0),
+  _threadsReady(kFALSE),
   _mpinterl(interleave),
   _doOffset(kFALSE),
   _offset(0),
@@ -161,8 +172,12 @@ RooAbsTestStatistic::RooAbsTestStatistic(const RooAbsTestStatistic& other, const
   _nGof(0),
   _gofArray(0),
   _gofSplitMode(other._gofSplitMode),
+  _simThreads(other._simThreads),
   _nCPU(other._nCPU),
   _mpfeArray(0),
+  _mpThreads(other._mpThreads),
+  _threadGofArray(0),
+  _threadsReady(kFALSE),
   _mpinterl(other._mpinterl),
   _doOffset(other._doOffset),
   _offset(other._offset),
@@ -209,8 +224,13 @@ RooAbsTestStatistic::RooAbsTestStatistic(const RooAbsTestStatistic& other, const
 RooAbsTestStatistic::~RooAbsTestStatistic()
 {
   if (MPMaster == _gofOpMode && _init) {
-    for (Int_t i = 0; i < _nCPU; ++i) delete _mpfeArray[i];
-    delete[] _mpfeArray ;
+    if (_mpThreads) {
+      for (Int_t i = 0; i < _nCPU; ++i) delete _threadGofArray[i];
+      delete[] _threadGofArray ;
+    } else {
+      for (Int_t i = 0; i < _nCPU; ++i) delete _mpfeArray[i];
+      delete[] _mpfeArray ;
+    }
   }
 
   if (SimMaster == _gofOpMode && _init) {
@@ -229,7 +249,7 @@ RooAbsTestStatistic::~RooAbsTestStatistic()
 /// is calculated from on a RooSimultaneous, the test statistic calculation
 /// is performed separately on each simultaneous p.d.f component and associated
 /// data and then combined. If the test statistic calculation is parallelized
-/// partitions are calculated in nCPU processes and a posteriori combined.
+/// partitions are calculated in nCPU processes (or threads) and a posteriori combined.
 
 Double_t RooAbsTestStatistic::evaluate() const
 {
@@ -239,6 +259,10 @@ Double_t RooAbsTestStatistic::evaluate() const
   }
 
   if (SimMaster == _gofOpMode) {
+    // Calculate components in parallel threads if requested, the combination below then
+    // uses their values in the same order as in the sequential calculation
+    if (_simThreads>1) calculateComponents() ;
+
     // Evaluate array of owned GOF objects
     Double_t ret = 0.;
 
@@ -269,6 +293,37 @@ Double_t RooAbsTestStatistic::evaluate() const
 
     return ret ;
 
+  } else if (MPMaster == _gofOpMode && _mpThreads) {
+
+    // Calculate partitions in parallel threads. The first calculation after (re)configuration
+    // of the partitions is done sequentially, so that all objects and caches that are created
+    // on demand in the evaluation are created in the main thread
+    const Bool_t wasThreaded = RooAbsArg::setThreadedCalculation(_threadsReady || RooAbsArg::threadedCalculation()) ;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static,1) num_threads(_nCPU) if(_threadsReady)
+#endif
+    for (Int_t i = 0; i < _nCPU; ++i) {
+      _threadVal[i] = _threadGofArray[i]->getValV();
+      _threadCarry[i] = _threadGofArray[i]->getCarry();
+    }
+    RooAbsArg::setThreadedCalculation(wasThreaded) ;
+    _threadsReady = kTRUE ;
+
+    // Combine partitions in fixed order so that the result does not depend on the thread scheduling
+    Double_t sum(0), carry = 0.;
+    for (Int_t i = 0; i < _nCPU; ++i) {
+      Double_t y = _threadVal[i];
+      carry += _threadCarry[i];
+      y -= carry;
+      const Double_t t = sum + y;
+      carry = (t - sum) - y;
+      sum = t;
+    }
+
+    Double_t ret = sum ;
+    _evalCarry = carry;
+    return ret ;
+
   } else if (MPMaster == _gofOpMode) {
     
     // Start calculations in parallel
@@ -342,7 +397,9 @@ Bool_t RooAbsTestStatistic::initialize()
 {
   if (_init) return kFALSE;
   
-  if (MPMaster == _gofOpMode) {
+  if (MPMaster == _gofOpMode && _mpThreads) {
+    initThreadMode(_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
+  } else if (MPMaster == _gofOpMode) {
     initMPMode(_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
   } else if (SimMaster == _gofOpMode) {
     initSimMode((RooSimultaneous*)_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
@@ -365,6 +422,15 @@ Bool_t RooAbsTestStatistic::redirectServersHook(const RooAbsCollection& newServe
 	_gofArray[i]->recursiveRedirectServers(newServerList,mustReplaceAll,nameChange);
       }
     }
+    _threadsReady = kFALSE ;
+  } else if (MPMaster == _gofOpMode && _threadGofArray) {
+    // Forward to partitions calculated in threads
+    for (Int_t i = 0; i < _nCPU; ++i) {
+      if (_threadGofArray[i]) {
+	_threadGofArray[i]->recursiveRedirectServers(newServerList,mustReplaceAll,nameChange);
+      }
+    }
+    _threadsReady = kFALSE ;
   } else if (MPMaster == _gofOpMode&& _mpfeArray) {
     // Forward to slaves
     for (Int_t i = 0; i < _nCPU; ++i) {
@@ -396,6 +462,15 @@ void RooAbsTestStatistic::printCompactTreeHook(ostream& os, const char* indent)
       }
     }
     os << indent << "RooAbsTestStatistic end GOF contents" << endl;
+  } else if (MPMaster == _gofOpMode && _threadGofArray) {
+    // Forward to partitions calculated in threads
+    os << indent << "RooAbsTestStatistic begin GOF contents" << endl ;
+    for (Int_t i = 0; i < _nCPU; ++i) {
+      TString indent2(indent);
+      indent2 += Form("[%d] ",i);
+      _threadGofArray[i]->printCompactTreeHook(os,indent2);
+    }
+    os << indent << "RooAbsTestStatistic end GOF contents" << endl;
   } else if (MPMaster == _gofOpMode) {
     // WVE implement this
   }
@@ -419,6 +494,12 @@ void RooAbsTestStatistic::constOptimizeTestStatistic(ConstOpCode opcode, Bool_t
 	if (_gofArray[i]) _gofArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt);
       }
     }
+    _threadsReady = kFALSE ;
+  } else if (MPMaster == _gofOpMode && _mpThreads) {
+    for (Int_t i = 0; i < _nCPU; ++i) {
+      _threadGofArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt);
+    }
+    _threadsReady = kFALSE ;
   } else if (MPMaster == _gofOpMode) {
     for (Int_t i = 0; i < _nCPU; ++i) {
       _mpfeArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt);
@@ -480,6 +561,157 @@ void RooAbsTestStatistic::initMPMode(RooAbsReal* real, RooAbsData* data, const R
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Initialize multi-threaded calculation mode. Create a component test statistic
+/// for each partition, each with its own clone of the function and of the data.
+/// The clones share the parameter objects of this test statistic, so that
+/// changes of the parameters need not be communicated to the threads.
+
+void RooAbsTestStatistic::initThreadMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName)
+{
+  _threadGofArray = new pRooAbsTestStatistic[_nCPU];
+  _threadVal.assign(_nCPU,0.) ;
+  _threadCarry.assign(_nCPU,0.) ;
+
+  for (Int_t i = 0; i < _nCPU; ++i) {
+    RooAbsTestStatistic* gof = create(Form("%s_GOF%d",GetName(),i),Form("%s_GOF%d",GetTitle(),i),*real,*data,*projDeps,
+				      rangeName,addCoefRangeName,1,_mpinterl,_verbose,_splitRange);
+    gof->_mpThreads = kTRUE ;
+    gof->recursiveRedirectServers(_paramSet);
+    gof->setMPSet(i,_nCPU);
+    gof->cloneSharedHistograms() ;
+    _threadGofArray[i] = gof ;
+  }
+  _threadsReady = kFALSE ;
+
+#ifdef _OPENMP
+  coutI(Eval) << "RooAbsTestStatistic::initThreadMode: calculating " << _nCPU << " partitions in parallel threads" << endl;
+#else
+  coutW(Eval) << "RooAbsTestStatistic::initThreadMode: WARNING: RooFit is compiled without OpenMP support, the "
+	      << _nCPU << " partitions are calculated sequentially" << endl;
+#endif
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forward to the component test statistics. The threads of this process share
+/// all objects that the clones of the function do not copy: the RooDataHist of
+/// RooHistPdf and RooHistFunc, whose bin lookup modifies its internal state, is
+/// replaced by a private copy in each clone that is calculated in a thread
+
+void RooAbsTestStatistic::cloneSharedHistograms()
+{
+  if (SimMaster == _gofOpMode && _gofArray) {
+    for (Int_t i = 0; i < _nGof; ++i) {
+      if (_gofArray[i]) _gofArray[i]->cloneSharedHistograms() ;
+    }
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Select calculation of the partitions of the test statistic in threads of this
+/// process (with shared memory) rather than in separate processes. Each thread
+/// evaluates its own clone of the function on its own clone of the data, while the
+/// parameters are read from the parameter objects of this test statistic. The threads
+/// are managed by OpenMP: they can be bound to processor cores with the standard
+/// OMP_PROC_BIND and OMP_PLACES environment variables. The partitions are combined
+/// in fixed order, so the result does not depend on the scheduling of the threads.
+/// The mode can only be changed before the parallel calculation is initialized.
+
+void RooAbsTestStatistic::setThreadedMode(Bool_t flag)
+{
+  if (_init && MPMaster == _gofOpMode && flag != _mpThreads) {
+    coutW(Eval) << "RooAbsTestStatistic::setThreadedMode(" << GetName() << ") WARNING: parallel calculation already initialized, ignoring change of mode" << endl ;
+    return ;
+  }
+  _mpThreads = flag ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate the components of a simultaneous p.d.f in up to nThreads threads
+/// of this process. Only components that need recalculation are calculated, the
+/// most expensive ones (as measured in previous calculations) first, and each
+/// thread takes the next component when it is done with the previous one, so that
+/// components of very different calculation time are distributed evenly. The
+/// components are combined afterwards in their fixed order, so the result does
+/// not depend on the scheduling. Each component has its own clone of the p.d.f
+/// and of the data, and the parameters are shared.
+
+void RooAbsTestStatistic::setComponentThreads(Int_t nThreads)
+{
+#ifndef _OPENMP
+  if (nThreads>1) {
+    coutW(Eval) << "RooAbsTestStatistic::setComponentThreads(" << GetName() << ") WARNING: RooFit is compiled without OpenMP support, "
+		<< "components are calculated sequentially" << endl ;
+    nThreads = 1 ;
+  }
+#endif
+  _simThreads = nThreads>1 ? nThreads : 1 ;
+}
+
+
+
+namespace {
+  // Order of component indices by decreasing calculation time (and increasing index for equal times)
+  struct RooCompCostOrder {
+    RooCompCostOrder(const std::vector<Double_t>& cost) : _cost(cost) {}
+    bool operator()(Int_t i, Int_t j) const { return _cost[i]>_cost[j] || (_cost[i]==_cost[j] && i<j) ; }
+    const std::vector<Double_t>& _cost ;
+  } ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate the components of the simultaneous p.d.f that need recalculation
+/// in parallel threads, in order of decreasing calculation time. The values are
+/// stored in the components, which are subsequently combined in combinedValue().
+/// The first calculation after (re)configuration of the components is done
+/// sequentially, so that all objects and caches created on demand are created
+/// in the main thread
+
+void RooAbsTestStatistic::calculateComponents() const
+{
+  _gofOrder.clear() ;
+  for (Int_t i = 0; i < _nGof; ++i) {
+    Bool_t used = (_mpinterl == RooFit::BulkPartition || _mpinterl == RooFit::Interleave) ||
+      (i % _numSets == _setNum || (_mpinterl==RooFit::Hybrid && _gofSplitMode[i] != RooFit::SimComponents)) ;
+    if (used && _gofArray[i]->isValueDirty()) _gofOrder.push_back(i) ;
+  }
+  std::sort(_gofOrder.begin(),_gofOrder.end(),RooCompCostOrder(_gofCost)) ;
+
+  const Int_t n = _gofOrder.size() ;
+  if (!_threadsReady) {
+    // Components sharing a histogram cannot look it up concurrently
+    for (Int_t i = 0; i < _nGof; ++i) {
+      _gofArray[i]->cloneSharedHistograms() ;
+    }
+  }
+  const Bool_t wasThreaded = RooAbsArg::setThreadedCalculation((_threadsReady && n>1) || RooAbsArg::threadedCalculation()) ;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,1) num_threads(_simThreads) if(_threadsReady && n>1)
+#endif
+  for (Int_t k = 0; k < n; ++k) {
+    const Int_t i = _gofOrder[k] ;
+#ifdef _OPENMP
+    const Double_t start = omp_get_wtime() ;
+#endif
+    _gofArray[i]->getValV() ;
+#ifdef _OPENMP
+    _gofCost[i] = omp_get_wtime() - start ;
+#endif
+  }
+  RooAbsArg::setThreadedCalculation(wasThreaded) ;
+  _threadsReady = kTRUE ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Initialize simultaneous p.d.f processing mode. Strip simultaneous
 /// p.d.f into individual components, split dataset in subset
@@ -565,6 +797,7 @@ void RooAbsTestStatistic::initSimMode(RooSimultaneous* simpdf, RooAbsData* data,
 			      rangeName,addCoefRangeName,_nCPU,_mpinterl,_verbose,_splitRange,binnedL);
       }
       _gofArray[n]->setSimCount(_nGof);
+      _gofArray[n]->_mpThreads = _mpThreads ;
       // *** END HERE
 
       // Fill per-component split mode with Bulk Partition for now so that Auto will map to bulk-splitting of all components
@@ -601,6 +834,8 @@ void RooAbsTestStatistic::initSimMode(RooSimultaneous* simpdf, RooAbsData* data,
     }
   }
   coutI(Fitting) << "RooAbsTestStatistic::initSimMode: created " << n << " slave calculators." << endl;
+  _gofCost.assign(_nGof,0.) ;
+  _threadsReady = kFALSE ;
   
   // Delete datasets by hand as TList::Delete() doesn't see our datasets as 'on the heap'...
   TIterator* iter = dsetList->MakeIterator();
@@ -660,6 +895,7 @@ Bool_t RooAbsTestStatistic::setData(RooAbsData& indata, Bool_t cloneData)
 	}
       }
     }
+    _threadsReady = kFALSE ;
     break;
   case MPMaster:
     // Not supported
@@ -699,7 +935,11 @@ void RooAbsTestStatistic::enableOffsetting(Bool_t flag)
   case MPMaster:    
     _doOffset = flag;
     for (Int_t i = 0; i < _nCPU; ++i) {
-      _mpfeArray[i]->enableOffsetting(flag);
+      if (_mpThreads) {
+	_threadGofArray[i]->enableOffsetting(flag);
+      } else {
+	_mpfeArray[i]->enableOffsetting(flag);
+      }
     }
     break;
   }
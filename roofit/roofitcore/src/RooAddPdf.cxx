@@ -66,6 +66,7 @@
 #include "RooGlobalFunc.h"
 #include "RooRealIntegral.h"
 #include "RooTrace.h"
+#include "RooVectorDataStore.h"
 
 #include "Riostream.h"
 #include <algorithm>
@@ -851,6 +852,68 @@ Double_t RooAddPdf::evaluate() const
 }
 
 
+
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate() for a range of events of a vector data store.
+/// The values of the component p.d.f.s are obtained in batch mode as well.
+/// Return kFALSE if the coefficients or their projection integrals depend
+/// on the observables of the data, as these are not the same for all events
+
+Bool_t RooAddPdf::evaluateBatch(Double_t* output, Int_t firstEvent, Int_t nEvents, const RooVectorDataStore& data) const
+{
+  const RooArgSet* nset = _normSet ; 
+
+  if (nset==0 || nset->getSize()==0) {
+    if (_refCoefNorm.getSize()!=0) {
+      nset = &_refCoefNorm ;
+    }
+  }
+
+  CacheElem* cache = getProjCache(nset) ;
+
+  const RooArgList* coefLists[5] = { &_coefList, &cache->_suppNormList, &cache->_projList, &cache->_suppProjList, &cache->_refRangeProjList } ;
+  for (Int_t k=0 ; k<5 ; k++) {
+    RooFIter ci = coefLists[k]->fwdIterator() ;
+    RooAbsArg* arg ;
+    while((arg=ci.next())) {
+      if (arg->dependsOn(*data.get(),0,kTRUE)) {
+	return kFALSE ;
+      }
+    }
+  }
+
+  updateCoefficients(*cache,nset) ;
+
+  for (Int_t j=0 ; j<nEvents ; j++) {
+    output[j] = 0 ;
+  }
+
+  // Do running sum of coef/pdf pairs in the same order as evaluate()
+  std::vector<Double_t> pdfVals(nEvents) ;
+  RooAbsPdf* pdf ;
+  Int_t i(0) ;
+  RooFIter pi = _pdfList.fwdIterator() ;
+  while((pdf = (RooAbsPdf*)pi.next())) {
+    Double_t snormVal = cache->_needSupNorm ? ((RooAbsReal*)cache->_suppNormList.at(i))->getVal() : 1 ;
+    pdf->getValBatch(&pdfVals[0],firstEvent,nEvents,data,nset) ;
+    if (pdf->isSelectedComp()) {
+      if (cache->_needSupNorm) {
+	for (Int_t j=0 ; j<nEvents ; j++) {
+	  output[j] += pdfVals[j]*_coefCache[i]/snormVal ;
+	}
+      } else {
+	for (Int_t j=0 ; j<nEvents ; j++) {
+	  output[j] += pdfVals[j]*_coefCache[i] ;
+	}
+      }
+    }
+    i++ ;
+  }
+
+  return kTRUE ;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Reset error counter to given value, limiting the number
 /// of future error messages for this pdf to 'resetValue'
@@ -256,6 +256,23 @@ Bool_t RooAddition::setData(RooAbsData& data, Bool_t cloneData)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Label OK'ed terms of a RooAddition with cache-and-track, so that in a likelihood
+/// only the terms that depend on a changed parameter are recalculated
+
+void RooAddition::setCacheAndTrackHints(RooArgSet& trackNodes) 
+{
+  RooFIter siter = _set.fwdIterator() ;
+  RooAbsArg* sarg ;
+  while ((sarg=siter.next())) {
+    if (sarg->isDerived() && sarg->canNodeBeCached()==Always) {
+      trackNodes.add(*sarg) ;
+    }
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void RooAddition::printMetaArgs(ostream& os) const 
@@ -22,6 +22,11 @@
 // a list of input parameter names. The factory can also compile
 // the generated code on the fly, and on request also immediate
 // instantiate objects.
+// <p>
+// With makeCompiledFunction() and makeCompiledPdf() the factory can
+// also translate a tree of formula, addition and product objects into
+// a single C++ expression, and compile it into one object that replaces
+// the interpreted evaluation of the complete tree.
 // END_HTML
 //
 
@@ -37,6 +42,12 @@
 #include "RooWorkspace.h"
 #include "RooGlobalFunc.h"
 #include "RooAbsPdf.h"
+#include "RooConstVar.h"
+#include "RooFormulaVar.h"
+#include "RooGenericPdf.h"
+#include "RooAddition.h"
+#include "RooProduct.h"
+#include "TMath.h"
 #include <fstream>
 #include <vector>
 #include <string>
@@ -361,6 +372,265 @@ RooAbsPdf* RooClassFactory::makePdfInstance(const char* className, const char* n
 
 
 
+namespace {
+
+  Bool_t flattenArg(const RooAbsArg& arg, string& out, RooArgList& inputs) ;
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Return true if 'name' can be used as a C++ identifier in generated code
+
+  Bool_t isIdentifier(const char* name)
+  {
+    if (!name || !(isalpha(*name) || *name=='_')) return kFALSE ;
+    for (const char* c=name ; *c ; c++) {
+      if (!(isalnum(*c) || *c=='_')) return kFALSE ;
+    }
+    return kTRUE ;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Return true if 'name' is a built-in function of TFormula without C++ equivalent
+
+  Bool_t isFormulaShortcut(const string& name)
+  {
+    static const char* shortcuts[] = { "sq", "gaus", "gausn", "expo", "landau", "landaun",
+				       "xygaus", "xyexpo", "xylandau", "xylandaun", 0 } ;
+    for (const char** sc=shortcuts ; *sc ; sc++) {
+      if (name==*sc) return kTRUE ;
+    }
+    return name.size()>3 && name.compare(0,3,"pol")==0 && name.find_first_not_of("0123456789",3)==string::npos ;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Append the formula expression 'formExpr' of object 'owner' to 'out', with all
+  /// references to its dependents (by name or as @N) replaced by their expressions.
+  /// Integer literals are written as floating point literals, since the formula
+  /// evaluates 1/2 as 0.5, and the constant pi is replaced by its value
+
+  Bool_t flattenFormula(const char* owner, const char* formExpr, const RooArgList& deps, string& out, RooArgList& inputs)
+  {
+    out += "(" ;
+    const char* c = formExpr ;
+    while (*c) {
+      if (*c=='^' || (c[0]=='*' && c[1]=='*')) {
+	oocoutE((TObject*)0,InputArguments) << "RooClassFactory::flattenExpression(" << owner << ") ERROR: operator '" << (*c=='^'?"^":"**")
+					  << "' in expression " << formExpr << " has no C++ equivalent, use pow() instead" << endl ;
+	return kFALSE ;
+      }
+      if (*c=='%' || *c=='[') {
+	oocoutE((TObject*)0,InputArguments) << "RooClassFactory::flattenExpression(" << owner << ") ERROR: " << (*c=='%'?"operator '%'":"parameter reference")
+					  << " in expression " << formExpr << " is not supported" << (*c=='%'?", use fmod() instead":"") << endl ;
+	return kFALSE ;
+      }
+      if (*c=='@') {
+	const char* e = c+1 ;
+	while (isdigit(*e)) e++ ;
+	RooAbsArg* dep = (e>c+1) ? deps.at(atoi(c+1)) : 0 ;
+	if (!dep) {
+	  oocoutE((TObject*)0,InputArguments) << "RooClassFactory::flattenExpression(" << owner << ") ERROR: invalid reference "
+					    << string(c,e-c) << " in expression " << formExpr << endl ;
+	  return kFALSE ;
+	}
+	if (!flattenArg(*dep,out,inputs)) return kFALSE ;
+	c = e ;
+	continue ;
+      }
+      if (isalpha(*c) || *c=='_') {
+	// Read identifier, including namespace qualifiers
+	const char* e = c ;
+	while (isalnum(*e) || *e=='_' || (e[0]==':' && e[1]==':')) {
+	  e += (*e==':') ? 2 : 1 ;
+	}
+	string token(c,e-c) ;
+	RooAbsArg* dep = deps.find(token.c_str()) ;
+	if (dep) {
+	  if (!flattenArg(*dep,out,inputs)) return kFALSE ;
+	} else {
+	  size_t colon = token.find("::") ;
+	  if (colon!=string::npos && deps.find(token.substr(0,colon).c_str())) {
+	    oocoutE((TObject*)0,InputArguments) << "RooClassFactory::flattenExpression(" << owner << ") ERROR: category state reference "
+					      << token << " in expression " << formExpr << " is not supported" << endl ;
+	    return kFALSE ;
+	  }
+	  if (isFormulaShortcut(token)) {
+	    oocoutE((TObject*)0,InputArguments) << "RooClassFactory::flattenExpression(" << owner << ") ERROR: TFormula function " << token
+					      << " in expression " << formExpr << " has no C++ equivalent" << endl ;
+	    return kFALSE ;
+	  }
+	  out += (token=="pi") ? Form("(%.17g)",TMath::Pi()) : token ;
+	}
+	c = e ;
+	continue ;
+      }
+      if (isdigit(*c) || *c=='.') {
+	// Copy numeric literal, including exponent markers and suffixes
+	const char* e = c ;
+	while (isalnum(*e) || *e=='.') e++ ;
+	string literal(c,e-c) ;
+	out += literal ;
+	if (literal.find_first_not_of("0123456789")==string::npos) out += "." ;
+	c = e ;
+	continue ;
+      }
+      out += *c++ ;
+    }
+    out += ")" ;
+    return kTRUE ;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Append the C++ expression of 'arg' to 'out'. Constants, formulas, additions
+  /// and products are expanded in place, any other argument is added to 'inputs'
+  /// and referred to by name
+
+  Bool_t flattenArg(const RooAbsArg& arg, string& out, RooArgList& inputs)
+  {
+    if (const RooConstVar* cvar = dynamic_cast<const RooConstVar*>(&arg)) {
+      out += Form("(%.17g)",cvar->getVal()) ;
+      return kTRUE ;
+    }
+
+    if (const RooFormulaVar* fvar = dynamic_cast<const RooFormulaVar*>(&arg)) {
+      return flattenFormula(fvar->GetName(),fvar->expression(),fvar->dependents(),out,inputs) ;
+    }
+
+    const RooAddition* add = dynamic_cast<const RooAddition*>(&arg) ;
+    const RooProduct* prod = dynamic_cast<const RooProduct*>(&arg) ;
+    if (add || prod) {
+      RooArgList terms(add ? add->list() : prod->components()) ;
+      out += "(" ;
+      for (Int_t i=0 ; i<terms.getSize() ; i++) {
+	if (i>0) out += add ? " + " : " * " ;
+	if (!flattenArg(*terms.at(i),out,inputs)) return kFALSE ;
+      }
+      if (terms.getSize()==0) out += add ? "0" : "1" ;
+      out += ")" ;
+      return kTRUE ;
+    }
+
+    // Variables, categories and functions without code generation become
+    // inputs of the compiled object
+    RooAbsArg* known = inputs.find(arg.GetName()) ;
+    if (known && known!=&arg) {
+      oocoutE((TObject*)0,InputArguments) << "RooClassFactory::flattenExpression ERROR: different arguments with the same name "
+					<< arg.GetName() << " in expression tree" << endl ;
+      return kFALSE ;
+    }
+    if (!dynamic_cast<const RooAbsReal*>(&arg) && !dynamic_cast<const RooAbsCategory*>(&arg)) {
+      oocoutE((TObject*)0,InputArguments) << "RooClassFactory::flattenExpression ERROR: argument " << arg.GetName()
+					<< " is neither RooAbsReal nor RooAbsCategory" << endl ;
+      return kFALSE ;
+    }
+    if (!isIdentifier(arg.GetName())) {
+      oocoutE((TObject*)0,InputArguments) << "RooClassFactory::flattenExpression ERROR: name of argument " << arg.GetName()
+					<< " is not a valid C++ identifier" << endl ;
+      return kFALSE ;
+    }
+    if (!known) {
+      inputs.add(arg) ;
+    }
+    out += arg.GetName() ;
+    return kTRUE ;
+  }
+
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translate the expression tree of 'func' into a single one-line C++
+/// expression, returned in 'expression', of the arguments returned in 'inputs'.
+///
+/// Formula objects (RooFormulaVar, and RooGenericPdf as top-level node),
+/// additions (RooAddition), products (RooProduct) and constants (RooConstVar)
+/// are expanded in place into the expression. All other arguments, i.e. the
+/// variables and categories as well as any function or p.d.f. of another
+/// type, are referenced by name and added to 'inputs'. The category states
+/// can only be referred to by index and the formulas must use C++ syntax,
+/// e.g. pow(x,2) instead of x^2 or x**2. The integer literals of the formulas
+/// become floating point literals and the constant pi is replaced by its value, so
+/// that the C++ expression has the value of the formula; the TFormula shortcuts
+/// (gaus, expo, polN, ...), parameters [N] and the '%' operator are rejected.
+///
+/// The likelihood (createNLL(), RooMinimizerFcn) does not make this replacement
+/// itself: the compiled object must be substituted in the model by the user.
+///
+/// Returns true if the tree can be translated
+
+Bool_t RooClassFactory::flattenExpression(const RooAbsReal& func, string& expression, RooArgList& inputs)
+{
+  expression.clear() ;
+
+  const RooGenericPdf* gpdf = dynamic_cast<const RooGenericPdf*>(&func) ;
+  if (gpdf) {
+    return flattenFormula(gpdf->GetName(),gpdf->expression(),gpdf->dependents(),expression,inputs) ;
+  }
+
+  if (!dynamic_cast<const RooFormulaVar*>(&func) && !dynamic_cast<const RooAddition*>(&func) && 
+      !dynamic_cast<const RooProduct*>(&func)) {
+    oocoutE(&func,InputArguments) << "RooClassFactory::flattenExpression(" << func.GetName() << ") ERROR: no code generation for objects of class "
+				  << func.IsA()->GetName() << endl ;
+    return kFALSE ;
+  }
+
+  return flattenArg(func,expression,inputs) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write, compile and load code and instantiate object for a RooAbsReal
+/// implementation that calculates the value of the complete expression
+/// tree of 'func' in a single compiled function (see flattenExpression()
+/// for the supported nodes). The intermediate formula, addition and product
+/// objects are no longer evaluated (or interpreted) one by one: the returned
+/// object 'name' of class 'className' (default Roo<name>Func) only depends
+/// on the input arguments of the tree and can replace 'func' in the model.
+///
+/// Returns a null pointer if the tree cannot be translated.
+
+RooAbsReal* RooClassFactory::makeCompiledFunction(const char* name, const RooAbsReal& func, const char* className)
+{
+  string expression ;
+  RooArgList inputs ;
+  if (!flattenExpression(func,expression,inputs)) {
+    return 0 ;
+  }
+
+  oocxcoutI(&func,ObjectHandling) << "RooClassFactory::makeCompiledFunction(" << name << ") compiling expression tree of "
+				  << func.GetName() << " with " << inputs.getSize() << " inputs" << endl ;
+
+  return className ? makeFunctionInstance(className,name,expression.c_str(),inputs) : makeFunctionInstance(name,expression.c_str(),inputs) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write, compile and load code and instantiate object for a RooAbsPdf
+/// implementation with the expression tree of 'shape' as unnormalized
+/// value (see flattenExpression() for the supported nodes). If 'shape' is
+/// a RooGenericPdf, the returned p.d.f. is a compiled equivalent of it,
+/// which is normalized in the same way. The object has name 'name' and
+/// class 'className' (default Roo<name>Pdf).
+///
+/// Returns a null pointer if the tree cannot be translated.
+
+RooAbsPdf* RooClassFactory::makeCompiledPdf(const char* name, const RooAbsReal& shape, const char* className)
+{
+  string expression ;
+  RooArgList inputs ;
+  if (!flattenExpression(shape,expression,inputs)) {
+    return 0 ;
+  }
+
+  oocxcoutI(&shape,ObjectHandling) << "RooClassFactory::makeCompiledPdf(" << name << ") compiling expression tree of "
+				   << shape.GetName() << " with " << inputs.getSize() << " inputs" << endl ;
+
+  return className ? makePdfInstance(className,name,expression.c_str(),inputs) : makePdfInstance(name,expression.c_str(),inputs) ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Write code for a RooAbsPdf implementation with class name 'name',
 /// taking RooAbsReal arguments with names listed in argNames and
@@ -1115,6 +1115,72 @@ Int_t RooDataHist::calcTreeIndex() const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Assign the values of the elements of 'coord' to the matching observables
+/// of the internal argset, as _vars.assignValueOnly(coord,oneSafe). The
+/// matching by name is only done when 'coord' holds other elements than
+/// in the previous call, or when the elements or the observables have been
+/// renamed since, so that repeated lookups with the same coordinate set
+/// (as in RooHistFunc and RooHistPdf) only copy the values. Like the current
+/// coordinates, this matching is state of the RooDataHist: lookups in the same
+/// RooDataHist must not be made concurrently, clones of RooHistPdf and RooHistFunc
+/// evaluated in parallel threads hold private copies (see RooHistPdf::cloneDataHist())
+
+void RooDataHist::assignCoordinates(const RooArgSet& coord, Bool_t oneSafe) const
+{
+  if (&coord==&_vars) return ;
+
+  // Short cut for 1 element assignment
+  if (oneSafe && _vars.getSize()==1 && coord.getSize()==1) {
+    coord.first()->syncCache() ;
+    _vars.first()->copyCache(coord.first(),kTRUE) ;
+    return ;
+  }
+
+  // Check if coord holds the same elements (with the same names) as in the previous call,
+  // and if the observables still have the same names (see changeObservableName())
+  Bool_t same = (_lookupCoord.size()==(UInt_t)coord.getSize() && _lookupVars.size()==(UInt_t)_vars.getSize()) ;
+  RooFIter citer = coord.fwdIterator() ;
+  RooAbsArg* carg ;
+  UInt_t n(0) ;
+  while(same && (carg=citer.next())) {
+    same = (_lookupCoord[n].first==carg && _lookupCoord[n].second==carg->namePtr()) ;
+    n++ ;
+  }
+  RooFIter viter = _vars.fwdIterator() ;
+  RooAbsArg* varg ;
+  n = 0 ;
+  while(same && (varg=viter.next())) {
+    same = (_lookupVars[n++]==varg->namePtr()) ;
+  }
+
+  viter = _vars.fwdIterator() ;
+  if (!same) {
+    _lookupCoord.clear() ;
+    citer = coord.fwdIterator() ;
+    while((carg=citer.next())) {
+      _lookupCoord.push_back(std::make_pair(carg,carg->namePtr())) ;
+    }
+    _lookupSrc.clear() ;
+    _lookupVars.clear() ;
+    while((varg=viter.next())) {
+      _lookupSrc.push_back(coord.find(*varg)) ;
+      _lookupVars.push_back(varg->namePtr()) ;
+    }
+    viter = _vars.fwdIterator() ;
+  }
+
+  n = 0 ;
+  while((varg=viter.next())) {
+    RooAbsArg* src = _lookupSrc[n++] ;
+    if (!src) continue ;
+    src->syncCache() ;
+    varg->copyCache(src,kTRUE) ;
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Debug stuff, should go...
 
@@ -1195,7 +1261,7 @@ Double_t RooDataHist::weight(const RooArgSet& bin, Int_t intOrder, Bool_t correc
 
   // Handle no-interpolation case
   if (intOrder==0) {    
-    _vars.assignValueOnly(bin,oneSafe) ;
+    assignCoordinates(bin,oneSafe) ;
     Int_t idx = calcTreeIndex() ;
     //cout << "intOrder 0, idx = " << idx << endl ;
     if (correctForBinSize) {
@@ -1209,7 +1275,7 @@ Double_t RooDataHist::weight(const RooArgSet& bin, Int_t intOrder, Bool_t correc
   }
 
   // Handle all interpolation cases
-  _vars.assignValueOnly(bin) ;
+  assignCoordinates(bin) ;
 
   Double_t wInt(0) ;
   if (_realVars.getSize()==1) {
@@ -119,6 +119,7 @@
 #include "RooGlobalFunc.h"
 #include "RooLinearVar.h"
 #include "RooConstVar.h"
+#include "RooChangeTracker.h"
 #include "TClass.h"
 #include "TSystem.h"
 
@@ -247,7 +248,9 @@ RooFFTConvPdf::PdfCacheElem* RooFFTConvPdf::createCache(const RooArgSet* nset) c
 
 RooFFTConvPdf::FFTCacheElem::FFTCacheElem(const RooFFTConvPdf& self, const RooArgSet* nsetIn) : 
   PdfCacheElem(self,nsetIn),
-  fftr2c1(0),fftr2c2(0),fftc2r(0) 
+  fftr2c1(0),fftr2c2(0),fftc2r(0),
+  pdf1Tracker(0),pdf2Tracker(0),
+  reuse1(kFALSE),reuse2(kFALSE),curSlice(0),nBins(0),nBins2(0),binShift1(0)
 {
   RooAbsPdf* clonePdf1 = (RooAbsPdf*) self._pdf1.arg().cloneTree() ;
   RooAbsPdf* clonePdf2 = (RooAbsPdf*) self._pdf2.arg().cloneTree() ;
@@ -310,6 +313,17 @@ RooFFTConvPdf::FFTCacheElem::FFTCacheElem(const RooFFTConvPdf& self, const RooAr
 
   delete fftParams ;
 
+  // Track the parameters of each input p.d.f. separately, so that the transform
+  // of an input whose parameters did not change can be reused
+  RooArgSet* params1 = pdf1Clone->getParameters(*hist()->get()) ;
+  RooArgSet* params2 = pdf2Clone->getParameters(*hist()->get()) ;
+  pdf1Tracker = new RooChangeTracker(Form("%s_pdf1Tracker",self.GetName()),"pdf1Tracker",*params1,kTRUE) ;
+  pdf2Tracker = new RooChangeTracker(Form("%s_pdf2Tracker",self.GetName()),"pdf2Tracker",*params2,kTRUE) ;
+  pdf1Tracker->hasChanged(kTRUE) ;
+  pdf2Tracker->hasChanged(kTRUE) ;
+  delete params1 ;
+  delete params2 ;
+
   // Save copy of original histX binning and make alternate binning
   // for extended range scanning
 
@@ -353,6 +367,8 @@ RooArgList RooFFTConvPdf::FFTCacheElem::containedArgs(Action a)
   if (pdf2Clone->ownedComponents()) {
     ret.add(*pdf2Clone->ownedComponents()) ;
   }
+  ret.add(*pdf1Tracker) ;
+  ret.add(*pdf2Tracker) ;
 
   return ret ;
 }
@@ -366,6 +382,9 @@ RooFFTConvPdf::FFTCacheElem::~FFTCacheElem()
   delete fftr2c2 ; 
   delete fftc2r ; 
 
+  delete pdf1Tracker ;
+  delete pdf2Tracker ;
+
   delete pdf1Clone ;
   delete pdf2Clone ;
 
@@ -387,6 +406,12 @@ void RooFFTConvPdf::fillCacheObject(RooAbsCachedPdf::PdfCacheElem& cache) const
   ((FFTCacheElem&)cache).pdf1Clone->setOperMode(ADirty,kTRUE) ;
   ((FFTCacheElem&)cache).pdf2Clone->setOperMode(ADirty,kTRUE) ;
 
+  // Determine for which input p.d.f.s the transforms of the previous fill can be reused
+  FFTCacheElem& aux = (FFTCacheElem&) cache ;
+  aux.reuse1 = !aux.pdf1Tracker->hasChanged(kTRUE) ;
+  aux.reuse2 = !aux.pdf2Tracker->hasChanged(kTRUE) ;
+  aux.curSlice = 0 ;
+
   // Determine if there other observables than the convolution observable in the cache
   RooArgSet otherObs ;
   RooArgSet(*cacheHist.get()).snapshot(otherObs) ;
@@ -485,14 +510,35 @@ void RooFFTConvPdf::fillCacheSlice(FFTCacheElem& aux, const RooArgSet& slicePos)
   // 
 
   Int_t N,N2,binShift1,binShift2 ;
+
+  // Only sample and transform the p.d.f.s whose transform for this slice cannot be reused
+  UInt_t islice = aux.curSlice++ ;
+  if (aux.spec1.size()<=islice) {
+    aux.spec1.resize(islice+1) ;
+    aux.spec2.resize(islice+1) ;
+  }
+  Bool_t reuse1 = aux.reuse1 && !aux.spec1[islice].empty() ;
+  Bool_t reuse2 = aux.reuse2 && !aux.spec2[islice].empty() ;
   
   RooRealVar* histX = (RooRealVar*) cacheHist.get()->find(_x.arg().GetName()) ;
   if (_bufStrat==Extend) histX->setBinning(*aux.scanBinning) ;
-  Double_t* input1 = scanPdf((RooRealVar&)_x.arg(),*aux.pdf1Clone,cacheHist,slicePos,N,N2,binShift1,_shift1) ;
-  Double_t* input2 = scanPdf((RooRealVar&)_x.arg(),*aux.pdf2Clone,cacheHist,slicePos,N,N2,binShift2,_shift2) ;
+  Double_t* input1 = reuse1 ? 0 : scanPdf((RooRealVar&)_x.arg(),*aux.pdf1Clone,cacheHist,slicePos,N,N2,binShift1,_shift1) ;
+  Double_t* input2 = reuse2 ? 0 : scanPdf((RooRealVar&)_x.arg(),*aux.pdf2Clone,cacheHist,slicePos,N,N2,binShift2,_shift2) ;
   if (_bufStrat==Extend) histX->setBinning(*aux.histBinning) ;
 
-
+  // The sampling sizes and shifts are the same for all fills of this cache
+  if (input1) {
+    aux.binShift1 = binShift1 ;
+  } else {
+    binShift1 = aux.binShift1 ;
+  }
+  if (input1 || input2) {
+    aux.nBins = N ;
+    aux.nBins2 = N2 ;
+  } else {
+    N = aux.nBins ;
+    N2 = aux.nBins2 ;
+  }
 
 
   // Retrieve previously defined FFT transformation plans
@@ -503,19 +549,32 @@ void RooFFTConvPdf::fillCacheSlice(FFTCacheElem& aux, const RooArgSet& slicePos)
   }
   
   // Real->Complex FFT Transform on p.d.f. 1 sampling
-  aux.fftr2c1->SetPoints(input1);
-  aux.fftr2c1->Transform();
+  vector<Double_t>& spec1 = aux.spec1[islice] ;
+  if (input1) {
+    aux.fftr2c1->SetPoints(input1);
+    aux.fftr2c1->Transform();
+    spec1.resize(2*(N2/2+1)) ;
+    for (Int_t i=0 ; i<N2/2+1 ; i++) {
+      aux.fftr2c1->GetPointComplex(i,spec1[2*i],spec1[2*i+1]) ;
+    }
+  }
 
   // Real->Complex FFT Transform on p.d.f 2 sampling
-  aux.fftr2c2->SetPoints(input2);
-  aux.fftr2c2->Transform();
+  vector<Double_t>& spec2 = aux.spec2[islice] ;
+  if (input2) {
+    aux.fftr2c2->SetPoints(input2);
+    aux.fftr2c2->Transform();
+    spec2.resize(2*(N2/2+1)) ;
+    for (Int_t i=0 ; i<N2/2+1 ; i++) {
+      aux.fftr2c2->GetPointComplex(i,spec2[2*i],spec2[2*i+1]) ;
+    }
+  }
 
   // Loop over first half +1 of complex output results, multiply 
   // and set as input of reverse transform
   for (Int_t i=0 ; i<N2/2+1 ; i++) {
-    Double_t re1,re2,im1,im2 ;
-    aux.fftr2c1->GetPointComplex(i,re1,im1) ;
-    aux.fftr2c2->GetPointComplex(i,re2,im2) ;
+    Double_t re1 = spec1[2*i], im1 = spec1[2*i+1] ;
+    Double_t re2 = spec2[2*i], im2 = spec2[2*i+1] ;
     Double_t re = re1*re2 - im1*im2 ;
     Double_t im = re1*im2 + re2*im1 ;
     TComplex t(re,im) ;
@@ -842,6 +901,25 @@ void RooFFTConvPdf::setBufferFraction(Double_t frac)
 void RooFFTConvPdf::setBufferStrategy(BufStrat bs) 
 {
   _bufStrat = bs ;
+
+  // Sterilize the cache as the sampled and transformed inputs depend on the buffer strategy
+  _cacheMgr.sterilize() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Change the shifts applied to the sampled input p.d.f.s in the convolution
+/// (by default zero for the first and the center of the convolution observable range
+/// for the second)
+
+void RooFFTConvPdf::setShift(Double_t val1, Double_t val2) 
+{
+  _shift1 = val1 ;
+  _shift2 = val2 ;
+
+  // Sterilize the cache as the sampled and transformed inputs depend on the shifts
+  _cacheMgr.sterilize() ;
 }
 
 
@@ -165,6 +165,23 @@ void RooFormulaVar::printMultiline(ostream& os, Int_t contents, Bool_t verbose,
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Label OK'ed real-valued derived arguments of the formula with cache-and-track, so that in a
+/// likelihood only the arguments that depend on a changed parameter are recalculated
+
+void RooFormulaVar::setCacheAndTrackHints(RooArgSet& trackNodes) 
+{
+  RooFIter aiter = _actualVars.fwdIterator() ;
+  RooAbsArg* aarg ;
+  while ((aarg=aiter.next())) {
+    if (aarg->isDerived() && dynamic_cast<RooAbsReal*>(aarg) && aarg->canNodeBeCached()==Always) {
+      trackNodes.add(*aarg) ;
+    }
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Add formula expression as meta argument in printing interface
 
@@ -47,6 +47,7 @@ ClassImp(RooHistFunc)
 
 RooHistFunc::RooHistFunc() :
   _dataHist(0),
+  _ownedDataHist(0),
   _intOrder(0),
   _cdfBoundaries(kFALSE),
   _totVolume(0),
@@ -71,6 +72,7 @@ RooHistFunc::RooHistFunc(const char *name, const char *title, const RooArgSet& v
   RooAbsReal(name,title), 
   _depList("depList","List of dependents",this),
   _dataHist((RooDataHist*)&dhist), 
+  _ownedDataHist(0),
   _codeReg(10),
   _intOrder(intOrder),
   _cdfBoundaries(kFALSE),
@@ -117,6 +119,7 @@ RooHistFunc::RooHistFunc(const char *name, const char *title, const RooArgList&
   RooAbsReal(name,title), 
   _depList("depList","List of dependents",this),
   _dataHist((RooDataHist*)&dhist), 
+  _ownedDataHist(0),
   _codeReg(10),
   _intOrder(intOrder),
   _cdfBoundaries(kFALSE),
@@ -158,6 +161,7 @@ RooHistFunc::RooHistFunc(const RooHistFunc& other, const char* name) :
   RooAbsReal(other,name), 
   _depList("depList",this,other._depList),
   _dataHist(other._dataHist),
+  _ownedDataHist(other._ownedDataHist ? new RooDataHist(*other._ownedDataHist) : 0),
   _codeReg(other._codeReg),
   _intOrder(other._intOrder),
   _cdfBoundaries(other._cdfBoundaries),
@@ -166,6 +170,7 @@ RooHistFunc::RooHistFunc(const RooHistFunc& other, const char* name) :
 {
   TRACE_CREATE 
 
+  if (_ownedDataHist) _dataHist = _ownedDataHist ;
   _histObsList.addClone(other._histObsList) ;
 
   _histObsIter = _histObsList.createIterator() ;
@@ -182,6 +187,25 @@ RooHistFunc::~RooHistFunc()
 
   delete _histObsIter ;
   delete _pdfObsIter ;
+  delete _ownedDataHist ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Replace the (unowned) histogram by a private copy owned by this function.
+/// The lookup of a bin in a RooDataHist modifies its internal state (current
+/// coordinates, cached bin and matching of the coordinate set, see
+/// RooDataHist::assignCoordinates()), so that clones sharing the same histogram
+/// cannot be evaluated concurrently. Clones of a RooHistFunc holding a private copy
+/// receive a private copy as well. Nothing is done if the histogram is already
+/// owned.
+
+void RooHistFunc::cloneDataHist()
+{
+  if (_ownedDataHist || !_dataHist) return ;
+  _ownedDataHist = new RooDataHist(*_dataHist) ;
+  _dataHist = _ownedDataHist ;
 }
 
 
@@ -236,10 +260,9 @@ Double_t RooHistFunc::maxVal(Int_t code) const
   R__ASSERT(code==1) ;
 
   Double_t max(-1) ;
+  const Double_t* wgt = _dataHist->weightArray() ;
   for (Int_t i=0 ; i<_dataHist->numEntries() ; i++) {
-    _dataHist->get(i) ;
-    Double_t wgt = _dataHist->weight() ;
-    if (wgt>max) max=wgt ;
+    if (wgt[i]>max) max=wgt[i] ;
   }
 
   return max*1.05 ;
@@ -48,7 +48,7 @@ ClassImp(RooHistPdf)
 /// Default constructor
 /// coverity[UNINIT_CTOR]
 
-RooHistPdf::RooHistPdf() : _dataHist(0), _totVolume(0), _unitNorm(kFALSE)
+RooHistPdf::RooHistPdf() : _dataHist(0), _ownedDataHist(0), _totVolume(0), _unitNorm(kFALSE)
 {
   _histObsIter = _histObsList.createIterator() ;
   _pdfObsIter = _pdfObsList.createIterator() ;
@@ -66,6 +66,7 @@ RooHistPdf::RooHistPdf(const char *name, const char *title, const RooArgSet& var
   RooAbsPdf(name,title), 
   _pdfObsList("pdfObs","List of p.d.f. observables",this),
   _dataHist((RooDataHist*)&dhist), 
+  _ownedDataHist(0),
   _codeReg(10),
   _intOrder(intOrder),
   _cdfBoundaries(kFALSE),
@@ -126,6 +127,7 @@ RooHistPdf::RooHistPdf(const char *name, const char *title, const RooArgList& pd
   RooAbsPdf(name,title), 
   _pdfObsList("pdfObs","List of p.d.f. observables",this),
   _dataHist((RooDataHist*)&dhist), 
+  _ownedDataHist(0),
   _codeReg(10),
   _intOrder(intOrder),
   _cdfBoundaries(kFALSE),
@@ -183,12 +185,14 @@ RooHistPdf::RooHistPdf(const RooHistPdf& other, const char* name) :
   RooAbsPdf(other,name), 
   _pdfObsList("pdfObs",this,other._pdfObsList),
   _dataHist(other._dataHist),
+  _ownedDataHist(other._ownedDataHist ? new RooDataHist(*other._ownedDataHist) : 0),
   _codeReg(other._codeReg),
   _intOrder(other._intOrder),
   _cdfBoundaries(other._cdfBoundaries),
   _totVolume(other._totVolume),
   _unitNorm(other._unitNorm)
 {
+  if (_ownedDataHist) _dataHist = _ownedDataHist ;
   _histObsList.addClone(other._histObsList) ;
 
   _histObsIter = _histObsList.createIterator() ;
@@ -205,6 +209,25 @@ RooHistPdf::~RooHistPdf()
 {
   delete _histObsIter ;
   delete _pdfObsIter ;
+  delete _ownedDataHist ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Replace the (unowned) histogram by a private copy owned by this p.d.f..
+/// The lookup of a bin in a RooDataHist modifies its internal state (current
+/// coordinates, cached bin and matching of the coordinate set, see
+/// RooDataHist::assignCoordinates()), so that clones sharing the same histogram
+/// cannot be evaluated concurrently. Clones of a RooHistPdf holding a private copy
+/// receive a private copy as well. Nothing is done if the histogram is already
+/// owned.
+
+void RooHistPdf::cloneDataHist()
+{
+  if (_ownedDataHist || !_dataHist) return ;
+  _ownedDataHist = new RooDataHist(*_dataHist) ;
+  _dataHist = _ownedDataHist ;
 }
 
 
@@ -513,10 +536,9 @@ Double_t RooHistPdf::maxVal(Int_t code) const
   R__ASSERT(code==1) ;
 
   Double_t max(-1) ;
+  const Double_t* wgt = _dataHist->weightArray() ;
   for (Int_t i=0 ; i<_dataHist->numEntries() ; i++) {
-    _dataHist->get(i) ;
-    Double_t wgt = _dataHist->weight() ;
-    if (wgt>max) max=wgt ;
+    if (wgt[i]>max) max=wgt[i] ;
   }
 
   return max*1.05 ;
@@ -125,6 +125,10 @@ RooMinimizerFcn::~RooMinimizerFcn()
 
 ROOT::Math::IBaseFunctionMultiDim* RooMinimizerFcn::Clone() const 
 {  
+  // The clone evaluates the same function object and parameters as the original:
+  // it is not thread safe and must not be evaluated concurrently with it (Minuit2
+  // does not use clones in its threads unless the extra option "CloneFCN" is set)
+
   return new RooMinimizerFcn(*this) ;
 }
 
@@ -38,14 +38,33 @@
 #include "RooCmdConfig.h"
 #include "RooMsgService.h"
 #include "RooAbsDataStore.h"
+#include "RooVectorDataStore.h"
+#include "RooDataSet.h"
 #include "RooRealMPFE.h"
 #include "RooRealSumPdf.h"
 #include "RooRealVar.h"
 #include "RooProdPdf.h"
+#include "TClass.h"
+#include "TMethod.h"
 
 ClassImp(RooNLLVar)
 ;
 
+namespace {
+
+  // Return true if getLogVal() of the p.d.f is the one of RooAbsPdf, which calculates
+  // the logarithm of getVal(). The batch mode, which takes the logarithm of the values
+  // of getValBatch(), can only be used in this case.
+  Bool_t logValIsLogOfVal(const RooAbsReal* func)
+  {
+    const RooAbsPdf* pdf = dynamic_cast<const RooAbsPdf*>(func) ;
+    if (!pdf) return kFALSE ;
+    TMethod* method = pdf->IsA()->GetMethodWithPrototype("getLogVal","const RooArgSet*",kTRUE) ;
+    return method && method->GetClass()==RooAbsPdf::Class() ;
+  }
+
+}
+
 RooArgSet RooNLLVar::_emptySet ;
 
 
@@ -60,6 +79,7 @@ RooArgSet RooNLLVar::_emptySet ;
 ///  ConditionalObservables() -- Define conditional observables 
 ///  Verbose()      -- Verbose output of GOF framework classes
 ///  CloneData()    -- Clone input dataset for internal use (default is kTRUE)
+///  BatchMode()    -- Evaluate the p.d.f for blocks of events at once (see setBatchMode())
 
 RooNLLVar::RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbsData& indata,
 		     const RooCmdArg& arg1, const RooCmdArg& arg2,const RooCmdArg& arg3,
@@ -79,6 +99,7 @@ RooNLLVar::RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbs
   RooCmdConfig pc("RooNLLVar::RooNLLVar") ;
   pc.allowUndefined() ;
   pc.defineInt("extended","Extended",0,kFALSE) ;
+  pc.defineInt("batchMode","BatchMode",0,kFALSE) ;
 
   pc.process(arg1) ;  pc.process(arg2) ;  pc.process(arg3) ;
   pc.process(arg4) ;  pc.process(arg5) ;  pc.process(arg6) ;
@@ -86,6 +107,8 @@ RooNLLVar::RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbs
 
   _extended = pc.getInt("extended") ;
   _weightSq = kFALSE ;
+  _batchEvaluations = pc.getInt("batchMode") ;
+  _batchLogValOK = logValIsLogOfVal(_funcClone) ;
   _first = kTRUE ;
   _offset = 0.;
   _offsetCarry = 0.;
@@ -107,11 +130,13 @@ RooNLLVar::RooNLLVar(const char *name, const char *title, RooAbsPdf& pdf, RooAbs
   RooAbsOptTestStatistic(name,title,pdf,indata,RooArgSet(),rangeName,addCoefRangeName,nCPU,interleave,verbose,splitRange,cloneData),
   _extended(extended),
   _weightSq(kFALSE),
+  _batchEvaluations(kFALSE),
   _first(kTRUE), _offsetSaveW2(0.), _offsetCarrySaveW2(0.)
 {
   // If binned likelihood flag is set, pdf is a RooRealSumPdf representing a yield vector
   // for a binned likelihood calculation
   _binnedPdf = binnedL ? (RooRealSumPdf*)_funcClone : 0 ;
+  _batchLogValOK = logValIsLogOfVal(_funcClone) ;
 
   // Retrieve and cache bin widths needed to convert unnormalized binnedPdf values back to yields
   if (_binnedPdf) {
@@ -152,11 +177,13 @@ RooNLLVar::RooNLLVar(const char *name, const char *title, RooAbsPdf& pdf, RooAbs
   RooAbsOptTestStatistic(name,title,pdf,indata,projDeps,rangeName,addCoefRangeName,nCPU,interleave,verbose,splitRange,cloneData),
   _extended(extended),
   _weightSq(kFALSE),
+  _batchEvaluations(kFALSE),
   _first(kTRUE), _offsetSaveW2(0.), _offsetCarrySaveW2(0.)
 {
   // If binned likelihood flag is set, pdf is a RooRealSumPdf representing a yield vector
   // for a binned likelihood calculation
   _binnedPdf = binnedL ? (RooRealSumPdf*)_funcClone : 0 ;
+  _batchLogValOK = logValIsLogOfVal(_funcClone) ;
 
   // Retrieve and cache bin widths needed to convert unnormalized binnedPdf values back to yields
   if (_binnedPdf) {
@@ -191,9 +218,11 @@ RooNLLVar::RooNLLVar(const RooNLLVar& other, const char* name) :
   RooAbsOptTestStatistic(other,name),
   _extended(other._extended),
   _weightSq(other._weightSq),
+  _batchEvaluations(other._batchEvaluations),
   _first(kTRUE), _offsetSaveW2(other._offsetSaveW2),
   _offsetCarrySaveW2(other._offsetCarrySaveW2),
-  _binw(other._binw) {
+  _binw(other._binw),
+  _batchLogValOK(other._batchLogValOK) {
   _binnedPdf = other._binnedPdf ? (RooRealSumPdf*)_funcClone : 0 ;
 }
 
@@ -221,6 +250,10 @@ void RooNLLVar::applyWeightSquared(Bool_t flag)
       std::swap(_offsetCarry, _offsetCarrySaveW2);
     }
     setValueDirty();
+  } else if ( _gofOpMode==MPMaster && _mpThreads) {
+    for (Int_t i=0 ; i<_nCPU ; i++)
+      ((RooNLLVar*)_threadGofArray[i])->applyWeightSquared(flag);
+    setValueDirty();
   } else if ( _gofOpMode==MPMaster) {
     for (Int_t i=0 ; i<_nCPU ; i++)
       _mpfeArray[i]->applyNLLWeightSquared(flag);
@@ -232,6 +265,33 @@ void RooNLLVar::applyWeightSquared(Bool_t flag)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Activate or deactivate the batch evaluation of the p.d.f. In batch mode
+/// the p.d.f values of unbinned datasets are calculated for blocks of events
+/// at once with RooAbsReal::getValBatch(), which reads the observables from
+/// the columns of the vector data store instead of loading the events one
+/// by one. P.d.f.s without a batch implementation are still evaluated event
+/// by event and the likelihood value is the same as in the scalar mode.
+/// P.d.f.s which override RooAbsPdf::getLogVal() (e.g. RooHistConstraint)
+/// are always evaluated in the scalar mode.
+/// The mode must be set before the first evaluation of a likelihood
+/// that is calculated in parallel processes
+
+void RooNLLVar::setBatchMode(Bool_t flag) 
+{
+  _batchEvaluations = flag ;
+  if (_gofOpMode==SimMaster) {
+    for (Int_t i=0 ; i<_nGof ; i++)
+      ((RooNLLVar*)_gofArray[i])->setBatchMode(flag);
+  } else if (_gofOpMode==MPMaster && _threadGofArray) {
+    for (Int_t i=0 ; i<_nCPU ; i++)
+      ((RooNLLVar*)_threadGofArray[i])->setBatchMode(flag);
+  }
+  setValueDirty() ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Calculate and return likelihood on subset of data from firstEvent to lastEvent
 /// processed with a step size of 'stepSize'. If this an extended likelihood and
@@ -303,28 +363,41 @@ Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t s
 
   } else {
 
-    for (i=firstEvent ; i<lastEvent ; i+=stepSize) {
-            
-      _dataClone->get(i) ;
-      
-      if (!_dataClone->valid()) continue;
-      
-      Double_t eventWeight = _dataClone->weight();
-      if (0. == eventWeight * eventWeight) continue ;
-      if (_weightSq) eventWeight = _dataClone->weightSquared() ;
-      
-      Double_t term = -eventWeight * pdfClone->getLogVal(_normSet);
-      
-      
-      Double_t y = eventWeight - sumWeightCarry;
-      Double_t t = sumWeight + y;
-      sumWeightCarry = (t - sumWeight) - y;
-      sumWeight = t;
-      
-      y = term - carry;
-      t = result + y;
-      carry = (t - result) - y;
-      result = t;
+    // In batch mode unbinned datasets in vector stores are processed in blocks of events
+    const RooVectorDataStore* vstore(0) ;
+    if (_batchEvaluations && _batchLogValOK && stepSize==1 && dynamic_cast<RooDataSet*>(_dataClone)) {
+      vstore = dynamic_cast<const RooVectorDataStore*>(_dataClone->store()) ;
+    }
+
+    if (vstore) {
+
+      sumLogValBatch(*vstore,firstEvent,lastEvent,result,carry,sumWeight,sumWeightCarry) ;
+
+    } else {
+
+      for (i=firstEvent ; i<lastEvent ; i+=stepSize) {
+	
+	_dataClone->get(i) ;
+	
+	if (!_dataClone->valid()) continue;
+	
+	Double_t eventWeight = _dataClone->weight();
+	if (0. == eventWeight * eventWeight) continue ;
+	if (_weightSq) eventWeight = _dataClone->weightSquared() ;
+	
+	Double_t term = -eventWeight * pdfClone->getLogVal(_normSet);
+	
+	
+	Double_t y = eventWeight - sumWeightCarry;
+	Double_t t = sumWeight + y;
+	sumWeightCarry = (t - sumWeight) - y;
+	sumWeight = t;
+	
+	y = term - carry;
+	t = result + y;
+	carry = (t - result) - y;
+	result = t;
+      }
     }
     
     // include the extended maximum likelihood term, if requested
@@ -422,4 +495,58 @@ Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t s
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Batch mode equivalent of the event loop of evaluatePartition() for
+/// unbinned datasets: the p.d.f values of the events firstEvent..lastEvent-1
+/// are calculated in blocks with RooAbsReal::getValBatch() and the weighted
+/// logarithms are added to 'result' and the weights to 'sumWeight', with
+/// Kahan summation in the order of the events. Values for which getLogVal()
+/// reports a problem (zero, negative, NaN or very large values) are
+/// calculated again with getLogVal() so that the error logging is unchanged
+
+void RooNLLVar::sumLogValBatch(const RooVectorDataStore& store, Int_t firstEvent, Int_t lastEvent, Double_t& result, Double_t& carry,
+			       Double_t& sumWeight, Double_t& sumWeightCarry) const
+{
+  const Int_t blockSize(1024) ;
+
+  RooAbsPdf* pdfClone = (RooAbsPdf*) _funcClone ;
+  const Double_t* weights = store.weightColumn() ;
+  _batchValues.resize(blockSize) ;
+
+  for (Int_t first=firstEvent ; first<lastEvent ; first+=blockSize) {
+
+    Int_t n = std::min(blockSize,lastEvent-first) ;
+    pdfClone->getValBatch(&_batchValues[0],first,n,store,_normSet) ;
+
+    for (Int_t j=0 ; j<n ; j++) {
+
+      Double_t eventWeight = weights ? weights[first+j] : 1. ;
+      if (0. == eventWeight * eventWeight) continue ;
+      if (_weightSq) eventWeight = eventWeight * eventWeight ;
+
+      Double_t prob = _batchValues[j] ;
+      Double_t logVal ;
+      if (prob>0 && prob<=1e6) {
+	logVal = log(prob) ;
+      } else {
+	_dataClone->get(first+j) ;
+	logVal = pdfClone->getLogVal(_normSet) ;
+      }
+      Double_t term = -eventWeight * logVal ;
+
+      Double_t y = eventWeight - sumWeightCarry;
+      Double_t t = sumWeight + y;
+      sumWeightCarry = (t - sumWeight) - y;
+      sumWeight = t;
+
+      y = term - carry;
+      t = result + y;
+      carry = (t - result) - y;
+      result = t;
+    }
+  }
+}
+
+
+
 
@@ -63,6 +63,7 @@
 #include "RooCustomizer.h"
 #include "RooRealIntegral.h"
 #include "RooTrace.h"
+#include "RooVectorDataStore.h"
 
 #include <string.h>
 #include <sstream>
@@ -546,6 +547,67 @@ Double_t RooProdPdf::evaluate() const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of getValV(): the normalization set is also needed
+/// by evaluateBatch() to select the product terms
+
+Bool_t RooProdPdf::getValBatchV(Double_t* output, Int_t firstEvent, Int_t nEvents, const RooVectorDataStore& data, const RooArgSet* set) const
+{
+  _curNormSet = (RooArgSet*)set ;
+  return RooAbsPdf::getValBatchV(output,firstEvent,nEvents,data,set) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate() for a range of events of a vector data store.
+/// The product terms are obtained in batch mode and multiplied as in calculate(),
+/// rearranged products are not supported and return kFALSE
+
+Bool_t RooProdPdf::evaluateBatch(Double_t* output, Int_t firstEvent, Int_t nEvents, const RooVectorDataStore& data) const
+{
+  Int_t code ;
+  CacheElem* cache = (CacheElem*) _cacheMgr.getObj(_curNormSet,0,&code) ;
+  
+  // If cache doesn't have our configuration, recalculate here
+  if (!cache) {
+    RooArgList *plist(0) ;
+    RooLinkedList *nlist(0) ;
+    getPartIntList(_curNormSet,0,plist,nlist,code) ;
+    cache = (CacheElem*) _cacheMgr.getObj(_curNormSet,0,&code) ;
+  }
+
+  if (cache->_isRearranged) {
+    return kFALSE ;
+  }
+
+  std::vector<Double_t> piVals(nEvents) ;
+  RooAbsReal* partInt ;
+  RooArgSet* normSet ;
+  Int_t n = cache->_partList.getSize() ;
+  RooFIter plIter = cache->_partList.fwdIterator() ;
+  RooFIter nlIter = cache->_normList.fwdIterator() ;
+
+  for (Int_t j=0 ; j<nEvents ; j++) {
+    output[j] = 1.0 ;
+  }
+
+  for (Int_t i=0 ; i<n ; i++) {
+    partInt = (RooAbsReal*) plIter.next() ;
+    normSet = (RooArgSet*) nlIter.next() ;
+    partInt->getValBatch(&piVals[0],firstEvent,nEvents,data,normSet->getSize()>0 ? normSet : 0) ;
+
+    // Products that dropped below the cut-off are not multiplied further, as in calculate()
+    for (Int_t j=0 ; j<nEvents ; j++) {
+      output[j] = (i>0 && output[j]<=_cutOff) ? output[j] : output[j]*piVals[j] ;
+    }
+  }
+
+  return kTRUE ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Calculate running product of pdfs terms, using the supplied
 /// normalization set in 'normSetList' for each component
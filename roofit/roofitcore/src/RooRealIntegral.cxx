@@ -58,6 +58,9 @@ ClassImp(RooRealIntegral)
 
 
 Int_t RooRealIntegral::_cacheAllNDim(2) ;
+Int_t RooRealIntegral::_memoSize(4) ;
+std::atomic<Long64_t> RooRealIntegral::_nNumInt(0) ;
+std::atomic<Long64_t> RooRealIntegral::_nNumIntMemoHit(0) ;
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -777,6 +780,11 @@ RooRealIntegral::RooRealIntegral(const RooRealIntegral& other, const char* name)
 {
  _funcNormSet = other._funcNormSet ? (RooArgSet*)other._funcNormSet->snapshot(kFALSE) : 0 ;
 
+ // Use own copy of specialized integrator configuration set with setIntegratorConfig()
+ if (other._iconfig && other._iconfig==other.specialIntegratorConfig()) {
+   _iconfig = specialIntegratorConfig() ;
+ }
+
  other._facListIter->Reset() ;
  RooAbsArg* arg ;
  while((arg=(RooAbsArg*)other._facListIter->Next())) {
@@ -900,6 +908,9 @@ Double_t RooRealIntegral::evaluate() const
       if (cacheVal) {
 	retVal = *cacheVal ;
 	//	cout << "using cached value of integral" << GetName() << endl ;
+      } else if (findNumIntMemo(retVal)) {
+	// Reuse integral calculated earlier for the same parameter values
+	_nNumIntMemoHit++ ;
       } else {
 
 
@@ -929,6 +940,9 @@ Double_t RooRealIntegral::evaluate() const
 	_intList=_saveInt ;
 	_sumList=_saveSum ;
 
+	_nNumInt++ ;
+	storeNumIntMemo(retVal) ;
+
 	// Cache numeric integrals in >1d expensive object cache
 	if ((_cacheNum && _intList.getSize()>0) || _intList.getSize()>=_cacheAllNDim) {
 	  RooDouble* val = new RooDouble(retVal) ;
@@ -1090,6 +1104,8 @@ Bool_t RooRealIntegral::redirectServersHook(const RooAbsCollection& /*newServerL
     _params = 0 ;
   }
 
+  clearNumIntMemo() ;
+
   return kFALSE ;
 }
 
@@ -1225,3 +1241,135 @@ Int_t RooRealIntegral::getCacheAllNumeric()
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Global switch to memoize the last n numeric integrals of each integral
+/// object, with the values of the parameters and integration limits for
+/// which they were calculated. An integral is reused if these values
+/// match exactly, e.g. when MIGRAD returns to a parameter point after a
+/// gradient step. A value of 0 disables the memo (default is 4)
+
+void RooRealIntegral::setNumIntMemoSize(Int_t n) 
+{
+  _memoSize = n>0 ? n : 0 ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return number of numeric integrals memoized per integral object
+
+Int_t RooRealIntegral::getNumIntMemoSize() 
+{
+  return _memoSize ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reset the counters of numeric integral calculations and memo reuses
+
+void RooRealIntegral::resetNumIntCounters() 
+{
+  _nNumInt = 0 ;
+  _nNumIntMemoHit = 0 ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Look up the numeric integral for the current values of the parameters
+/// and integration limits in the memo. Returns true and the integral in
+/// 'value' if found. The lookup key is kept for storeNumIntMemo()
+
+Bool_t RooRealIntegral::findNumIntMemo(Double_t& value) const
+{
+  if (_memoSize==0) return kFALSE ;
+
+  _memoCurKey.clear() ;
+  RooFIter piter = parameters().fwdIterator() ;
+  RooAbsArg* par ;
+  while((par=piter.next())) {
+    RooAbsReal* rpar = dynamic_cast<RooAbsReal*>(par) ;
+    RooAbsCategory* cpar = dynamic_cast<RooAbsCategory*>(par) ;
+    if (rpar) {
+      _memoCurKey.push_back(rpar->getVal()) ;
+    } else if (cpar) {
+      _memoCurKey.push_back(cpar->getIndex()) ;
+    }
+  }
+  RooFIter iiter = _intList.fwdIterator() ;
+  RooAbsArg* obs ;
+  while((obs=iiter.next())) {
+    RooAbsRealLValue* lv = dynamic_cast<RooAbsRealLValue*>(obs) ;
+    if (lv) {
+      _memoCurKey.push_back(lv->getMin(RooNameReg::str(_rangeName))) ;
+      _memoCurKey.push_back(lv->getMax(RooNameReg::str(_rangeName))) ;
+    }
+  }
+
+  for (UInt_t i=0 ; i<_memoKey.size() ; i++) {
+    if (_memoKey[i]==_memoCurKey) {
+      value = _memoVal[i] ;
+      return kTRUE ;
+    }
+  }
+  return kFALSE ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store numeric integral 'value' in the memo under the key of the last
+/// call to findNumIntMemo(), replacing the oldest entry if the memo is full
+
+void RooRealIntegral::storeNumIntMemo(Double_t value) const
+{
+  if (_memoSize==0) {
+    clearNumIntMemo() ;
+    return ;
+  }
+
+  while (_memoKey.size()>=(UInt_t)_memoSize) {
+    _memoKey.erase(_memoKey.begin()) ;
+    _memoVal.erase(_memoVal.begin()) ;
+  }
+  _memoKey.push_back(_memoCurKey) ;
+  _memoVal.push_back(value) ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Clear the memoized numeric integrals
+
+void RooRealIntegral::clearNumIntMemo() const
+{
+  _memoKey.clear() ;
+  _memoVal.clear() ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Use the given numeric integration configuration for this integral instead
+/// of the one it was created with. The numeric integration engine is recreated
+/// and the integrals memoized with the previous configuration are cleared
+
+void RooRealIntegral::setIntegratorConfig(const RooNumIntConfig& config)
+{
+  RooAbsReal::setIntegratorConfig(config) ;
+  _iconfig = specialIntegratorConfig() ;
+  _restartNumIntEngine = kTRUE ;
+  clearNumIntMemo() ;
+  setValueDirty() ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove the specialized numeric integration configuration of this integral
+/// and use that of the integrand. The numeric integration engine is recreated
+/// and the integrals memoized with the previous configuration are cleared
+
+void RooRealIntegral::setIntegratorConfig()
+{
+  RooAbsReal::setIntegratorConfig() ;
+  _iconfig = (RooNumIntConfig*) _function.arg().getIntegratorConfig() ;
+  _restartNumIntEngine = kTRUE ;
+  clearNumIntMemo() ;
+  setValueDirty() ;
+}
+
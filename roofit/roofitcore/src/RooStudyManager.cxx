@@ -41,6 +41,17 @@
 #include <string>
 #include "TROOT.h"
 #include "TSystem.h"
+#include "TRandom.h"
+#include "TMath.h"
+#include "RooRandom.h"
+#include <vector>
+#include <cstdio>
+#include <cctype>
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
 
 using namespace std ;
 
@@ -98,6 +109,98 @@ void RooStudyManager::run(Int_t nExperiments)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Run nExperiments in nWorkers processes forked on the local host. Each
+/// worker runs its share of the experiments on its own copy of the workspace
+/// and of the studies, with a random seed drawn from RooRandom::randomGenerator()
+/// of the master process, so that the results for a given master seed are
+/// reproducible. The summary and detailed output of the workers is aggregated
+/// in the studies of this manager, as with runProof() and processBatchOutput()
+
+void RooStudyManager::runParallel(Int_t nExperiments, Int_t nWorkers) 
+{
+#ifdef _WIN32
+  coutW(Generation) << "RooStudyManager::runParallel(" << GetName() << ") WARNING: parallel running is not supported on Windows, running "
+		    << nExperiments << " experiments in this process" << endl ;
+  run(nExperiments) ;
+#else
+  if (nWorkers>nExperiments) nWorkers = nExperiments ;
+  if (nWorkers<2) {
+    run(nExperiments) ;
+    return ;
+  }
+
+  // Draw the random seeds of the workers
+  vector<UInt_t> seeds(nWorkers) ;
+  for (Int_t i=0 ; i<nWorkers ; i++) {
+    seeds[i] = RooRandom::integer(TMath::Limits<Int_t>::Max()) ;
+  }
+
+  // Only use the characters of the name that are safe in a file name
+  TString name(GetName()) ;
+  for (Ssiz_t j=0 ; j<name.Length() ; j++) {
+    if (!isalnum((unsigned char)name[j]) && name[j]!='_' && name[j]!='-') name[j] = '_' ;
+  }
+  TString prefix = Form("%s/study_result_%s_%d",gSystem->TempDirectory(),name.Data(),gSystem->GetPid()) ;
+
+  coutP(Generation) << "RooStudyManager::runParallel(" << GetName() << ") starting " << nExperiments << " experiments in " 
+		    << nWorkers << " worker processes" << endl ;
+
+  // Flush output buffers so that they are not written again by the workers
+  cout.flush() ;
+  fflush(stdout) ;
+
+  vector<pid_t> pids(nWorkers,-1) ;
+  for (Int_t i=0 ; i<nWorkers ; i++) {
+    Int_t nexp = nExperiments/nWorkers + (i<nExperiments%nWorkers ? 1 : 0) ;
+    pid_t pid = fork() ;
+    if (pid==0) {
+
+      // Worker process: run experiments and save results. The worker must never
+      // return into the code of the master process, also not by an exception
+      try {
+	RooRandom::randomGenerator()->SetSeed(seeds[i]) ;
+	gRandom->SetSeed(seeds[i]) ;
+	_pkg->driver(nexp) ;
+
+	TList res ;
+	_pkg->exportData(&res,i) ;
+	TFile fout(Form("%s_%d.root",prefix.Data(),i),"RECREATE") ;
+	if (fout.IsZombie()) _exit(1) ;
+	res.Write() ;
+	fout.Close() ;
+	cout.flush() ;
+      } catch (...) {
+	_exit(1) ;
+      }
+      _exit(0) ;
+
+    } else if (pid<0) {
+      coutE(Generation) << "RooStudyManager::runParallel(" << GetName() << ") ERROR: cannot fork worker process " << i 
+			<< ", its " << nexp << " experiments are not run" << endl ;
+    }
+    pids[i] = pid ;
+  }
+
+  // Wait for the workers and aggregate their results
+  for (Int_t i=0 ; i<nWorkers ; i++) {
+    if (pids[i]<0) continue ;
+    int status(0) ;
+    waitpid(pids[i],&status,0) ;
+    string fname = Form("%s_%d.root",prefix.Data(),i) ;
+    if (!WIFEXITED(status) || WEXITSTATUS(status)!=0 || gSystem->AccessPathName(fname.c_str())) {
+      coutE(Generation) << "RooStudyManager::runParallel(" << GetName() << ") ERROR: worker process " << i 
+			<< " failed, its results are not included" << endl ;
+      continue ;
+    }
+    processBatchOutput(fname.c_str()) ;
+    gSystem->Unlink(fname.c_str()) ;
+  }
+#endif
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Open PROOF-Lite session
 
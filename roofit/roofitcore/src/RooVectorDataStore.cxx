@@ -1300,19 +1300,19 @@ void RooVectorDataStore::recalculateCache( const RooArgSet *projectedArgs, Int_t
 {
   if (!_cache) return ;
 
-  pRealVector tv[1000] ;
-  Int_t ntv(0) ;
-
-  // Check which items need recalculation
+  // Check which items need recalculation (the number of tracked items is not bounded)
+  vector<pRealVector> tv ;
+  tv.reserve(_cache->_nReal) ;
   for (Int_t i=0 ; i<_cache->_nReal ; i++) {
     if ((*(_cache->_firstReal+i))->needRecalc() || _forcedUpdate) {
-      tv[ntv] = (*(_cache->_firstReal+i)) ;
-      tv[ntv]->_nativeReal->setOperMode(RooAbsArg::ADirty) ;
-      tv[ntv]->_nativeReal->_operMode=RooAbsArg::Auto ;
-//       cout << "recalculate: need to update " << tv[ntv]->_nativeReal->GetName() << endl ;
-      ntv++ ;
+      pRealVector rv = (*(_cache->_firstReal+i)) ;
+      rv->_nativeReal->setOperMode(RooAbsArg::ADirty) ;
+      rv->_nativeReal->_operMode=RooAbsArg::Auto ;
+//       cout << "recalculate: need to update " << rv->_nativeReal->GetName() << endl ;
+      tv.push_back(rv) ;
     }    
   }
+  const Int_t ntv = tv.size() ;
   _forcedUpdate = kFALSE ;
 
   // If no recalculations are neede stop here
@@ -1427,6 +1427,69 @@ void RooVectorDataStore::resetCache()
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return a pointer to the first element of the column holding the values
+/// of the given real-valued object, if its buffer is attached to this
+/// store or to its optimization cache, and zero otherwise. The values of the
+/// event i are found at index i of the returned array, so that functions
+/// can be evaluated on ranges of events without loading them one by one
+
+const Double_t* RooVectorDataStore::realColumn(const RooAbsReal& real) const
+{
+  std::vector<RealVector*>::const_iterator iter = _realStoreList.begin() ;
+  for (; iter!=_realStoreList.end() ; ++iter) {
+    if ((*iter)->_real==&real) {
+      return (*iter)->_vec0 ;
+    }
+  }
+
+  std::vector<RealFullVector*>::const_iterator fiter = _realfStoreList.begin() ;
+  for (; fiter!=_realfStoreList.end() ; ++fiter) {
+    if ((*fiter)->_real==&real) {
+      return (*fiter)->_vec0 ;
+    }
+  }
+
+  if (_cache) {
+    return _cache->realColumn(real) ;
+  }
+
+  return 0 ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a pointer to the first element of the array of event weights,
+/// from the external weight array or from the column of the weight variable.
+/// Zero is returned if the events are not weighted (all weights are 1)
+
+const Double_t* RooVectorDataStore::weightColumn() const
+{
+  if (_extWgtArray) {
+    return _extWgtArray ;
+  }
+
+  if (_wgtVar) {
+    std::vector<RealVector*>::const_iterator iter = _realStoreList.begin() ;
+    for (; iter!=_realStoreList.end() ; ++iter) {
+      if ((*iter)->bufArg()->namePtr()==_wgtVar->namePtr()) {
+	return (*iter)->_vec0 ;
+      }
+    }
+    std::vector<RealFullVector*>::const_iterator fiter = _realfStoreList.begin() ;
+    for (; fiter!=_realfStoreList.end() ; ++fiter) {
+      if ((*fiter)->bufArg()->namePtr()==_wgtVar->namePtr()) {
+	return (*fiter)->_vec0 ;
+      }
+    }
+  }
+
+  return 0 ;
+}
+
+
+
 
 
 ////////////////////////////////////////////////////////////////////////////////
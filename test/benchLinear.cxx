@@ -0,0 +1,195 @@
+// @(#)root/test:$Id$
+
+/////////////////////////////////////////////////////////////////
+//
+//    B E N C H M A R K  of the dense matrix kernels
+//    ==============================================
+//
+// Times the products of dense matrices (A*B, A^T*B, A*B^T and A^T*A)
+// and the LU and Cholesky decompositions for increasing matrix sizes,
+// with 1 thread and with gMatrixNThreads threads, and compares them
+// with the simple (unblocked) loops used before the blocked kernels.
+// The results must be identical, independently of the blocking and of
+// the number of threads. When libMatrix is compiled with the cblas option
+// (and this benchmark with -DCBLAS) the large products are computed by the
+// CBLAS library, which sums in its own order: these results are only
+// required to agree within rounding errors.
+// The threads are only used when libMatrix is compiled with OpenMP.
+//
+// To run in batch, do
+//   benchLinear         : matrices up to 1000x1000, all available threads
+//   benchLinear 2000 8  : matrices up to 2000x2000, 8 threads
+//
+/////////////////////////////////////////////////////////////////
+
+#include "TMatrixD.h"
+#include "TMatrixDSym.h"
+#include "TDecompLU.h"
+#include "TDecompChol.h"
+#include "TRandom3.h"
+#include "TMath.h"
+#include "TStopwatch.h"
+#include "TError.h"
+#include "Riostream.h"
+#include <cstdio>
+#include <cstdlib>
+
+//------------------------------------------------------------------------
+// Reference: simple loop for C = A * B
+
+void RefMult(const TMatrixD &a,const TMatrixD &b,TMatrixD &c)
+{
+   const Int_t ni = a.GetNrows();
+   const Int_t nk = a.GetNcols();
+   const Int_t nj = b.GetNcols();
+   const Double_t *ap = a.GetMatrixArray();
+   const Double_t *bp = b.GetMatrixArray();
+         Double_t *cp = c.GetMatrixArray();
+   for (Int_t i = 0; i < ni; i++) {
+      for (Int_t j = 0; j < nj; j++) {
+         Double_t cij = 0;
+         for (Int_t k = 0; k < nk; k++)
+            cij += ap[i*nk+k]*bp[k*nj+j];
+         cp[i*nj+j] = cij;
+      }
+   }
+}
+
+//------------------------------------------------------------------------
+// Reference: unblocked Cholesky decomposition of a positive definite matrix
+// (upper triangle U with A = U^T * U)
+
+void RefChol(TMatrixD &u)
+{
+   const Int_t n = u.GetNrows();
+   Double_t *pU = u.GetMatrixArray();
+   for (Int_t icol = 0; icol < n; icol++) {
+      const Int_t rowOff = icol*n;
+      Double_t ujj = pU[rowOff+icol];
+      for (Int_t irow = 0; irow < icol; irow++)
+         ujj -= pU[irow*n+icol]*pU[irow*n+icol];
+      ujj = TMath::Sqrt(ujj);
+      pU[rowOff+icol] = ujj;
+      for (Int_t j = icol+1; j < n; j++) {
+         for (Int_t i = 0; i < icol; i++)
+            pU[rowOff+j] -= pU[i*n+j]*pU[i*n+icol];
+         pU[rowOff+j] /= ujj;
+      }
+   }
+   for (Int_t irow = 0; irow < n; irow++)
+      for (Int_t icol = 0; icol < irow; icol++)
+         pU[irow*n+icol] = 0.;
+}
+
+//------------------------------------------------------------------------
+Bool_t Identical(const TMatrixD &m1,const TMatrixD &m2)
+{
+   const Int_t n = m1.GetNoElements();
+   const Double_t *p1 = m1.GetMatrixArray();
+   const Double_t *p2 = m2.GetMatrixArray();
+   for (Int_t i = 0; i < n; i++)
+      if (p1[i] != p2[i]) return kFALSE;
+   return kTRUE;
+}
+
+//------------------------------------------------------------------------
+Bool_t Close(const TMatrixD &m1,const TMatrixD &m2)
+{
+   const Int_t n = m1.GetNoElements();
+   const Double_t *p1 = m1.GetMatrixArray();
+   const Double_t *p2 = m2.GetMatrixArray();
+   const Double_t tol = 1e-12*m1.NormInf();
+   for (Int_t i = 0; i < n; i++)
+      if (TMath::Abs(p1[i]-p2[i]) > tol) return kFALSE;
+   return kTRUE;
+}
+
+//------------------------------------------------------------------------
+Bool_t SameResult(Int_t iop,const TMatrixD &m1,const TMatrixD &m2)
+{
+#ifdef CBLAS
+   // the products (not the decompositions) are delegated to CBLAS
+   if (iop <= 3) return Close(m1,m2);
+#else
+   (void) iop;
+#endif
+   return Identical(m1,m2);
+}
+
+//------------------------------------------------------------------------
+Int_t benchLinear(Int_t maxSize = 1000,Int_t nThreads = 0)
+{
+   const Int_t nSizes = 5;
+   const Int_t sizes[nSizes] = { 100, 200, 500, 1000, 2000 };
+
+   TRandom3 r(4357);
+   TStopwatch w;
+   Int_t nFail = 0;
+
+   printf("\nCPU/real time in seconds (real time for the threads)\n");
+   printf("  size  operation     reference  blocked(1)  blocked(%d)\n",nThreads);
+   for (Int_t is = 0; is < nSizes && sizes[is] <= maxSize; is++) {
+      const Int_t n = sizes[is];
+      TMatrixD a(n,n), b(n,n);
+      for (Int_t i = 0; i < n; i++) {
+         for (Int_t j = 0; j < n; j++) {
+            a(i,j) = r.Uniform(-1,1);
+            b(i,j) = r.Uniform(-1,1);
+         }
+      }
+      // positive definite matrix for the Cholesky decomposition
+      TMatrixDSym spd(TMatrixDSym::kAtA,a);
+      for (Int_t i = 0; i < n; i++) spd(i,i) += n;
+
+      for (Int_t iop = 0; iop < 6; iop++) {
+         const char *names[6] = { "A*B", "A^T*B", "A*B^T", "A^T*A", "LU", "Cholesky" };
+         printf("%6d  %-12s",n,names[iop]);
+
+         TMatrixD ref(n,n);
+         if (iop == 0) {
+            w.Start(); RefMult(a,b,ref); w.Stop();
+            printf("  %10.3f",w.CpuTime());
+         } else if (iop == 5) {
+            ref = spd;
+            w.Start(); RefChol(ref); w.Stop();
+            printf("  %10.3f",w.CpuTime());
+         } else
+            printf("  %10s","-");
+
+         TMatrixD res[2];
+         for (Int_t it = 0; it < 2; it++) {
+            gMatrixNThreads = (it == 0) ? 1 : nThreads;
+            w.Start();
+            switch (iop) {
+               case 0: res[it].ResizeTo(n,n); res[it].Mult(a,b); break;
+               case 1: res[it].ResizeTo(n,n); res[it].TMult(a,b); break;
+               case 2: res[it].ResizeTo(n,n); res[it].MultT(a,b); break;
+               case 3: res[it].ResizeTo(n,n); res[it] = TMatrixDSym(TMatrixDSym::kAtA,a); break;
+               case 4: { TDecompLU lu(a); lu.Decompose(); res[it].ResizeTo(n,n); res[it] = lu.GetLU(); break; }
+               case 5: { TDecompChol ch(spd); ch.Decompose(); res[it].ResizeTo(n,n); res[it] = ch.GetU(); break; }
+            }
+            w.Stop();
+            printf("  %10.3f",(it == 0) ? w.CpuTime() : w.RealTime());
+         }
+         printf("\n");
+
+         if (!SameResult(iop,res[0],res[1]) || ((iop == 0 || iop == 5) && !SameResult(iop,res[0],ref))) {
+            Error("benchLinear","%s of a %dx%d matrix: results differ",names[iop],n,n);
+            nFail++;
+         }
+      }
+   }
+   gMatrixNThreads = 1;
+
+   if (nFail) std::cout << "benchLinear: Test FAILED !" << std::endl;
+   return nFail;
+}
+
+#ifndef __CINT__
+int main(int argc,char **argv)
+{
+   Int_t maxSize  = (argc > 1) ? atoi(argv[1]) : 1000;
+   Int_t nThreads = (argc > 2) ? atoi(argv[2]) : 0;
+   return benchLinear(maxSize,nThreads);
+}
+#endif
@@ -51,7 +51,8 @@
 // Test 18: Extend axis tests for Histograms.................................OK
 // Test 19: TH1-THn[Sparse] Conversion tests.................................OK
 // Test 20: FillData tests for Histograms and Sparses........................OK
-// Test 21: Reference File Read for Histograms and Profiles..................OK
+// Test 21: TUnfold, TEfficiency and TKDE tests..............................OK
+// Test 22: Reference File Read for Histograms and Profiles..................OK
 // ****************************************************************************
 // stressHistogram: Real Time =  86.22 seconds Cpu Time =  85.64 seconds
 //  ROOTMARKS = 1292.62 ROOT version: 6.05/01      remotes/origin/master@v6-05-01-336-g5c3d5ff
@@ -61,10 +62,17 @@
 
 
 #include <sstream>
+#include <vector>
 #include <cmath>
 
 #include "TH2.h"
 #include "TH3.h"
+#include "TH1K.h"
+#include "TGraph2D.h"
+#include "TUnfold.h"
+#include "TEfficiency.h"
+#include "TKDE.h"
+#include "TMatrixD.h"
 #include "TH2.h"
 #include "THn.h"
 #include "THnSparse.h"
@@ -5738,6 +5746,141 @@ bool testMerge1DMixedLimits() {
    return testMerge1DWithBuffer(false);
 }
 
+bool testMerge1DSameBinningFloat()
+{
+   // Tests the merge of float histograms with the same binning and weights
+   // (array-wise fast path), including the sum of weights squared
+
+   TH1F* h1 = new TH1F("merge1DF-h1", "h1-Title", numberOfBins, minRange, maxRange);
+   TH1F* h2 = new TH1F("merge1DF-h2", "h2-Title", numberOfBins, minRange, maxRange);
+   TH1F* h3 = new TH1F("merge1DF-h3", "h3-Title", numberOfBins, minRange, maxRange);
+   TH1D* h4 = new TH1D("merge1DF-h4", "h4-Title", numberOfBins, minRange, maxRange);
+
+   h1->Sumw2();h2->Sumw2();h3->Sumw2();h4->Sumw2();
+
+   TH1F* hists[3] = { h1, h2, h3 };
+   for ( Int_t i = 0; i < 3; ++i ) {
+      for ( Int_t e = 0; e < nEvents; ++e ) {
+         Double_t value = r.Uniform( 0.9 * minRange, 1.1 * maxRange);
+         Double_t weight = std::exp(r.Gaus(0,1));
+         hists[i]->Fill(value, weight);
+         h4->Fill(value, weight);
+      }
+   }
+
+   TList *list = new TList;
+   list->Add(h2);
+   list->Add(h3);
+
+   h1->Merge(list);
+
+   int differents = 0;
+   for ( Int_t bin = 0; bin <= h1->GetNbinsX() + 1; ++bin ) {
+      differents += equals(h1->GetBinContent(bin), h4->GetBinContent(bin), 1E-5);
+      differents += equals(h1->GetBinError(bin), h4->GetBinError(bin), 1E-5);
+   }
+   differents += equals(h1->GetEntries(), h4->GetEntries(), 1E-10);
+   differents += equals(h1->GetMean(), h4->GetMean(), 1E-6);
+   differents += equals(h1->GetRMS(), h4->GetRMS(), 1E-6);
+   if ( defaultEqualOptions & cmpOptPrint )
+      std::cout << "Merge1DSameBinningFloat: \t" << (differents?"FAILED":"OK") << std::endl;
+
+   delete h1;
+   delete h2;
+   delete h3;
+   delete h4;
+   return differents;
+}
+
+bool testMerge1DSameBinningNoSumw2()
+{
+   // Tests the merge of histograms with the same binning when the target
+   // has Sumw2 but one of the inputs does not (generic merge must be used)
+
+   TH1D* h1 = new TH1D("merge1DNoW2-h1", "h1-Title", numberOfBins, minRange, maxRange);
+   TH1D* h2 = new TH1D("merge1DNoW2-h2", "h2-Title", numberOfBins, minRange, maxRange);
+   TH1D* h3 = new TH1D("merge1DNoW2-h3", "h3-Title", numberOfBins, minRange, maxRange);
+   TH1D* h4 = new TH1D("merge1DNoW2-h4", "h4-Title", numberOfBins, minRange, maxRange);
+
+   h1->Sumw2();h2->Sumw2();h4->Sumw2();
+
+   FillHistograms(h1, h4);
+   FillHistograms(h2, h4);
+   FillHistograms(h3, h4);
+
+   TList *list = new TList;
+   list->Add(h2);
+   list->Add(h3);
+
+   h1->Merge(list);
+
+   bool ret = equals("Merge1DSameBinningNoSumw2", h1, h4, cmpOptStats, 1E-10);
+   delete h1;
+   delete h2;
+   delete h3;
+   return ret;
+}
+
+bool testMerge1DSameRangeDiffBins()
+{
+   // Tests the merge of histograms with the same range but a different
+   // number of bins (binning is not identical, generic merge must be used)
+
+   TH1D* h1 = new TH1D("merge1DDiffBins-h1", "h1-Title", numberOfBins, minRange, maxRange);
+   TH1D* h2 = new TH1D("merge1DDiffBins-h2", "h2-Title", 2*numberOfBins, minRange, maxRange);
+   TH1D* h4 = new TH1D("merge1DDiffBins-h4", "h4-Title", numberOfBins, minRange, maxRange);
+
+   h1->Sumw2();h2->Sumw2();h4->Sumw2();
+
+   FillHistograms(h1, h4);
+   FillHistograms(h2, h4);
+
+   TList *list = new TList;
+   list->Add(h2);
+
+   h1->Merge(list);
+
+   bool ret = equals("Merge1DSameRangeDiffBins", h1, h4, cmpOptStats, 1E-10);
+   delete h1;
+   delete h2;
+   return ret;
+}
+
+bool testMerge1DTH1K()
+{
+   // Tests that the merge of TH1K does not add the arrays of stored points
+   // as if they were bin contents
+
+   const Int_t nPoints = 50;
+   TH1K* h1 = new TH1K("merge1DK-h1", "h1-Title", numberOfBins, minRange, maxRange);
+   TH1K* h2 = new TH1K("merge1DK-h2", "h2-Title", numberOfBins, minRange, maxRange);
+
+   for ( Int_t e = 0; e < nPoints; ++e ) {
+      h1->Fill(r.Uniform(minRange, maxRange));
+      h2->Fill(r.Uniform(minRange, maxRange));
+   }
+   std::vector<Float_t> points(h1->GetArray(), h1->GetArray() + nPoints);
+
+   TList *list = new TList;
+   list->Add(h2);
+
+   // TH1K does not implement AddBinContent: silence the warnings of the generic merge
+   int precLevel = gErrorIgnoreLevel;
+   gErrorIgnoreLevel = kError;
+   h1->Merge(list);
+   gErrorIgnoreLevel = precLevel;
+
+   int differents = 0;
+   for ( Int_t i = 0; i < nPoints; ++i )
+      differents += (h1->GetArray()[i] != points[i]);
+   if ( defaultEqualOptions & cmpOptPrint )
+      std::cout << "Merge1DTH1K: \t" << (differents?"FAILED":"OK") << std::endl;
+
+   delete h1;
+   delete h2;
+   return differents;
+}
+
 
 
 bool testLabel()
@@ -6024,6 +6167,99 @@ bool testInterpolation2D()
    return status;
 }
 
+bool checkGraph2DInterpolation(TGraph2D* g, Double_t a, Double_t b, Double_t c, Double_t xmax, Double_t ymax)
+{
+   // Compares the Delaunay interpolation of g with the plane a*x+b*y+c inside [minRange,xmax]x[minRange,ymax]
+
+   bool status = false;
+   for (int itest = 0; itest < 1000; ++itest) {
+      double xp = r.Uniform( minRange + 0.01, xmax - 0.01 );
+      double yp = r.Uniform( minRange + 0.01, ymax - 0.01 );
+      double ip = g->Interpolate(xp, yp);
+      double fp = a * xp + b * yp + c;
+      if ( fabs(ip - fp) > 1.E-9 * (1 + fabs(fp)) ) {
+         status = true;
+         std::cout << "x: " << xp << " y: " << yp
+                   << " g->Interpolate: " << ip
+                   << " function: " << fp << std::endl;
+         break;
+      }
+   }
+   return status;
+}
+
+bool testInterpolationGraph2D()
+{
+   // Tests the Delaunay interpolation of a 2D graph of a plane, after the
+   // points have been changed and added with SetPoint
+
+   bool status = false;
+   const Double_t a = -2.1, b = 0.6;
+   const Double_t mid = (minRange + maxRange) / 2;
+
+   // points in the lower left quarter of the range, with its corners
+   TGraph2D* g = new TGraph2D();
+   g->SetDirectory(0);
+   Double_t cx[4] = { minRange, mid, minRange, mid };
+   Double_t cy[4] = { minRange, minRange, mid, mid };
+   int n = 0;
+   for ( int i = 0; i < 4; ++i, ++n ) g->SetPoint(n, cx[i], cy[i], a * cx[i] + b * cy[i]);
+   for ( int i = 0; i < 200; ++i, ++n ) {
+      Double_t x = r.Uniform(minRange, mid);
+      Double_t y = r.Uniform(minRange, mid);
+      g->SetPoint(n, x, y, a * x + b * y);
+   }
+   status |= checkGraph2DInterpolation(g, a, b, 0, mid, mid);
+
+   // the painter books the empty histogram, whose triangles are then reused
+   g->GetHistogram("empty");
+
+   // change all the points to another plane and extend them to the full range
+   for ( int i = 0; i < n; ++i ) g->SetPoint(i, g->GetX()[i], g->GetY()[i], 2 * (a * g->GetX()[i] + b * g->GetY()[i]) + 1);
+   Double_t ex[3] = { maxRange, minRange, maxRange };
+   Double_t ey[3] = { minRange, maxRange, maxRange };
+   for ( int i = 0; i < 3; ++i, ++n ) g->SetPoint(n, ex[i], ey[i], 2 * (a * ex[i] + b * ey[i]) + 1);
+   for ( int i = 0; i < 2000; ++i, ++n ) {
+      Double_t x = r.Uniform(minRange, maxRange);
+      Double_t y = r.Uniform(minRange, maxRange);
+      g->SetPoint(n, x, y, 2 * (a * x + b * y) + 1);
+   }
+   status |= checkGraph2DInterpolation(g, 2 * a, 2 * b, 1, maxRange, maxRange);
+   delete g;
+
+   // 1e5 points interpolated on a 500x500 histogram
+   const int nLarge = 100000;
+   TGraph2D* gl = new TGraph2D(nLarge + 4);
+   gl->SetDirectory(0);
+   Double_t lx[4] = { minRange, maxRange, minRange, maxRange };
+   Double_t ly[4] = { minRange, minRange, maxRange, maxRange };
+   for ( int i = 0; i < 4; ++i ) gl->SetPoint(i, lx[i], ly[i], a * lx[i] + b * ly[i]);
+   for ( int i = 4; i < nLarge + 4; ++i ) {
+      Double_t x = r.Uniform(minRange, maxRange);
+      Double_t y = r.Uniform(minRange, maxRange);
+      gl->SetPoint(i, x, y, a * x + b * y);
+   }
+   gl->SetNpx(500);
+   gl->SetNpy(500);
+   TH2D* h = gl->GetHistogram();
+   for ( int i = 1; i <= h->GetNbinsX() && !status; ++i ) {
+      for ( int j = 1; j <= h->GetNbinsY(); ++j ) {
+         Double_t x = h->GetXaxis()->GetBinCenter(i);
+         Double_t y = h->GetYaxis()->GetBinCenter(j);
+         if ( fabs(h->GetBinContent(i, j) - (a * x + b * y)) > 1.E-9 * (1 + fabs(a * x + b * y)) ) {
+            std::cout << "bin (" << i << "," << j << ") of the 500x500 histogram: " << h->GetBinContent(i, j)
+                      << " function: " << a * x + b * y << std::endl;
+            status = true;
+            break;
+         }
+      }
+   }
+   delete gl;
+
+   if ( defaultEqualOptions & cmpOptPrint ) std::cout << "testInterpolationGraph2D: \t" << (status?"FAILED":"OK") << std::endl;
+   return status;
+}
+
 Double_t function3D(Double_t x, Double_t y, Double_t z)
 {
 
@@ -7614,6 +7850,248 @@ bool testBinDataData3DInt()
    return status;
 }
 
+// TUnfold giving access to the matrices of the unfolding
+class TUnfoldTest : public TUnfold
+{
+public:
+   TUnfoldTest(const TH2* hA) : TUnfold(hA, kHistMapOutputHoriz, kRegModeCurvature, kEConstraintNone) {}
+
+   // Largest difference of the result with the solution of the normal equations
+   // calculated with dense matrices, relative to the largest element of the result
+   Double_t DenseDifference() const
+   {
+      TMatrixD a(*fA);
+      TMatrixD l(*fL);
+      TMatrixD vyyInv(*GetVyyInv());
+      TMatrixD atVyyInv(a, TMatrixD::kTransposeMult, vyyInv);
+      TMatrixD eInv(atVyyInv, TMatrixD::kMult, a);
+      TMatrixD lSquared(l, TMatrixD::kTransposeMult, l);
+      eInv += fTauSquared * lSquared;
+      TMatrixD rhs(atVyyInv, TMatrixD::kMult, *fY);
+      TMatrixD x(eInv.Invert(), TMatrixD::kMult, rhs);
+      Double_t diff = 0, norm = 0;
+      for ( Int_t i = 0; i < x.GetNrows(); ++i ) {
+         diff = TMath::Max(diff, TMath::Abs(x(i,0) - (*GetX())(i,0)));
+         norm = TMath::Max(norm, TMath::Abs(x(i,0)));
+      }
+      return diff / norm;
+   }
+
+   // True if the results of both unfoldings are identical
+   Bool_t SameResult(const TUnfoldTest& other) const
+   {
+      for ( Int_t i = 0; i < GetX()->GetNrows(); ++i )
+         if ( (*GetX())(i,0) != (*other.GetX())(i,0) ) return kFALSE;
+      return kTRUE;
+   }
+};
+
+bool testTUnfold()
+{
+   // Unfolding of a small problem compared with the calculation with dense
+   // matrices, and a scan of tau and a new input reusing the products kept
+   // between the calls compared with a new unfolding
+
+   const int nGen = 6;
+   const int nRec = 12;
+   TH2D* hA = new TH2D("tunfoldA", "response", nGen, minRange, maxRange, nRec, minRange, maxRange);
+   for ( int i = 1; i <= nGen; ++i ) {
+      Double_t xGen = hA->GetXaxis()->GetBinCenter(i);
+      for ( int j = 1; j <= nRec; ++j ) {
+         Double_t xRec = hA->GetYaxis()->GetBinCenter(j);
+         hA->SetBinContent(i, j, 100 * TMath::Exp(-0.5 * TMath::Power((xRec - xGen) / 0.5, 2)));
+      }
+   }
+
+   TH1D* hY[2];
+   for ( int k = 0; k < 2; ++k ) {
+      hY[k] = new TH1D(Form("tunfoldY%d", k), "input", nRec, minRange, maxRange);
+      for ( int j = 1; j <= nRec; ++j ) {
+         Double_t y = 0;
+         for ( int i = 1; i <= nGen; ++i ) y += hA->GetBinContent(i, j) * (10 + (k + 1) * i) / 100;
+         y = r.Poisson(y);
+         hY[k]->SetBinContent(j, y);
+         hY[k]->SetBinError(j, TMath::Sqrt(y + 1));
+      }
+   }
+
+   bool status = false;
+   const Double_t tau[3] = { 1.E-3, 1.E-2, 1.E-1 };
+
+   TUnfoldTest unfold(hA);
+   for ( int k = 0; k < 2; ++k ) {
+      unfold.SetInput(hY[k]);
+      for ( int it = 0; it < 3; ++it ) {
+         unfold.DoUnfold(tau[it]);
+         Double_t diff = unfold.DenseDifference();
+         if ( diff > 1.E-8 ) {
+            std::cout << "testTUnfold: result for input " << k << " and tau " << tau[it]
+                      << " differs from the dense calculation by " << diff << std::endl;
+            status = true;
+         }
+         TUnfoldTest fresh(hA);
+         fresh.SetInput(hY[k]);
+         fresh.DoUnfold(tau[it]);
+         if ( !unfold.SameResult(fresh) ) {
+            std::cout << "testTUnfold: repeated unfolding for input " << k << " and tau " << tau[it]
+                      << " differs from a new unfolding" << std::endl;
+            status = true;
+         }
+      }
+   }
+
+   delete hA;
+   delete hY[0];
+   delete hY[1];
+
+   if ( defaultEqualOptions & cmpOptPrint ) std::cout << "testTUnfold: \t" << (status?"FAILED":"OK") << std::endl;
+   return status;
+}
+
+// TEfficiency giving access to the calculation of the intervals without cache
+class TEfficiencyTest : public TEfficiency
+{
+public:
+   TEfficiencyTest(const TH1& passed, const TH1& total) : TEfficiency(passed, total) {}
+   using TEfficiency::ComputeEfficiencyErrorLow;
+   using TEfficiency::ComputeEfficiencyErrorUp;
+};
+
+bool compareEfficiencyIntervals(const TEfficiencyTest& eff, const char* what)
+{
+   // Compares the cached intervals of all the bins (and the ones calculated
+   // in one go by GetEfficiencies) with the calculation of each bin
+
+   bool status = false;
+   std::vector<Double_t> e, low, up;
+   Int_t n = eff.GetEfficiencies(e, low, up);
+   for ( Int_t bin = 0; bin < n; ++bin ) {
+      Double_t refLow = eff.ComputeEfficiencyErrorLow(bin);
+      Double_t refUp = eff.ComputeEfficiencyErrorUp(bin);
+      if ( e[bin] != eff.GetEfficiency(bin) || low[bin] != refLow || up[bin] != refUp ||
+           eff.GetEfficiencyErrorLow(bin) != refLow || eff.GetEfficiencyErrorUp(bin) != refUp ) {
+         std::cout << "testTEfficiency: " << what << ", bin " << bin << ": interval " << e[bin] << " -" << low[bin]
+                   << " +" << up[bin] << " instead of " << eff.GetEfficiency(bin) << " -" << refLow << " +" << refUp << std::endl;
+         status = true;
+      }
+   }
+   return status;
+}
+
+bool testTEfficiency()
+{
+   // Tests the intervals of the efficiencies calculated in one go and kept in
+   // the cache against the calculation of each bin, for all the statistic options,
+   // including the underflow and overflow bins and the bins without events,
+   // without passed events and with all events passed
+
+   TH1D* hTotal = new TH1D("teffTotal", "total", numberOfBins, minRange, maxRange);
+   TH1D* hPassed = new TH1D("teffPassed", "passed", numberOfBins, minRange, maxRange);
+   for ( Int_t bin = 0; bin <= numberOfBins + 1; ++bin ) {
+      Int_t total = r.Integer(50) + 1;
+      Int_t passed = r.Integer(total + 1);
+      if ( bin == 1 ) total = passed = 0;
+      if ( bin == 2 ) passed = 0;
+      if ( bin == 3 ) passed = total;
+      hTotal->SetBinContent(bin, total);
+      hPassed->SetBinContent(bin, passed);
+   }
+
+   bool status = false;
+   TEfficiencyTest eff(*hPassed, *hTotal);
+   const TEfficiency::EStatOption options[8] = { TEfficiency::kFCP, TEfficiency::kFNormal, TEfficiency::kFWilson,
+                                                 TEfficiency::kFAC, TEfficiency::kFFC, TEfficiency::kBJeffrey,
+                                                 TEfficiency::kBUniform, TEfficiency::kBBayesian };
+   for ( int iopt = 0; iopt < 8; ++iopt ) {
+      eff.SetStatisticOption(options[iopt]);
+      status |= compareEfficiencyIntervals(eff, Form("statistic option %d", options[iopt]));
+   }
+
+   // change of the settings and of the contents of some bins
+   eff.SetBetaAlpha(2);
+   eff.SetPosteriorMode(true);
+   status |= compareEfficiencyIntervals(eff, "posterior mode");
+   eff.SetStatisticOption(TEfficiency::kFCP);
+   eff.SetConfidenceLevel(0.95);
+   status |= compareEfficiencyIntervals(eff, "confidence level 0.95");
+   eff.SetTotalEvents(0, 10);
+   eff.SetPassedEvents(0, 10);
+   eff.SetTotalEvents(numberOfBins + 1, 60);
+   eff.SetPassedEvents(numberOfBins + 1, 0);
+   eff.SetTotalEvents(1, 5);
+   eff.SetPassedEvents(1, 3);
+   status |= compareEfficiencyIntervals(eff, "changed events");
+
+   delete hTotal;
+   delete hPassed;
+
+   if ( defaultEqualOptions & cmpOptPrint ) std::cout << "testTEfficiency: \t" << (status?"FAILED":"OK") << std::endl;
+   return status;
+}
+
+struct WideGausKernel {
+   // Gaussian kernel wider than the default support of the user kernels
+   Double_t operator()(Double_t x) const { return TMath::Gaus(x, 0., 4., kTRUE); }
+};
+
+bool compareKDEGrid(TKDE& direct, TKDE& grid, const char* msg)
+{
+   // Compares the density estimated on the FFT grid with the direct sum of the kernels
+   const UInt_t nPoints = 50;
+   std::vector<Double_t> x(nPoints), yDirect(nPoints), yGrid(nPoints);
+   for ( UInt_t i = 0; i < nPoints; ++i )
+      x[i] = minRange + (i + 0.5) * (maxRange - minRange) / nPoints;
+   direct.GetValues(nPoints, &x[0], &yDirect[0]);
+   grid.GetValues(nPoints, &x[0], &yGrid[0]);
+   Double_t yMax = *std::max_element(yDirect.begin(), yDirect.end());
+   bool status = false;
+   for ( UInt_t i = 0; i < nPoints; ++i ) {
+      if ( std::abs(yGrid[i] - yDirect[i]) > 1.E-3 * yMax ) {
+         if ( defaultEqualOptions & cmpOptDebug )
+            std::cout << "testTKDE: " << msg << " at x = " << x[i] << " grid " << yGrid[i]
+                      << " direct " << yDirect[i] << std::endl;
+         status = true;
+      }
+   }
+   return status;
+}
+
+bool testTKDE()
+{
+   // Tests the kernel density estimate computed on a grid with FFT against the direct sum
+   // of the kernels, with the asymmetric mirroring (which needs the kernel sum around the
+   // range mirrored at the boundaries) and with a user kernel wider than 9 bandwidths
+
+   std::vector<Double_t> data(nEvents);
+   for ( Int_t e = 0; e < nEvents; ++e ) {
+      do data[e] = minRange + r.Exp(1.); while ( data[e] >= maxRange );
+   }
+
+   bool status = false;
+   const char* mirrors[3] = { "MirrorAsymBoth", "MirrorAsymLeftRight", "MirrorLeftAsymRight" };
+   for ( int i = 0; i < 3; ++i ) {
+      TString option = TString::Format("KernelType:Gaussian;Iteration:Fixed;Mirror:%s;Binning:Unbinned", mirrors[i]);
+      TKDE direct(nEvents, &data[0], minRange, maxRange, option);
+      TKDE grid(nEvents, &data[0], minRange, maxRange, option);
+      grid.SetUseFFT();
+      status |= compareKDEGrid(direct, grid, mirrors[i]);
+   }
+
+   // the unit integral of the user kernel is checked exactly and fails by rounding
+   WideGausKernel kernel;
+   const char* userOption = "KernelType:UserDefined;Iteration:Fixed;Mirror:MirrorAsymBoth;Binning:Unbinned";
+   int precLevel = gErrorIgnoreLevel;
+   gErrorIgnoreLevel = kBreak;
+   TKDE direct("kdeDirect", kernel, nEvents, &data[0], minRange, maxRange, userOption);
+   TKDE grid("kdeGrid", kernel, nEvents, &data[0], minRange, maxRange, userOption);
+   gErrorIgnoreLevel = precLevel;
+   grid.SetUseFFT();
+   status |= compareKDEGrid(direct, grid, "user kernel");
+
+   if ( defaultEqualOptions & cmpOptPrint ) std::cout << "testTKDE: \t" << (status?"FAILED":"OK") << std::endl;
+   return status;
+}
+
 bool testRefRead1D()
 {
    // Tests consistency with a reference file for 1D Histogram
@@ -9991,7 +10469,7 @@ int stressHistogram()
 
    // Test 10
    // Merge Tests
-   const unsigned int numberOfMerge = 49;
+   const unsigned int numberOfMerge = 53;
    pointer2Test mergeTestPointer[numberOfMerge] = { testMerge1D,                 testMergeProf1D,
                                                     testMergeVar1D,              testMergeProfVar1D,
                                                     testMerge2D,                 testMergeProf2D,
@@ -10017,7 +10495,9 @@ int stressHistogram()
                                                     testMerge3DDiffEmpty,        testMergeProf1DDiffEmpty,
                                                     testMerge1DRebin,            testMerge2DRebin,
                                                     testMerge3DRebin,            testMerge1DRebinProf,
-                                                    testMerge1DNoLimits
+                                                    testMerge1DNoLimits,         testMerge1DSameBinningFloat,
+                                                    testMerge1DSameBinningNoSumw2, testMerge1DSameRangeDiffBins,
+                                                    testMerge1DTH1K
    };
    struct TTestSuite mergeTestSuite = { numberOfMerge,
                                         "Merge tests for 1D, 2D and 3D Histograms and Profiles............",
@@ -10034,11 +10514,12 @@ int stressHistogram()
 
    // Test 12
    // Interpolation Tests
-   const unsigned int numberOfInterpolation = 4;
+   const unsigned int numberOfInterpolation = 5;
    pointer2Test interpolationTestPointer[numberOfInterpolation] = { testInterpolation1D,
                                                                     testInterpolationVar1D,
                                                                     testInterpolation2D,
-                                                                    testInterpolation3D
+                                                                    testInterpolation3D,
+                                                                    testInterpolationGraph2D
    };
    struct TTestSuite interpolationTestSuite = { numberOfInterpolation,
                                                 "Interpolation tests for Histograms...............................",
@@ -10114,9 +10595,20 @@ int stressHistogram()
                                            "FillData tests for Histograms and Sparses........................",
                                            fillDataTestPointer };
 
+   // Test 17
+   // Unfolding, Efficiency and Kernel Density Estimation Tests
+   const unsigned int numberOfUnfold = 3;
+   pointer2Test unfoldTestPointer[numberOfUnfold] = { testTUnfold,
+                                                      testTEfficiency,
+                                                      testTKDE
+   };
+   struct TTestSuite unfoldTestSuite = { numberOfUnfold,
+                                         "TUnfold, TEfficiency and TKDE tests..............................",
+                                         unfoldTestPointer };
+
 
    // Combination of tests
-   const unsigned int numberOfSuits = 16;
+   const unsigned int numberOfSuits = 17;
    struct TTestSuite* testSuite[numberOfSuits];
    testSuite[ 0] = &rangeTestSuite;
    testSuite[ 1] = &rebinTestSuite;
@@ -10134,6 +10626,7 @@ int stressHistogram()
    testSuite[13] = &extendTestSuite;
    testSuite[14] = &conversionsTestSuite;
    testSuite[15] = &fillDataTestSuite;
+   testSuite[16] = &unfoldTestSuite;
 
    status = 0;
    for ( unsigned int i = 0; i < numberOfSuits; ++i ) {
@@ -10148,7 +10641,7 @@ int stressHistogram()
    }
    GlobalStatus += status;
 
-   // Test 17
+   // Test 18
    // Reference Tests
    const unsigned int numberOfRefRead = 7;
    pointer2Test refReadTestPointer[numberOfRefRead] = { testRefRead1D,  testRefReadProf1D,
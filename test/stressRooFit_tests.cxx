@@ -6444,3 +6444,1132 @@ public:
   }
 } ;
 
+
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+// 'PERFORMANCE OPTIMIZATIONS' RooFit regression test #901
+//
+// Likelihood calculated in batch mode compared with the scalar mode
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooDataSet.h"
+#include "RooGaussian.h"
+#include "RooExponential.h"
+#include "RooPolynomial.h"
+#include "RooPoisson.h"
+#include "RooAddPdf.h"
+#include "RooProdPdf.h"
+#include "RooRandom.h"
+#include "TMath.h"
+
+using namespace RooFit ;
+
+
+class TestBasic901 : public RooUnitTest
+{
+public:
+  TestBasic901(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Likelihood in batch mode",refFile,writeRef,verbose) {} ;
+
+  // Compare the likelihood of pdf on data in batch mode and in scalar mode
+  Bool_t compareNLL(RooAbsPdf& pdf, RooDataSet& data, Double_t tol) {
+    RooAbsReal* nllScalar = pdf.createNLL(data) ;
+    RooAbsReal* nllBatch = pdf.createNLL(data,BatchMode(kTRUE)) ;
+    Double_t valScalar = nllScalar->getVal() ;
+    Double_t valBatch = nllBatch->getVal() ;
+    delete nllScalar ;
+    delete nllBatch ;
+    if (TMath::Abs(valBatch-valScalar) > tol*TMath::Abs(valScalar)) {
+      cout << "TestBasic901: likelihood of " << pdf.GetName() << " on " << data.GetName()
+	   << " in batch mode is " << valBatch << " instead of " << valScalar << endl ;
+      return kFALSE ;
+    }
+    return kTRUE ;
+  }
+
+  // Return a copy of data with random weights
+  RooDataSet* weightedData(RooDataSet& data, RooRealVar& w) {
+    RooArgSet vars(*data.get()) ;
+    vars.add(w) ;
+    RooDataSet* wdata = new RooDataSet(Form("%s_weighted",data.GetName()),"weighted data",vars,WeightVar(w)) ;
+    for (Int_t i=0 ; i<data.numEntries() ; i++) {
+      wdata->add(*data.get(i),RooRandom::uniform()*2) ;
+    }
+    return wdata ;
+  }
+
+  Bool_t testCode() {
+
+  // C r e a t e   p . d . f s   w i t h   b a t c h   e v a l u a t i o n
+  // -----------------------------------------------------------------------
+
+  RooRealVar x("x","x",0.5,10) ;
+  RooRealVar y("y","y",-5,5) ;
+  RooRealVar w("w","w",0,2) ;
+
+  RooRealVar m("m","m",4,0,10) ;
+  RooRealVar s("s","s",1.5,0.1,10) ;
+  RooGaussian gauss("gauss","gauss",x,m,s) ;
+
+  RooRealVar c("c","c",-0.3,-1.,0.) ;
+  RooExponential expo("expo","expo",x,c) ;
+
+  RooRealVar a1("a1","a1",0.1,-1,1) ;
+  RooRealVar a2("a2","a2",0.05,-1,1) ;
+  RooPolynomial poly("poly","poly",y,RooArgList(a1,a2)) ;
+
+  RooRealVar f("f","f",0.3,0,1) ;
+  RooAddPdf sum("sum","sum",RooArgList(gauss,expo),f) ;
+
+  RooProdPdf prod("prod","prod",RooArgList(sum,poly)) ;
+
+  // RooPoisson overrides getLogVal(): the batch mode must fall back to the scalar calculation
+  RooRealVar n("n","n",0,20) ;
+  RooRealVar mu("mu","mu",5,0,20) ;
+  RooPoisson pois("pois","pois",n,mu) ;
+
+
+  // C o m p a r e   t h e   l i k e l i h o o d s
+  // -----------------------------------------------
+
+  RooDataSet* datax = sum.generate(x,2500) ;
+  RooDataSet* datay = poly.generate(y,2500) ;
+  RooDataSet* dataxy = prod.generate(RooArgSet(x,y),2500) ;
+  RooDataSet* datan = pois.generate(n,1000) ;
+
+  RooDataSet* wdatax = weightedData(*datax,w) ;
+  RooDataSet* wdatay = weightedData(*datay,w) ;
+  RooDataSet* wdataxy = weightedData(*dataxy,w) ;
+  RooDataSet* wdatan = weightedData(*datan,w) ;
+
+  Bool_t ok = kTRUE ;
+  ok &= compareNLL(gauss,*datax,1e-10) && compareNLL(gauss,*wdatax,1e-10) ;
+  ok &= compareNLL(expo,*datax,1e-10) && compareNLL(expo,*wdatax,1e-10) ;
+  ok &= compareNLL(poly,*datay,1e-10) && compareNLL(poly,*wdatay,1e-10) ;
+  ok &= compareNLL(sum,*datax,1e-10) && compareNLL(sum,*wdatax,1e-10) ;
+  ok &= compareNLL(prod,*dataxy,1e-10) && compareNLL(prod,*wdataxy,1e-10) ;
+  ok &= compareNLL(pois,*datan,0) && compareNLL(pois,*wdatan,0) ;
+
+  delete datax ; delete datay ; delete dataxy ; delete datan ;
+  delete wdatax ; delete wdatay ; delete wdataxy ; delete wdatan ;
+
+  return ok ;
+  }
+} ;
+
+
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+// 'PERFORMANCE OPTIMIZATIONS' RooFit regression test #902
+//
+// Likelihood and fit calculated in parallel threads compared with the serial calculation
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooDataSet.h"
+#include "RooGaussian.h"
+#include "RooGenericPdf.h"
+#include "RooAddPdf.h"
+#include "RooDataHist.h"
+#include "RooHistPdf.h"
+#include "RooFitResult.h"
+#include "TMath.h"
+
+using namespace RooFit ;
+
+
+class TestBasic902 : public RooUnitTest
+{
+public:
+  TestBasic902(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Likelihood in parallel threads",refFile,writeRef,verbose) {} ;
+
+  Bool_t testCode() {
+
+  // C r e a t e   m o d e l   w i t h   n u m e r i c   n o r m a l i z a t i o n
+  // ---------------------------------------------------------------------------------
+
+  RooRealVar x("x","x",-10,10) ;
+
+  RooRealVar m("m","m",1,-5,5) ;
+  RooRealVar s("s","s",2,0.5,5) ;
+  RooGaussian gauss("gauss","gauss",x,m,s) ;
+
+  // Normalization integral of the generic p.d.f. is calculated numerically, which inhibits
+  // the dirty state propagation inside the threads
+  RooRealVar a("a","a",0.2,0.,1.) ;
+  RooGenericPdf bkg("bkg","bkg","1+a*x/10+a*a*x*x/100",RooArgSet(x,a)) ;
+
+  RooRealVar f("f","f",0.4,0.,1.) ;
+  RooAddPdf model("model","model",RooArgList(gauss,bkg),f) ;
+
+  RooDataSet* data = model.generate(x,2000) ;
+
+
+  // C o m p a r e   t h e   l i k e l i h o o d s
+  // -----------------------------------------------
+
+  Bool_t ok = kTRUE ;
+
+  RooAbsReal* nllSerial = model.createNLL(*data) ;
+  RooAbsReal* nllThreads = model.createNLL(*data,NumThreads(4)) ;
+  RooAbsReal* nllInterleave = model.createNLL(*data,NumThreads(3,Interleave)) ;
+
+  // Evaluate repeatedly, since the first calculation after configuration is done sequentially
+  for (Int_t i=0 ; i<3 ; i++) {
+    m.setVal(1+0.1*i) ;
+    a.setVal(0.2+0.1*i) ;
+    Double_t valSerial = nllSerial->getVal() ;
+    Double_t valThreads = nllThreads->getVal() ;
+    Double_t valInterleave = nllInterleave->getVal() ;
+    if (TMath::Abs(valThreads-valSerial) > 1e-10*TMath::Abs(valSerial) ||
+        TMath::Abs(valInterleave-valSerial) > 1e-10*TMath::Abs(valSerial)) {
+      cout << "TestBasic902: likelihood in threads is " << valThreads << " (bulk) and " << valInterleave
+	   << " (interleaved) instead of " << valSerial << endl ;
+      ok = kFALSE ;
+    }
+  }
+
+  delete nllSerial ;
+  delete nllThreads ;
+  delete nllInterleave ;
+
+
+  // C o m p a r e   t h e   f i t   r e s u l t s
+  // -----------------------------------------------
+
+  RooArgSet params(m,s,a,f) ;
+  RooArgSet* init = (RooArgSet*) params.snapshot() ;
+
+  RooFitResult* rSerial = model.fitTo(*data,Save(),PrintLevel(-1)) ;
+  params = *init ;
+  RooFitResult* rThreads = model.fitTo(*data,NumThreads(4),Save(),PrintLevel(-1)) ;
+
+  if (TMath::Abs(rThreads->minNll()-rSerial->minNll()) > 1e-8*TMath::Abs(rSerial->minNll())) {
+    cout << "TestBasic902: minimum of likelihood in threads is " << rThreads->minNll()
+	 << " instead of " << rSerial->minNll() << endl ;
+    ok = kFALSE ;
+  }
+  for (Int_t i=0 ; i<rSerial->floatParsFinal().getSize() ; i++) {
+    RooRealVar* pSerial = (RooRealVar*) rSerial->floatParsFinal().at(i) ;
+    RooRealVar* pThreads = (RooRealVar*) rThreads->floatParsFinal().find(pSerial->GetName()) ;
+    if (!pThreads || TMath::Abs(pThreads->getVal()-pSerial->getVal()) > 1e-4*pSerial->getError()) {
+      cout << "TestBasic902: fitted " << pSerial->GetName() << " in threads is "
+	   << (pThreads ? pThreads->getVal() : 0.) << " instead of " << pSerial->getVal() << endl ;
+      ok = kFALSE ;
+    }
+  }
+
+  delete rSerial ;
+  delete rThreads ;
+  delete init ;
+
+
+  // C o m p a r e   t h e   l i k e l i h o o d s   o f   h i s t o g r a m   p . d . f . s
+  // -------------------------------------------------------------------------------------------
+
+  // Both histogram p.d.f.s and their clones in the threads share the same RooDataHist,
+  // whose bin lookup modifies its internal state
+  RooDataHist hist("hist","hist",x,*data) ;
+  RooHistPdf histPdf("histPdf","histPdf",x,hist,1) ;
+  RooHistPdf histPdf0("histPdf0","histPdf0",x,hist,0) ;
+  RooRealVar g("g","g",0.3,0.,1.) ;
+  RooAddPdf histModel("histModel","histModel",RooArgList(gauss,histPdf,histPdf0),RooArgList(f,g)) ;
+
+  RooAbsReal* histNllSerial = histModel.createNLL(*data) ;
+  RooAbsReal* histNllThreads = histModel.createNLL(*data,NumThreads(4)) ;
+
+  for (Int_t i=0 ; i<3 ; i++) {
+    m.setVal(1+0.1*i) ;
+    g.setVal(0.3+0.1*i) ;
+    Double_t valSerial = histNllSerial->getVal() ;
+    Double_t valThreads = histNllThreads->getVal() ;
+    if (TMath::Abs(valThreads-valSerial) > 1e-10*TMath::Abs(valSerial)) {
+      cout << "TestBasic902: likelihood of histogram p.d.f.s in threads is " << valThreads
+	   << " instead of " << valSerial << endl ;
+      ok = kFALSE ;
+    }
+  }
+
+  delete histNllSerial ;
+  delete histNllThreads ;
+  delete data ;
+
+  return ok ;
+  }
+} ;
+
+
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+// 'PERFORMANCE OPTIMIZATIONS' RooFit regression test #903
+//
+// Components of a simultaneous likelihood calculated in parallel threads
+// compared with the serial calculation
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooCategory.h"
+#include "RooDataSet.h"
+#include "RooGaussian.h"
+#include "RooExponential.h"
+#include "RooGenericPdf.h"
+#include "RooAddPdf.h"
+#include "RooSimultaneous.h"
+#include "TMath.h"
+
+using namespace RooFit ;
+
+
+class TestBasic903 : public RooUnitTest
+{
+public:
+  TestBasic903(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Simultaneous likelihood in parallel threads",refFile,writeRef,verbose) {} ;
+
+  Bool_t testCode() {
+
+  // C r e a t e   s i m u l t a n e o u s   m o d e l
+  // ---------------------------------------------------
+
+  RooRealVar x("x","x",0.,10.) ;
+  RooCategory c("c","c") ;
+  c.defineType("gaus") ;
+  c.defineType("expo") ;
+  c.defineType("poly") ;
+
+  RooRealVar m("m","m",5,0,10) ;
+  RooRealVar s("s","s",1,0.1,5) ;
+  RooGaussian gauss("gauss","gauss",x,m,s) ;
+
+  RooRealVar k("k","k",-0.3,-1.,0.) ;
+  RooExponential expo("expo","expo",x,k) ;
+
+  // Numerically normalized component, which inhibits the dirty state propagation inside its thread
+  RooRealVar a("a","a",0.5,0.,1.) ;
+  RooGenericPdf poly("poly","poly","1+a*x+a*a*x*x/10",RooArgSet(x,a)) ;
+
+  RooRealVar f("f","f",0.5,0.,1.) ;
+  RooAddPdf sum("sum","sum",RooArgList(gauss,poly),f) ;
+
+  RooSimultaneous simPdf("simPdf","simPdf",c) ;
+  simPdf.addPdf(gauss,"gaus") ;
+  simPdf.addPdf(expo,"expo") ;
+  simPdf.addPdf(sum,"poly") ;
+
+  RooDataSet* data = simPdf.generate(RooArgSet(x,c),3000) ;
+
+
+  // C o m p a r e   t h e   l i k e l i h o o d s
+  // -----------------------------------------------
+
+  RooAbsReal* nllSerial = simPdf.createNLL(*data) ;
+  RooAbsReal* nllThreads = simPdf.createNLL(*data,NumThreads(3,SimComponents)) ;
+
+  // Evaluate repeatedly with changes in all, in some and in none of the components,
+  // since only the components with changed parameters are recalculated
+  Bool_t ok = kTRUE ;
+  for (Int_t i=0 ; i<6 ; i++) {
+    if (i%3==0) { m.setVal(5+0.1*i) ; k.setVal(-0.3-0.05*i) ; a.setVal(0.5-0.05*i) ; }
+    if (i%3==1) { f.setVal(0.5+0.05*i) ; }
+    Double_t valSerial = nllSerial->getVal() ;
+    Double_t valThreads = nllThreads->getVal() ;
+    if (TMath::Abs(valThreads-valSerial) > 1e-10*TMath::Abs(valSerial)) {
+      cout << "TestBasic903: simultaneous likelihood in threads is " << valThreads
+	   << " instead of " << valSerial << " in iteration " << i << endl ;
+      ok = kFALSE ;
+    }
+  }
+
+  delete nllSerial ;
+  delete nllThreads ;
+  delete data ;
+
+  return ok ;
+  }
+} ;
+
+
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+// 'PERFORMANCE OPTIMIZATIONS' RooFit regression test #904
+//
+// Likelihood with cache-and-track optimization of additions and formula
+// components compared with the unoptimized calculation
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooDataSet.h"
+#include "RooGaussian.h"
+#include "RooFormulaVar.h"
+#include "RooGenericPdf.h"
+#include "RooAddition.h"
+#include "RooAddPdf.h"
+#include "TMath.h"
+
+using namespace RooFit ;
+
+
+class TestBasic904 : public RooUnitTest
+{
+public:
+  TestBasic904(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Cache-and-track of additions and formulas",refFile,writeRef,verbose) {} ;
+
+  Bool_t testCode() {
+
+  // C r e a t e   m o d e l   w i t h   a d d i t i o n   a n d   f o r m u l a   t e r m s
+  // -----------------------------------------------------------------------------------------
+
+  RooRealVar x("x","x",0.,5.) ;
+
+  RooRealVar a("a","a",0.5,0.,2.) ;
+  RooRealVar b("b","b",0.1,0.,1.) ;
+  RooRealVar c("c","c",0.3,0.,1.) ;
+
+  RooFormulaVar fa("fa","exp(-a*x)",RooArgList(a,x)) ;
+  RooFormulaVar fb("fb","b*x*x",RooArgList(b,x)) ;
+  RooAddition add("add","add",RooArgList(fa,fb)) ;
+  RooFormulaVar fc("fc","c*(1+sin(x))",RooArgList(c,x)) ;
+  RooGenericPdf shape("shape","@0+@1",RooArgList(add,fc)) ;
+
+  RooRealVar m("m","m",2.5,0.,5.) ;
+  RooRealVar s("s","s",0.5,0.1,2.) ;
+  RooGaussian gauss("gauss","gauss",x,m,s) ;
+
+  RooRealVar f("f","f",0.3,0.,1.) ;
+  RooAddPdf model("model","model",RooArgList(gauss,shape),f) ;
+
+  RooDataSet* data = model.generate(x,2000) ;
+
+
+  // C o m p a r e   t h e   l i k e l i h o o d s
+  // -----------------------------------------------
+
+  RooAbsReal* nllPlain = model.createNLL(*data) ;
+  RooAbsReal* nllTrack = model.createNLL(*data,Optimize(2)) ;
+
+  // Change one parameter at a time, so that only the components depending on it are recalculated
+  RooRealVar* pars[5] = { &a, &b, &c, &m, &f } ;
+  Bool_t ok = kTRUE ;
+  for (Int_t i=0 ; i<11 ; i++) {
+    if (i>0) {
+      RooRealVar* p = pars[(i-1)%5] ;
+      p->setVal(p->getVal()*(1+0.05*i)) ;
+    }
+    Double_t valPlain = nllPlain->getVal() ;
+    Double_t valTrack = nllTrack->getVal() ;
+    if (TMath::Abs(valTrack-valPlain) > 1e-10*TMath::Abs(valPlain)) {
+      cout << "TestBasic904: optimized likelihood is " << valTrack << " instead of " << valPlain
+	   << " in iteration " << i << endl ;
+      ok = kFALSE ;
+    }
+  }
+
+  delete nllPlain ;
+  delete nllTrack ;
+  delete data ;
+
+  return ok ;
+  }
+} ;
+
+
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+// 'PERFORMANCE OPTIMIZATIONS' RooFit regression test #905
+//
+// Flattened expression of a tree of formula, addition and product objects
+// compared with the node-by-node evaluation of the tree
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooConstVar.h"
+#include "RooGaussian.h"
+#include "RooFormulaVar.h"
+#include "RooAddition.h"
+#include "RooProduct.h"
+#include "RooClassFactory.h"
+#include "TSystem.h"
+#include "TMath.h"
+#include <string>
+
+using namespace RooFit ;
+
+
+class TestBasic905 : public RooUnitTest
+{
+public:
+  TestBasic905(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Flattened expression trees",refFile,writeRef,verbose) {} ;
+
+  Bool_t testCode() {
+
+  // C r e a t e   e x p r e s s i o n   t r e e
+  // ---------------------------------------------
+
+  RooRealVar x("x","x",1,0,5) ;
+  RooRealVar a("a","a",0.5,0,2) ;
+  RooRealVar b("b","b",1.5,0,3) ;
+  RooRealVar c("c","c",0.2,0,1) ;
+  RooConstVar k("k","k",2.5) ;
+
+  RooRealVar m("m","m",2,0,5) ;
+  RooRealVar s("s","s",1,0.1,2) ;
+  RooGaussian gauss("gauss","gauss",x,m,s) ;
+
+  RooFormulaVar fa("fa","exp(-@0*@1)",RooArgList(a,x)) ;
+  RooProduct prod("prod","prod",RooArgList(fa,k,b)) ;
+  RooFormulaVar fc("fc","pow(x,2)*c+1/2*x*cos(pi/4)",RooArgList(x,c)) ;
+  RooAddition add("add","add",RooArgList(prod,fc)) ;
+  RooFormulaVar top("top","sqrt(@0)+@1",RooArgList(add,gauss)) ;
+
+
+  // F l a t t e n   a n d   c o m p a r e
+  // ---------------------------------------
+
+  std::string expression ;
+  RooArgList inputs ;
+  if (!RooClassFactory::flattenExpression(top,expression,inputs)) {
+    cout << "TestBasic905: expression tree of " << top.GetName() << " cannot be flattened" << endl ;
+    return kFALSE ;
+  }
+
+  // Formulas, additions, products and constants are expanded, the variables and the Gaussian are inputs
+  Bool_t ok = kTRUE ;
+  RooArgSet expected(x,a,b,c,gauss) ;
+  if (inputs.getSize()!=expected.getSize() || !RooArgSet(inputs).equals(expected)) {
+    cout << "TestBasic905: inputs of flattened expression " << expression << " are wrong: " ; inputs.Print() ;
+    ok = kFALSE ;
+  }
+
+  // The formula evaluates 1/2 as 0.5, in C++ the literals must not be integers
+  if (expression.find("1/2")!=std::string::npos || expression.find("pi")!=std::string::npos) {
+    cout << "TestBasic905: flattened expression " << expression << " is not valid C++ for 1/2*x*cos(pi/4)" << endl ;
+    ok = kFALSE ;
+  }
+
+  RooFormulaVar flat("flat",expression.c_str(),inputs) ;
+  for (Int_t i=0 ; i<10 ; i++) {
+    x.setVal(0.5*i) ;
+    a.setVal(0.2*i) ;
+    c.setVal(0.1*(i%5)) ;
+    if (TMath::Abs(flat.getVal()-top.getVal()) > 1e-12*TMath::Abs(top.getVal())) {
+      cout << "TestBasic905: flattened expression " << expression << " is " << flat.getVal()
+	   << " instead of " << top.getVal() << " at x=" << x.getVal() << endl ;
+      ok = kFALSE ;
+    }
+  }
+
+
+  // C o m p i l e   a n d   c o m p a r e
+  // ---------------------------------------
+
+  // Only where ACLiC can compile the generated code
+  if (strlen(gSystem->GetMakeSharedLib())>0) {
+    RooAbsReal* compiled = RooClassFactory::makeCompiledFunction("flat905",top) ;
+    if (!compiled) {
+      cout << "TestBasic905: expression tree of " << top.GetName() << " cannot be compiled" << endl ;
+      return kFALSE ;
+    }
+    for (Int_t i=0 ; i<10 ; i++) {
+      x.setVal(0.5*i) ;
+      a.setVal(0.2*i) ;
+      c.setVal(0.1*(i%5)) ;
+      if (TMath::Abs(compiled->getVal()-top.getVal()) > 1e-12*TMath::Abs(top.getVal())) {
+	cout << "TestBasic905: compiled expression " << expression << " is " << compiled->getVal()
+	     << " instead of " << top.getVal() << " at x=" << x.getVal() << endl ;
+	ok = kFALSE ;
+      }
+    }
+    delete compiled ;
+  }
+
+  return ok ;
+  }
+} ;
+
+
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+// 'PERFORMANCE OPTIMIZATIONS' RooFit regression test #906
+//
+// Generate-and-fit study run in parallel worker processes compared with
+// the study run in this process
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooDataSet.h"
+#include "RooWorkspace.h"
+#include "RooGenFitStudy.h"
+#include "RooStudyManager.h"
+#include "RooRandom.h"
+#include "TMath.h"
+
+using namespace RooFit ;
+
+
+class TestBasic906 : public RooUnitTest
+{
+public:
+  TestBasic906(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Studies in parallel processes",refFile,writeRef,verbose) {} ;
+
+  // Run nExp generate-and-fit experiments of Gaussian model in w in nWorkers processes (serially if nWorkers is 0)
+  RooDataSet* runStudy(RooWorkspace& w, const char* name, Int_t nExp, Int_t nWorkers) {
+    RooGenFitStudy* study = new RooGenFitStudy(name,name) ;
+    study->setGenConfig("g","x",NumEvents(200)) ;
+    study->setFitConfig("g","x",PrintLevel(-1)) ;
+    RooStudyManager mgr(w,*study) ;
+    if (nWorkers>0) {
+      mgr.runParallel(nExp,nWorkers) ;
+    } else {
+      mgr.run(nExp) ;
+    }
+    return study->summaryData() ;
+  }
+
+  Bool_t testCode() {
+
+#ifdef _WIN32
+  // No worker processes on Windows: nothing to compare
+  return kTRUE ;
+#endif
+
+  RooWorkspace w("w") ;
+  w.factory("Gaussian::g(x[-10,10],m[0,-5,5],s[2,0.5,5])") ;
+
+  const Int_t nExp = 20 ;
+  RooDataSet* serial = runStudy(w,"serial",nExp,0) ;
+
+  RooRandom::randomGenerator()->SetSeed(4321) ;
+  RooDataSet* parallel = runStudy(w,"parallel",nExp,3) ;
+  RooRandom::randomGenerator()->SetSeed(4321) ;
+  RooDataSet* repeated = runStudy(w,"repeated",nExp,3) ;
+
+
+  // C o m p a r e   t h e   s u m m a r y   d a t a
+  // -------------------------------------------------
+
+  // All experiments are run once, with the same summary variables as in a serial run
+  if (!serial || !parallel || !repeated) {
+    cout << "TestBasic906: study produced no summary data" << endl ;
+    return kFALSE ;
+  }
+  if (parallel->numEntries()!=nExp || serial->numEntries()!=nExp || !parallel->get()->equals(*serial->get())) {
+    cout << "TestBasic906: " << parallel->numEntries() << " experiments in parallel and " << serial->numEntries()
+	 << " in serial run instead of " << nExp << endl ;
+    return kFALSE ;
+  }
+
+  // The fitted mean is compatible with the generated value
+  Double_t sum(0) ;
+  for (Int_t i=0 ; i<nExp ; i++) {
+    sum += parallel->get(i)->getRealValue("m") ;
+  }
+  if (TMath::Abs(sum/nExp) > 5*2/TMath::Sqrt(200.*nExp)) {
+    cout << "TestBasic906: average fitted mean in parallel run is " << sum/nExp << endl ;
+    return kFALSE ;
+  }
+
+  // The results are reproducible for a given seed of the master process
+  if (repeated->numEntries()!=nExp) {
+    cout << "TestBasic906: " << repeated->numEntries() << " experiments in repeated parallel run instead of " << nExp << endl ;
+    return kFALSE ;
+  }
+  for (Int_t i=0 ; i<nExp ; i++) {
+    if (parallel->get(i)->getRealValue("m") != repeated->get(i)->getRealValue("m") ||
+        parallel->get(i)->getRealValue("s") != repeated->get(i)->getRealValue("s")) {
+      cout << "TestBasic906: experiment " << i << " is not reproduced with the same seed" << endl ;
+      return kFALSE ;
+    }
+  }
+
+  return kTRUE ;
+  }
+} ;
+
+
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+// 'PERFORMANCE OPTIMIZATIONS' RooFit regression test #907
+//
+// Weights of binned data looked up with a cached coordinate matching
+// compared with the lookup by name, also after renaming an observable
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooDataSet.h"
+#include "RooDataHist.h"
+#include "RooPolynomial.h"
+#include "RooProdPdf.h"
+
+using namespace RooFit ;
+
+
+class TestBasic907 : public RooUnitTest
+{
+public:
+  TestBasic907(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Coordinate lookup in binned data",refFile,writeRef,verbose) {} ;
+
+  // Compare weight of coord in hist with the weight of the bin found by name matching
+  Bool_t compareWeight(RooDataHist& hist, const RooArgSet& coord, const char* label) {
+    Double_t w = hist.weight(coord,0,kFALSE) ;
+    hist.get(coord) ;
+    Double_t wref = hist.weight() ;
+    if (w!=wref) {
+      cout << "TestBasic907: weight " << label << " is " << w << " instead of " << wref << endl ;
+      return kFALSE ;
+    }
+    return kTRUE ;
+  }
+
+  Bool_t testCode() {
+
+  RooRealVar x("x","x",0,10) ;
+  RooRealVar y("y","y",0,10) ;
+  RooRealVar u("u","u",0,10) ;
+  x.setBins(10) ;
+  y.setBins(5) ;
+
+  RooRealVar a("a","a",0.1,0.,1.) ;
+  RooRealVar b("b","b",-0.05,-1.,1.) ;
+  RooPolynomial px("px","px",x,RooArgList(a)) ;
+  RooPolynomial py("py","py",y,RooArgList(b)) ;
+  RooProdPdf model("model","model",RooArgList(px,py)) ;
+
+  RooDataSet* data = model.generate(RooArgSet(x,y),5000) ;
+  RooDataHist hist("hist","hist",RooArgSet(x,y),*data) ;
+
+
+  // R e p e a t e d   l o o k u p s   w i t h   t h e   s a m e   s e t
+  // ---------------------------------------------------------------------
+
+  // Coordinate set with the observables in another order and an extra element
+  RooArgSet coord(u,y,x) ;
+  Bool_t ok = kTRUE ;
+  for (Int_t i=0 ; i<10 && ok ; i++) {
+    x.setVal(0.5+i) ;
+    y.setVal(9.5-i) ;
+    u.setVal(0.5+(i*7)%10) ;
+    ok &= compareWeight(hist,coord,Form("at x=%g, y=%g",x.getVal(),y.getVal())) ;
+  }
+
+
+  // L o o k u p s   a f t e r   r e n a m i n g   a n   o b s e r v a b l e
+  // -------------------------------------------------------------------------
+
+  // Observable x of the histogram is now matched by u of the same coordinate set
+  hist.changeObservableName("x","u") ;
+  for (Int_t i=0 ; i<10 && ok ; i++) {
+    x.setVal(0.5+i) ;
+    y.setVal(9.5-i) ;
+    u.setVal(0.5+(i*7)%10) ;
+    ok &= compareWeight(hist,coord,Form("at u=%g, y=%g after renaming",u.getVal(),y.getVal())) ;
+  }
+
+  delete data ;
+
+  return ok ;
+  }
+} ;
+
+
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+// 'PERFORMANCE OPTIMIZATIONS' RooFit regression test #908
+//
+// Dataset with category columns read from the reference file, which may
+// have been written with the RooCatType columns of earlier versions, and
+// written to and read back from a file in memory
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooCategory.h"
+#include "RooDataSet.h"
+#include "RooWorkspace.h"
+#include "TFile.h"
+#include "TMemFile.h"
+#include "TStreamerInfo.h"
+
+using namespace RooFit ;
+
+class TestBasic908 : public RooUnitTest
+{
+public:
+  TestBasic908(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Category columns in stored datasets",refFile,writeRef,verbose) {} ;
+
+  // Expected states of categories c and d in entry i
+  Int_t expectedC(Int_t i) { return i%3 ; }
+  Int_t expectedD(Int_t i) { return (i%7==0) ? -1 : ((i%2) ? 10 : 4) ; }
+  const char* labelC(Int_t i) { const char* labels[3] = { "zero", "one", "two" } ; return labels[expectedC(i)] ; }
+  const char* labelD(Int_t i) { return (i%7==0) ? "minus" : ((i%2) ? "ten" : "four") ; }
+
+  static const Int_t nEntries = 1000 ;
+
+  RooDataSet* makeData() {
+
+    RooRealVar x("x","x",0,nEntries) ;
+    RooCategory c("c","c") ;
+    c.defineType("zero",0) ;
+    c.defineType("one",1) ;
+    c.defineType("two",2) ;
+    RooCategory d("d","d") ;
+    d.defineType("minus",-1) ;
+    d.defineType("four",4) ;
+    d.defineType("ten",10) ;
+
+    // Category columns are RooVectorDataStore::CatVector objects
+    RooAbsData::StorageType oldType = RooAbsData::getDefaultStorageType() ;
+    RooAbsData::setDefaultStorageType(RooAbsData::Vector) ;
+    RooDataSet* data = new RooDataSet("data","data",RooArgSet(x,c,d)) ;
+    RooAbsData::setDefaultStorageType(oldType) ;
+
+    for (Int_t i=0 ; i<nEntries ; i++) {
+      x.setVal(i) ;
+      c.setIndex(expectedC(i)) ;
+      d.setIndex(expectedD(i)) ;
+      data->add(RooArgSet(x,c,d)) ;
+    }
+    return data ;
+  }
+
+  Bool_t checkData(RooAbsData* data, const char* source) {
+
+    if (!data || data->numEntries()!=nEntries) {
+      cout << "TestBasic908: dataset from " << source << " with " << (data ? data->numEntries() : 0) << " entries instead of " << nEntries << endl ;
+      return kFALSE ;
+    }
+
+    for (Int_t i=0 ; i<nEntries ; i++) {
+      const RooArgSet* row = data->get(i) ;
+      const RooCategory* c = (const RooCategory*) row->find("c") ;
+      const RooCategory* d = (const RooCategory*) row->find("d") ;
+      if (c->getIndex()!=expectedC(i) || d->getIndex()!=expectedD(i) ||
+	  TString(c->getLabel())!=labelC(i) || TString(d->getLabel())!=labelD(i)) {
+	cout << "TestBasic908: entry " << i << " from " << source << " has states " << c->getLabel() << "(" << c->getIndex() << "), "
+	     << d->getLabel() << "(" << d->getIndex() << ") instead of " << labelC(i) << "(" << expectedC(i) << "), "
+	     << labelD(i) << "(" << expectedD(i) << ")" << endl ;
+	return kFALSE ;
+      }
+    }
+    return kTRUE ;
+  }
+
+  Bool_t testCode() {
+
+    Bool_t ok = kTRUE ;
+
+    // Round trip through a file in memory, independent of the reference file
+    RooDataSet* data = makeData() ;
+    TMemFile file("rf908_mem.root","RECREATE") ;
+    file.WriteTObject(data,"data") ;
+    file.WriteStreamerInfo() ;
+
+    // The category columns are written with the index only streamer (version 2)
+    TList* infos = file.GetStreamerInfoList() ;
+    TStreamerInfo* info = infos ? (TStreamerInfo*) infos->FindObject("RooVectorDataStore::CatVector") : 0 ;
+    if (!info || info->GetClassVersion()!=2) {
+      cout << "TestBasic908: category column written with version " << (info ? info->GetClassVersion() : -1) << " instead of 2" << endl ;
+      ok = kFALSE ;
+    }
+    if (infos) {
+      infos->Delete() ;
+      delete infos ;
+    }
+
+    RooDataSet* dataRead = (RooDataSet*) file.Get("data") ;
+    ok &= checkData(dataRead,"memory file") ;
+    delete dataRead ;
+
+    if (_write) {
+
+      RooWorkspace* w = new RooWorkspace("w") ;
+      w->import(*data) ;
+      regWS(w,"rf908_ws") ;
+
+    } else if (_refFile && _refFile->FindKey("rf908_ws")) {
+
+      // only if the reference file has the dataset (it is not in reference files written before this test)
+      RooWorkspace* w = getWS("rf908_ws") ;
+      if (!w) ok = kFALSE ;
+      else ok &= checkData(w->data("data"),"reference file") ;
+    }
+
+    delete data ;
+    return ok ;
+  }
+} ;
+
+
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+// 'PERFORMANCE OPTIMIZATIONS' RooFit regression test #909
+//
+// Memoized numeric integrals compared with their recalculation
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooGenericPdf.h"
+#include "RooRealIntegral.h"
+#include "RooNumIntConfig.h"
+
+using namespace RooFit ;
+
+
+class TestBasic909 : public RooUnitTest
+{
+public:
+  TestBasic909(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Memoized numeric integrals",refFile,writeRef,verbose) {} ;
+
+  // Check the numbers of calculated and memoized integrals since the last reset
+  Bool_t checkCounters(Long64_t nInt, Long64_t nHit, const char* label) {
+    if (RooRealIntegral::numIntCount()!=nInt || RooRealIntegral::numIntMemoHitCount()!=nHit) {
+      cout << "TestBasic909: " << RooRealIntegral::numIntCount() << " calculated and " << RooRealIntegral::numIntMemoHitCount()
+	   << " memoized integrals " << label << " instead of " << nInt << " and " << nHit << endl ;
+      return kFALSE ;
+    }
+    return kTRUE ;
+  }
+
+  Bool_t testCode() {
+
+  RooRealVar x("x","x",0,5) ;
+  RooRealVar a("a","a",0.2,0.,1.) ;
+  RooGenericPdf pdf("pdf","pdf","exp(-a*x)*(1+sin(x))",RooArgSet(x,a)) ;
+
+  RooRealIntegral* integ = dynamic_cast<RooRealIntegral*>(pdf.createIntegral(x)) ;
+  if (!integ) {
+    cout << "TestBasic909: integral of " << pdf.GetName() << " is not a RooRealIntegral" << endl ;
+    return kFALSE ;
+  }
+
+  Int_t oldMemoSize = RooRealIntegral::getNumIntMemoSize() ;
+  RooRealIntegral::setNumIntMemoSize(4) ;
+  RooRealIntegral::resetNumIntCounters() ;
+
+  Bool_t ok = kTRUE ;
+
+
+  // R e t u r n   t o   a n   e a r l i e r   p a r a m e t e r   p o i n t
+  // -------------------------------------------------------------------------
+
+  Double_t v1 = integ->getVal() ;
+  a.setVal(0.3) ;
+  Double_t v2 = integ->getVal() ;
+  ok &= checkCounters(2,0,"at two parameter points") ;
+
+  a.setVal(0.2) ;
+  Double_t v3 = integ->getVal() ;
+  ok &= checkCounters(2,1,"after returning to the first point") ;
+
+
+  // C o m p a r e   w i t h   r e c a l c u l a t i o n   w i t h o u t   m e m o
+  // ---------------------------------------------------------------------------------
+
+  RooRealIntegral::setNumIntMemoSize(0) ;
+  a.setVal(0.3) ;
+  Double_t v4 = integ->getVal() ;
+  a.setVal(0.2) ;
+  Double_t v5 = integ->getVal() ;
+  ok &= checkCounters(4,1,"without memo") ;
+  RooRealIntegral::setNumIntMemoSize(4) ;
+
+  if (v3!=v5 || v2!=v4 || v1!=v3) {
+    cout << "TestBasic909: memoized integrals " << v3 << ", " << v2 << " instead of recalculated " << v5 << ", " << v4 << endl ;
+    ok = kFALSE ;
+  }
+
+
+  // N o   m e m o   h i t s   a f t e r   c h a n g i n g   t h e   c o n f i g u r a t i o n
+  // ---------------------------------------------------------------------------------------------
+
+  // Fill the memo again with both points
+  a.setVal(0.3) ;
+  integ->getVal() ;
+  a.setVal(0.2) ;
+  integ->getVal() ;
+  ok &= checkCounters(6,1,"after enabling the memo") ;
+
+  RooNumIntConfig config(*integ->getIntegratorConfig()) ;
+  config.setEpsRel(1e-9) ;
+  config.setEpsAbs(1e-9) ;
+  integ->setIntegratorConfig(config) ;
+  a.setVal(0.3) ;
+  integ->getVal() ;
+  a.setVal(0.2) ;
+  integ->getVal() ;
+  a.setVal(0.3) ;
+  integ->getVal() ;
+  ok &= checkCounters(8,2,"after changing the integrator configuration") ;
+
+  RooRealIntegral::setNumIntMemoSize(oldMemoSize) ;
+  delete integ ;
+
+  return ok ;
+  }
+} ;
+
+
+
+
+/////////////////////////////////////////////////////////////////////////
+//
+// 'PERFORMANCE OPTIMIZATIONS' RooFit regression test #910
+//
+// FFT convolution reusing the transform of unchanged inputs compared
+// with a newly constructed convolution
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooGaussian.h"
+#include "RooLandau.h"
+#include "RooFFTConvPdf.h"
+#include "TPluginManager.h"
+#include "TROOT.h"
+#include "TMath.h"
+
+using namespace RooFit ;
+
+
+class TestBasic910 : public RooUnitTest
+{
+public:
+  TestBasic910(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("FFT convolution with unchanged inputs",refFile,writeRef,verbose) {} ;
+
+  Bool_t isTestAvailable() {
+     // only if ROOT was build with fftw3 enabled
+     TString conffeatures = gROOT->GetConfigFeatures();
+     if(conffeatures.Contains("fftw3")) {
+        TPluginHandler *h;
+        if ((h = gROOT->GetPluginManager()->FindHandler("TVirtualFFT"))) {
+           if (h->LoadPlugin() == -1) {
+              gROOT->ProcessLine("new TNamed ;") ;
+              return kFALSE;
+           } else {
+              return kTRUE ;
+           }
+        }
+     }
+     return kFALSE ;
+  }
+
+  // Compare conv at several values of t with a new convolution of the same inputs, buffer strategy and shift
+  Bool_t compareConv(RooFFTConvPdf& conv, RooRealVar& t, RooAbsPdf& landau, RooAbsPdf& gauss,
+		     RooFFTConvPdf::BufStrat strat, Double_t shift2, const char* label) {
+    RooFFTConvPdf fresh("fresh","fresh",t,landau,gauss) ;
+    fresh.setBufferStrategy(strat) ;
+    fresh.setShift(0,shift2) ;
+    RooArgSet nset(t) ;
+    for (Int_t i=0 ; i<8 ; i++) {
+      t.setVal(-2+4*i) ;
+      Double_t val = conv.getVal(nset) ;
+      Double_t ref = fresh.getVal(nset) ;
+      if (TMath::Abs(val-ref) > 1e-10*TMath::Abs(ref)) {
+	cout << "TestBasic910: convolution " << label << " is " << val << " instead of " << ref << " at t=" << t.getVal() << endl ;
+	return kFALSE ;
+      }
+    }
+    return kTRUE ;
+  }
+
+  Bool_t testCode() {
+
+  // C o n s t r u c t   L a n d a u   ( x )   G a u s s
+  // -----------------------------------------------------
+
+  RooRealVar t("t","t",-10,30) ;
+  t.setBins(2000,"cache") ;
+
+  RooRealVar ml("ml","mean landau",5.,-20,20) ;
+  RooRealVar sl("sl","sigma landau",1,0.1,10) ;
+  RooLandau landau("lx","lx",t,ml,sl) ;
+
+  RooRealVar mg("mg","mg",0) ;
+  RooRealVar sg("sg","sg",2,0.1,10) ;
+  RooGaussian gauss("gauss","gauss",t,mg,sg) ;
+
+  RooFFTConvPdf conv("conv","conv",t,landau,gauss) ;
+  const Double_t shift2 = 10 ;
+
+
+  // C h a n g e   o n l y   r e s o l u t i o n   p a r a m e t e r s
+  // -------------------------------------------------------------------
+
+  Bool_t ok = compareConv(conv,t,landau,gauss,RooFFTConvPdf::Extend,shift2,"initially") ;
+  for (Int_t i=1 ; i<4 && ok ; i++) {
+    sg.setVal(2+0.5*i) ;
+    ok &= compareConv(conv,t,landau,gauss,RooFFTConvPdf::Extend,shift2,Form("after changing the resolution to %g",sg.getVal())) ;
+  }
+  ml.setVal(6) ;
+  ok &= compareConv(conv,t,landau,gauss,RooFFTConvPdf::Extend,shift2,"after changing the Landau mean") ;
+  sg.setVal(1.5) ;
+  ok &= compareConv(conv,t,landau,gauss,RooFFTConvPdf::Extend,shift2,"after changing the resolution back") ;
+
+
+  // C h a n g e   b u f f e r   s t r a t e g y   a n d   s h i f t s
+  // -------------------------------------------------------------------
+
+  conv.setBufferStrategy(RooFFTConvPdf::Mirror) ;
+  ok &= compareConv(conv,t,landau,gauss,RooFFTConvPdf::Mirror,shift2,"after changing the buffer strategy") ;
+  conv.setShift(0,5) ;
+  ok &= compareConv(conv,t,landau,gauss,RooFFTConvPdf::Mirror,5,"after changing the shift") ;
+  sg.setVal(2) ;
+  ok &= compareConv(conv,t,landau,gauss,RooFFTConvPdf::Mirror,5,"after changing the resolution with new shift") ;
+
+  return ok ;
+  }
+} ;